@@ -426,9 +426,11 @@ public class TestSelectAggr extends BaseCQLTest {
     LOG.info("TEST ERRONEOUS CASES FOR AGGREGATE FUNCTIONS");
     setupAggrTest();
 
-    // AVG is not yet supported.
-    execErroneousAggrCalls("SELECT AVG(v2) " +
-                           "  FROM test_aggr_expr WHERE h = 1 AND r = 1;");
+    // GROUP BY is supported only on a prefix of the primary key with all hash columns.
+    execErroneousAggrCalls("SELECT COUNT(*) " +
+                           "  FROM test_aggr_expr GROUP BY r;");
+    execErroneousAggrCalls("SELECT h, v1, COUNT(*) " +
+                           "  FROM test_aggr_expr GROUP BY h;");
 
     // Cannot pass an expression such as constant to AGGR.
     execErroneousAggrCalls("SELECT COUNT(2 + 2) " +
@@ -442,6 +442,15 @@ ReadRpc::ReadRpc(
         if (ql_op->read_time()) {
           ql_op->read_time().AddToPB(&req_);
         }
+        if (yb_consistency_level == YBConsistencyLevel::CONSISTENT_PREFIX &&
+            ql_op->max_staleness()) {
+          // Reads are batched together, so the strictest bound applies to all of them.
+          const uint64_t max_staleness_ms = std::max<int64_t>(
+              ql_op->max_staleness().ToMilliseconds(), 0);
+          if (!req_.has_max_staleness_ms() || max_staleness_ms < req_.max_staleness_ms()) {
+            req_.set_max_staleness_ms(max_staleness_ms);
+          }
+        }
         break;
       }
       case YBOperation::Type::REDIS_WRITE: FALLTHROUGH_INTENDED;
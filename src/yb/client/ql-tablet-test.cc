@@ -50,6 +50,7 @@ DECLARE_uint64(initial_seqno);
 DECLARE_int32(leader_lease_duration_ms);
 DECLARE_int64(db_write_buffer_size);
 DECLARE_bool(use_test_clock);
+DECLARE_int32(max_wait_for_follower_safe_time_ms);
 
 namespace yb {
 namespace client {
@@ -656,5 +657,27 @@ TEST_F(QLTabletTest, SkewedClocks) {
   cluster_.reset();
 }
 
+// Reads with zero staleness from any replica should see all writes done before by the same client.
+TEST_F(QLTabletTest, BoundedStalenessRead) {
+  google::FlagSaver saver;
+  FLAGS_max_wait_for_follower_safe_time_ms = 5000;
+
+  constexpr int kKeys = 100;
+  CreateTable(kTable1Name, &table1_, 1);
+  auto session = CreateSession();
+  for (int i = 0; i != kKeys; ++i) {
+    SetValue(session, i, ValueForKey(i), &table1_);
+
+    auto op = CreateReadOp(i, &table1_);
+    op->set_yb_consistency_level(YBConsistencyLevel::CONSISTENT_PREFIX);
+    op->set_max_staleness(MonoDelta::FromMilliseconds(0));
+    ASSERT_OK(session->Apply(op));
+    ASSERT_EQ(QLResponsePB::YQL_STATUS_OK, op->response().status());
+    auto rowblock = RowsResult(op.get()).GetRowBlock();
+    ASSERT_EQ(1, rowblock->row_count()) << "i: " << i;
+    ASSERT_EQ(ValueForKey(i), rowblock->row(0).column(0).int32_value()) << "i: " << i;
+  }
+}
+
 } // namespace client
 } // namespace yb
@@ -594,6 +594,24 @@ TEST_F(QLTransactionTest, PreserveLogs) {
   VerifyData(kTransactions);
 }
 
+// Flushes intents of a pending transaction and restarts the cluster, so after restart intents
+// are read back from SSTables of the intents RocksDB.
+TEST_F(QLTransactionTest, FlushIntents) {
+  google::FlagSaver flag_saver;
+  SetDisableHeartbeatInTests(true);
+  FLAGS_transaction_timeout_usec = std::chrono::microseconds(60s).count();
+  auto txn = CreateTransaction();
+  WriteRows(CreateSession(txn));
+  ASSERT_OK(cluster_->FlushTablets());
+  ASSERT_OK(cluster_->CleanTabletLogs());
+  ASSERT_OK(cluster_->RestartSync());
+  ASSERT_OK(txn->CommitFuture().get());
+  VerifyData();
+  ASSERT_OK(cluster_->FlushTablets());
+  ASSERT_OK(cluster_->RestartSync());
+  VerifyData();
+}
+
 TEST_F(QLTransactionTest, ResendApplying) {
   google::FlagSaver flag_saver;
 
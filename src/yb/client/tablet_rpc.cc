@@ -45,8 +45,8 @@ TabletInvoker::TabletInvoker(bool consistent_prefix,
 void TabletInvoker::SelectTabletServerWithConsistentPrefix() {
   std::vector<RemoteTabletServer*> candidates;
   current_ts_ = client_->data_->SelectTServer(tablet_.get(),
-                                              YBClient::ReplicaSelection::CLOSEST_REPLICA, {},
-                                              &candidates);
+                                              YBClient::ReplicaSelection::CLOSEST_REPLICA,
+                                              lagging_replicas_, &candidates);
   VLOG(1) << "Using tserver: " << yb::ToString(current_ts_);
 }
 
@@ -208,6 +208,16 @@ bool TabletInvoker::Done(Status* status) {
     *status = resp_error_status;
   }
 
+  // The replica is too stale for a bounded staleness read, but otherwise healthy. Retry on another
+  // replica without marking this one as failed.
+  if (ErrorCode(rpc_->response_error()) ==
+          tserver::TabletServerErrorPB::REPLICA_SAFE_TIME_LAGGING) {
+    lagging_replicas_.insert(current_ts_->permanent_uuid());
+    auto retry_status = retrier_->DelayedRetry(command_, *status);
+    LOG_IF(DFATAL, !retry_status.ok()) << "Retry failed: " << retry_status;
+    return false;
+  }
+
   // Oops, we failed over to a replica that wasn't a LEADER. Unlikely as
   // we're using consensus configuration information from the master, but still possible
   // (e.g. leader restarted and became a FOLLOWER). Try again.
@@ -302,6 +312,7 @@ void TabletInvoker::LookupTabletCb(const Status& status) {
   // but unnecessary the first time through. Seeing as leader failures are
   // rare, perhaps this doesn't matter.
   followers_.clear();
+  lagging_replicas_.clear();
   auto retry_status = retrier_->DelayedRetry(command_, status);
   if (!retry_status.ok()) {
     command_->Finished(status);
@@ -16,6 +16,8 @@
 #ifndef YB_CLIENT_TABLET_RPC_H
 #define YB_CLIENT_TABLET_RPC_H
 
+#include <set>
+#include <string>
 #include <unordered_set>
 
 #include "yb/client/client-internal.h"
@@ -123,6 +125,11 @@ class TabletInvoker {
   // Cleared when new consensus configuration information arrives from the master.
   std::unordered_set<RemoteTabletServer*> followers_;
 
+  // Permanent uuids of tablet servers that rejected a bounded staleness read because their safe
+  // time lagged behind. Cleared when new consensus configuration information arrives from the
+  // master.
+  std::set<std::string> lagging_replicas_;
+
   bool consistent_prefix_;
 
   // The TS receiving the write. May change if the write is retried.
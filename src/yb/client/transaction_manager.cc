@@ -133,7 +133,8 @@ class TransactionManager::Impl {
         tasks_pool_(kQueueLimit) {}
 
   void PickStatusTablet(PickStatusTabletCallback callback) {
-    if (!tasks_pool_.Enqueue(&thread_pool_, client_, &status_table_exists_, std::move(callback))) {
+    if (!tasks_pool_.Enqueue(&thread_pool_, rpc::ThreadPoolTaskPriority::kNormal, client_,
+                             &status_table_exists_, std::move(callback))) {
       callback(STATUS_FORMAT(ServiceUnavailable, "Tasks overflow, exists: $0", tasks_pool_.size()));
     }
   }
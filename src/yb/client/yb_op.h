@@ -41,6 +41,8 @@
 
 #include "yb/client/meta_cache.h"
 
+#include "yb/util/monotime.h"
+
 namespace yb {
 
 class RedisWriteRequestPB;
@@ -298,6 +300,12 @@ class YBqlReadOp : public YBqlOp {
     yb_consistency_level_ = yb_consistency_level;
   }
 
+  // With CONSISTENT_PREFIX consistency level, bounds how far behind the current time the data
+  // returned by a follower could be. Not initialized means no bound.
+  const MonoDelta& max_staleness() const { return max_staleness_; }
+
+  void set_max_staleness(const MonoDelta& max_staleness) { max_staleness_ = max_staleness; }
+
   std::vector<ColumnSchema> MakeColumnSchemasFromRequest() const;
   Result<QLRowBlock> MakeRowBlock() const;
 
@@ -312,6 +320,7 @@ class YBqlReadOp : public YBqlOp {
   explicit YBqlReadOp(const std::shared_ptr<YBTable>& table);
   std::unique_ptr<QLReadRequestPB> ql_read_request_;
   YBConsistencyLevel yb_consistency_level_;
+  MonoDelta max_staleness_;
   ReadHybridTime read_time_;
 };
 
@@ -0,0 +1,60 @@
+//--------------------------------------------------------------------------------------------------
+// Copyright (c) YugaByte, Inc.
+//--------------------------------------------------------------------------------------------------
+
+#include "yb/common/ql_column_batch.h"
+
+#include <algorithm>
+
+#include "yb/common/ql_expr.h"
+
+namespace yb {
+
+QLColumnBatch::QLColumnBatch(std::vector<ColumnId> column_ids)
+    : column_ids_(std::move(column_ids)), columns_(column_ids_.size()) {
+}
+
+void QLColumnBatch::Reset(size_t capacity) {
+  num_rows_ = 0;
+  capacity_ = capacity;
+  selection_.clear();
+}
+
+size_t QLColumnBatch::AddRow() {
+  DCHECK(!full());
+  const size_t row = num_rows_++;
+  for (auto& column : columns_) {
+    if (column.size() > row) {
+      column[row].Clear();
+    } else {
+      column.emplace_back();
+    }
+  }
+  selection_.push_back(1);
+  return row;
+}
+
+void QLColumnBatch::AppendRow(const QLTableRow& table_row) {
+  const size_t row = AddRow();
+  for (size_t i = 0; i != column_ids_.size(); ++i) {
+    const QLTableColumn* column = table_row.FindColumn(column_ids_[i].rep());
+    if (column != nullptr) {
+      columns_[i][row] = column->value;
+    }
+  }
+}
+
+int QLColumnBatch::ColumnIndex(ColumnIdRep col_id) const {
+  for (size_t i = 0; i != column_ids_.size(); ++i) {
+    if (column_ids_[i].rep() == col_id) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+size_t QLColumnBatch::CountSelected() const {
+  return std::count_if(selection_.begin(), selection_.end(), [](uint8_t s) { return s != 0; });
+}
+
+} // namespace yb
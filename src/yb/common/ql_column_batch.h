@@ -0,0 +1,100 @@
+//--------------------------------------------------------------------------------------------------
+// Copyright (c) YugaByte, Inc.
+//
+// This module defines the column batch that is used by the batch-at-a-time QL scan path.
+// Instead of building a QLTableRow (a column-id to value map) for every scanned row, the iterator
+// decodes a batch of rows into per-column vectors. The WHERE condition and the selected
+// expressions are then evaluated over the whole batch, and the selected rows are serialized
+// straight from the column vectors.
+//--------------------------------------------------------------------------------------------------
+
+#ifndef YB_COMMON_QL_COLUMN_BATCH_H_
+#define YB_COMMON_QL_COLUMN_BATCH_H_
+
+#include <vector>
+
+#include "yb/common/ql_value.h"
+#include "yb/common/schema.h"
+
+namespace yb {
+
+class QLTableRow;
+
+class QLColumnBatch {
+ public:
+  // One entry per row of the batch, non-zero when the row is selected.
+  typedef std::vector<uint8_t> Selection;
+
+  // Creates a batch of the given columns. The order of the columns is defined by the reader
+  // that fills the batch.
+  explicit QLColumnBatch(std::vector<ColumnId> column_ids);
+
+  size_t num_columns() const {
+    return column_ids_.size();
+  }
+
+  size_t num_rows() const {
+    return num_rows_;
+  }
+
+  bool empty() const {
+    return num_rows_ == 0;
+  }
+
+  bool full() const {
+    return num_rows_ >= capacity_;
+  }
+
+  // Remove all rows and set the max number of rows in the batch. Values allocated by the previous
+  // batch are kept so they are reused by the next one.
+  void Reset(size_t capacity);
+
+  // Append a new row with all columns set to null, and return its index.
+  size_t AddRow();
+
+  // Append a row read from a table row.
+  void AppendRow(const QLTableRow& table_row);
+
+  // Index of the column with the given id, or -1 if the column is not in the batch.
+  int ColumnIndex(ColumnIdRep col_id) const;
+
+  const ColumnId& column_id(size_t column_index) const {
+    return column_ids_[column_index];
+  }
+
+  const QLValuePB& value(size_t column_index, size_t row) const {
+    return columns_[column_index][row];
+  }
+
+  QLValuePB* mutable_value(size_t column_index, size_t row) {
+    return &columns_[column_index][row];
+  }
+
+  // Values of the column. The vector could contain more entries than num_rows().
+  const std::vector<QLValuePB>& column(size_t column_index) const {
+    return columns_[column_index];
+  }
+
+  // The rows that are selected. All rows are selected when added, conditions unselect the rows
+  // that do not match.
+  const Selection& selection() const {
+    return selection_;
+  }
+
+  Selection* mutable_selection() {
+    return &selection_;
+  }
+
+  size_t CountSelected() const;
+
+ private:
+  std::vector<ColumnId> column_ids_;
+  std::vector<std::vector<QLValuePB>> columns_;
+  Selection selection_;
+  size_t num_rows_ = 0;
+  size_t capacity_ = 0;
+};
+
+} // namespace yb
+
+#endif // YB_COMMON_QL_COLUMN_BATCH_H_
@@ -3,6 +3,9 @@
 //--------------------------------------------------------------------------------------------------
 
 #include "yb/common/ql_expr.h"
+
+#include <algorithm>
+
 #include "yb/common/ql_bfunc.h"
 
 namespace yb {
@@ -311,6 +314,332 @@ CHECKED_STATUS QLExprExecutor::EvalCondition(const QLConditionPB& condition,
 
 //--------------------------------------------------------------------------------------------------
 
+namespace {
+
+bool IsBatchOperand(const QLExpressionPB& ql_expr) {
+  return ql_expr.expr_case() == QLExpressionPB::ExprCase::kValue ||
+         ql_expr.expr_case() == QLExpressionPB::ExprCase::kColumnId;
+}
+
+// Operand of an expression evaluated over a batch: either a constant or a column of the batch.
+// Resolved once per batch, so evaluation of a row does not look up columns by id.
+class BatchOperand {
+ public:
+  BatchOperand(const QLExpressionPB& ql_expr, const QLColumnBatch& batch) {
+    if (ql_expr.expr_case() == QLExpressionPB::ExprCase::kColumnId) {
+      const int index = batch.ColumnIndex(ql_expr.column_id());
+      if (index >= 0) {
+        column_ = &batch.column(index);
+        return;
+      }
+      // Same as QLTableRow::ReadColumn, a missing column is read as null.
+      constant_ = &QLValuePB::default_instance();
+    } else {
+      DCHECK_EQ(ql_expr.expr_case(), QLExpressionPB::ExprCase::kValue);
+      constant_ = &ql_expr.value();
+    }
+  }
+
+  const QLValuePB& operator[](size_t row) const {
+    return constant_ != nullptr ? *constant_ : (*column_)[row];
+  }
+
+ private:
+  const QLValuePB* constant_ = nullptr;
+  const std::vector<QLValuePB>* column_ = nullptr;
+};
+
+template <class Predicate>
+CHECKED_STATUS UnselectRows(
+    const QLColumnBatch& batch, QLColumnBatch::Selection* selection, const Predicate& predicate) {
+  auto& selected = *selection;
+  for (size_t row = 0; row != batch.num_rows(); ++row) {
+    if (selected[row]) {
+      bool match = false;
+      RETURN_NOT_OK(predicate(row, &match));
+      selected[row] = match;
+    }
+  }
+  return Status::OK();
+}
+
+template <class Op>
+CHECKED_STATUS EvalRelationalOpBatch(const QLConditionPB& condition,
+                                     const QLColumnBatch& batch,
+                                     QLColumnBatch::Selection* selection,
+                                     const Op& op) {
+  const auto& operands = condition.operands();
+  CHECK_EQ(operands.size(), 2);
+  const BatchOperand left(operands.Get(0), batch), right(operands.Get(1), batch);
+  return UnselectRows(batch, selection, [&left, &right, &op](size_t row, bool* match) {
+    const QLValuePB& lhs = left[row];
+    const QLValuePB& rhs = right[row];
+    if (!Comparable(lhs, rhs)) {
+      return STATUS(RuntimeError, "values not comparable");
+    }
+    *match = op(lhs, rhs);
+    return Status::OK();
+  });
+}
+
+CHECKED_STATUS EvalInBatch(const QLConditionPB& condition,
+                           const QLColumnBatch& batch,
+                           QLColumnBatch::Selection* selection,
+                           bool match_if_found) {
+  const auto& operands = condition.operands();
+  CHECK_EQ(operands.size(), 2);
+  const BatchOperand left(operands.Get(0), batch);
+  const auto& elems = operands.Get(1).value().list_value().elems();
+  return UnselectRows(batch, selection, [&](size_t row, bool* match) {
+    const QLValuePB& value = left[row];
+    *match = !match_if_found;
+    for (const QLValuePB& elem : elems) {
+      if (!Comparable(elem, value)) {
+        return STATUS(RuntimeError, "values not comparable");
+      }
+      if (elem == value) {
+        *match = match_if_found;
+        break;
+      }
+    }
+    return Status::OK();
+  });
+}
+
+} // namespace
+
+bool QLExprExecutor::CanEvalBatch(const QLExpressionPB& ql_expr) {
+  switch (ql_expr.expr_case()) {
+    case QLExpressionPB::ExprCase::kValue: FALLTHROUGH_INTENDED;
+    case QLExpressionPB::ExprCase::kColumnId:
+      return true;
+
+    case QLExpressionPB::ExprCase::kBfcall:
+      for (const auto& operand : ql_expr.bfcall().operands()) {
+        if (!CanEvalBatch(operand)) {
+          return false;
+        }
+      }
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+bool QLExprExecutor::CanEvalBatch(const QLConditionPB& condition) {
+  const auto& operands = condition.operands();
+  switch (condition.op()) {
+    case QL_OP_NOT: FALLTHROUGH_INTENDED;
+    case QL_OP_AND: FALLTHROUGH_INTENDED;
+    case QL_OP_OR:
+      for (const auto& operand : operands) {
+        if (operand.expr_case() != QLExpressionPB::ExprCase::kCondition ||
+            !CanEvalBatch(operand.condition())) {
+          return false;
+        }
+      }
+      return operands.size() > 0;
+
+    case QL_OP_IS_NULL: FALLTHROUGH_INTENDED;
+    case QL_OP_IS_NOT_NULL: FALLTHROUGH_INTENDED;
+    case QL_OP_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_LESS_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_LESS_THAN_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_GREATER_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_GREATER_THAN_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_NOT_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_BETWEEN:
+      return std::all_of(operands.begin(), operands.end(), IsBatchOperand);
+
+    case QL_OP_EXISTS: FALLTHROUGH_INTENDED;
+    case QL_OP_NOT_EXISTS:
+      return true;
+
+    case QL_OP_IN: FALLTHROUGH_INTENDED;
+    case QL_OP_NOT_IN:
+      return operands.size() == 2 && IsBatchOperand(operands.Get(0)) &&
+             operands.Get(1).has_value() && operands.Get(1).value().has_list_value();
+
+    default:
+      return false;
+  }
+}
+
+CHECKED_STATUS QLExprExecutor::EvalExprBatch(const QLExpressionPB& ql_expr,
+                                             const QLColumnBatch& batch,
+                                             std::vector<QLValue>* results) {
+  results->resize(batch.num_rows());
+  const auto& selected = batch.selection();
+  switch (ql_expr.expr_case()) {
+    case QLExpressionPB::ExprCase::kValue: FALLTHROUGH_INTENDED;
+    case QLExpressionPB::ExprCase::kColumnId: {
+      const BatchOperand operand(ql_expr, batch);
+      for (size_t row = 0; row != batch.num_rows(); ++row) {
+        if (selected[row]) {
+          *(*results)[row].mutable_value() = operand[row];
+        }
+      }
+      return Status::OK();
+    }
+
+    case QLExpressionPB::ExprCase::kBfcall: {
+      // Nested calls are evaluated for the whole batch first, constant and column arguments are
+      // read directly from the batch.
+      const auto& operands = ql_expr.bfcall().operands();
+      std::vector<BatchOperand> simple_operands;
+      std::vector<std::vector<QLValue>> call_results(operands.size());
+      simple_operands.reserve(operands.size());
+      for (int i = 0; i != operands.size(); ++i) {
+        if (IsBatchOperand(operands.Get(i))) {
+          simple_operands.emplace_back(operands.Get(i), batch);
+        } else {
+          RETURN_NOT_OK(EvalExprBatch(operands.Get(i), batch, &call_results[i]));
+        }
+      }
+
+      const auto opcode = static_cast<bfql::BFOpcode>(ql_expr.bfcall().opcode());
+      vector<QLValue> args(operands.size());
+      for (size_t row = 0; row != batch.num_rows(); ++row) {
+        if (!selected[row]) {
+          continue;
+        }
+        size_t simple_index = 0;
+        for (int i = 0; i != operands.size(); ++i) {
+          if (IsBatchOperand(operands.Get(i))) {
+            *args[i].mutable_value() = simple_operands[simple_index++][row];
+          } else {
+            args[i] = call_results[i][row];
+          }
+        }
+        RETURN_NOT_OK(QLBfunc::Exec(opcode, &args, &(*results)[row]));
+      }
+      return Status::OK();
+    }
+
+    default:
+      return STATUS_FORMAT(NotSupported, "Batch evaluation of expression $0",
+                           ql_expr.ShortDebugString());
+  }
+}
+
+CHECKED_STATUS QLExprExecutor::EvalConditionBatch(const QLConditionPB& condition,
+                                                  const QLColumnBatch& batch,
+                                                  QLColumnBatch::Selection* selection) {
+  const auto& operands = condition.operands();
+  auto& selected = *selection;
+  switch (condition.op()) {
+    case QL_OP_NOT: {
+      CHECK_EQ(operands.size(), 1);
+      QLColumnBatch::Selection temp = selected;
+      RETURN_NOT_OK(EvalConditionBatch(operands.Get(0).condition(), batch, &temp));
+      for (size_t row = 0; row != batch.num_rows(); ++row) {
+        selected[row] = selected[row] && !temp[row];
+      }
+      return Status::OK();
+    }
+
+    case QL_OP_IS_NULL: FALLTHROUGH_INTENDED;
+    case QL_OP_IS_NOT_NULL: {
+      CHECK_EQ(operands.size(), 1);
+      const BatchOperand operand(operands.Get(0), batch);
+      const bool match_null = condition.op() == QL_OP_IS_NULL;
+      for (size_t row = 0; row != batch.num_rows(); ++row) {
+        selected[row] = selected[row] && IsNull(operand[row]) == match_null;
+      }
+      return Status::OK();
+    }
+
+    case QL_OP_EQUAL:
+      return EvalRelationalOpBatch(condition, batch, selection,
+          [](const QLValuePB& lhs, const QLValuePB& rhs) { return lhs == rhs; });
+
+    case QL_OP_LESS_THAN:
+      return EvalRelationalOpBatch(condition, batch, selection,
+          [](const QLValuePB& lhs, const QLValuePB& rhs) { return lhs < rhs; });
+
+    case QL_OP_LESS_THAN_EQUAL:
+      return EvalRelationalOpBatch(condition, batch, selection,
+          [](const QLValuePB& lhs, const QLValuePB& rhs) { return lhs <= rhs; });
+
+    case QL_OP_GREATER_THAN:
+      return EvalRelationalOpBatch(condition, batch, selection,
+          [](const QLValuePB& lhs, const QLValuePB& rhs) { return lhs > rhs; });
+
+    case QL_OP_GREATER_THAN_EQUAL:
+      return EvalRelationalOpBatch(condition, batch, selection,
+          [](const QLValuePB& lhs, const QLValuePB& rhs) { return lhs >= rhs; });
+
+    case QL_OP_NOT_EQUAL:
+      return EvalRelationalOpBatch(condition, batch, selection,
+          [](const QLValuePB& lhs, const QLValuePB& rhs) { return lhs != rhs; });
+
+    case QL_OP_AND:
+      // Each operand narrows the selection, so later operands are evaluated only for the rows
+      // that matched all previous ones, same as short-circuit evaluation of a single row.
+      CHECK_GT(operands.size(), 0);
+      for (const auto &operand : operands) {
+        RETURN_NOT_OK(EvalConditionBatch(operand.condition(), batch, selection));
+      }
+      return Status::OK();
+
+    case QL_OP_OR: {
+      // Each operand is evaluated only for the rows that did not match any previous one.
+      CHECK_GT(operands.size(), 0);
+      QLColumnBatch::Selection remaining = selected;
+      QLColumnBatch::Selection temp;
+      std::fill(selected.begin(), selected.end(), 0);
+      for (const auto &operand : operands) {
+        temp = remaining;
+        RETURN_NOT_OK(EvalConditionBatch(operand.condition(), batch, &temp));
+        for (size_t row = 0; row != batch.num_rows(); ++row) {
+          if (temp[row]) {
+            selected[row] = 1;
+            remaining[row] = 0;
+          }
+        }
+      }
+      return Status::OK();
+    }
+
+    case QL_OP_BETWEEN: {
+      CHECK_EQ(operands.size(), 3);
+      const BatchOperand value(operands.Get(0), batch);
+      const BatchOperand lower(operands.Get(1), batch), upper(operands.Get(2), batch);
+      return UnselectRows(batch, selection, [&value, &lower, &upper](size_t row, bool* match) {
+        const QLValuePB& temp = value[row];
+        if (!Comparable(temp, lower[row]) || !Comparable(temp, upper[row])) {
+          return STATUS(RuntimeError, "values not comparable");
+        }
+        *match = temp >= lower[row] && temp <= upper[row];
+        return Status::OK();
+      });
+    }
+
+    // Rows of a batch always have the primary key columns populated, so they always exist.
+    case QL_OP_EXISTS:
+      return Status::OK();
+
+    case QL_OP_NOT_EXISTS:
+      std::fill(selected.begin(), selected.end(), 0);
+      return Status::OK();
+
+    case QL_OP_IN:
+      return EvalInBatch(condition, batch, selection, true /* match_if_found */);
+
+    case QL_OP_NOT_IN:
+      return EvalInBatch(condition, batch, selection, false /* match_if_found */);
+
+    default:
+      break;
+  }
+
+  return STATUS_FORMAT(NotSupported, "Batch evaluation of condition $0",
+                       condition.ShortDebugString());
+}
+
+//--------------------------------------------------------------------------------------------------
+
 CHECKED_STATUS QLTableRow::ReadColumn(ColumnIdRep col_id, QLValue *col_value) const {
   const auto& col_iter = col_map_.find(col_id);
   if (col_iter == col_map_.end()) {
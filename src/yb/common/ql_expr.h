@@ -10,6 +10,7 @@
 #include "yb/common/ql_value.h"
 #include "yb/common/schema.h"
 #include "yb/common/ql_bfunc.h"
+#include "yb/common/ql_column_batch.h"
 
 namespace yb {
 
@@ -87,6 +88,12 @@ class QLTableRow {
     return GetValue(col.rep(), column);
   }
 
+  // Get the column, or nullptr if the row has no such column.
+  const QLTableColumn* FindColumn(ColumnIdRep col_id) const {
+    const auto it = col_map_.find(col_id);
+    return it != col_map_.end() ? &it->second : nullptr;
+  }
+
   // Get the column value in PB format.
   CHECKED_STATUS ReadColumn(ColumnIdRep col_id, QLValue *col_value) const;
   CHECKED_STATUS ReadSubscriptedColumn(const QLSubscriptedColPB& subcol,
@@ -157,6 +164,27 @@ class QLExprExecutor {
   virtual CHECKED_STATUS EvalCondition(const QLConditionPB& condition,
                                        const QLTableRow& table_row,
                                        QLValue *result);
+
+  //------------------------------------------------------------------------------------------------
+  // Batch evaluation over the rows of a QLColumnBatch. Only a subset of expressions is supported:
+  // constants, columns and builtin calls of them in select expressions, and logical, relational,
+  // null-check, BETWEEN and IN conditions of constants and columns.
+
+  // Check whether the expression / condition could be evaluated over a batch.
+  static bool CanEvalBatch(const QLExpressionPB& ql_expr);
+  static bool CanEvalBatch(const QLConditionPB& condition);
+
+  // Evaluate the expression for the selected rows of the batch. results[i] is set to the value
+  // for row i.
+  CHECKED_STATUS EvalExprBatch(const QLExpressionPB& ql_expr,
+                               const QLColumnBatch& batch,
+                               std::vector<QLValue>* results);
+
+  // Evaluate a boolean condition for the rows of the batch, unselecting rows in "selection" that
+  // do not satisfy it. Rows that are not selected are not evaluated.
+  CHECKED_STATUS EvalConditionBatch(const QLConditionPB& condition,
+                                    const QLColumnBatch& batch,
+                                    QLColumnBatch::Selection* selection);
 };
 
 } // namespace yb
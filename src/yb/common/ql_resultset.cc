@@ -62,7 +62,8 @@ QLRSRow *QLResultSet::AllocateRSRow(int32_t rscol_count) {
 CHECKED_STATUS QLResultSet::CQLSerialize(const QLClient& client,
                                          const QLRSRowDesc& rsrow_desc,
                                          faststring* buffer) const {
-  CQLEncodeLength(rsrows_.size(), buffer);
+  CQLEncodeLength(rsrow_count(), buffer);
+  buffer->append(serialized_rows_.data(), serialized_rows_.size());
   for (const auto& rsrow : rsrows_) {
     RETURN_NOT_OK(rsrow.CQLSerialize(client, rsrow_desc, buffer));
   }
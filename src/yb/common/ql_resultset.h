@@ -33,10 +33,10 @@ class QLRSRowDesc {
     RSColDesc(const string& name, const QLType::SharedPtr& ql_type)
         : name_(name), ql_type_(ql_type) {
     }
-    const string& name() {
+    const string& name() const {
       return name_;
     }
-    const QLType::SharedPtr& ql_type() {
+    const QLType::SharedPtr& ql_type() const {
       return ql_type_;
     }
    private:
@@ -100,8 +100,13 @@ class QLResultSet {
   // Allocate a new rsrow and append it to the end of result set.
   QLRSRow *AllocateRSRow(int32_t rscol_count);
 
+  // Rows serialized in CQL format directly by the batch scan path, bypassing QLRSRow. They are
+  // not included in rsrows() and precede them in the serialized result set.
+  faststring* mutable_serialized_rows() { return &serialized_rows_; }
+  void AddSerializedRows(size_t count) { serialized_row_count_ += count; }
+
   // Row count
-  size_t rsrow_count() const { return rsrows_.size(); }
+  size_t rsrow_count() const { return rsrows_.size() + serialized_row_count_; }
 
   // Serialization routines with CQL encoding format.
   CHECKED_STATUS CQLSerialize(const QLClient& client,
@@ -110,6 +115,8 @@ class QLResultSet {
 
  private:
   std::vector<QLRSRow> rsrows_;
+  faststring serialized_rows_;
+  size_t serialized_row_count_ = 0;
 };
 
 } // namespace yb
@@ -14,6 +14,7 @@
 #ifndef YB_COMMON_QL_ROWWISE_ITERATOR_INTERFACE_H
 #define YB_COMMON_QL_ROWWISE_ITERATOR_INTERFACE_H
 
+#include "yb/common/ql_column_batch.h"
 #include "yb/common/ql_rowblock.h"
 #include "yb/common/ql_resultset.h"
 #include "yb/common/ql_scanspec.h"
@@ -45,6 +46,19 @@ class QLRowwiseIteratorIf {
     return DoNextRow(schema(), table_row);
   }
 
+  // Read rows using the specified projection into the column batch until it is full. Reading
+  // stops before a static row, so rows with static columns are left for NextRow.
+  // The default implementation reads the rows one at a time.
+  virtual CHECKED_STATUS NextRowBatch(const Schema& projection, QLColumnBatch* batch) {
+    QLTableRow table_row;
+    while (!batch->full() && HasNext() && !IsNextStaticColumn()) {
+      table_row.Clear();
+      RETURN_NOT_OK(DoNextRow(projection, &table_row));
+      batch->AppendRow(table_row);
+    }
+    return Status::OK();
+  }
+
   // Skip the current row.
   virtual void SkipRow() = 0;
 
@@ -309,5 +309,16 @@ CHECKED_STATUS QLScanSpec::Match(const QLTableRow& table_row, bool* match) const
   return Status::OK();
 }
 
+CHECKED_STATUS QLScanSpec::MatchBatch(QLColumnBatch* batch) const {
+  if (condition_ != nullptr) {
+    return executor_->EvalConditionBatch(*condition_, *batch, batch->mutable_selection());
+  }
+  return Status::OK();
+}
+
+bool QLScanSpec::CanMatchBatch() const {
+  return condition_ == nullptr || QLExprExecutor::CanEvalBatch(*condition_);
+}
+
 } // namespace common
 } // namespace yb
@@ -75,6 +75,12 @@ class QLScanSpec {
   // virtual to make the class polymorphic.
   virtual CHECKED_STATUS Match(const QLTableRow& table_row, bool* match) const;
 
+  // Evaluate the WHERE condition for the rows of the batch, unselecting rows that do not match.
+  CHECKED_STATUS MatchBatch(QLColumnBatch* batch) const;
+
+  // Whether the WHERE condition could be evaluated by MatchBatch.
+  bool CanMatchBatch() const;
+
   bool is_forward_scan() const {
     return is_forward_scan_;
   }
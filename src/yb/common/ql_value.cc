@@ -215,6 +215,50 @@ void AppendToKey(const QLValuePB &value_pb, string *bytes) {
   }
 }
 
+void QLValue::Serialize(const QLValuePB& pb,
+                        const std::shared_ptr<QLType>& ql_type,
+                        const QLClient& client,
+                        faststring* buffer) {
+  CHECK_EQ(client, YQL_CLIENT_CQL);
+  if (yb::IsNull(pb)) {
+    CQLEncodeLength(-1, buffer);
+    return;
+  }
+
+  switch (ql_type->main()) {
+    case INT8:
+      CQLEncodeNum(Store8, static_cast<int8_t>(pb.int8_value()), buffer);
+      return;
+    case INT16:
+      CQLEncodeNum(NetworkByteOrder::Store16, static_cast<int16_t>(pb.int16_value()), buffer);
+      return;
+    case INT32:
+      CQLEncodeNum(NetworkByteOrder::Store32, pb.int32_value(), buffer);
+      return;
+    case INT64:
+      CQLEncodeNum(NetworkByteOrder::Store64, pb.int64_value(), buffer);
+      return;
+    case FLOAT:
+      CQLEncodeFloat(NetworkByteOrder::Store32, pb.float_value(), buffer);
+      return;
+    case DOUBLE:
+      CQLEncodeFloat(NetworkByteOrder::Store64, pb.double_value(), buffer);
+      return;
+    case STRING:
+      CQLEncodeBytes(pb.string_value(), buffer);
+      return;
+    case BOOL:
+      CQLEncodeNum(Store8, static_cast<uint8>(pb.bool_value() ? 1 : 0), buffer);
+      return;
+    case BINARY:
+      CQLEncodeBytes(pb.binary_value(), buffer);
+      return;
+    default:
+      QLValue(pb).Serialize(ql_type, client, buffer);
+      return;
+  }
+}
+
 void QLValue::Serialize(
     const std::shared_ptr<QLType>& ql_type, const QLClient& client, faststring* buffer) const {
   CHECK_EQ(client, YQL_CLIENT_CQL);
@@ -334,6 +334,12 @@ class QLValue {
   virtual void Serialize(const std::shared_ptr<QLType>& ql_type,
                          const QLClient& client,
                          faststring* buffer) const;
+  // Serialize a value in protobuf format without copying it into a QLValue first, which is
+  // only needed for collection and other non-primitive types.
+  static void Serialize(const QLValuePB& pb,
+                        const std::shared_ptr<QLType>& ql_type,
+                        const QLClient& client,
+                        faststring* buffer);
   virtual CHECKED_STATUS Deserialize(const std::shared_ptr<QLType>& ql_type,
                                      const QLClient& client,
                                      Slice* data);
@@ -351,13 +351,15 @@ class TableProperties {
       : default_time_to_live_(kNoDefaultTtl),
         contain_counters_(false),
         is_transactional_(false),
-        copartition_table_id_(kNoCopartitionTableId) {}
+        copartition_table_id_(kNoCopartitionTableId),
+        num_bloom_filter_range_components_(0) {}
 
   TableProperties(const TableProperties& other) {
     default_time_to_live_ = other.default_time_to_live_;
     contain_counters_ = other.contain_counters_;
     is_transactional_ = other.is_transactional_;
     copartition_table_id_ = other.copartition_table_id_;
+    num_bloom_filter_range_components_ = other.num_bloom_filter_range_components_;
   }
 
   // Containing counters is a internal property instead of a user-defined property, so we don't use
@@ -410,6 +412,16 @@ class TableProperties {
     copartition_table_id_ = copartition_table_id;
   }
 
+  // The number of first range components of the keys that bloom filters take into account in
+  // addition to the hashed components. It can only be set when a table is created.
+  uint32_t num_bloom_filter_range_components() const {
+    return num_bloom_filter_range_components_;
+  }
+
+  void SetNumBloomFilterRangeComponents(uint32_t num_bloom_filter_range_components) {
+    num_bloom_filter_range_components_ = num_bloom_filter_range_components;
+  }
+
   void ToTablePropertiesPB(TablePropertiesPB *pb) const {
     if (HasDefaultTimeToLive()) {
       pb->set_default_time_to_live(default_time_to_live_);
@@ -419,6 +431,9 @@ class TableProperties {
     if (HasCopartitionTableId()) {
       pb->set_copartition_table_id(copartition_table_id_);
     }
+    if (num_bloom_filter_range_components_ != 0) {
+      pb->set_num_bloom_filter_range_components(num_bloom_filter_range_components_);
+    }
   }
 
   static TableProperties FromTablePropertiesPB(const TablePropertiesPB& pb) {
@@ -435,6 +450,9 @@ class TableProperties {
     if (pb.has_copartition_table_id()) {
       table_properties.SetCopartitionTableId(pb.copartition_table_id());
     }
+    if (pb.has_num_bloom_filter_range_components()) {
+      table_properties.SetNumBloomFilterRangeComponents(pb.num_bloom_filter_range_components());
+    }
     return table_properties;
   }
 
@@ -455,6 +473,7 @@ class TableProperties {
     contain_counters_ = false;
     is_transactional_ = false;
     copartition_table_id_ = kNoCopartitionTableId;
+    num_bloom_filter_range_components_ = 0;
   }
 
  private:
@@ -463,6 +482,7 @@ class TableProperties {
   bool contain_counters_;
   bool is_transactional_;
   TableId copartition_table_id_;
+  uint32_t num_bloom_filter_range_components_;
 };
 
 // The schema for a set of rows.
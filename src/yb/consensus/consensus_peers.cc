@@ -64,6 +64,7 @@ DEFINE_int32(consensus_rpc_timeout_ms, 2000,
 TAG_FLAG(consensus_rpc_timeout_ms, advanced);
 
 DECLARE_int32(raft_heartbeat_interval_ms);
+DECLARE_bool(enable_multi_raft_heartbeat_batcher);
 
 DEFINE_test_flag(double, fault_crash_on_leader_request_fraction, 0.0,
                  "Fraction of the time when the leader will crash just before sending an "
@@ -265,16 +266,24 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   MAYBE_FAULT(FLAGS_fault_crash_on_leader_request_fraction);
   controller_.Reset();
 
-  proxy_->UpdateAsync(&request_, &response_, &controller_, std::bind(&Peer::ProcessResponse, this));
+  if (!req_has_ops) {
+    // Heartbeats of idle tablets to the same server may be coalesced by the proxy.
+    proxy_->HeartbeatAsync(&request_, &response_, &controller_,
+                           std::bind(&Peer::ProcessResponse, this, std::placeholders::_1));
+    return;
+  }
+  proxy_->UpdateAsync(&request_, &response_, &controller_, [this] {
+    ProcessResponse(controller_.status());
+  });
 }
 
-void Peer::ProcessResponse() {
+void Peer::ProcessResponse(const Status& status) {
   // Note: This method runs on the reactor thread.
 
   DCHECK_LE(sem_.GetValue(), 0) << "Got a response when nothing was pending";
 
-  if (!controller_.status().ok()) {
-    if (controller_.status().IsRemoteError()) {
+  if (!status.ok()) {
+    if (status.IsRemoteError()) {
       // Most controller errors are caused by network issues or corner cases like shutdown and
       // failure to serialize a protobuf. Therefore, we generally consider these errors to indicate
       // an unreachable peer.  However, a RemoteError wraps some other error propagated from the
@@ -282,7 +291,7 @@ void Peer::ProcessResponse() {
       // remote is responsive.
       queue_->NotifyPeerIsResponsiveDespiteError(peer_pb_.permanent_uuid());
     }
-    ProcessResponseError(controller_.status());
+    ProcessResponseError(status);
     return;
   }
 
@@ -404,9 +413,11 @@ Peer::~Peer() {
 }
 
 RpcPeerProxy::RpcPeerProxy(gscoped_ptr<HostPort> hostport,
-                           gscoped_ptr<ConsensusServiceProxy> consensus_proxy)
+                           gscoped_ptr<ConsensusServiceProxy> consensus_proxy,
+                           MultiRaftHeartbeatBatcherPtr multi_raft_batcher)
     : hostport_(hostport.Pass()),
-      consensus_proxy_(consensus_proxy.Pass()) {
+      consensus_proxy_(consensus_proxy.Pass()),
+      multi_raft_batcher_(std::move(multi_raft_batcher)) {
 }
 
 void RpcPeerProxy::UpdateAsync(const ConsensusRequestPB* request,
@@ -417,6 +428,17 @@ void RpcPeerProxy::UpdateAsync(const ConsensusRequestPB* request,
   consensus_proxy_->UpdateConsensusAsync(*request, response, controller, callback);
 }
 
+void RpcPeerProxy::HeartbeatAsync(const ConsensusRequestPB* request,
+                                  ConsensusResponsePB* response,
+                                  rpc::RpcController* controller,
+                                  const HeartbeatResponseCallback& callback) {
+  if (multi_raft_batcher_ && FLAGS_enable_multi_raft_heartbeat_batcher) {
+    multi_raft_batcher_->AddRequestToBatch(*request, response, callback);
+    return;
+  }
+  PeerProxy::HeartbeatAsync(request, response, controller, callback);
+}
+
 void RpcPeerProxy::RequestConsensusVoteAsync(const VoteRequestPB* request,
                                              VoteResponsePB* response,
                                              rpc::RpcController* controller,
@@ -466,8 +488,9 @@ Status CreateConsensusServiceProxyForHost(const shared_ptr<Messenger>& messenger
 
 } // anonymous namespace
 
-RpcPeerProxyFactory::RpcPeerProxyFactory(shared_ptr<Messenger> messenger)
-    : messenger_(std::move(messenger)) {}
+RpcPeerProxyFactory::RpcPeerProxyFactory(shared_ptr<Messenger> messenger,
+                                         MultiRaftManager* multi_raft_manager)
+    : messenger_(std::move(messenger)), multi_raft_manager_(multi_raft_manager) {}
 
 Status RpcPeerProxyFactory::NewProxy(const RaftPeerPB& peer_pb,
                                      gscoped_ptr<PeerProxy>* proxy) {
@@ -475,7 +498,11 @@ Status RpcPeerProxyFactory::NewProxy(const RaftPeerPB& peer_pb,
   RETURN_NOT_OK(HostPortFromPB(peer_pb.last_known_addr(), hostport.get()));
   gscoped_ptr<ConsensusServiceProxy> new_proxy;
   RETURN_NOT_OK(CreateConsensusServiceProxyForHost(messenger_, *hostport, &new_proxy));
-  proxy->reset(new RpcPeerProxy(hostport.Pass(), new_proxy.Pass()));
+  MultiRaftHeartbeatBatcherPtr multi_raft_batcher;
+  if (multi_raft_manager_) {
+    multi_raft_batcher = VERIFY_RESULT(multi_raft_manager_->AddOrGetBatcher(*hostport));
+  }
+  proxy->reset(new RpcPeerProxy(hostport.Pass(), new_proxy.Pass(), std::move(multi_raft_batcher)));
   return Status::OK();
 }
 
@@ -42,6 +42,7 @@
 #include "yb/consensus/metadata.pb.h"
 #include "yb/consensus/ref_counted_replicate.h"
 #include "yb/consensus/consensus_util.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/rpc/response_callback.h"
 #include "yb/rpc/rpc_controller.h"
 #include "yb/util/countdown_latch.h"
@@ -168,10 +169,10 @@ class Peer {
 
   void SendNextRequest(RequestTriggerMode trigger_mode);
 
-  // Signals that a response was received from the peer.  This method is called from the reactor
-  // thread and calls DoProcessResponse() on raft_pool_token_ to do any work that requires IO or
-  // lock-taking.
-  void ProcessResponse();
+  // Signals that a response was received from the peer, or that sending the request failed with
+  // 'status'.  This method is called from the reactor thread and calls DoProcessResponse() on
+  // raft_pool_token_ to do any work that requires IO or lock-taking.
+  void ProcessResponse(const Status& status);
 
   // Run on 'raft_pool_token'. Does response handling that requires IO or may block.
   void DoProcessResponse();
@@ -255,6 +256,17 @@ class PeerProxy {
                            rpc::RpcController* controller,
                            const rpc::ResponseCallback& callback) = 0;
 
+  // Sends a request without new operations, asynchronously, to a remote peer. It may be batched
+  // with the heartbeats of other tablets to the same server. 'callback' gets the RPC status.
+  virtual void HeartbeatAsync(const ConsensusRequestPB* request,
+                              ConsensusResponsePB* response,
+                              rpc::RpcController* controller,
+                              const HeartbeatResponseCallback& callback) {
+    UpdateAsync(request, response, controller, [controller, callback] {
+      callback(controller->status());
+    });
+  }
+
   // Sends a RequestConsensusVote to a remote peer.
   virtual void RequestConsensusVoteAsync(const VoteRequestPB* request,
                                          VoteResponsePB* response,
@@ -302,13 +314,19 @@ class PeerProxyFactory {
 class RpcPeerProxy : public PeerProxy {
  public:
   RpcPeerProxy(gscoped_ptr<HostPort> hostport,
-               gscoped_ptr<ConsensusServiceProxy> consensus_proxy);
+               gscoped_ptr<ConsensusServiceProxy> consensus_proxy,
+               MultiRaftHeartbeatBatcherPtr multi_raft_batcher = nullptr);
 
   virtual void UpdateAsync(const ConsensusRequestPB* request,
                            ConsensusResponsePB* response,
                            rpc::RpcController* controller,
                            const rpc::ResponseCallback& callback) override;
 
+  virtual void HeartbeatAsync(const ConsensusRequestPB* request,
+                              ConsensusResponsePB* response,
+                              rpc::RpcController* controller,
+                              const HeartbeatResponseCallback& callback) override;
+
   virtual void RequestConsensusVoteAsync(const VoteRequestPB* request,
                                          VoteResponsePB* response,
                                          rpc::RpcController* controller,
@@ -334,12 +352,16 @@ class RpcPeerProxy : public PeerProxy {
  private:
   gscoped_ptr<HostPort> hostport_;
   gscoped_ptr<ConsensusServiceProxy> consensus_proxy_;
+  // Shared by the proxies to the same server, null when heartbeats are not batched.
+  MultiRaftHeartbeatBatcherPtr multi_raft_batcher_;
 };
 
 // PeerProxyFactory implementation that generates RPCPeerProxies
 class RpcPeerProxyFactory : public PeerProxyFactory {
  public:
-  explicit RpcPeerProxyFactory(std::shared_ptr<rpc::Messenger> messenger);
+  // 'multi_raft_manager' may be null, in which case heartbeats are never batched.
+  RpcPeerProxyFactory(std::shared_ptr<rpc::Messenger> messenger,
+                      MultiRaftManager* multi_raft_manager = nullptr);
 
   virtual CHECKED_STATUS NewProxy(const RaftPeerPB& peer_pb,
                           gscoped_ptr<PeerProxy>* proxy) override;
@@ -347,6 +369,7 @@ class RpcPeerProxyFactory : public PeerProxyFactory {
   virtual ~RpcPeerProxyFactory();
  private:
   std::shared_ptr<rpc::Messenger> messenger_;
+  MultiRaftManager* const multi_raft_manager_;
 };
 
 // Query the consensus service at last known host/port that is specified in 'remote_peer' and set
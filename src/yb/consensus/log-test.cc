@@ -43,6 +43,7 @@
 #include "yb/consensus/consensus-test-util.h"
 #include "yb/consensus/log-test-base.h"
 #include "yb/consensus/log_index.h"
+#include "yb/consensus/log_syncer.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/gutil/stl_util.h"
 #include "yb/gutil/strings/substitute.h"
@@ -56,6 +57,7 @@ DECLARE_bool(never_fsync);
 DECLARE_bool(writable_file_use_fsync);
 DECLARE_int32(o_direct_block_alignment_bytes);
 DECLARE_int32(o_direct_block_size_bytes);
+DECLARE_int32(log_reader_parallel_segments);
 
 namespace yb {
 namespace log {
@@ -222,6 +224,131 @@ TEST_F(LogTest, TestFsync) {
   ASSERT_OK(log_->Close());
 }
 
+// Tests that the log written with O_DIRECT into zero-filled preallocated segments is synced
+// through the per-disk syncer and is readable, both while written and after a restart.
+TEST_F(LogTest, TestGroupSync) {
+  options_.o_direct_group_sync = true;
+  BuildLog();
+
+  auto syncer = ASSERT_RESULT(LogSyncer::ForPath(tablet_wal_path_));
+  const int64_t initial_rounds = syncer->completed_rounds();
+
+  OpId opid;
+  opid.set_term(0);
+  opid.set_index(1);
+
+  const int kNumEntries = 10;
+  ASSERT_OK(AppendNoOps(&opid, kNumEntries));
+  ASSERT_GT(syncer->completed_rounds(), initial_rounds);
+
+  SegmentSequence segments;
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  ASSERT_EQ(1, segments.size());
+  LogEntries entries;
+  ASSERT_OK(segments[0]->ReadEntries(&entries));
+  ASSERT_EQ(kNumEntries, entries.size());
+  ASSERT_OK(log_->Close());
+
+  std::unique_ptr<LogReader> reader;
+  ASSERT_OK(LogReader::Open(fs_manager_.get(), nullptr, kTestTablet, tablet_wal_path_,
+                            nullptr, &reader));
+  ASSERT_OK(reader->GetSegmentsSnapshot(&segments));
+  entries.clear();
+  ASSERT_OK(segments[0]->ReadEntries(&entries));
+  ASSERT_EQ(kNumEntries, entries.size());
+}
+
+// Tests that entries appended by the thread shared by logs in the same data directory are synced
+// and readable, and that entries queued before Close() are appended.
+TEST_F(LogTest, TestSharedAppendThread) {
+  options_.shared_append_thread = true;
+  options_.o_direct_group_sync = true;
+  BuildLog();
+
+  OpId opid = MakeOpId(1, 1);
+  const int kNumEntries = 20;
+  ASSERT_OK(AppendNoOps(&opid, kNumEntries));
+
+  SegmentSequence segments;
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  LogEntries entries;
+  ASSERT_OK(segments.back()->ReadEntries(&entries));
+  ASSERT_EQ(kNumEntries, entries.size());
+
+  auto replicate = std::make_shared<ReplicateMsg>();
+  replicate->mutable_id()->CopyFrom(opid);
+  replicate->set_op_type(NO_OP);
+  replicate->set_hybrid_time(clock_->Now().ToUint64());
+  Synchronizer synchronizer;
+  ASSERT_OK(log_->AsyncAppendReplicates({ replicate }, synchronizer.AsStatusCallback()));
+  ASSERT_OK(log_->Close());
+  ASSERT_OK(synchronizer.Wait());
+
+  std::unique_ptr<LogReader> reader;
+  ASSERT_OK(LogReader::Open(fs_manager_.get(), nullptr, kTestTablet, tablet_wal_path_,
+                            nullptr, &reader));
+  ASSERT_OK(reader->GetSegmentsSnapshot(&segments));
+  entries.clear();
+  ASSERT_OK(segments.back()->ReadEntries(&entries));
+  ASSERT_EQ(kNumEntries + 1, entries.size());
+}
+
+// Tests that the shared append thread is rejected without group sync, which would otherwise
+// serialize the fsyncs of all tablets in the data directory.
+TEST_F(LogTest, TestSharedAppendThreadRequiresGroupSync) {
+  options_.shared_append_thread = true;
+  options_.o_direct_group_sync = false;
+  Schema schema_with_ids = SchemaBuilder(schema_).Build();
+  Status s = Log::Open(options_, fs_manager_.get(), kTestTablet, tablet_wal_path_,
+                       schema_with_ids, 0 /* schema_version */, metric_entity_.get(), &log_);
+  ASSERT_TRUE(s.IsInvalidArgument()) << s;
+}
+
+// Tests that segments read in parallel are passed to the callback in order.
+TEST_F(LogTest, TestReadSegmentsEntries) {
+  FLAGS_log_reader_parallel_segments = 3;
+  BuildLog();
+
+  OpId opid = MakeOpId(1, 1);
+  const int kNumSegments = 6;
+  const int kNumOpsPerSegment = 5;
+  ASSERT_OK(AppendMultiSegmentSequence(kNumSegments, kNumOpsPerSegment, &opid, nullptr));
+  ASSERT_OK(log_->Close());
+
+  SegmentSequence segments;
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  ASSERT_EQ(kNumSegments, segments.size());
+
+  int64_t next_index = 1;
+  size_t num_segments_read = 0;
+  ASSERT_OK(LogReader::ReadSegmentsEntries(
+      segments,
+      [&](const scoped_refptr<ReadableLogSegment>& segment, LogEntries* entries,
+          const Status& read_status) -> Status {
+        RETURN_NOT_OK(read_status);
+        EXPECT_EQ(segments[num_segments_read]->path(), segment->path());
+        EXPECT_EQ(kNumOpsPerSegment, entries->size());
+        for (const auto& entry : *entries) {
+          EXPECT_EQ(next_index, entry->replicate().id().index());
+          ++next_index;
+        }
+        ++num_segments_read;
+        return Status::OK();
+      }));
+  ASSERT_EQ(kNumSegments, num_segments_read);
+
+  // The first error returned by the callback stops reading.
+  num_segments_read = 0;
+  Status s = LogReader::ReadSegmentsEntries(
+      segments,
+      [&](const scoped_refptr<ReadableLogSegment>& segment, LogEntries* entries,
+          const Status& read_status) -> Status {
+        return ++num_segments_read == 2 ? STATUS(IllegalState, "Stop") : Status::OK();
+      });
+  ASSERT_TRUE(s.IsIllegalState()) << s;
+  ASSERT_EQ(2, num_segments_read);
+}
+
 // Tests interval for durable wal write
 TEST_F(LogTest, TestFsyncInterval) {
   options_.interval_durable_wal_write = MonoDelta::FromMilliseconds(1);
@@ -33,14 +33,18 @@
 #include "yb/consensus/log.h"
 
 #include <algorithm>
+#include <condition_variable>
 #include <mutex>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <boost/thread/shared_mutex.hpp>
 #include "yb/common/wire_protocol.h"
 #include "yb/consensus/log_index.h"
 #include "yb/consensus/log_metrics.h"
 #include "yb/consensus/log_reader.h"
+#include "yb/consensus/log_syncer.h"
 #include "yb/consensus/log_util.h"
 #include "yb/fs/fs_manager.h"
 #include "yb/gutil/map-util.h"
@@ -196,75 +200,228 @@ void Log::AppendThread::RunThread() {
       shutting_down = true;
     }
 
-    auto sleep_duration = log_->sleep_duration_.load(std::memory_order_acquire);
-    if (sleep_duration.count() > 0) {
-      std::this_thread::sleep_for(sleep_duration);
-    }
+    SCOPED_LATENCY_METRIC(log_->metrics_, group_commit_latency);
 
-    if (log_->metrics_) {
-      log_->metrics_->entry_batches_per_group->Increment(entry_batches.size());
-    }
-    TRACE_EVENT1("log", "batch", "batch_size", entry_batches.size());
+    log_->AppendBatches(entry_batches);
+    log_->SyncBatches(&entry_batches);
+  }
+  VLOG(1) << "Exiting AppendThread for tablet " << log_->tablet_id();
+}
 
-    SCOPED_LATENCY_METRIC(log_->metrics_, group_commit_latency);
+void Log::AppendThread::Shutdown() {
+  log_->entry_queue()->Shutdown();
+  std::lock_guard<std::mutex> lock_guard(lock_);
+  if (thread_) {
+    VLOG(1) << "Shutting down log append thread for tablet " << log_->tablet_id();
+    CHECK_OK(ThreadJoiner(thread_.get()).Join());
+    VLOG(1) << "Log append thread for tablet " << log_->tablet_id() << " is shut down";
+    thread_.reset();
+  }
+}
 
-    for (LogEntryBatch* entry_batch : entry_batches) {
-      TRACE_EVENT_FLOW_END0("log", "Batch", entry_batch);
-      Status s = log_->DoAppend(entry_batch);
-
-      if (PREDICT_FALSE(!s.ok())) {
-        LOG(ERROR) << "Error appending to the log: " << s.ToString();
-        DLOG(FATAL) << "Aborting: " << s.ToString();
-        entry_batch->set_failed_to_append();
-        // TODO If a single operation fails to append, should we abort all subsequent operations
-        // in this batch or allow them to be appended? What about operations in future batches?
-        if (!entry_batch->callback().is_null()) {
-          entry_batch->callback().Run(s);
-        }
-      } else if (!log_->sync_disabled_) {
-        if (!log_->periodic_sync_needed_.load()) {
-          log_->periodic_sync_needed_.store(true);
-          log_->periodic_sync_earliest_unsync_entry_time_ = MonoTime::Now();
+// Appends entries of all logs whose WAL is in the same data directory from a single thread.
+// Entries of all the logs that are ready are appended first, and then the logs are synced. So
+// with log_o_direct_group_sync one fdatasync() makes the entries of all these tablets durable.
+class Log::SharedAppendThread {
+ public:
+  // Returns the thread of the data directory 'wal_root', starting it on first use. These threads
+  // are never stopped.
+  static Result<SharedAppendThread*> ForDir(const std::string& wal_root);
+
+  void Register(Log* log);
+
+  // Stops appending to 'log', whose queue is shut down. Waits until the thread is done with 'log'
+  // and appends the entries that are still queued from the calling thread.
+  void Unregister(Log* log);
+
+  // Notifies the thread that entries were queued to 'log'.
+  void Wakeup(Log* log);
+
+ private:
+  SharedAppendThread() {}
+
+  void RunThread();
+
+  // Appends the queued entries of 'logs' and syncs them.
+  void Process(const std::vector<Log*>& logs);
+
+  std::mutex mutex_;
+
+  // Signaled when a log becomes ready.
+  std::condition_variable ready_cond_;
+
+  // Signaled when the thread finishes processing logs.
+  std::condition_variable idle_cond_;
+
+  std::unordered_set<Log*> logs_;
+  std::unordered_set<Log*> ready_logs_;
+
+  // Logs that the thread is processing now.
+  std::vector<Log*> processing_logs_;
+
+  // How often logs are checked for a periodic sync, see interval_durable_wal_write.
+  MonoDelta periodic_sync_interval_ = MonoDelta::FromSeconds(1);
+
+  scoped_refptr<Thread> thread_;
+};
+
+Result<Log::SharedAppendThread*> Log::SharedAppendThread::ForDir(const std::string& wal_root) {
+  static std::mutex threads_mutex;
+  static std::unordered_map<std::string, SharedAppendThread*> threads;
+
+  std::lock_guard<std::mutex> lock(threads_mutex);
+  auto& result = threads[wal_root];
+  if (!result) {
+    std::unique_ptr<SharedAppendThread> thread(new SharedAppendThread());
+    LOG(INFO) << "Starting shared log append thread for " << wal_root;
+    RETURN_NOT_OK(yb::Thread::Create("log", "shared-appender",
+        &SharedAppendThread::RunThread, thread.get(), &thread->thread_));
+    result = thread.release();
+  }
+  return result;
+}
+
+void Log::SharedAppendThread::Register(Log* log) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  logs_.insert(log);
+  if (log->interval_durable_wal_write_ &&
+      log->interval_durable_wal_write_ < periodic_sync_interval_) {
+    periodic_sync_interval_ = log->interval_durable_wal_write_;
+  }
+}
+
+void Log::SharedAppendThread::Unregister(Log* log) {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    logs_.erase(log);
+    ready_logs_.erase(log);
+    idle_cond_.wait(lock, [this, log] {
+      return std::find(processing_logs_.begin(), processing_logs_.end(), log) ==
+             processing_logs_.end();
+    });
+  }
+
+  std::vector<LogEntryBatch*> entry_batches;
+  ElementDeleter d(&entry_batches);
+  log->entry_queue()->BlockingDrainTo(&entry_batches, MonoTime::kMin);
+  if (!entry_batches.empty()) {
+    log->AppendBatches(entry_batches);
+    log->SyncBatches(&entry_batches);
+  }
+}
+
+void Log::SharedAppendThread::Wakeup(Log* log) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (logs_.count(log) == 0) {
+      return;
+    }
+    ready_logs_.insert(log);
+  }
+  ready_cond_.notify_one();
+}
+
+void Log::SharedAppendThread::RunThread() {
+  std::vector<Log*> logs;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      processing_logs_.clear();
+      idle_cond_.notify_all();
+      if (ready_logs_.empty()) {
+        ready_cond_.wait_for(
+            lock, std::chrono::milliseconds(periodic_sync_interval_.ToMilliseconds()));
+      }
+      if (ready_logs_.empty()) {
+        // Nothing was appended for a while, check whether some logs need a periodic sync.
+        for (Log* log : logs_) {
+          if (log->periodic_sync_needed_.load()) {
+            processing_logs_.push_back(log);
+          }
         }
-        log_->periodic_sync_unsynced_bytes_ += entry_batch->total_size_bytes();
+      } else {
+        processing_logs_.assign(ready_logs_.begin(), ready_logs_.end());
+        ready_logs_.clear();
       }
+      logs = processing_logs_;
     }
+    Process(logs);
+  }
+}
+
+void Log::SharedAppendThread::Process(const std::vector<Log*>& logs) {
+  std::vector<std::vector<LogEntryBatch*>> entry_batches(logs.size());
+  for (size_t i = 0; i != logs.size(); ++i) {
+    Log* log = logs[i];
+    log->entry_queue()->BlockingDrainTo(&entry_batches[i], MonoTime::kMin);
+    log->AppendBatches(entry_batches[i]);
+    // Errors are reported by SyncBatches(), that flushes again.
+    WARN_NOT_OK(log->FlushActiveSegment(), "Failed to flush log");
+  }
+
+  for (size_t i = 0; i != logs.size(); ++i) {
+    ElementDeleter d(&entry_batches[i]);
+    logs[i]->SyncBatches(&entry_batches[i]);
+  }
+}
+
+void Log::AppendBatches(const std::vector<LogEntryBatch*>& entry_batches) {
+  auto sleep_duration = sleep_duration_.load(std::memory_order_acquire);
+  if (sleep_duration.count() > 0) {
+    std::this_thread::sleep_for(sleep_duration);
+  }
+
+  if (metrics_) {
+    metrics_->entry_batches_per_group->Increment(entry_batches.size());
+  }
+  TRACE_EVENT1("log", "batch", "batch_size", entry_batches.size());
+
+  for (LogEntryBatch* entry_batch : entry_batches) {
+    TRACE_EVENT_FLOW_END0("log", "Batch", entry_batch);
+    Status s = DoAppend(entry_batch);
 
-    Status s = log_->Sync();
     if (PREDICT_FALSE(!s.ok())) {
-      LOG(ERROR) << "Error syncing log" << s.ToString();
+      LOG(ERROR) << "Error appending to the log: " << s.ToString();
       DLOG(FATAL) << "Aborting: " << s.ToString();
-      for (LogEntryBatch* entry_batch : entry_batches) {
-        if (!entry_batch->callback().is_null()) {
-          entry_batch->callback().Run(s);
-        }
+      entry_batch->set_failed_to_append();
+      // TODO If a single operation fails to append, should we abort all subsequent operations
+      // in this batch or allow them to be appended? What about operations in future batches?
+      if (!entry_batch->callback().is_null()) {
+        entry_batch->callback().Run(s);
       }
-    } else {
-      TRACE_EVENT0("log", "Callbacks");
-      VLOG(2) << "Synchronized " << entry_batches.size() << " entry batches";
-      SCOPED_WATCH_STACK(100);
-      for (LogEntryBatch* entry_batch : entry_batches) {
-        if (PREDICT_TRUE(!entry_batch->failed_to_append() && !entry_batch->callback().is_null())) {
-          entry_batch->callback().Run(Status::OK());
-        }
-        // It's important to delete each batch as we see it, because deleting it may free up memory
-        // from memory trackers, and the callback of a later batch may want to use that memory.
-        delete entry_batch;
+    } else if (!sync_disabled_) {
+      if (!periodic_sync_needed_.load()) {
+        periodic_sync_needed_.store(true);
+        periodic_sync_earliest_unsync_entry_time_ = MonoTime::Now();
       }
-      entry_batches.clear();
+      periodic_sync_unsynced_bytes_ += entry_batch->total_size_bytes();
     }
   }
-  VLOG(1) << "Exiting AppendThread for tablet " << log_->tablet_id();
 }
 
-void Log::AppendThread::Shutdown() {
-  log_->entry_queue()->Shutdown();
-  std::lock_guard<std::mutex> lock_guard(lock_);
-  if (thread_) {
-    VLOG(1) << "Shutting down log append thread for tablet " << log_->tablet_id();
-    CHECK_OK(ThreadJoiner(thread_.get()).Join());
-    VLOG(1) << "Log append thread for tablet " << log_->tablet_id() << " is shut down";
-    thread_.reset();
+void Log::SyncBatches(std::vector<LogEntryBatch*>* entry_batches) {
+  Status s = Sync();
+  if (PREDICT_FALSE(!s.ok())) {
+    LOG(ERROR) << "Error syncing log" << s.ToString();
+    DLOG(FATAL) << "Aborting: " << s.ToString();
+    for (LogEntryBatch* entry_batch : *entry_batches) {
+      if (!entry_batch->callback().is_null()) {
+        entry_batch->callback().Run(s);
+      }
+    }
+  } else {
+    TRACE_EVENT0("log", "Callbacks");
+    VLOG(2) << "Synchronized " << entry_batches->size() << " entry batches";
+    SCOPED_WATCH_STACK(100);
+    for (LogEntryBatch* entry_batch : *entry_batches) {
+      if (PREDICT_TRUE(!entry_batch->failed_to_append() && !entry_batch->callback().is_null())) {
+        entry_batch->callback().Run(Status::OK());
+      }
+      // It's important to delete each batch as we see it, because deleting it may free up memory
+      // from memory trackers, and the callback of a later batch may want to use that memory.
+      delete entry_batch;
+    }
+    entry_batches->clear();
   }
 }
 
@@ -357,7 +514,16 @@ Status Log::Init() {
     active_segment_sequence_number_ = segments.back()->header().sequence_number();
   }
 
-  if (durable_wal_write_) {
+  if (options_.shared_append_thread && !options_.o_direct_group_sync) {
+    // Without group sync the shared thread would serialize the fsyncs of all tablets in the
+    // data directory.
+    return STATUS(InvalidArgument, "log_shared_append_thread requires log_o_direct_group_sync");
+  }
+
+  if (options_.o_direct_group_sync) {
+    group_syncer_ = VERIFY_RESULT(LogSyncer::ForPath(tablet_wal_path_));
+    YB_LOG_FIRST_N(INFO, 1) << "log_o_direct_group_sync is turned on.";
+  } else if (durable_wal_write_) {
     YB_LOG_FIRST_N(INFO, 1) << "durable_wal_write is turned on.";
   } else if (interval_durable_wal_write_) {
     YB_LOG_FIRST_N(INFO, 1) << "interval_durable_wal_write_ms is turned on to sync every "
@@ -374,7 +540,13 @@ Status Log::Init() {
   RETURN_NOT_OK(allocation_status_.Get());
   RETURN_NOT_OK(SwitchToAllocatedSegment());
 
-  RETURN_NOT_OK(append_thread_->Init());
+  if (options_.shared_append_thread) {
+    shared_append_thread_ = VERIFY_RESULT(
+        SharedAppendThread::ForDir(DirName(DirName(tablet_wal_path_))));
+    shared_append_thread_->Register(this);
+  } else {
+    RETURN_NOT_OK(append_thread_->Init());
+  }
   log_state_ = kLogWriting;
   return Status::OK();
 }
@@ -460,6 +632,9 @@ Status Log::AsyncAppend(LogEntryBatch* entry_batch, const StatusCallback& callba
     delete entry_batch;
     return kLogShutdownStatus;
   }
+  if (shared_append_thread_) {
+    shared_append_thread_->Wakeup(this);
+  }
 
   return Status::OK();
 }
@@ -631,11 +806,13 @@ Status Log::Sync() {
       }
     }
 
-    if (durable_wal_write_ || timed_or_data_limit_sync) {
+    RETURN_NOT_OK(FlushActiveSegment());
+
+    if (durable_wal_write_ || timed_or_data_limit_sync || group_syncer_) {
       periodic_sync_needed_.store(false);
       periodic_sync_unsynced_bytes_ = 0;
       LOG_SLOW_EXECUTION(WARNING, 50, "Fsync log took a long time") {
-        RETURN_NOT_OK(active_segment_->Sync());
+        RETURN_NOT_OK(SyncActiveSegment());
 
         if (log_hooks_) {
           RETURN_NOT_OK_PREPEND(log_hooks_->PostSyncIfFsyncEnabled(),
@@ -654,6 +831,42 @@ Status Log::Sync() {
   return Status::OK();
 }
 
+Status Log::FlushActiveSegment() {
+  if (!group_syncer_) {
+    return Status::OK();
+  }
+
+  const int64_t written_offset = active_segment_->written_offset();
+  if (written_offset == active_segment_flushed_offset_) {
+    return Status::OK();
+  }
+  // The segment keeps direct writes in its buffer until flushed.
+  RETURN_NOT_OK(active_segment_->Flush());
+  active_segment_flushed_offset_ = written_offset;
+  active_segment_sync_round_ = group_syncer_->NextRound();
+  return Status::OK();
+}
+
+Status Log::SyncActiveSegment() {
+  if (!group_syncer_) {
+    return active_segment_->Sync();
+  }
+
+  const int64_t written_offset = active_segment_->written_offset();
+  if (written_offset == active_segment_synced_offset_) {
+    return Status::OK();
+  }
+  if (static_cast<uint64_t>(written_offset) > active_segment_preallocated_size_) {
+    // Writes past the preallocated space change the size of the file, so syncs of other files
+    // don't cover them.
+    RETURN_NOT_OK(active_segment_->Sync());
+  } else {
+    RETURN_NOT_OK(group_syncer_->Sync(active_segment_.get(), active_segment_sync_round_));
+  }
+  active_segment_synced_offset_ = written_offset;
+  return Status::OK();
+}
+
 Status Log::GetSegmentsToGCUnlocked(int64_t min_op_idx, SegmentSequence* segments_to_gc) const {
   // Find the prefix of segments in the segment sequence that is guaranteed not to include
   // 'min_op_idx'.
@@ -864,7 +1077,12 @@ void Log::SetSchemaForNextLogSegment(const Schema& schema,
 
 Status Log::Close() {
   allocation_pool_->Shutdown();
-  append_thread_->Shutdown();
+  if (shared_append_thread_) {
+    entry_batch_queue_.Shutdown();
+    shared_append_thread_->Unregister(this);
+  } else {
+    append_thread_->Shutdown();
+  }
 
   std::lock_guard<percpu_rwlock> l(state_lock_);
   switch (log_state_) {
@@ -919,16 +1137,21 @@ Status Log::PreAllocateNewSegment() {
   CHECK_EQ(allocation_state(), kAllocationInProgress);
 
   WritableFileOptions opts;
-  opts.sync_on_close = durable_wal_write_;
-  opts.o_direct = durable_wal_write_;
+  const bool group_sync = options_.o_direct_group_sync;
+  opts.sync_on_close = durable_wal_write_ || group_sync;
+  opts.o_direct = durable_wal_write_ || group_sync;
+  // With group sync the direct writes are made durable by LogSyncer instead of O_SYNC.
+  opts.o_direct_sync_writes = !group_sync;
   RETURN_NOT_OK(CreatePlaceholderSegment(opts, &next_segment_path_, &next_segment_file_));
 
-  if (options_.preallocate_segments) {
+  next_segment_preallocated_size_ = 0;
+  // Group sync relies on the segment being preallocated, since the preallocated space is filled
+  // with zeros.
+  if (options_.preallocate_segments || group_sync) {
     uint64_t next_segment_size = NextSegmentDesiredSize();
     TRACE("Preallocating $0 byte segment in $1", next_segment_size, next_segment_path_);
-    // TODO (perf) zero the new segments -- this could result in additional performance
-    // improvements.
     RETURN_NOT_OK(next_segment_file_->PreAllocate(next_segment_size));
+    next_segment_preallocated_size_ = next_segment_size;
   }
 
   {
@@ -948,7 +1171,7 @@ Status Log::SwitchToAllocatedSegment() {
       fs_manager_->GetWalSegmentFileName(tablet_wal_path_, active_segment_sequence_number_);
 
   RETURN_NOT_OK(fs_manager_->env()->RenameFile(next_segment_path_, new_segment_path));
-  if (durable_wal_write_) {
+  if (durable_wal_write_ || group_syncer_) {
     RETURN_NOT_OK(fs_manager_->env()->SyncDir(log_dir_));
   }
 
@@ -998,6 +1221,9 @@ Status Log::SwitchToAllocatedSegment() {
 
   // Now set 'active_segment_' to the new segment.
   active_segment_.reset(new_segment.release());
+  active_segment_preallocated_size_ = next_segment_preallocated_size_;
+  active_segment_flushed_offset_ = 0;
+  active_segment_synced_offset_ = 0;
   cur_max_segment_size_ = NextSegmentDesiredSize();
 
   allocation_state_ = kAllocationNotStarted;
@@ -67,6 +67,7 @@ struct LogMetrics;
 class LogEntryBatch;
 class LogIndex;
 class LogReader;
+class LogSyncer;
 
 typedef BlockingQueue<LogEntryBatch*, LogEntryBatchLogicalSize> LogEntryBatchQueue;
 
@@ -256,6 +257,7 @@ class Log : public RefCountedThreadSafe<Log> {
   FRIEND_TEST(LogTest, TestWriteAndReadToAndFromInProgressSegment);
 
   class AppendThread;
+  class SharedAppendThread;
 
   // Log state.
   enum LogState {
@@ -298,6 +300,13 @@ class Log : public RefCountedThreadSafe<Log> {
   // Preallocates the space for a new segment.
   CHECKED_STATUS PreAllocateNewSegment();
 
+  // With group sync, writes out the data buffered by the active segment and remembers the sync
+  // round that covers it.
+  CHECKED_STATUS FlushActiveSegment();
+
+  // Makes the data written to the active segment durable.
+  CHECKED_STATUS SyncActiveSegment();
+
   // Returns the desired size for the next log segment to be created.
   uint64_t NextSegmentDesiredSize();
 
@@ -322,6 +331,14 @@ class Log : public RefCountedThreadSafe<Log> {
 
   CHECKED_STATUS Sync();
 
+  // Appends 'entry_batches' taken from the queue. Callbacks of the batches that failed to append
+  // are invoked with the error. Called by the thread appending to this log.
+  void AppendBatches(const std::vector<LogEntryBatch*>& entry_batches);
+
+  // Syncs the log after AppendBatches() and invokes the callbacks of 'entry_batches'. On success
+  // the batches are deleted and 'entry_batches' is cleared.
+  void SyncBatches(std::vector<LogEntryBatch*>* entry_batches);
+
   // Helper method to get the segment sequence to GC based on the provided min_op_idx.
   CHECKED_STATUS GetSegmentsToGCUnlocked(int64_t min_op_idx, SegmentSequence* segments_to_gc) const;
 
@@ -402,12 +419,31 @@ class Log : public RefCountedThreadSafe<Log> {
   // Thread writing to the log.
   gscoped_ptr<AppendThread> append_thread_;
 
+  // If set, entries of this log are appended by the thread shared by all logs in the same data
+  // directory, instead of append_thread_.
+  SharedAppendThread* shared_append_thread_ = nullptr;
+
   // A thread pool for asynchronously pre-allocating new log segments.
   gscoped_ptr<ThreadPool> allocation_pool_;
 
   // If true, sync on all appends.
   bool durable_wal_write_;
 
+  // If set, segments are written with O_DIRECT into zero-filled preallocated space and every
+  // Sync() is durable. Syncs are batched with the logs of other tablets on the same disk.
+  LogSyncer* group_syncer_ = nullptr;
+
+  // The space preallocated for the active and the next segment, in bytes.
+  uint64_t active_segment_preallocated_size_ = 0;
+  uint64_t next_segment_preallocated_size_ = 0;
+
+  // Offsets in the active segment up to which the data was flushed and synced by the group syncer.
+  int64_t active_segment_flushed_offset_ = 0;
+  int64_t active_segment_synced_offset_ = 0;
+
+  // The group syncer round that covers the data flushed to the active segment.
+  int64_t active_segment_sync_round_ = 0;
+
   // If non-zero, sync every interval of time.
   MonoDelta interval_durable_wal_write_;
 
@@ -42,11 +42,19 @@
 #include "yb/gutil/strings/util.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/util/coding.h"
+#include "yb/util/countdown_latch.h"
 #include "yb/util/env_util.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/hexdump.h"
 #include "yb/util/metrics.h"
 #include "yb/util/path_util.h"
 #include "yb/util/pb_util.h"
+#include "yb/util/threadpool.h"
+
+DEFINE_int32(log_reader_parallel_segments, 4,
+             "Max number of WAL segments that are read and CRC-checked in parallel when a log is "
+             "opened and replayed during tablet bootstrap. 1 reads segments one by one.");
+TAG_FLAG(log_reader_parallel_segments, advanced);
 
 METRIC_DEFINE_counter(tablet, log_reader_bytes_read, "Bytes Read From Log",
                       yb::MetricUnit::kBytes,
@@ -71,8 +79,27 @@ struct LogSegmentSeqnoComparator {
     return a->header().sequence_number() < b->header().sequence_number();
   }
 };
+
+size_t MaxParallelSegments() {
+  return std::max(FLAGS_log_reader_parallel_segments, 1);
 }
 
+// Opens the segment at 'path', rebuilding its footer if it was left in-progress.
+Status OpenSegment(Env* env, const string& path, scoped_refptr<ReadableLogSegment>* segment) {
+  RETURN_NOT_OK_PREPEND(ReadableLogSegment::Open(env, path, segment),
+                        "Unable to open readable log segment");
+  DCHECK(*segment);
+  CHECK((*segment)->IsInitialized()) << "Uninitialized segment at: " << (*segment)->path();
+
+  if (!(*segment)->HasFooter()) {
+    LOG(WARNING) << "Log segment " << path << " was likely left in-progress "
+        "after a previous crash. Will try to rebuild footer by scanning data.";
+    RETURN_NOT_OK((*segment)->RebuildFooterByScanning());
+  }
+  return Status::OK();
+}
+} // namespace
+
 using consensus::OpId;
 using consensus::ReplicateMsg;
 using env_util::ReadFully;
@@ -149,27 +176,35 @@ Status LogReader::Init(const string& tablet_wal_path) {
   RETURN_NOT_OK_PREPEND(env->GetChildren(tablet_wal_path, &log_files),
                         "Unable to read children from path");
 
-  SegmentSequence read_segments;
-
-  // build a log segment from each file
+  vector<string> segment_paths;
   for (const string &log_file : log_files) {
     if (HasPrefixString(log_file, FsManager::kWalFileNamePrefix)) {
-      string fqp = JoinPathSegments(tablet_wal_path, log_file);
-      scoped_refptr<ReadableLogSegment> segment;
-      RETURN_NOT_OK_PREPEND(ReadableLogSegment::Open(env, fqp, &segment),
-                            "Unable to open readable log segment");
-      DCHECK(segment);
-      CHECK(segment->IsInitialized()) << "Uninitialized segment at: " << segment->path();
-
-      if (!segment->HasFooter()) {
-        LOG(WARNING) << "Log segment " << fqp << " was likely left in-progress "
-            "after a previous crash. Will try to rebuild footer by scanning data.";
-        RETURN_NOT_OK(segment->RebuildFooterByScanning());
-      }
+      segment_paths.push_back(JoinPathSegments(tablet_wal_path, log_file));
+    }
+  }
 
-      read_segments.push_back(segment);
+  // build a log segment from each file
+  SegmentSequence read_segments(segment_paths.size());
+  vector<Status> statuses(segment_paths.size());
+  const size_t max_threads = std::min(MaxParallelSegments(), segment_paths.size());
+  gscoped_ptr<ThreadPool> pool;
+  if (max_threads > 1) {
+    RETURN_NOT_OK(ThreadPoolBuilder("log-open").set_max_threads(max_threads).Build(&pool));
+  }
+  for (size_t i = 0; i != segment_paths.size(); ++i) {
+    auto open = [env, &segment_paths, &read_segments, &statuses, i] {
+      statuses[i] = OpenSegment(env, segment_paths[i], &read_segments[i]);
+    };
+    if (!pool || !pool->SubmitFunc(open).ok()) {
+      open();
     }
   }
+  if (pool) {
+    pool->Wait();
+  }
+  for (const auto& status : statuses) {
+    RETURN_NOT_OK(status);
+  }
 
   // Sort the segments by sequence number.
   std::sort(read_segments.begin(), read_segments.end(), LogSegmentSeqnoComparator());
@@ -200,6 +235,53 @@ Status LogReader::Init(const string& tablet_wal_path) {
   return Status::OK();
 }
 
+Status LogReader::ReadSegmentsEntries(const SegmentSequence& segments,
+                                      const SegmentEntriesCallback& callback) {
+  struct SegmentEntries {
+    LogEntries entries;
+    Status status;
+    CountDownLatch read_latch{1};
+  };
+
+  const size_t max_threads = std::min(MaxParallelSegments(), segments.size());
+  gscoped_ptr<ThreadPool> pool;
+  if (max_threads > 1) {
+    RETURN_NOT_OK(ThreadPoolBuilder("log-read").set_max_threads(max_threads).Build(&pool));
+  }
+
+  // Number of segments, starting from the current one, that are being read at a time.
+  const size_t window = std::max<size_t>(max_threads, 1);
+  std::vector<std::unique_ptr<SegmentEntries>> read_segments(segments.size());
+  size_t next_to_read = 0;
+  Status result;
+  for (size_t idx = 0; idx != segments.size() && result.ok(); ++idx) {
+    while (next_to_read != segments.size() && next_to_read < idx + window) {
+      read_segments[next_to_read].reset(new SegmentEntries);
+      SegmentEntries* read_segment = read_segments[next_to_read].get();
+      const scoped_refptr<ReadableLogSegment>& segment = segments[next_to_read];
+      auto read = [read_segment, segment] {
+        read_segment->status = segment->ReadEntries(&read_segment->entries);
+        read_segment->read_latch.CountDown();
+      };
+      if (!pool || !pool->SubmitFunc(read).ok()) {
+        read();
+      }
+      ++next_to_read;
+    }
+
+    SegmentEntries* read_segment = read_segments[idx].get();
+    read_segment->read_latch.Wait();
+    result = callback(segments[idx], &read_segment->entries, read_segment->status);
+    read_segments[idx].reset();
+  }
+
+  if (pool) {
+    // Segments that are read ahead reference 'read_segments'.
+    pool->Wait();
+  }
+  return result;
+}
+
 Status LogReader::InitEmptyReaderForTests() {
   std::lock_guard<simple_spinlock> lock(lock_);
   state_ = kLogReaderReading;
@@ -32,6 +32,7 @@
 #ifndef YB_CONSENSUS_LOG_READER_H
 #define YB_CONSENSUS_LOG_READER_H
 
+#include <functional>
 #include <map>
 #include <string>
 #include <utility>
@@ -131,6 +132,18 @@ class LogReader {
   // Returns a bad Status if the log index fails to load (eg. due to an IO error).
   CHECKED_STATUS LookupOpId(int64_t op_index, consensus::OpId* op_id) const;
 
+  typedef std::function<Status(const scoped_refptr<ReadableLogSegment>& segment,
+                               LogEntries* entries,
+                               const Status& read_status)> SegmentEntriesCallback;
+
+  // Reads the entries of 'segments' in order and invokes 'callback' with the entries of each
+  // segment and the status of reading them (see ReadableLogSegment::ReadEntries()).
+  // While 'callback' processes a segment, the following segments are read and CRC-checked in
+  // parallel, up to FLAGS_log_reader_parallel_segments segments at a time.
+  // Stops at the first error returned by 'callback' and returns it.
+  static CHECKED_STATUS ReadSegmentsEntries(const SegmentSequence& segments,
+                                            const SegmentEntriesCallback& callback);
+
   // Returns the number of segments.
   const int num_segments() const;
 
@@ -192,7 +205,8 @@ class LogReader {
             std::string tablet_name,
             const scoped_refptr<MetricEntity>& metric_entity);
 
-  // Reads the headers of all segments in 'path_'.
+  // Reads the headers of all segments in 'path_'. Segments are opened in parallel, up to
+  // FLAGS_log_reader_parallel_segments at a time.
   CHECKED_STATUS Init(const std::string& path_);
 
   // Initializes an 'empty' reader for tests, i.e. does not scan a path looking for segments.
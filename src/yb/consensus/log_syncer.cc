@@ -0,0 +1,86 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+
+#include "yb/consensus/log_syncer.h"
+
+#include <sys/stat.h>
+
+#include <unordered_map>
+
+#include "yb/consensus/log_util.h"
+#include "yb/util/errno.h"
+
+namespace yb {
+namespace log {
+
+Result<LogSyncer*> LogSyncer::ForPath(const std::string& path) {
+  static std::mutex syncers_mutex;
+  static std::unordered_map<dev_t, LogSyncer*> syncers;
+
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0) {
+    int err = errno;
+    return STATUS(IOError, "Unable to stat " + path, ErrnoToString(err), err);
+  }
+
+  std::lock_guard<std::mutex> lock(syncers_mutex);
+  auto& syncer = syncers[st.st_dev];
+  if (!syncer) {
+    syncer = new LogSyncer();
+  }
+  return syncer;
+}
+
+int64_t LogSyncer::NextRound() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // The round that is running now could have started before the writes of the caller were
+  // completed, so only the round after it is guaranteed to cover them.
+  return completed_rounds_ + (sync_in_progress_ ? 2 : 1);
+}
+
+Status LogSyncer::Sync(WritableLogSegment* segment, int64_t round) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (completed_rounds_ < round) {
+    if (!sync_in_progress_) {
+      sync_in_progress_ = true;
+      lock.unlock();
+      Status status = segment->Sync();
+      lock.lock();
+      sync_in_progress_ = false;
+      ++completed_rounds_;
+      if (!status.ok()) {
+        last_failed_round_ = completed_rounds_;
+      }
+      cond_.notify_all();
+      RETURN_NOT_OK(status);
+      continue;
+    }
+    cond_.wait(lock);
+  }
+
+  if (last_failed_round_ < round) {
+    return Status::OK();
+  }
+  lock.unlock();
+  return segment->Sync();
+}
+
+int64_t LogSyncer::completed_rounds() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return completed_rounds_;
+}
+
+}  // namespace log
+}  // namespace yb
@@ -0,0 +1,86 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+
+#ifndef YB_CONSENSUS_LOG_SYNCER_H
+#define YB_CONSENSUS_LOG_SYNCER_H
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+
+#include "yb/gutil/macros.h"
+#include "yb/util/result.h"
+
+namespace yb {
+namespace log {
+
+class WritableLogSegment;
+
+// Batches the syncs of the WAL segments that are written with O_DIRECT, but without O_SYNC, into
+// zero-filled preallocated space.
+//
+// Writes over already written blocks don't change the file metadata, so they become durable once
+// the write cache of the device is flushed, and fdatasync() on any file of the device does it.
+// So a single fdatasync() covers all direct writes to the device completed before it started,
+// no matter which tablet they belong to.
+//
+// There is one syncer per device. The first caller that finds no sync in progress becomes the
+// leader of the next round and syncs its own segment. Callers that arrive while a round is running
+// wait for the following round, which is led by one of them.
+class LogSyncer {
+ public:
+  // Returns the syncer of the device that contains 'path'. Syncers are never destroyed.
+  static Result<LogSyncer*> ForPath(const std::string& path);
+
+  // Makes durable all direct writes to 'segment' that were completed before this call.
+  // 'segment' should be located on the device of this syncer and have unsynced writes, so its
+  // Sync() issues fdatasync() when this caller leads a round.
+  CHECKED_STATUS Sync(WritableLogSegment* segment) {
+    return Sync(segment, NextRound());
+  }
+
+  // Same as above, but waits for the given round, that was returned by NextRound() after the
+  // writes were completed. So writes of several segments could be made durable by one round.
+  CHECKED_STATUS Sync(WritableLogSegment* segment, int64_t round);
+
+  // Returns the first round that starts after this call, i.e. the round that covers all writes
+  // completed before this call.
+  int64_t NextRound() const;
+
+  // Number of completed sync rounds.
+  int64_t completed_rounds() const;
+
+ private:
+  LogSyncer() {}
+
+  mutable std::mutex mutex_;
+  std::condition_variable cond_;
+
+  // Number of completed sync rounds.
+  int64_t completed_rounds_ = 0;
+
+  // Whether a sync round is running now.
+  bool sync_in_progress_ = false;
+
+  // Last round that failed. Waiters covered by a failed round sync their own segment.
+  int64_t last_failed_round_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(LogSyncer);
+};
+
+}  // namespace log
+}  // namespace yb
+
+#endif // YB_CONSENSUS_LOG_SYNCER_H
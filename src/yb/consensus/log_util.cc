@@ -88,6 +88,18 @@ DEFINE_bool(log_async_preallocate_segments, true,
             "Whether the WAL segments preallocation should happen asynchronously");
 TAG_FLAG(log_async_preallocate_segments, advanced);
 
+DEFINE_bool(log_o_direct_group_sync, false,
+            "Whether the WAL should be written with O_DIRECT into zero-filled preallocated "
+            "segments, and synced on every write with a single fdatasync() shared by all tablets "
+            "whose WAL is on the same disk. Overrides durable_wal_write.");
+TAG_FLAG(log_o_direct_group_sync, advanced);
+
+DEFINE_bool(log_shared_append_thread, false,
+            "Whether the WAL entries of all tablets in the same data directory should be appended "
+            "and synced by a single shared thread, instead of a thread per tablet. Entries of all "
+            "tablets appended together are synced together. Requires log_o_direct_group_sync.");
+TAG_FLAG(log_shared_append_thread, advanced);
+
 namespace yb {
 namespace log {
 
@@ -129,7 +141,9 @@ LogOptions::LogOptions()
                                          FLAGS_interval_durable_wal_write_ms) : MonoDelta()),
       bytes_durable_wal_write_mb(FLAGS_bytes_durable_wal_write_mb),
       preallocate_segments(FLAGS_log_preallocate_segments),
-      async_preallocate_segments(FLAGS_log_async_preallocate_segments) {
+      async_preallocate_segments(FLAGS_log_async_preallocate_segments),
+      o_direct_group_sync(FLAGS_log_o_direct_group_sync),
+      shared_append_thread(FLAGS_log_shared_append_thread) {
 }
 
 Status ReadableLogSegment::Open(Env* env,
@@ -96,6 +96,13 @@ struct LogOptions {
   // Whether the allocation should happen asynchronously.
   bool async_preallocate_segments;
 
+  // Whether to write segments with O_DIRECT into zero-filled preallocated space, and batch the
+  // syncs of all logs on the same disk. Every sync is durable in this mode.
+  bool o_direct_group_sync;
+
+  // Whether entries are appended by a thread shared by all logs in the same data directory.
+  bool shared_append_thread;
+
   LogOptions();
 };
 
@@ -346,6 +353,11 @@ class WritableLogSegment {
     return writable_file_->Sync();
   }
 
+  // Writes out the data buffered by the underlying writable file, without syncing it.
+  CHECKED_STATUS Flush() {
+    return writable_file_->Flush(WritableFile::FLUSH_ASYNC);
+  }
+
   // Returns true if the segment header has already been written to disk.
   bool IsHeaderWritten() const {
     return is_header_written_;
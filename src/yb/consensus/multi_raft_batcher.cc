@@ -0,0 +1,175 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/multi_raft_batcher.h"
+
+#include <chrono>
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include "yb/consensus/consensus.proxy.h"
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/scheduler.h"
+#include "yb/util/flag_tags.h"
+
+DEFINE_bool(enable_multi_raft_heartbeat_batcher, false,
+            "Send the heartbeats of idle tablets to the same tablet server in batched "
+            "MultiRaftUpdateConsensus RPCs. All tablet servers must support this RPC.");
+TAG_FLAG(enable_multi_raft_heartbeat_batcher, advanced);
+
+DEFINE_int32(multi_raft_heartbeat_batch_window_ms, 20,
+             "For how long heartbeats to the same tablet server are collected before the batch "
+             "is sent.");
+TAG_FLAG(multi_raft_heartbeat_batch_window_ms, advanced);
+
+DEFINE_int32(multi_raft_batch_size, 256,
+             "Maximum number of heartbeats in a single MultiRaftUpdateConsensus RPC.");
+TAG_FLAG(multi_raft_batch_size, advanced);
+
+DECLARE_int32(consensus_rpc_timeout_ms);
+
+namespace yb {
+namespace consensus {
+
+MultiRaftHeartbeatBatcher::MultiRaftHeartbeatBatcher(
+    const HostPort& hostport,
+    std::shared_ptr<rpc::Messenger> messenger,
+    std::unique_ptr<ConsensusServiceProxy> proxy)
+    : hostport_(hostport), messenger_(std::move(messenger)), proxy_(std::move(proxy)) {}
+
+MultiRaftHeartbeatBatcher::~MultiRaftHeartbeatBatcher() {
+  // Every pending request keeps its peer proxy, and so this batcher, alive.
+  DCHECK(!current_batch_);
+}
+
+void MultiRaftHeartbeatBatcher::AddRequestToBatch(const ConsensusRequestPB& request,
+                                                  ConsensusResponsePB* response,
+                                                  HeartbeatResponseCallback callback) {
+  BatchPtr batch_to_send;
+  BatchPtr batch_to_schedule;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!current_batch_) {
+      current_batch_ = std::make_shared<Batch>();
+      batch_to_schedule = current_batch_;
+    }
+    current_batch_->request.add_consensus_request()->CopyFrom(request);
+    current_batch_->callbacks.push_back({response, std::move(callback)});
+    if (current_batch_->callbacks.size() >= static_cast<size_t>(FLAGS_multi_raft_batch_size)) {
+      batch_to_send = std::move(current_batch_);
+    }
+  }
+
+  if (batch_to_send) {
+    SendBatch(batch_to_send);
+    return;
+  }
+
+  if (batch_to_schedule) {
+    // A batch that gets full before its window elapses is sent right away, and then this task does
+    // nothing.
+    messenger_->scheduler().Schedule(
+        std::bind(&MultiRaftHeartbeatBatcher::ScheduledFlush, shared_from_this(),
+                  batch_to_schedule, std::placeholders::_1),
+        std::chrono::milliseconds(FLAGS_multi_raft_heartbeat_batch_window_ms));
+  }
+}
+
+void MultiRaftHeartbeatBatcher::ScheduledFlush(const BatchPtr& batch, const Status& status) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (current_batch_ != batch) {
+      return;
+    }
+    current_batch_.reset();
+  }
+
+  if (!status.ok()) {
+    // The scheduler was shut down, so the messenger cannot send the batch either.
+    FailBatch(batch, status);
+    return;
+  }
+  SendBatch(batch);
+}
+
+void MultiRaftHeartbeatBatcher::SendBatch(const BatchPtr& batch) {
+  VLOG(3) << "Sending " << batch->callbacks.size() << " heartbeats to " << hostport_.ToString();
+  batch->controller.set_timeout(MonoDelta::FromMilliseconds(FLAGS_consensus_rpc_timeout_ms));
+  proxy_->MultiRaftUpdateConsensusAsync(
+      batch->request, &batch->response, &batch->controller,
+      std::bind(&MultiRaftHeartbeatBatcher::ProcessBatchResponse, shared_from_this(), batch));
+}
+
+void MultiRaftHeartbeatBatcher::ProcessBatchResponse(const BatchPtr& batch) {
+  // Note: This method runs on the reactor thread.
+  Status status = batch->controller.status();
+  if (status.ok() &&
+      static_cast<size_t>(batch->response.consensus_response_size()) != batch->callbacks.size()) {
+    status = STATUS_FORMAT(
+        IllegalState, "Got $0 responses to $1 batched heartbeats",
+        batch->response.consensus_response_size(), batch->callbacks.size());
+  }
+  if (!status.ok()) {
+    FailBatch(batch, status);
+    return;
+  }
+
+  for (size_t i = 0; i != batch->callbacks.size(); ++i) {
+    auto& data = batch->callbacks[i];
+    data.response->Swap(batch->response.mutable_consensus_response(i));
+    data.callback(Status::OK());
+  }
+}
+
+void MultiRaftHeartbeatBatcher::FailBatch(const BatchPtr& batch, const Status& status) {
+  for (auto& data : batch->callbacks) {
+    data.callback(status);
+  }
+}
+
+MultiRaftManager::MultiRaftManager(std::shared_ptr<rpc::Messenger> messenger)
+    : messenger_(std::move(messenger)) {}
+
+Result<MultiRaftHeartbeatBatcherPtr> MultiRaftManager::AddOrGetBatcher(const HostPort& hostport) {
+  const auto key = hostport.ToString();
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = batchers_.find(key);
+  if (it != batchers_.end()) {
+    auto batcher = it->second.lock();
+    if (batcher) {
+      return batcher;
+    }
+  }
+
+  std::vector<Endpoint> addrs;
+  RETURN_NOT_OK(hostport.ResolveAddresses(&addrs));
+  if (addrs.empty()) {
+    return STATUS_FORMAT(NetworkError, "Unable to resolve address $0", key);
+  }
+  auto batcher = std::make_shared<MultiRaftHeartbeatBatcher>(
+      hostport, messenger_, std::make_unique<ConsensusServiceProxy>(messenger_, addrs[0]));
+
+  for (auto i = batchers_.begin(); i != batchers_.end();) {
+    if (i->second.expired()) {
+      i = batchers_.erase(i);
+    } else {
+      ++i;
+    }
+  }
+  batchers_[key] = batcher;
+  return batcher;
+}
+
+} // namespace consensus
+} // namespace yb
@@ -0,0 +1,120 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+#define YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/consensus/consensus.pb.h"
+#include "yb/rpc/rpc_controller.h"
+#include "yb/util/net/net_util.h"
+#include "yb/util/result.h"
+
+namespace yb {
+
+namespace rpc {
+class Messenger;
+}
+
+namespace consensus {
+
+class ConsensusServiceProxy;
+
+// Invoked once the response to a batched heartbeat was filled, or with the error that prevented
+// the batch from being sent.
+typedef std::function<void(const Status&)> HeartbeatResponseCallback;
+
+// Coalesces the status-only UpdateConsensus requests (heartbeats) that the leaders on this server
+// send to the replicas of their tablets on one destination server. The requests are collected for
+// up to multi_raft_heartbeat_batch_window_ms, or until multi_raft_batch_size of them were added,
+// and then sent as a single MultiRaftUpdateConsensus RPC.
+class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftHeartbeatBatcher> {
+ public:
+  MultiRaftHeartbeatBatcher(const HostPort& hostport,
+                            std::shared_ptr<rpc::Messenger> messenger,
+                            std::unique_ptr<ConsensusServiceProxy> proxy);
+
+  ~MultiRaftHeartbeatBatcher();
+
+  // Adds a copy of 'request' to the current batch. 'response' must stay valid until 'callback' is
+  // invoked.
+  void AddRequestToBatch(const ConsensusRequestPB& request,
+                         ConsensusResponsePB* response,
+                         HeartbeatResponseCallback callback);
+
+  const HostPort& hostport() const { return hostport_; }
+
+ private:
+  struct ResponseCallbackData {
+    ConsensusResponsePB* response;
+    HeartbeatResponseCallback callback;
+  };
+
+  struct Batch {
+    MultiRaftConsensusRequestPB request;
+    MultiRaftConsensusResponsePB response;
+    rpc::RpcController controller;
+    std::vector<ResponseCallbackData> callbacks;
+  };
+
+  typedef std::shared_ptr<Batch> BatchPtr;
+
+  // Sends 'batch' if it is still the one being filled. Runs on a reactor thread once the batch
+  // window of 'batch' has elapsed.
+  void ScheduledFlush(const BatchPtr& batch, const Status& status);
+
+  void SendBatch(const BatchPtr& batch);
+
+  void ProcessBatchResponse(const BatchPtr& batch);
+
+  static void FailBatch(const BatchPtr& batch, const Status& status);
+
+  const HostPort hostport_;
+  std::shared_ptr<rpc::Messenger> messenger_;
+  std::unique_ptr<ConsensusServiceProxy> proxy_;
+
+  std::mutex mutex_;
+  // The batch that new requests are added to, null when there are no pending requests.
+  BatchPtr current_batch_;
+};
+
+typedef std::shared_ptr<MultiRaftHeartbeatBatcher> MultiRaftHeartbeatBatcherPtr;
+
+// Hands out one MultiRaftHeartbeatBatcher per destination server, so that all the tablets led by
+// this server share it. Owned by the tablet manager and outlives all the tablet peers.
+class MultiRaftManager {
+ public:
+  explicit MultiRaftManager(std::shared_ptr<rpc::Messenger> messenger);
+
+  // Returns the batcher for the server at 'hostport', creating it if needed.
+  Result<MultiRaftHeartbeatBatcherPtr> AddOrGetBatcher(const HostPort& hostport);
+
+ private:
+  std::shared_ptr<rpc::Messenger> messenger_;
+
+  std::mutex mutex_;
+  // Batchers are owned by the peer proxies that use them, so the ones that are no longer used are
+  // dropped from here lazily.
+  std::unordered_map<std::string, std::weak_ptr<MultiRaftHeartbeatBatcher>> batchers_;
+};
+
+} // namespace consensus
+} // namespace yb
+
+#endif // YB_CONSENSUS_MULTI_RAFT_BATCHER_H
@@ -229,8 +229,10 @@ scoped_refptr<RaftConsensus> RaftConsensus::Create(
     const Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
     TableType table_type,
     LostLeadershipListener lost_leadership_listener,
-    ThreadPool* raft_pool) {
-  gscoped_ptr<PeerProxyFactory> rpc_factory(new RpcPeerProxyFactory(messenger));
+    ThreadPool* raft_pool,
+    MultiRaftManager* multi_raft_manager) {
+  gscoped_ptr<PeerProxyFactory> rpc_factory(
+      new RpcPeerProxyFactory(messenger, multi_raft_manager));
 
   // The message queue that keeps track of which operations need to be replicated
   // where.
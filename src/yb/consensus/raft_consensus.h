@@ -71,6 +71,7 @@ class Clock;
 
 namespace consensus {
 class ConsensusMetadata;
+class MultiRaftManager;
 class Peer;
 class PeerProxyFactory;
 class PeerManager;
@@ -100,7 +101,8 @@ class RaftConsensus : public Consensus,
     const Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
     TableType table_type,
     LostLeadershipListener lost_leadership_listener,
-    ThreadPool* raft_pool);
+    ThreadPool* raft_pool,
+    MultiRaftManager* multi_raft_manager);
 
   RaftConsensus(const ConsensusOptions& options,
     std::unique_ptr<ConsensusMetadata> cmeta,
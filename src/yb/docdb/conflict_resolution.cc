@@ -82,9 +82,10 @@ class ConflictResolverContext {
 class ConflictResolver {
  public:
   ConflictResolver(rocksdb::DB* db,
+                   rocksdb::DB* intents_db,
                    TransactionStatusManager* status_manager,
                    ConflictResolverContext* context)
-    : db_(db), status_manager_(*status_manager), context_(*context) {}
+    : db_(db), intents_db_(intents_db), status_manager_(*status_manager), context_(*context) {}
 
   TransactionStatusManager& status_manager() {
     return status_manager_;
@@ -162,7 +163,7 @@ class ConflictResolver {
   void EnsureIntentIteratorCreated() {
     if (!intent_iter_) {
       intent_iter_ = CreateRocksDBIterator(
-          db_,
+          intents_db_,
           BloomFilterMode::DONT_USE_BLOOM_FILTER,
           boost::none /* user_key_for_filter */,
           rocksdb::kDefaultQueryId);
@@ -279,6 +280,7 @@ class ConflictResolver {
   }
 
   rocksdb::DB* db_;
+  rocksdb::DB* intents_db_;
   std::unique_ptr<rocksdb::Iterator> intent_iter_;
   TransactionStatusManager& status_manager_;
   ConflictResolverContext& context_;
@@ -464,19 +466,21 @@ class OperationConflictResolverContext : public ConflictResolverContext {
 Status ResolveTransactionConflicts(const KeyValueWriteBatchPB& write_batch,
                                    HybridTime hybrid_time,
                                    rocksdb::DB* db,
+                                   rocksdb::DB* intents_db,
                                    TransactionStatusManager* status_manager) {
   DCHECK(hybrid_time.is_valid());
   TransactionConflictResolverContext context(write_batch, hybrid_time);
-  ConflictResolver resolver(db, status_manager, &context);
+  ConflictResolver resolver(db, intents_db, status_manager, &context);
   return resolver.Resolve();
 }
 
 Result<HybridTime> ResolveOperationConflicts(const DocOperations& doc_ops,
                                              HybridTime hybrid_time,
                                              rocksdb::DB* db,
+                                             rocksdb::DB* intents_db,
                                              TransactionStatusManager* status_manager) {
   OperationConflictResolverContext context(&doc_ops, hybrid_time);
-  ConflictResolver resolver(db, status_manager, &context);
+  ConflictResolver resolver(db, intents_db, status_manager, &context);
   RETURN_NOT_OK(resolver.Resolve());
   return context.GetHybridTime();
 }
@@ -44,10 +44,12 @@ class KeyValueWriteBatchPB;
 // write_batch - values that would be written as part of transaction.
 // hybrid_time - current hybrid time.
 // db - db that contains tablet data.
+// intents_db - db that contains transaction intents, could be the same as db.
 // status_manager - status manager that should be used during this conflict resolution.
 CHECKED_STATUS ResolveTransactionConflicts(const KeyValueWriteBatchPB& write_batch,
                                            HybridTime hybrid_time,
                                            rocksdb::DB* db,
+                                           rocksdb::DB* intents_db,
                                            TransactionStatusManager* status_manager);
 
 // Resolves conflicts for doc operations.
@@ -61,10 +63,12 @@ CHECKED_STATUS ResolveTransactionConflicts(const KeyValueWriteBatchPB& write_bat
 // doc_ops - doc operations that would be applied as part of operation.
 // hybrid_time - current hybrid time.
 // db - db that contains tablet data.
+// intents_db - db that contains transaction intents, could be the same as db.
 // status_manager - status manager that should be used during this conflict resolution.
 Result<HybridTime> ResolveOperationConflicts(const DocOperations& doc_ops,
                                              HybridTime hybrid_time,
                                              rocksdb::DB* db,
+                                             rocksdb::DB* intents_db,
                                              TransactionStatusManager* status_manager);
 
 struct ParsedIntent {
@@ -17,6 +17,10 @@
 
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_kv_util.h"
+#include "yb/docdb/value.h"
+
+#include "yb/gutil/endian.h"
 
 namespace yb {
 namespace docdb {
@@ -30,6 +34,7 @@ Status GetPrimitiveValue(const rocksdb::UserBoundaryValues& values,
 namespace {
 
 constexpr rocksdb::UserBoundaryTag kDocHybridTimeTag = 1;
+constexpr rocksdb::UserBoundaryTag kValueTtlExpirationTag = 2;
 // Here we reserve some tags for future use.
 // Because Tag is persistent.
 constexpr rocksdb::UserBoundaryTag kRangeComponentsStart = 10;
@@ -80,6 +85,72 @@ class DocHybridTimeValue : public rocksdb::UserBoundaryValue {
   Slice encoded_;
 };
 
+// Wrapper for UserBoundaryValue that stores the physical time in microseconds at which a value
+// with an explicit TTL expires. Values without their own TTL are recorded as 0, so the largest
+// boundary value of a file is 0 if all of its values expire according to the table TTL.
+class TtlExpirationValue : public rocksdb::UserBoundaryValue {
+ public:
+  explicit TtlExpirationValue(MicrosTime expiration_micros) {
+    BigEndian::Store64(buffer_, expiration_micros);
+  }
+
+  static CHECKED_STATUS Create(Slice data, rocksdb::UserBoundaryValuePtr* value) {
+    CHECK_NOTNULL(value);
+    if (data.size() != sizeof(uint64_t)) {
+      return STATUS_SUBSTITUTE(Corruption, "Wrong size of encoded TTL expiration: $0", data.size());
+    }
+
+    *value = std::make_shared<TtlExpirationValue>(BigEndian::Load64(data.data()));
+    return Status::OK();
+  }
+
+  virtual ~TtlExpirationValue() {}
+
+  rocksdb::UserBoundaryTag Tag() override {
+    return kValueTtlExpirationTag;
+  }
+
+  Slice Encode() override {
+    return Slice(buffer_, sizeof(buffer_));
+  }
+
+  int CompareTo(const UserBoundaryValue& pre_rhs) override {
+    const auto* rhs = down_cast<const TtlExpirationValue*>(&pre_rhs);
+    return memcmp(buffer_, rhs->buffer_, sizeof(buffer_));
+  }
+
+  MicrosTime value() const {
+    return BigEndian::Load64(buffer_);
+  }
+
+ private:
+  uint8_t buffer_[sizeof(uint64_t)];
+};
+
+// Returns the expiration time of a value with an explicit TTL, 0 for a value without one.
+CHECKED_STATUS ValueTtlExpiration(Slice doc_ht_slice, Slice value, MicrosTime* out) {
+  DocHybridTime intent_doc_ht;
+  RETURN_NOT_OK(DecodeIntentDocHT(&value, &intent_doc_ht));
+  MonoDelta ttl;
+  RETURN_NOT_OK(Value::DecodeTTL(&value, &ttl));
+  if (ttl.Equals(Value::kMaxTtl)) {
+    *out = 0;
+    return Status::OK();
+  }
+  if (ttl.ToMilliseconds() == kResetTTL) {
+    *out = std::numeric_limits<MicrosTime>::max();
+    return Status::OK();
+  }
+
+  DocHybridTime doc_ht;
+  RETURN_NOT_OK(doc_ht.FullyDecodeFrom(doc_ht_slice));
+  const MicrosTime write_micros = doc_ht.hybrid_time().GetPhysicalValueMicros();
+  const MicrosTime ttl_micros = ttl.ToMicroseconds();
+  *out = write_micros > std::numeric_limits<MicrosTime>::max() - ttl_micros
+      ? std::numeric_limits<MicrosTime>::max() : write_micros + ttl_micros;
+  return Status::OK();
+}
+
 // Wrapper for UserBoundaryValue that stores PrimitiveValue with index.
 class PrimitiveBoundaryValue : public rocksdb::UserBoundaryValue {
  public:
@@ -147,6 +218,9 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
     if (tag == kDocHybridTimeTag) {
       return DocHybridTimeValue::Create(data, value);
     }
+    if (tag == kValueTtlExpirationTag) {
+      return TtlExpirationValue::Create(data, value);
+    }
     if (tag >= kRangeComponentsStart) {
       return PrimitiveBoundaryValue::Create(tag - kRangeComponentsStart, data, value);
     }
@@ -178,6 +252,15 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
     RETURN_NOT_OK(DocHybridTimeValue::Create(slices.back(), &temp));
     values->push_back(std::move(temp));
 
+    if (static_cast<ValueType>(user_key[0]) != ValueType::kIntentPrefix) {
+      // A value we fail to parse must not fail the flush, so it is treated as never expiring.
+      MicrosTime expiration_micros;
+      if (!ValueTtlExpiration(slices.back(), value, &expiration_micros).ok()) {
+        expiration_micros = std::numeric_limits<MicrosTime>::max();
+      }
+      values->push_back(std::make_shared<TtlExpirationValue>(expiration_micros));
+    }
+
     for (size_t i = 0; i != size; ++i) {
       RETURN_NOT_OK(PrimitiveBoundaryValue::Create(i, slices[i], &temp));
       values->push_back(std::move(temp));
@@ -253,6 +336,15 @@ Status GetDocHybridTime(const rocksdb::UserBoundaryValues& values, DocHybridTime
   return time_value->value(out);
 }
 
+Status GetValueTtlExpiration(const rocksdb::UserBoundaryValues& values, MicrosTime* out) {
+  auto value = rocksdb::UserValueWithTag(values, kValueTtlExpirationTag);
+  if (!value) {
+    return STATUS(NotFound, "Not found value for TTL expiration");
+  }
+  *out = down_cast<TtlExpirationValue*>(value.get())->value();
+  return Status::OK();
+}
+
 rocksdb::UserBoundaryTag TagForRangeComponent(size_t index) {
   return PrimitiveBoundaryValue::TagForIndex(index);
 }
@@ -75,8 +75,11 @@ CHECKED_STATUS DocExprExecutor::EvalTSCall(const QLBCallPB& tscall,
       return EvalMax(arg_result, result);
     }
 
-    case TSOpcode::kAvg:
-      return STATUS(RuntimeError, "Not yet supported");
+    case TSOpcode::kAvg: {
+      QLValue arg_result;
+      RETURN_NOT_OK(EvalExpr(tscall.operands(0), table_row, &arg_result));
+      return EvalAvg(arg_result, result);
+    }
 
     case TSOpcode::kMapExtend: FALLTHROUGH_INTENDED;
     case TSOpcode::kMapRemove: FALLTHROUGH_INTENDED;
@@ -169,6 +172,42 @@ CHECKED_STATUS DocExprExecutor::EvalSum(const QLValue& val, QLValue *aggr_sum) {
   return Status::OK();
 }
 
+CHECKED_STATUS DocExprExecutor::EvalAvg(const QLValue& val, QLValue *aggr_sum) {
+  if (val.IsNull()) {
+    return Status::OK();
+  }
+
+  switch (val.type()) {
+    case InternalType::kInt8Value:
+      aggr_sum->set_int64_value((aggr_sum->IsNull() ? 0 : aggr_sum->int64_value()) +
+                                val.int8_value());
+      break;
+    case InternalType::kInt16Value:
+      aggr_sum->set_int64_value((aggr_sum->IsNull() ? 0 : aggr_sum->int64_value()) +
+                                val.int16_value());
+      break;
+    case InternalType::kInt32Value:
+      aggr_sum->set_int64_value((aggr_sum->IsNull() ? 0 : aggr_sum->int64_value()) +
+                                val.int32_value());
+      break;
+    case InternalType::kInt64Value:
+      aggr_sum->set_int64_value((aggr_sum->IsNull() ? 0 : aggr_sum->int64_value()) +
+                                val.int64_value());
+      break;
+    case InternalType::kFloatValue:
+      aggr_sum->set_double_value((aggr_sum->IsNull() ? 0 : aggr_sum->double_value()) +
+                                 val.float_value());
+      break;
+    case InternalType::kDoubleValue:
+      aggr_sum->set_double_value((aggr_sum->IsNull() ? 0 : aggr_sum->double_value()) +
+                                 val.double_value());
+      break;
+    default:
+      return STATUS(RuntimeError, "Cannot find AVG of this column");
+  }
+  return Status::OK();
+}
+
 CHECKED_STATUS DocExprExecutor::EvalMax(const QLValue& val, QLValue *aggr_max) {
   if (!val.IsNull() && (aggr_max->IsNull() || *aggr_max < val)) {
     *aggr_max = val;
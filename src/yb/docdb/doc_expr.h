@@ -37,6 +37,10 @@ class DocExprExecutor : public QLExprExecutor {
   CHECKED_STATUS EvalMax(const QLValue& val, QLValue *aggr_max);
   CHECKED_STATUS EvalMin(const QLValue& val, QLValue *aggr_min);
 
+  // The partial result of AVG() is the sum of the values in a type that does not overflow as easily
+  // as the argument type. The caller computes the count separately and divides the sums by it.
+  CHECKED_STATUS EvalAvg(const QLValue& val, QLValue *aggr_sum);
+
  protected:
   vector<QLValue> aggr_result_;
 };
@@ -373,6 +373,51 @@ TEST(DocKeyTest, TestKeyMatching) {
   ASSERT_FALSE(may_match(EncodeSimpleSubDocKey(absent_key))) << "Key: " << absent_key;
 }
 
+TEST(DocKeyTest, TestKeyMatchingWithRangeComponents) {
+  DocDbAwareFilterPolicy policy(
+      rocksdb::FilterPolicy::kDefaultFixedSizeFilterBits, nullptr, 1 /* num_range_components */);
+  DocDbAwareFilterPolicy hashed_policy(rocksdb::FilterPolicy::kDefaultFixedSizeFilterBits, nullptr);
+  ASSERT_STRNE(hashed_policy.Name(), policy.Name());
+  const auto* transformer = policy.GetKeyTransformer();
+
+  auto encode = [](const std::string& range_key1, const std::string& range_key2) {
+    DocKey doc_key(0, PrimitiveValues("hash_key"), PrimitiveValues(range_key1, range_key2));
+    return SubDocKey(doc_key, PrimitiveValue("sub_key"),
+                     HybridTime::FromMicros(12345L)).Encode().AsStringRef();
+  };
+
+  std::unique_ptr<FilterBitsBuilder> builder(policy.GetFilterBitsBuilder());
+  for (const auto& range_key : { "a", "b", "c" }) {
+    builder->AddKey(transformer->Transform(encode(range_key, "x")));
+  }
+  std::unique_ptr<const char[]> buf;
+  rocksdb::Slice filter = builder->Finish(&buf);
+  std::unique_ptr<FilterBitsReader> reader(policy.GetFilterBitsReader(filter));
+
+  auto may_match = [&](const std::string& key) {
+    return reader->MayMatch(transformer->Transform(key));
+  };
+
+  for (const auto& range_key : { "a", "b", "c" }) {
+    ASSERT_TRUE(may_match(encode(range_key, "x"))) << "Range key: " << range_key;
+    // Only the first range component is taken into account.
+    ASSERT_TRUE(may_match(encode(range_key, "y"))) << "Range key: " << range_key;
+  }
+  ASSERT_FALSE(may_match(encode("d", "x")));
+
+  // Keys without the first range component could match keys with any value of it, so the filter
+  // should not be checked for them.
+  const std::string full_key = encode("a", "x");
+  const KeyBytes range_prefix_key =
+      DocKey(0, PrimitiveValues("hash_key"), PrimitiveValues("a")).Encode();
+  const KeyBytes hashed_key = DocKey(0, PrimitiveValues("hash_key"), {}).Encode();
+  ASSERT_TRUE(transformer->IsFullFilterKey(full_key));
+  ASSERT_TRUE(transformer->IsFullFilterKey(range_prefix_key.AsSlice()));
+  ASSERT_FALSE(transformer->IsFullFilterKey(hashed_key.AsSlice()));
+  ASSERT_EQ(hashed_policy.GetKeyTransformer()->Transform(full_key),
+            transformer->Transform(hashed_key.AsSlice()));
+}
+
 TEST(DocKeyTest, TestWriteId) {
   SubDocKey subdoc_key(DocKey({PrimitiveValue("a"), PrimitiveValue(135)}),
                        DocHybridTime(1000000, 4091, 135));
@@ -13,6 +13,7 @@
 
 #include "yb/docdb/doc_key.h"
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 
@@ -191,6 +192,25 @@ Result<size_t> DocKey::EncodedSize(Slice slice, DocKeyPart part) {
   return slice.cdata() - initial_begin;
 }
 
+Result<size_t> DocKey::EncodedSizeWithRangeComponents(
+    Slice slice, size_t max_range_components, size_t* num_range_components) {
+  auto initial_begin = slice.cdata();
+  RETURN_NOT_OK(DoDecode(&slice, DocKeyPart::HASHED_PART_ONLY, DummyCallback()));
+  size_t range_components = 0;
+  while (range_components < max_range_components && !slice.empty() &&
+         IsPrimitiveValueType(static_cast<ValueType>(*slice.data()))) {
+    Slice component = slice;
+    if (!PrimitiveValue::DecodeKey(&component, nullptr).ok()) {
+      // Not a document key, e.g. transaction metadata in the intents DB.
+      break;
+    }
+    slice = component;
+    ++range_components;
+  }
+  *num_range_components = range_components;
+  return slice.cdata() - initial_begin;
+}
+
 class DocKey::DecodeFromCallback {
  public:
   explicit DecodeFromCallback(DocKey* key) : key_(key) {
@@ -308,6 +328,13 @@ bool DocKey::HashedComponentsEqual(const DocKey& other) const {
       (!hash_present_ || (hash_ == other.hash_ && hashed_group_ == other.hashed_group_));
 }
 
+bool DocKey::RangeComponentsPrefixEqual(const DocKey& other, size_t num_range_components) const {
+  return range_group_.size() >= num_range_components &&
+      other.range_group_.size() >= num_range_components &&
+      std::equal(range_group_.begin(), range_group_.begin() + num_range_components,
+                 other.range_group_.begin());
+}
+
 void DocKey::AddRangeComponent(const PrimitiveValue& val) {
   range_group_.push_back(val);
 }
@@ -665,8 +692,44 @@ class HashedComponentsExtractor : public rocksdb::FilterPolicy::KeyTransformer {
   }
 };
 
+class HashedAndRangeComponentsExtractor : public rocksdb::FilterPolicy::KeyTransformer {
+ public:
+  explicit HashedAndRangeComponentsExtractor(size_t num_range_components)
+      : num_range_components_(num_range_components) {}
+
+  Slice Transform(Slice key) const override {
+    size_t num_range_components;
+    auto size = DocKey::EncodedSizeWithRangeComponents(
+        key, num_range_components_, &num_range_components);
+    CHECK_OK(size);
+    return Slice(key.data(), *size);
+  }
+
+  bool IsFullFilterKey(Slice key) const override {
+    size_t num_range_components;
+    auto size = DocKey::EncodedSizeWithRangeComponents(
+        key, num_range_components_, &num_range_components);
+    return size.ok() && num_range_components == num_range_components_;
+  }
+
+ private:
+  const size_t num_range_components_;
+};
+
 } // namespace
 
+DocDbAwareFilterPolicy::DocDbAwareFilterPolicy(
+    size_t filter_block_size_bits, rocksdb::Logger* logger, size_t num_range_components) {
+  builtin_policy_.reset(rocksdb::NewFixedSizeFilterPolicy(
+      filter_block_size_bits, rocksdb::FilterPolicy::kDefaultFixedSizeFilterErrorRate, logger));
+  if (num_range_components == 0) {
+    name_ = "DocKeyHashedComponentsFilter";
+  } else {
+    range_components_extractor_.reset(
+        new HashedAndRangeComponentsExtractor(num_range_components));
+    name_ = Substitute("DocKeyHashedAnd$0RangeComponentsFilter", num_range_components);
+  }
+}
 
 void DocDbAwareFilterPolicy::CreateFilter(
     const rocksdb::Slice* keys, int n, std::string* dst) const {
@@ -693,6 +756,9 @@ rocksdb::FilterPolicy::FilterType DocDbAwareFilterPolicy::GetFilterType() const
 }
 
 const rocksdb::FilterPolicy::KeyTransformer* DocDbAwareFilterPolicy::GetKeyTransformer() const {
+  if (range_components_extractor_) {
+    return range_components_extractor_.get();
+  }
   return &HashedComponentsExtractor::GetInstance();
 }
 
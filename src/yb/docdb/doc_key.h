@@ -117,6 +117,14 @@ class DocKey {
 
   static Result<size_t> EncodedSize(Slice slice, DocKeyPart part);
 
+  // Returns the encoded size of the hashed part and up to max_range_components first range
+  // components of the document key at the beginning of the given slice. Stops at the end of the
+  // range group and at anything that could not be decoded as a primitive value, so it could be used
+  // for any DocDB key, e.g. for an intent key or for a key with fewer range components.
+  // num_range_components (out) - the number of range components that are included.
+  static Result<size_t> EncodedSizeWithRangeComponents(
+      Slice slice, size_t max_range_components, size_t* num_range_components);
+
   // Decode the current document key from the given slice, but expect all bytes to be consumed, and
   // return an error status if that is not the case.
   CHECKED_STATUS FullyDecodeFrom(const rocksdb::Slice& slice);
@@ -137,6 +145,10 @@ class DocKey {
 
   bool HashedComponentsEqual(const DocKey& other) const;
 
+  // Checks whether both keys have at least num_range_components range components, and their
+  // first num_range_components range components are equal.
+  bool RangeComponentsPrefixEqual(const DocKey& other, size_t num_range_components) const;
+
   void AddRangeComponent(const PrimitiveValue& val);
 
   int CompareTo(const DocKey& other) const;
@@ -496,15 +508,17 @@ inline std::ostream& operator <<(std::ostream& out, const SubDocKey& subdoc_key)
 std::string BestEffortDocDBKeyToStr(const KeyBytes &key_bytes);
 std::string BestEffortDocDBKeyToStr(const rocksdb::Slice &slice);
 
-// This filter policy only takes into account hashed components of keys for filtering.
+// This filter policy only takes into account hashed components of keys for filtering, and the
+// first num_range_components range components if it is not zero. In the latter case the filter is
+// only checked for keys that have all of these components, see DocRowwiseIterator.
 class DocDbAwareFilterPolicy : public rocksdb::FilterPolicy {
  public:
-  explicit DocDbAwareFilterPolicy(size_t filter_block_size_bits, rocksdb::Logger* logger) {
-    builtin_policy_.reset(rocksdb::NewFixedSizeFilterPolicy(
-        filter_block_size_bits, rocksdb::FilterPolicy::kDefaultFixedSizeFilterErrorRate, logger));
-  }
+  DocDbAwareFilterPolicy(
+      size_t filter_block_size_bits, rocksdb::Logger* logger, size_t num_range_components = 0);
 
-  const char* Name() const override { return "DocKeyHashedComponentsFilter"; }
+  // Filters built with a different number of range components have different names, so they are
+  // ignored for SST files written with another setting.
+  const char* Name() const override { return name_.c_str(); }
 
   void CreateFilter(const rocksdb::Slice* keys, int n, std::string* dst) const override;
 
@@ -520,6 +534,8 @@ class DocDbAwareFilterPolicy : public rocksdb::FilterPolicy {
 
  private:
   std::unique_ptr<const rocksdb::FilterPolicy> builtin_policy_;
+  std::unique_ptr<const KeyTransformer> range_components_extractor_;
+  std::string name_;
 };
 
 }  // namespace docdb
@@ -34,6 +34,9 @@
 DECLARE_uint64(rocksdb_max_file_size_for_compaction);
 DECLARE_int32(rocksdb_level0_slowdown_writes_trigger);
 DECLARE_int32(rocksdb_level0_stop_writes_trigger);
+DECLARE_int32(ql_read_batch_size);
+DECLARE_int32(rocksdb_max_subcompactions);
+DECLARE_uint64(rocksdb_min_subcompaction_size_bytes);
 
 using namespace std::literals; // NOLINT
 
@@ -206,6 +209,19 @@ SubDocKey(DocKey(0x0000, [1], []), [ColumnId(3); HT{ <max> w: 2 }]) -> 4
       col->type()->ToQLTypePB(rscol_desc->mutable_ql_type());
     }
 
+    // Transfer the column values from result set to rowblock.
+    QLResponsePB response;
+    const std::string rows_data = ReadQLRowsData(
+        schema, query_schema, ql_read_req, read_time, &response);
+    Slice data(rows_data);
+    EXPECT_OK(row_block.Deserialize(YQL_CLIENT_CQL, &data));
+    return row_block;
+  }
+
+  // Read rows using the request and return them serialized in CQL format, as sent to the client.
+  std::string ReadQLRowsData(const Schema& schema, const Schema& query_schema,
+                             const QLReadRequestPB& ql_read_req, const HybridTime& read_time,
+                             QLResponsePB* response) {
     QLReadOperation read_op(ql_read_req, kNonTransactionalOperationContext);
     QLRocksDBStorage ql_storage(rocksdb());
     QLResultSet resultset;
@@ -215,12 +231,11 @@ SubDocKey(DocKey(0x0000, [1], []), [ColumnId(3); HT{ <max> w: 2 }]) -> 4
         &read_restart_ht));
     EXPECT_FALSE(read_restart_ht.is_valid());
 
-    // Transfer the column values from result set to rowblock.
-    for (const auto& rsrow : resultset.rsrows()) {
-      QLRow& row = row_block.Extend();
-      row.SetColumnValues(rsrow.rscols());
-    }
-    return row_block;
+    faststring rows_data;
+    EXPECT_OK(resultset.CQLSerialize(
+        YQL_CLIENT_CQL, QLRSRowDesc(ql_read_req.rsrow_desc()), &rows_data));
+    *response = read_op.response();
+    return rows_data.ToString();
   }
 };
 
@@ -631,6 +646,76 @@ TEST_F_EX(DocOperationTest, TestQLDescAscScan, DocOperationRangeFilterTest) {
   TestWithSortingType(ColumnSchema::kDescending, false);
 }
 
+TEST_F(DocOperationTest, QLReadBatches) {
+  google::FlagSaver flag_saver;
+
+  ColumnSchema hash_column("k", INT32, false, true);
+  ColumnSchema range_column("r", INT32, false, false);
+  ColumnSchema value_column("v", INT32, false, false);
+  auto columns = { hash_column, range_column, value_column };
+  Schema schema(columns, CreateColumnIds(columns.size()), 2);
+
+  constexpr int32_t kNumRows = 100;
+  for (int32_t i = 0; i != kNumRows; ++i) {
+    WriteQLRow(QLWriteRequestPB_QLStmtType_QL_STMT_INSERT, schema, { 1, i, i * 7 % 17 }, 1000,
+               HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(1000, 0));
+  }
+
+  // SELECT k, r, v FROM t WHERE k = 1 AND v >= 5 AND r NOT IN (10, 20, 30) LIMIT 30.
+  QLReadRequestPB ql_read_req;
+  ql_read_req.set_client(YQL_CLIENT_CQL);
+  ql_read_req.add_hashed_column_values()->mutable_value()->set_int32_value(1);
+  for (int32_t i = 0; i != schema.num_columns(); ++i) {
+    ql_read_req.add_selected_exprs()->set_column_id(i);
+    ql_read_req.mutable_column_refs()->add_ids(i);
+    QLRSColDescPB* rscol_desc = ql_read_req.mutable_rsrow_desc()->add_rscol_descs();
+    rscol_desc->set_name(schema.column(i).name());
+    schema.column(i).type()->ToQLTypePB(rscol_desc->mutable_ql_type());
+  }
+  QLConditionPB* condition = ql_read_req.mutable_where_expr()->mutable_condition();
+  condition->set_op(QL_OP_AND);
+  QLConditionPB* value_condition = condition->add_operands()->mutable_condition();
+  value_condition->set_op(QL_OP_GREATER_THAN_EQUAL);
+  value_condition->add_operands()->set_column_id(2);
+  value_condition->add_operands()->mutable_value()->set_int32_value(5);
+  QLConditionPB* range_condition = condition->add_operands()->mutable_condition();
+  range_condition->set_op(QL_OP_NOT_IN);
+  range_condition->add_operands()->set_column_id(1);
+  auto* range_values = range_condition->add_operands()->mutable_value()->mutable_list_value();
+  for (int32_t value : { 10, 20, 30 }) {
+    range_values->add_elems()->set_int32_value(value);
+  }
+  ql_read_req.set_limit(30);
+
+  const auto read_time = HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(2000, 0);
+
+  // Rows read one at a time are the reference.
+  FLAGS_ql_read_batch_size = 0;
+  QLResponsePB expected_response;
+  const std::string expected = ReadQLRowsData(
+      schema, schema, ql_read_req, read_time, &expected_response);
+  ASSERT_TRUE(expected_response.has_paging_state());
+
+  for (int batch_size : { 1, 7, 1024 }) {
+    FLAGS_ql_read_batch_size = batch_size;
+    QLResponsePB response;
+    ASSERT_EQ(expected, ReadQLRowsData(schema, schema, ql_read_req, read_time, &response))
+        << "Batch size: " << batch_size;
+    ASSERT_EQ(expected_response.ShortDebugString(), response.ShortDebugString())
+        << "Batch size: " << batch_size;
+  }
+
+  QLRowBlock row_block(schema);
+  Slice data(expected);
+  ASSERT_OK(row_block.Deserialize(YQL_CLIENT_CQL, &data));
+  ASSERT_EQ(30, row_block.row_count());
+  for (const auto& row : row_block.rows()) {
+    ASSERT_GE(row.column(2).int32_value(), 5);
+    const int32_t r = row.column(1).int32_value();
+    ASSERT_TRUE(r != 10 && r != 20 && r != 30) << r;
+  }
+}
+
 TEST_F(DocOperationTest, TestQLCompactions) {
   yb::QLWriteRequestPB ql_writereq_pb;
   yb::QLResponsePB ql_writeresp_pb;
@@ -811,5 +896,66 @@ TEST_F(DocOperationTest, MaxFileSizeWithWritesTrigger) {
   ASSERT_EQ(0, stats->GetCFStats(rocksdb::InternalStats::LEVEL0_SLOWDOWN_TOTAL));
 }
 
+TEST_F(DocOperationTest, ExpiredFilesDeletion) {
+  ASSERT_OK(DisableCompactions());
+  SetTableTTL(1);
+
+  // One file per key, the value in the second oldest file has its own TTL that has not expired.
+  constexpr int kNumFiles = 4;
+  for (int i = 0; i != kNumFiles; ++i) {
+    DocKey doc_key(PrimitiveValues(Format("k$0", i)));
+    Value value(PrimitiveValue(Format("v$0", i)), i == 1 ? MonoDelta(1h) : Value::kMaxTtl);
+    ASSERT_OK(SetPrimitive(DocPath(doc_key.Encode(), PrimitiveValue("s")), value,
+                           HybridTime::FromMicros(1000 + i * 10000)));
+    ASSERT_OK(FlushRocksDB());
+  }
+
+  SetHistoryCutoffHybridTime(HybridTime::FromMicros(1000 + kNumFiles * 10000));
+  ASSERT_OK(ReinitDBOptions());
+  WaitCompactionsDone(rocksdb());
+
+  // Only the oldest file is deleted, the newer expired files are behind the one that has not
+  // expired yet.
+  std::vector<rocksdb::LiveFileMetaData> files;
+  rocksdb()->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(kNumFiles - 1, files.size());
+  auto dump = DocDBDebugDumpToStr();
+  ASSERT_EQ(std::string::npos, dump.find("\"v0\"")) << dump;
+  ASSERT_NE(std::string::npos, dump.find("\"v1\"")) << dump;
+}
+
+TEST_F(DocOperationTest, Subcompactions) {
+  FLAGS_rocksdb_max_subcompactions = 4;
+  FLAGS_rocksdb_min_subcompaction_size_bytes = 0;
+  ASSERT_OK(ReinitDBOptions());
+
+  constexpr int kNumFiles = 4;
+  constexpr int kKeysPerFile = 500;
+  const std::string kPadding(200, 'x');
+  auto value_prefix = [](int i) { return Format("v$0:", i); };
+  for (int i = 0; i != kNumFiles * kKeysPerFile; ++i) {
+    DocKey doc_key(i * 131 % 0x10000, PrimitiveValues(Format("k$0", i)));
+    ASSERT_OK(SetPrimitive(DocPath(doc_key.Encode(), PrimitiveValue("s")),
+                           Value(PrimitiveValue(value_prefix(i) + kPadding)),
+                           HybridTime::FromMicros(1000 + i)));
+    if ((i + 1) % kKeysPerFile == 0) {
+      ASSERT_OK(FlushRocksDB());
+    }
+  }
+
+  ASSERT_OK(FullyCompactDB(rocksdb()));
+  WaitCompactionsDone(rocksdb());
+
+  // Each subcompaction writes its own file, and these files are not compacted again.
+  std::vector<rocksdb::LiveFileMetaData> files;
+  rocksdb()->GetLiveFilesMetaData(&files);
+  ASSERT_GT(files.size(), 1);
+  ASSERT_LE(files.size(), 4);
+  auto dump = DocDBDebugDumpToStr();
+  for (int i = 0; i != kNumFiles * kKeysPerFile; ++i) {
+    ASSERT_NE(std::string::npos, dump.find("\"" + value_prefix(i))) << i;
+  }
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -16,6 +16,7 @@
 #include "yb/common/ql_storage_interface.h"
 #include "yb/common/ql_value.h"
 #include "yb/common/ql_expr.h"
+#include "yb/common/ql_resultset.h"
 #include "yb/docdb/doc_operation.h"
 #include "yb/docdb/docdb.h"
 #include "yb/docdb/docdb_util.h"
@@ -40,6 +41,11 @@ DEFINE_bool(emulate_redis_responses,
     "and HDEL. If emulate_redis_responses is true, we read the required records to compute the "
     "response as specified by the official Redis API documentation. https://redis.io/commands");
 
+DEFINE_int32(ql_read_batch_size, 1024,
+    "Max number of rows read at a time by QL scans that could be evaluated over column batches. "
+    "Rows are decoded into per column vectors, filtered and serialized to the CQL wire format "
+    "directly from them. 0 disables batch reads.");
+
 namespace yb {
 namespace docdb {
 
@@ -2072,7 +2078,11 @@ Status QLReadOperation::Execute(const common::QLStorageIf& ql_storage,
     if (request_.limit() == 0) {
       return Status::OK();
     }
-    row_count_limit = request_.limit();
+    // An aggregate read returns one row per group and is not paged. The limit on the groups is
+    // applied after the partial aggregates of all tablets are merged.
+    if (!request_.is_aggregate()) {
+      row_count_limit = request_.limit();
+    }
   }
 
   // Create the projections of the non-key columns selected by the row block plus any referenced in
@@ -2098,6 +2108,11 @@ Status QLReadOperation::Execute(const common::QLStorageIf& ql_storage,
     TRACE("Initialized iterator");
   }
 
+  if (static_row_spec == nullptr && CanReadBatches(schema, read_static_columns, *spec)) {
+    RETURN_NOT_OK(ReadBatches(
+        schema, non_static_projection, *spec, row_count_limit, iter.get(), resultset));
+  }
+
   QLTableRow static_row;
   QLTableRow non_static_row;
   QLTableRow& selected_row = read_distinct_columns ? static_row : non_static_row;
@@ -2209,6 +2224,92 @@ Status QLReadOperation::Execute(const common::QLStorageIf& ql_storage,
   return Status::OK();
 }
 
+bool QLReadOperation::CanReadBatches(const Schema& schema,
+                                     bool read_static_columns,
+                                     const common::QLScanSpec& spec) const {
+  if (FLAGS_ql_read_batch_size <= 0 || schema.has_statics() || read_static_columns ||
+      request_.distinct() || request_.is_aggregate() || request_.client() != YQL_CLIENT_CQL ||
+      request_.rsrow_desc().rscol_descs_size() != request_.selected_exprs_size()) {
+    return false;
+  }
+  for (const QLExpressionPB& expr : request_.selected_exprs()) {
+    if (!CanEvalBatch(expr)) {
+      return false;
+    }
+  }
+  return spec.CanMatchBatch();
+}
+
+CHECKED_STATUS QLReadOperation::ReadBatches(const Schema& schema,
+                                            const Schema& projection,
+                                            const common::QLScanSpec& spec,
+                                            size_t row_count_limit,
+                                            common::QLRowwiseIteratorIf* iter,
+                                            QLResultSet* resultset) {
+  // Columns of the batch are the key columns of the table followed by the projection columns,
+  // see DocRowwiseIterator::NextRowBatch.
+  std::vector<ColumnId> column_ids(schema.column_ids().begin(),
+                                   schema.column_ids().begin() + schema.num_key_columns());
+  for (size_t i = projection.num_key_columns(); i < projection.num_columns(); i++) {
+    column_ids.push_back(projection.column_id(i));
+  }
+  QLColumnBatch batch(std::move(column_ids));
+
+  // Resolve how each selected expression is produced: directly from a batch column, or from the
+  // values evaluated for the whole batch.
+  const QLRSRowDesc rsrow_desc(request_.rsrow_desc());
+  const int column_count = request_.selected_exprs_size();
+  std::vector<int> column_indexes(column_count, -1);
+  std::vector<std::vector<QLValue>> expr_values(column_count);
+  for (int i = 0; i != column_count; ++i) {
+    const QLExpressionPB& expr = request_.selected_exprs(i);
+    if (expr.expr_case() == QLExpressionPB::ExprCase::kColumnId) {
+      column_indexes[i] = batch.ColumnIndex(expr.column_id());
+    }
+  }
+
+  faststring* buffer = resultset->mutable_serialized_rows();
+  while (resultset->rsrow_count() < row_count_limit && iter->HasNext()) {
+    // Never read more rows than could be returned, so the paging state is set right after the
+    // last returned row.
+    batch.Reset(std::min<size_t>(FLAGS_ql_read_batch_size,
+                                 row_count_limit - resultset->rsrow_count()));
+    RETURN_NOT_OK(iter->NextRowBatch(projection, &batch));
+    if (batch.empty()) {
+      // Next row is a static row, it is handled by the row-at-a-time read.
+      break;
+    }
+
+    RETURN_NOT_OK(spec.MatchBatch(&batch));
+    for (int i = 0; i != column_count; ++i) {
+      if (column_indexes[i] < 0) {
+        RETURN_NOT_OK(EvalExprBatch(request_.selected_exprs(i), batch, &expr_values[i]));
+      }
+    }
+
+    const auto& selected = batch.selection();
+    size_t selected_count = 0;
+    for (size_t row = 0; row != batch.num_rows(); ++row) {
+      if (!selected[row]) {
+        continue;
+      }
+      for (int i = 0; i != column_count; ++i) {
+        const auto& ql_type = rsrow_desc.rscol_descs()[i].ql_type();
+        if (column_indexes[i] >= 0) {
+          QLValue::Serialize(batch.value(column_indexes[i], row), ql_type, request_.client(),
+                             buffer);
+        } else {
+          expr_values[i][row].Serialize(ql_type, request_.client(), buffer);
+        }
+      }
+      ++selected_count;
+    }
+    resultset->AddSerializedRows(selected_count);
+  }
+
+  return Status::OK();
+}
+
 CHECKED_STATUS QLReadOperation::PopulateResultSet(const QLTableRow& table_row,
                                                   QLResultSet *resultset) {
   int column_count = request_.selected_exprs().size();
@@ -2223,7 +2324,11 @@ CHECKED_STATUS QLReadOperation::PopulateResultSet(const QLTableRow& table_row,
   return Status::OK();
 }
 
-CHECKED_STATUS QLReadOperation::EvalAggregate(const QLTableRow& table_row) {
+CHECKED_STATUS QLReadOperation::EvalAggregate(const QLTableRow& table_row,
+                                              QLResultSet *resultset) {
+  if (request_.group_by_column_ids_size() > 0) {
+    RETURN_NOT_OK(StartAggregateGroup(table_row, resultset));
+  }
   if (aggr_result_.empty()) {
     int column_count = request_.selected_exprs().size();
     aggr_result_.resize(column_count);
@@ -2247,6 +2352,34 @@ CHECKED_STATUS QLReadOperation::PopulateAggregate(const QLTableRow& table_row,
   return Status::OK();
 }
 
+CHECKED_STATUS QLReadOperation::StartAggregateGroup(const QLTableRow& table_row,
+                                                    QLResultSet *resultset) {
+  static const QLValuePB kNullValue;
+  const int num_group_by_columns = request_.group_by_column_ids_size();
+
+  // Rows are read in the primary key order and GROUP BY columns are a prefix of the key, so all
+  // rows of a group are adjacent.
+  bool same_group = !aggr_result_.empty();
+  for (int i = 0; same_group && i < num_group_by_columns; i++) {
+    const QLTableColumn* column = table_row.FindColumn(request_.group_by_column_ids(i));
+    same_group = aggr_group_key_[i] == (column != nullptr ? column->value : kNullValue);
+  }
+  if (same_group) {
+    return Status::OK();
+  }
+
+  if (!aggr_result_.empty()) {
+    RETURN_NOT_OK(PopulateAggregate(table_row, resultset));
+    aggr_result_.clear();
+  }
+  aggr_group_key_.resize(num_group_by_columns);
+  for (int i = 0; i < num_group_by_columns; i++) {
+    const QLTableColumn* column = table_row.FindColumn(request_.group_by_column_ids(i));
+    aggr_group_key_[i] = column != nullptr ? column->value : kNullValue;
+  }
+  return Status::OK();
+}
+
 CHECKED_STATUS QLReadOperation::AddRowToResult(const std::unique_ptr<common::QLScanSpec>& spec,
                                                const QLTableRow& row,
                                                const size_t row_count_limit,
@@ -2258,7 +2391,7 @@ CHECKED_STATUS QLReadOperation::AddRowToResult(const std::unique_ptr<common::QLS
     if (match) {
       (*match_count)++;
       if (request_.is_aggregate()) {
-        RETURN_NOT_OK(EvalAggregate(row));
+        RETURN_NOT_OK(EvalAggregate(row, resultset));
       } else {
         RETURN_NOT_OK(PopulateResultSet(row, resultset));
       }
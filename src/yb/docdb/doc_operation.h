@@ -220,7 +220,7 @@ class QLReadOperation : public DocExprExecutor {
 
   CHECKED_STATUS PopulateResultSet(const QLTableRow& table_row, QLResultSet *result_set);
 
-  CHECKED_STATUS EvalAggregate(const QLTableRow& table_row);
+  CHECKED_STATUS EvalAggregate(const QLTableRow& table_row, QLResultSet *resultset);
   CHECKED_STATUS PopulateAggregate(const QLTableRow& table_row, QLResultSet *resultset);
 
   CHECKED_STATUS AddRowToResult(const std::unique_ptr<common::QLScanSpec>& spec,
@@ -232,9 +232,30 @@ class QLReadOperation : public DocExprExecutor {
   QLResponsePB& response() { return response_; }
 
  private:
+  // Whether the rows could be read, filtered and serialized batch at a time.
+  bool CanReadBatches(const Schema& schema,
+                      bool read_static_columns,
+                      const common::QLScanSpec& spec) const;
+
+  // Read rows batch at a time and serialize the selected ones directly into the result set.
+  // Stops at the first static row, if any, leaving it to the row-at-a-time read.
+  CHECKED_STATUS ReadBatches(const Schema& schema,
+                             const Schema& projection,
+                             const common::QLScanSpec& spec,
+                             size_t row_count_limit,
+                             common::QLRowwiseIteratorIf* iter,
+                             QLResultSet* resultset);
+
+  // Check whether the row starts a new GROUP BY group. If so, the aggregate of the previous group
+  // is complete and is added to the result set.
+  CHECKED_STATUS StartAggregateGroup(const QLTableRow& table_row, QLResultSet *resultset);
+
   const QLReadRequestPB& request_;
   const TransactionOperationContextOpt txn_op_context_;
   QLResponsePB response_;
+
+  // Values of the GROUP BY columns of the group being aggregated.
+  std::vector<QLValuePB> aggr_group_key_;
 };
 
 }  // namespace docdb
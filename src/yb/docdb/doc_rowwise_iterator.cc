@@ -40,13 +40,15 @@ DocRowwiseIterator::DocRowwiseIterator(
     const TransactionOperationContextOpt& txn_op_context,
     rocksdb::DB *db,
     const ReadHybridTime& read_time,
-    yb::util::PendingOperationCounter* pending_op_counter)
+    yb::util::PendingOperationCounter* pending_op_counter,
+    const KeyBounds* key_bounds)
     : projection_(projection),
       schema_(schema),
       txn_op_context_(txn_op_context),
       read_time_(read_time),
       db_(db),
       has_bound_key_(false),
+      key_bounds_(key_bounds),
       pending_op_(pending_op_counter),
       done_(false) {
   projection_subkeys_.reserve(projection.num_columns() + 1);
@@ -61,16 +63,20 @@ DocRowwiseIterator::~DocRowwiseIterator() {
 }
 
 Status DocRowwiseIterator::Init() {
-  auto query_id = rocksdb::kDefaultQueryId;
+  // Without a scan spec the whole tablet is scanned.
+  auto query_id = rocksdb::kLongScanQueryId;
 
   db_iter_ = CreateIntentAwareIterator(
       db_, BloomFilterMode::DONT_USE_BLOOM_FILTER, boost::none /* user_key_for_filter */,
       query_id, txn_op_context_, read_time_);
 
-  row_key_ = DocKey();
+  row_key_ = key_bounds_ ? key_bounds_->lower() : DocKey();
   db_iter_->Seek(row_key_);
   row_ready_ = false;
-  has_bound_key_ = false;
+  has_bound_key_ = key_bounds_ && !key_bounds_->upper().empty();
+  if (has_bound_key_) {
+    bound_key_ = key_bounds_->upper();
+  }
 
   return Status::OK();
 }
@@ -90,14 +96,34 @@ Status DocRowwiseIterator::Init(const common::QLScanSpec& spec) {
   // TOOD(bogdan): decide if this is a good enough heuristic for using blooms for scans.
   const bool is_fixed_point_get = !lower_doc_key.empty() &&
       upper_doc_key.HashedComponentsEqual(lower_doc_key);
-  const auto mode = is_fixed_point_get ? BloomFilterMode::USE_BLOOM_FILTER :
+  // When bloom filters also take into account the first range components, they can only be used if
+  // all keys in the scan range have the same values of these components.
+  const bool use_bloom_filter = is_fixed_point_get &&
+      upper_doc_key.RangeComponentsPrefixEqual(
+          lower_doc_key, schema_.table_properties().num_bloom_filter_range_components());
+  const auto mode = use_bloom_filter ? BloomFilterMode::USE_BLOOM_FILTER :
       BloomFilterMode::DONT_USE_BLOOM_FILTER;
 
+  if (key_bounds_) {
+    // Restrict the scan to the range served by this tablet.
+    if (!key_bounds_->lower().empty() &&
+        (lower_doc_key.empty() || lower_doc_key < key_bounds_->lower())) {
+      lower_doc_key = key_bounds_->lower();
+    }
+    if (!key_bounds_->upper().empty() &&
+        (upper_doc_key.empty() || key_bounds_->upper() < upper_doc_key)) {
+      upper_doc_key = key_bounds_->upper();
+    }
+  }
+
   const KeyBytes row_key_encoded = lower_doc_key.Encode();
   const Slice row_key_encoded_as_slice = row_key_encoded.AsSlice();
 
+  // Scans across hash keys could read the whole tablet, so they should not push the blocks of
+  // other queries out of the block cache.
+  const auto query_id = is_fixed_point_get ? doc_spec.QueryId() : rocksdb::kLongScanQueryId;
   db_iter_ = CreateIntentAwareIterator(
-      db_, mode, row_key_encoded_as_slice, doc_spec.QueryId(), txn_op_context_, read_time_,
+      db_, mode, row_key_encoded_as_slice, query_id, txn_op_context_, read_time_,
       doc_spec.CreateFileFilter());
 
   db_iter_->SeekWithoutHt(row_key_encoded);
@@ -228,13 +254,13 @@ string DocRowwiseIterator::ToString() const {
 
 namespace {
 
-// Set primary key column values (hashed or range columns) in a QL row value map.
-CHECKED_STATUS SetQLPrimaryKeyColumnValues(const Schema& schema,
-                                           const size_t begin_index,
-                                           const size_t column_count,
-                                           const char* column_type,
-                                           const vector<PrimitiveValue>& values,
-                                           QLTableRow* table_row) {
+// Check that the primary key columns (hashed or range columns) found in the doc key match the
+// schema.
+CHECKED_STATUS CheckPrimaryKeyColumns(const Schema& schema,
+                                      const size_t begin_index,
+                                      const size_t column_count,
+                                      const char* column_type,
+                                      const vector<PrimitiveValue>& values) {
   if (values.size() != column_count) {
     return STATUS_SUBSTITUTE(Corruption, "$0 $1 primary key columns found but $2 expected",
                              values.size(), column_type, column_count);
@@ -245,6 +271,17 @@ CHECKED_STATUS SetQLPrimaryKeyColumnValues(const Schema& schema,
         "$0 primary key columns between positions $1 and $2 go beyond table columns $3",
         column_type, begin_index, begin_index + column_count - 1, schema.num_columns());
   }
+  return Status::OK();
+}
+
+// Set primary key column values (hashed or range columns) in a QL row value map.
+CHECKED_STATUS SetQLPrimaryKeyColumnValues(const Schema& schema,
+                                           const size_t begin_index,
+                                           const size_t column_count,
+                                           const char* column_type,
+                                           const vector<PrimitiveValue>& values,
+                                           QLTableRow* table_row) {
+  RETURN_NOT_OK(CheckPrimaryKeyColumns(schema, begin_index, column_count, column_type, values));
   for (size_t i = 0, j = begin_index; i < column_count; i++, j++) {
     const auto ql_type = schema.column(j).type();
     QLTableColumn& column = table_row->AllocColumn(schema.column_id(j));
@@ -253,6 +290,22 @@ CHECKED_STATUS SetQLPrimaryKeyColumnValues(const Schema& schema,
   return Status::OK();
 }
 
+// Set primary key column values (hashed or range columns) of a row in a column batch. Key
+// columns of the batch have the same indexes as in the schema.
+CHECKED_STATUS SetQLPrimaryKeyColumnValues(const Schema& schema,
+                                           const size_t begin_index,
+                                           const size_t column_count,
+                                           const char* column_type,
+                                           const vector<PrimitiveValue>& values,
+                                           const size_t row,
+                                           QLColumnBatch* batch) {
+  RETURN_NOT_OK(CheckPrimaryKeyColumns(schema, begin_index, column_count, column_type, values));
+  for (size_t i = 0, j = begin_index; i < column_count; i++, j++) {
+    PrimitiveValue::ToQLValuePB(values[i], schema.column(j).type(), batch->mutable_value(j, row));
+  }
+  return Status::OK();
+}
+
 } // namespace
 
 void DocRowwiseIterator::SkipRow() {
@@ -271,7 +324,7 @@ bool DocRowwiseIterator::IsNextStaticColumn() const {
   return schema_.has_statics() && row_key_.range_group().empty();
 }
 
-Status DocRowwiseIterator::DoNextRow(const Schema& projection, QLTableRow* table_row) {
+Status DocRowwiseIterator::CheckRowReady() const {
   if (!status_.ok()) {
     // An error happened in HasNext.
     return status_;
@@ -286,6 +339,11 @@ Status DocRowwiseIterator::DoNextRow(const Schema& projection, QLTableRow* table
   if (!row_ready_) {
     return STATUS(InternalError, "next row has not be prepared for reading");
   }
+  return Status::OK();
+}
+
+Status DocRowwiseIterator::DoNextRow(const Schema& projection, QLTableRow* table_row) {
+  RETURN_NOT_OK(CheckRowReady());
 
   // Populate the key column values from the doc key. The key column values in doc key were
   // written in the same order as in the table schema (see DocKeyFromQLKey). If the range columns
@@ -314,6 +372,35 @@ Status DocRowwiseIterator::DoNextRow(const Schema& projection, QLTableRow* table
   return Status::OK();
 }
 
+Status DocRowwiseIterator::NextRowBatch(const Schema& projection, QLColumnBatch* batch) {
+  const size_t num_key_columns = schema_.num_key_columns();
+  DCHECK_EQ(batch->num_columns(),
+            num_key_columns + projection.num_columns() - projection.num_key_columns());
+  while (!batch->full() && HasNext() && !IsNextStaticColumn()) {
+    RETURN_NOT_OK(CheckRowReady());
+
+    const size_t row = batch->AddRow();
+    RETURN_NOT_OK(SetQLPrimaryKeyColumnValues(
+        schema_, 0, schema_.num_hash_key_columns(),
+        "hash", row_key_.hashed_group(), row, batch));
+    RETURN_NOT_OK(SetQLPrimaryKeyColumnValues(
+        schema_, schema_.num_hash_key_columns(), schema_.num_range_key_columns(),
+        "range", row_key_.range_group(), row, batch));
+
+    size_t column_index = num_key_columns;
+    for (size_t i = projection.num_key_columns(); i < projection.num_columns(); i++) {
+      const SubDocument* column_value = row_.GetChild(PrimitiveValue(projection.column_id(i)));
+      if (column_value != nullptr) {
+        SubDocument::ToQLValuePB(
+            *column_value, projection.column(i).type(), batch->mutable_value(column_index, row));
+      }
+      ++column_index;
+    }
+    row_ready_ = false;
+  }
+  return Status::OK();
+}
+
 CHECKED_STATUS DocRowwiseIterator::GetNextReadSubDocKey(SubDocKey* sub_doc_key) const {
   if (db_iter_ == nullptr) {
     return STATUS(Corruption, "Iterator not initialized.");
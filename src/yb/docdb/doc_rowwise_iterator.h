@@ -26,6 +26,7 @@
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/subdocument.h"
 #include "yb/docdb/doc_ql_scanspec.h"
+#include "yb/docdb/key_bounds.h"
 #include "yb/docdb/value.h"
 #include "yb/util/status.h"
 #include "yb/util/pending_op_counter.h"
@@ -43,15 +44,18 @@ class DocRowwiseIterator : public common::QLRowwiseIteratorIf {
                      const TransactionOperationContextOpt& txn_op_context,
                      rocksdb::DB *db,
                      const ReadHybridTime& read_time,
-                     yb::util::PendingOperationCounter* pending_op_counter = nullptr);
+                     yb::util::PendingOperationCounter* pending_op_counter = nullptr,
+                     const KeyBounds* key_bounds = nullptr);
 
   DocRowwiseIterator(std::unique_ptr<Schema> projection,
                      const Schema &schema,
                      const TransactionOperationContextOpt& txn_op_context,
                      rocksdb::DB *db,
                      const ReadHybridTime& read_time,
-                     yb::util::PendingOperationCounter* pending_op_counter = nullptr)
-      : DocRowwiseIterator(*projection, schema, txn_op_context, db, read_time, pending_op_counter) {
+                     yb::util::PendingOperationCounter* pending_op_counter = nullptr,
+                     const KeyBounds* key_bounds = nullptr)
+      : DocRowwiseIterator(*projection, schema, txn_op_context, db, read_time, pending_op_counter,
+                           key_bounds) {
     projection_owner_ = std::move(projection);
   }
 
@@ -84,6 +88,11 @@ class DocRowwiseIterator : public common::QLRowwiseIteratorIf {
     return row_key_;
   }
 
+  // Read rows into the column batch, decoding values directly into the column vectors.
+  // Columns of the batch are the key columns of the table schema, followed by the non-key columns
+  // of the projection.
+  CHECKED_STATUS NextRowBatch(const Schema& projection, QLColumnBatch* batch) override;
+
   // Skip the current row.
   void SkipRow() override;
 
@@ -130,6 +139,9 @@ class DocRowwiseIterator : public common::QLRowwiseIteratorIf {
   // Read next row into a value map using the specified projection.
   CHECKED_STATUS DoNextRow(const Schema& projection, QLTableRow* table_row) override;
 
+  // Checks that the prepared row could be read.
+  CHECKED_STATUS CheckRowReady() const;
+
   const Schema& projection_;
   // Used to maintain ownership of projection_.
   // Separate field is used since ownership could be optional.
@@ -152,6 +164,9 @@ class DocRowwiseIterator : public common::QLRowwiseIteratorIf {
   bool has_bound_key_;
   DocKey bound_key_;
 
+  // Range of keys served by the tablet, rows outside of it are not returned. Could be null.
+  const KeyBounds* key_bounds_;
+
   std::unique_ptr<IntentAwareIterator> db_iter_;
 
   // We keep the "pending operation" counter incremented for the lifetime of this iterator so that
@@ -13,6 +13,7 @@
 
 #include "yb/docdb/docdb_compaction_filter.h"
 
+#include <algorithm>
 #include <memory>
 
 #include <glog/logging.h>
@@ -21,9 +22,22 @@
 #include "yb/rocksdb/util/string_util.h"
 
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_kv_util.h"
 #include "yb/docdb/docdb-internal.h"
 #include "yb/docdb/value.h"
 #include "yb/rocksutil/yb_rocksdb.h"
+#include "yb/util/flag_tags.h"
+
+DEFINE_bool(docdb_delete_expired_sst_files, true,
+            "Delete the oldest SST files of a table with a default TTL once all of their data has "
+            "expired, instead of removing the expired values one by one during compactions.");
+TAG_FLAG(docdb_delete_expired_sst_files, runtime);
+
+DEFINE_int32(docdb_sst_file_expiring_soon_percentage, 10,
+             "SST files whose data expires within this percentage of the table TTL are not "
+             "compacted together with newer files, so that they could be deleted as a whole.");
+TAG_FLAG(docdb_sst_file_expiring_soon_percentage, advanced);
+TAG_FLAG(docdb_sst_file_expiring_soon_percentage, runtime);
 
 using std::shared_ptr;
 using std::unique_ptr;
@@ -34,18 +48,23 @@ using rocksdb::VectorToString;
 namespace yb {
 namespace docdb {
 
+Status GetDocHybridTime(const rocksdb::UserBoundaryValues& values, DocHybridTime* out);
+Status GetValueTtlExpiration(const rocksdb::UserBoundaryValues& values, MicrosTime* out);
+
 // ------------------------------------------------------------------------------------------------
 
 DocDBCompactionFilter::DocDBCompactionFilter(HybridTime history_cutoff,
                                              ColumnIdsPtr deleted_cols,
                                              bool is_full_compaction,
-                                             MonoDelta table_ttl)
+                                             MonoDelta table_ttl,
+                                             const KeyBounds* key_bounds)
     : history_cutoff_(history_cutoff),
       is_full_compaction_(is_full_compaction),
       is_first_key_value_(true),
       filter_usage_logged_(false),
       table_ttl_(table_ttl),
-      deleted_cols_(deleted_cols) {
+      deleted_cols_(deleted_cols),
+      key_bounds_(key_bounds) {
 }
 
 DocDBCompactionFilter::~DocDBCompactionFilter() {
@@ -56,6 +75,11 @@ bool DocDBCompactionFilter::Filter(int level,
                                    const rocksdb::Slice& existing_value,
                                    std::string* new_value,
                                    bool* value_changed) const {
+  if (key_bounds_ && !key_bounds_->IsWithinBounds(key)) {
+    // Key belongs to the other half of a split tablet, its SST files are shared through hard links.
+    return true;
+  }
+
   if (!is_full_compaction_) {
     // By default, we only perform history garbage collection on full compactions
     // (or major compactions, in the HBase terminology).
@@ -214,9 +238,10 @@ const char* DocDBCompactionFilter::Name() const {
 // ------------------------------------------------------------------------------------------------
 
 DocDBCompactionFilterFactory::DocDBCompactionFilterFactory(
-    shared_ptr<HistoryRetentionPolicy> retention_policy)
+    shared_ptr<HistoryRetentionPolicy> retention_policy, const KeyBounds* key_bounds)
     :
-    retention_policy_(retention_policy) {
+    retention_policy_(retention_policy),
+    key_bounds_(key_bounds) {
 }
 
 DocDBCompactionFilterFactory::~DocDBCompactionFilterFactory() {
@@ -227,7 +252,100 @@ unique_ptr<CompactionFilter> DocDBCompactionFilterFactory::CreateCompactionFilte
   return unique_ptr<DocDBCompactionFilter>(
       new DocDBCompactionFilter(retention_policy_->GetHistoryCutoff(),
                                 retention_policy_->GetDeletedColumns(),
-                                context.is_full_compaction, retention_policy_->GetTableTTL()));
+                                context.is_full_compaction, retention_policy_->GetTableTTL(),
+                                key_bounds_));
+}
+
+namespace {
+
+// Compares the expiration of files against the table TTL and the history cutoff as of the creation
+// of the checker.
+class DocDBFileExpirationChecker : public rocksdb::FileExpirationChecker {
+ public:
+  DocDBFileExpirationChecker(MonoDelta table_ttl, HybridTime history_cutoff)
+      : ttl_micros_(table_ttl.ToMicroseconds()),
+        history_cutoff_(history_cutoff.GetPhysicalValueMicros()) {
+  }
+
+  rocksdb::FileExpiration GetFileExpiration(
+      const rocksdb::UserBoundaryValues& largest_user_values) override {
+    // Files written before value TTL expirations were recorded don't have this boundary value,
+    // and are never considered expired.
+    DocHybridTime max_write_time;
+    MicrosTime max_value_expiration;
+    if (!GetDocHybridTime(largest_user_values, &max_write_time).ok() ||
+        !GetValueTtlExpiration(largest_user_values, &max_value_expiration).ok()) {
+      return rocksdb::FileExpiration::kNotExpired;
+    }
+
+    constexpr auto kMaxMicros = std::numeric_limits<MicrosTime>::max();
+    const MicrosTime write_micros = max_write_time.hybrid_time().GetPhysicalValueMicros();
+    const MicrosTime expiration = std::max(
+        write_micros > kMaxMicros - ttl_micros_ ? kMaxMicros : write_micros + ttl_micros_,
+        max_value_expiration);
+
+    // Values are only removed when they have expired as of the history cutoff, so no read could
+    // see them anymore.
+    if (expiration < history_cutoff_) {
+      return rocksdb::FileExpiration::kExpired;
+    }
+    const MicrosTime window =
+        ttl_micros_ / 100 * std::max(FLAGS_docdb_sst_file_expiring_soon_percentage, 0);
+    if (expiration - history_cutoff_ < window) {
+      return rocksdb::FileExpiration::kExpiringSoon;
+    }
+    return rocksdb::FileExpiration::kNotExpired;
+  }
+
+ private:
+  const MicrosTime ttl_micros_;
+  const MicrosTime history_cutoff_;
+};
+
+}  // namespace
+
+unique_ptr<rocksdb::FileExpirationChecker>
+DocDBCompactionFilterFactory::CreateFileExpirationChecker() {
+  if (!FLAGS_docdb_delete_expired_sst_files) {
+    return nullptr;
+  }
+  const MonoDelta table_ttl = retention_policy_->GetTableTTL();
+  if (table_ttl.Equals(Value::kMaxTtl)) {
+    return nullptr;
+  }
+  return std::make_unique<DocDBFileExpirationChecker>(
+      table_ttl, retention_policy_->GetHistoryCutoff());
+}
+
+bool DocDBCompactionFilterFactory::GetSubcompactionBoundaries(
+    const rocksdb::Slice& smallest_user_key, const rocksdb::Slice& largest_user_key,
+    size_t max_boundaries, std::vector<std::string>* boundaries) {
+  // The compaction filter keeps state across the keys of a document, so a subcompaction must never
+  // start in the middle of one. Documents of hash partitioned tables never span hash codes, so we
+  // split at the hash code prefix. Range partitioned tables are not split.
+  constexpr size_t kHashPrefixSize = 1 + sizeof(DocKeyHash);
+  auto is_hashed = [](const rocksdb::Slice& key) {
+    return key.size() >= kHashPrefixSize && key[0] == static_cast<char>(ValueType::kUInt16Hash);
+  };
+  if (!is_hashed(smallest_user_key) || !is_hashed(largest_user_key)) {
+    return true;
+  }
+  const uint32_t first_hash = BigEndian::Load16(smallest_user_key.data() + 1);
+  const uint32_t last_hash = BigEndian::Load16(largest_user_key.data() + 1);
+  if (first_hash >= last_hash) {
+    return true;
+  }
+
+  // Split [first_hash, last_hash] into count + 1 parts of roughly the same number of hash codes.
+  const uint32_t num_hashes = last_hash - first_hash + 1;
+  const uint32_t count = std::min<uint32_t>(max_boundaries, num_hashes - 1);
+  for (uint32_t i = 1; i <= count; ++i) {
+    std::string boundary;
+    boundary.push_back(static_cast<char>(ValueType::kUInt16Hash));
+    AppendUInt16ToKey(first_hash + num_hashes * i / (count + 1), &boundary);
+    boundaries->push_back(std::move(boundary));
+  }
+  return true;
 }
 
 const char* DocDBCompactionFilterFactory::Name() const {
@@ -23,6 +23,7 @@
 #include "yb/common/schema.h"
 #include "yb/common/hybrid_time.h"
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/key_bounds.h"
 
 namespace yb {
 namespace docdb {
@@ -32,7 +33,8 @@ class DocDBCompactionFilter : public rocksdb::CompactionFilter {
   DocDBCompactionFilter(HybridTime history_cutoff,
                         ColumnIdsPtr deleted_cols,
                         bool is_full_compaction,
-                        MonoDelta table_ttl);
+                        MonoDelta table_ttl,
+                        const KeyBounds* key_bounds = nullptr);
 
   ~DocDBCompactionFilter() override;
   bool Filter(int level,
@@ -100,6 +102,9 @@ class DocDBCompactionFilter : public rocksdb::CompactionFilter {
   MonoDelta table_ttl_;
 
   ColumnIdsPtr deleted_cols_;
+
+  // Keys outside of these bounds belong to another tablet after a split, and are always removed.
+  const KeyBounds* key_bounds_;
 };
 
 // A strategy for deciding the history cutoff. We may implement this differently in production and
@@ -139,14 +144,20 @@ class FixedHybridTimeRetentionPolicy : public HistoryRetentionPolicy {
 
 class DocDBCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
  public:
-  explicit DocDBCompactionFilterFactory(std::shared_ptr<HistoryRetentionPolicy> retention_policy);
+  explicit DocDBCompactionFilterFactory(std::shared_ptr<HistoryRetentionPolicy> retention_policy,
+                                        const KeyBounds* key_bounds = nullptr);
   ~DocDBCompactionFilterFactory() override;
   std::unique_ptr<rocksdb::CompactionFilter> CreateCompactionFilter(
       const rocksdb::CompactionFilter::Context& context) override;
+  std::unique_ptr<rocksdb::FileExpirationChecker> CreateFileExpirationChecker() override;
+  bool GetSubcompactionBoundaries(
+      const rocksdb::Slice& smallest_user_key, const rocksdb::Slice& largest_user_key,
+      size_t max_boundaries, std::vector<std::string>* boundaries) override;
   const char* Name() const override;
 
  private:
   std::shared_ptr<HistoryRetentionPolicy> retention_policy_;
+  const KeyBounds* key_bounds_;
 };
 
 }  // namespace docdb
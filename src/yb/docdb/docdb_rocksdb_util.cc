@@ -13,6 +13,7 @@
 
 #include "yb/docdb/docdb_rocksdb_util.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "yb/common/transaction.h"
@@ -24,6 +25,7 @@
 #include "yb/rocksutil/yb_rocksdb.h"
 #include "yb/rocksutil/yb_rocksdb_logger.h"
 #include "yb/server/hybrid_clock.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/trace.h"
 
@@ -54,6 +56,13 @@ DEFINE_uint64(rocksdb_compaction_size_threshold_bytes, 2ULL * 1024 * 1024 * 1024
              "Threshold beyond which compaction is considered large.");
 DEFINE_uint64(rocksdb_max_file_size_for_compaction, 0,
              "Maximal allowed file size to participate in RocksDB compaction. 0 - unlimited.");
+DEFINE_int32(rocksdb_max_subcompactions, 4,
+             "Maximal number of subcompactions, each covering a range of hash codes, that a large "
+             "compaction is split into and run in parallel. 1 - do not split compactions.");
+TAG_FLAG(rocksdb_max_subcompactions, advanced);
+DEFINE_uint64(rocksdb_min_subcompaction_size_bytes, 1_GB,
+              "Minimal amount of input data for each subcompaction of a compaction.");
+TAG_FLAG(rocksdb_min_subcompaction_size_bytes, advanced);
 
 DEFINE_int64(db_block_size_bytes, 32_KB,
              "Size of RocksDB data block (in bytes).");
@@ -70,15 +79,33 @@ DEFINE_int64(db_min_keys_per_index_block, 100,
 DEFINE_int64(db_write_buffer_size, -1,
              "Size of RocksDB write buffer (in bytes). -1 to use default.");
 
+DEFINE_int64(db_memtable_huge_page_size_bytes, 0,
+             "If > 0, memtables allocate their blocks from huge pages of this size, which should "
+             "be the huge page size of the system, e.g. 2097152. Reserved huge pages are used if "
+             "there are any, transparent huge pages otherwise. 0 to use regular allocations. See "
+             "also arena_bind_huge_pages_to_local_numa_node.");
+TAG_FLAG(db_memtable_huge_page_size_bytes, advanced);
+
 DEFINE_bool(use_docdb_aware_bloom_filter, true,
             "Whether to use the DocDbAwareFilterPolicy for both bloom storage and seeks.");
 DEFINE_int32(max_nexts_to_avoid_seek, 8,
              "The number of next calls to try before doing resorting to do a rocksdb seek.");
 DEFINE_bool(trace_docdb_calls, false, "Whether we should trace calls into the docdb.");
+DEFINE_bool(docdb_long_scans_bypass_block_cache, false,
+            "Whether the blocks read by long scans, i.e. scans that are not limited to a single "
+            "hash key, are not added to the block cache. Otherwise they are only added to the "
+            "single touch part of the block cache.");
+TAG_FLAG(docdb_long_scans_bypass_block_cache, advanced);
+TAG_FLAG(docdb_long_scans_bypass_block_cache, runtime);
 // TODO(mli) - switch to true once it is safe (necessary installations are upgraded to a build which
 // supports multi-level index). Also update other places in tests where it is set to true
 // explicitly.
 DEFINE_bool(use_multi_level_index, false, "Whether to use multi-level data index.");
+DEFINE_uint64(db_index_blocks_prefetch_count, 8,
+              "When a forward scan moves to a lowest level index block of the multi-level data "
+              "index that is not in the block cache, up to this number of consecutive index blocks "
+              "are read with a single read and added to the block cache. 0 to disable.");
+TAG_FLAG(db_index_blocks_prefetch_count, advanced);
 
 DEFINE_uint64(initial_seqno, 1ULL << 50, "Initial seqno for new RocksDB instances.");
 
@@ -301,6 +328,9 @@ rocksdb::ReadOptions PrepareReadOptions(
     std::shared_ptr<rocksdb::ReadFileFilter> file_filter) {
   rocksdb::ReadOptions read_opts;
   read_opts.query_id = query_id;
+  if (query_id == rocksdb::kLongScanQueryId && FLAGS_docdb_long_scans_bypass_block_cache) {
+    read_opts.fill_cache = false;
+  }
   if (FLAGS_use_docdb_aware_bloom_filter &&
     bloom_filter_mode == BloomFilterMode::USE_BLOOM_FILTER) {
     DCHECK(user_key_for_filter);
@@ -340,7 +370,8 @@ unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
 void InitRocksDBOptions(
     rocksdb::Options* options, const string& tablet_id,
     const shared_ptr<rocksdb::Statistics>& statistics,
-    const tablet::TabletOptions& tablet_options) {
+    const tablet::TabletOptions& tablet_options,
+    size_t num_bloom_filter_range_components) {
   options->create_if_missing = true;
   options->disableDataSync = true;
   options->statistics = statistics;
@@ -352,6 +383,7 @@ void InitRocksDBOptions(
   if (FLAGS_db_write_buffer_size != -1) {
     options->write_buffer_size = FLAGS_db_write_buffer_size;
   }
+  options->memtable_huge_page_size = FLAGS_db_memtable_huge_page_size_bytes;
   options->listeners.insert(
       options->listeners.end(), tablet_options.listeners.begin(),
       tablet_options.listeners.end()); // Append listeners
@@ -360,6 +392,8 @@ void InitRocksDBOptions(
   rocksdb::BlockBasedTableOptions table_options;
   if (tablet_options.block_cache) {
     table_options.block_cache = tablet_options.block_cache;
+    // Data blocks evicted from the block cache are still found in the secondary tier.
+    table_options.block_cache_compressed = tablet_options.secondary_block_cache;
     // Cache the bloom filters in the block cache.
     table_options.cache_index_and_filter_blocks = true;
   } else {
@@ -370,11 +404,13 @@ void InitRocksDBOptions(
   table_options.filter_block_size = FLAGS_db_filter_block_size_bytes;
   table_options.index_block_size = FLAGS_db_index_block_size_bytes;
   table_options.min_keys_per_index_block = FLAGS_db_min_keys_per_index_block;
+  table_options.index_blocks_prefetch_count = FLAGS_db_index_blocks_prefetch_count;
 
   // Set our custom bloom filter that is docdb aware.
   if (FLAGS_use_docdb_aware_bloom_filter) {
     table_options.filter_policy.reset(new DocDbAwareFilterPolicy(
-        table_options.filter_block_size * 8, options->info_log.get()));
+        table_options.filter_block_size * 8, options->info_log.get(),
+        num_bloom_filter_range_components));
   }
 
   if (FLAGS_use_multi_level_index) {
@@ -411,6 +447,8 @@ void InitRocksDBOptions(
     options->compaction_options_universal.min_merge_width =
         FLAGS_rocksdb_universal_compaction_min_merge_width;
     options->compaction_size_threshold_bytes = FLAGS_rocksdb_compaction_size_threshold_bytes;
+    options->max_subcompactions = std::max(FLAGS_rocksdb_max_subcompactions, 1);
+    options->min_subcompaction_size = FLAGS_rocksdb_min_subcompaction_size_bytes;
     if (FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec > 0) {
       options->rate_limiter.reset(
           rocksdb::NewGenericRateLimiter(FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec));
@@ -119,11 +119,13 @@ std::unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
 
 // Initialize the RocksDB 'options' object for tablet identified by 'tablet_id'. The 'statistics'
 // object provided by the caller will be used by RocksDB to maintain the stats for the tablet
-// specified by 'tablet_id'.
+// specified by 'tablet_id'. 'num_bloom_filter_range_components' is the number of range components
+// that bloom filters take into account, see TableProperties.
 void InitRocksDBOptions(
     rocksdb::Options* options, const std::string& tablet_id,
     const std::shared_ptr<rocksdb::Statistics>& statistics,
-    const tablet::TabletOptions& tablet_options);
+    const tablet::TabletOptions& tablet_options,
+    size_t num_bloom_filter_range_components = 0);
 
 }  // namespace docdb
 }  // namespace yb
@@ -214,7 +214,8 @@ IntentAwareIterator::IntentAwareIterator(
   VLOG(4) << "IntentAwareIterator, read_time: " << read_time
           << ", txp_op_context: " << txn_op_context_;
   if (txn_op_context.is_initialized()) {
-    intent_iter_ = docdb::CreateRocksDBIterator(rocksdb,
+    auto* intents_db = txn_op_context->intents_db ? txn_op_context->intents_db : rocksdb;
+    intent_iter_ = docdb::CreateRocksDBIterator(intents_db,
                                                 docdb::BloomFilterMode::DONT_USE_BLOOM_FILTER,
                                                 boost::none,
                                                 rocksdb::kDefaultQueryId);
@@ -0,0 +1,92 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/key_bounds.h"
+
+#include "yb/common/partition.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+KeyBytes EncodedKey(DocKeyHash hash, const std::string& hashed_value) {
+  return DocKey(hash, { PrimitiveValue(hashed_value) }).Encode();
+}
+
+rocksdb::LiveFileMetaData FileMetaData(DocKeyHash first, DocKeyHash last, uint64_t size) {
+  rocksdb::LiveFileMetaData result;
+  result.smallest.key = EncodedKey(first, "a").data();
+  result.largest.key = EncodedKey(last, "z").data();
+  result.total_size = size;
+  return result;
+}
+
+} // namespace
+
+class KeyBoundsTest : public YBTest {
+};
+
+TEST_F(KeyBoundsTest, TestIsWithinBounds) {
+  KeyBounds bounds = KeyBounds::FromHashPartition(
+      PartitionSchema::EncodeMultiColumnHashValue(0x4000),
+      PartitionSchema::EncodeMultiColumnHashValue(0x8000));
+  ASSERT_FALSE(bounds.unbounded());
+
+  ASSERT_FALSE(bounds.IsWithinBounds(EncodedKey(0x3fff, "z").AsSlice()));
+  ASSERT_TRUE(bounds.IsWithinBounds(EncodedKey(0x4000, "").AsSlice()));
+  ASSERT_TRUE(bounds.IsWithinBounds(EncodedKey(0x4000, "a").AsSlice()));
+  ASSERT_TRUE(bounds.IsWithinBounds(EncodedKey(0x7fff, "z").AsSlice()));
+  ASSERT_FALSE(bounds.IsWithinBounds(EncodedKey(0x8000, "").AsSlice()));
+  ASSERT_FALSE(bounds.IsWithinBounds(EncodedKey(0x8000, "a").AsSlice()));
+
+  // First and last tablets are bounded from one side only.
+  KeyBounds first = KeyBounds::FromHashPartition(
+      "", PartitionSchema::EncodeMultiColumnHashValue(0x4000));
+  ASSERT_TRUE(first.IsWithinBounds(EncodedKey(0, "").AsSlice()));
+  ASSERT_FALSE(first.IsWithinBounds(EncodedKey(0x4000, "a").AsSlice()));
+  KeyBounds last = KeyBounds::FromHashPartition(
+      PartitionSchema::EncodeMultiColumnHashValue(0x8000), "");
+  ASSERT_FALSE(last.IsWithinBounds(EncodedKey(0x7fff, "a").AsSlice()));
+  ASSERT_TRUE(last.IsWithinBounds(EncodedKey(0xffff, "z").AsSlice()));
+
+  ASSERT_TRUE(KeyBounds::FromHashPartition("", "").unbounded());
+}
+
+TEST_F(KeyBoundsTest, TestGetSplitHashCode) {
+  // Single file with uniformly distributed data is split in the middle.
+  ASSERT_EQ(0x8000, ASSERT_RESULT(GetSplitHashCode({ FileMetaData(0, 0xffff, 1000) }, 0, 0x10000)));
+
+  // Most of the data is in the small file at the beginning of the range.
+  auto split = ASSERT_RESULT(GetSplitHashCode(
+      { FileMetaData(0, 0xffff, 1000), FileMetaData(0x1000, 0x1fff, 10000) }, 0, 0x10000));
+  ASSERT_GT(split, 0x1000);
+  ASSERT_LT(split, 0x2000);
+
+  // Only the part of the file within the range of the tablet is taken into account.
+  split = ASSERT_RESULT(GetSplitHashCode({ FileMetaData(0, 0xffff, 1000) }, 0x8000, 0x10000));
+  ASSERT_EQ(0xc000, split);
+
+  // Split key is always strictly inside the range.
+  ASSERT_EQ(0x8001, ASSERT_RESULT(GetSplitHashCode({ FileMetaData(0x8000, 0x8000, 1000) },
+                                                   0x8000, 0x9000)));
+
+  ASSERT_NOK(GetSplitHashCode({}, 0, 0x10000));
+  ASSERT_NOK(GetSplitHashCode({ FileMetaData(0, 0xffff, 1000) }, 0x8000, 0x8001));
+  ASSERT_NOK(GetSplitHashCode({ FileMetaData(0, 0x1000, 1000) }, 0x8000, 0x10000));
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,131 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/key_bounds.h"
+
+#include <algorithm>
+
+#include "yb/common/partition.h"
+#include "yb/docdb/value_type.h"
+#include "yb/util/format.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+// Hash code range of the doc keys that are prefixed by hash, i.e. [0, 0x10000).
+constexpr uint32_t kHashCodeLimit = PartitionSchema::kMaxPartitionKey + 1;
+
+DocKey HashBound(const std::string& partition_key) {
+  if (partition_key.size() != PartitionSchema::kPartitionKeySize) {
+    return DocKey();
+  }
+  return DocKey(PartitionSchema::DecodeMultiColumnHashValue(partition_key), {});
+}
+
+// Hash code of the given encoded key, or -1 if the key is not prefixed by a hash.
+int32_t HashCode(const std::string& key) {
+  if (key.size() < 1 + PartitionSchema::kPartitionKeySize ||
+      key[0] != static_cast<char>(ValueType::kUInt16Hash)) {
+    return -1;
+  }
+  return PartitionSchema::DecodeMultiColumnHashValue(
+      key.substr(1, PartitionSchema::kPartitionKeySize));
+}
+
+} // namespace
+
+KeyBounds::KeyBounds(DocKey lower, DocKey upper)
+    : lower_(std::move(lower)), upper_(std::move(upper)) {
+  if (!lower_.empty()) {
+    encoded_lower_ = lower_.Encode();
+  }
+  if (!upper_.empty()) {
+    encoded_upper_ = upper_.Encode();
+  }
+}
+
+KeyBounds KeyBounds::FromHashPartition(const std::string& partition_key_start,
+                                       const std::string& partition_key_end) {
+  return KeyBounds(HashBound(partition_key_start), HashBound(partition_key_end));
+}
+
+std::string KeyBounds::ToString() const {
+  return Format("[$0, $1)", lower_, upper_);
+}
+
+Result<uint16_t> GetSplitHashCode(const std::vector<rocksdb::LiveFileMetaData>& files,
+                                  uint32_t start, uint32_t end) {
+  end = std::min(end, kHashCodeLimit);
+  if (start + 1 >= end) {
+    return STATUS_FORMAT(IllegalState, "Hash range [$0, $1) is too small to split", start, end);
+  }
+
+  struct FileRange {
+    uint32_t first;
+    uint32_t last;
+    double size;
+  };
+  std::vector<FileRange> ranges;
+  double total_size = 0;
+  for (const auto& file : files) {
+    const int32_t first = HashCode(file.smallest.key);
+    const int32_t last = HashCode(file.largest.key);
+    if (first < 0 || last < 0) {
+      continue;
+    }
+    FileRange range = { std::max<uint32_t>(first, start), std::min<uint32_t>(last, end - 1),
+                        static_cast<double>(file.total_size) };
+    if (range.first > range.last) {
+      // File from the parent tablet that was not compacted yet, and has no data of this tablet.
+      continue;
+    }
+    // Only the part of the file within [start, end) belongs to this tablet.
+    range.size = range.size * (range.last - range.first + 1) / (last - first + 1);
+    total_size += range.size;
+    ranges.push_back(range);
+  }
+  if (total_size == 0) {
+    return STATUS_FORMAT(IllegalState, "No data in hash range [$0, $1)", start, end);
+  }
+
+  // Size of the data with hash codes less than the given one.
+  auto size_below = [&ranges](uint32_t hash_code) {
+    double result = 0;
+    for (const auto& range : ranges) {
+      if (hash_code > range.last) {
+        result += range.size;
+      } else if (hash_code > range.first) {
+        result += range.size * (hash_code - range.first) / (range.last - range.first + 1);
+      }
+    }
+    return result;
+  };
+
+  // Find the smallest hash code in (start, end) that has at least half of the data below it.
+  uint32_t lo = start + 1;
+  uint32_t hi = end - 1;
+  while (lo < hi) {
+    const uint32_t mid = lo + (hi - lo) / 2;
+    if (size_below(mid) * 2 >= total_size) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  return static_cast<uint16_t>(lo);
+}
+
+}  // namespace docdb
+}  // namespace yb
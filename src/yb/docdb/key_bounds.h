@@ -0,0 +1,80 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_KEY_BOUNDS_H
+#define YB_DOCDB_KEY_BOUNDS_H
+
+#include <string>
+#include <vector>
+
+#include "yb/docdb/doc_key.h"
+#include "yb/rocksdb/metadata.h"
+#include "yb/util/result.h"
+
+namespace yb {
+namespace docdb {
+
+// Range of document keys served by a tablet. A tablet that was split shares its SST files with the
+// other child tablet through hard links, so its RocksDB also contains keys outside of this range.
+// Such keys are skipped by reads and removed by compactions.
+class KeyBounds {
+ public:
+  // Unbounded.
+  KeyBounds() {}
+
+  // 'lower' is inclusive and 'upper' is exclusive. An empty key means no bound.
+  KeyBounds(DocKey lower, DocKey upper);
+
+  // Bounds of a tablet with the given hash partition. The lower bound is a doc key with the hash
+  // of 'partition_key_start' and no components, that is smaller than any doc key with this hash.
+  static KeyBounds FromHashPartition(const std::string& partition_key_start,
+                                     const std::string& partition_key_end);
+
+  const DocKey& lower() const {
+    return lower_;
+  }
+
+  const DocKey& upper() const {
+    return upper_;
+  }
+
+  bool unbounded() const {
+    return lower_.empty() && upper_.empty();
+  }
+
+  // Whether the given encoded RocksDB key (starting with an encoded doc key) is within bounds.
+  bool IsWithinBounds(const Slice& key) const {
+    return (encoded_lower_.size() == 0 || key.compare(encoded_lower_.AsSlice()) >= 0) &&
+           (encoded_upper_.size() == 0 || key.compare(encoded_upper_.AsSlice()) < 0);
+  }
+
+  std::string ToString() const;
+
+ private:
+  DocKey lower_;
+  DocKey upper_;
+  KeyBytes encoded_lower_;
+  KeyBytes encoded_upper_;
+};
+
+// Picks the hash code that splits the data of SST files with hash partitioned keys in
+// [start, end) into two halves. Each file is assumed to have its data evenly distributed between
+// the hash codes of its smallest and largest keys. Returns a hash code in (start, end), or
+// IllegalState if the data cannot be split.
+Result<uint16_t> GetSplitHashCode(const std::vector<rocksdb::LiveFileMetaData>& files,
+                                  uint32_t start, uint32_t end);
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif  // YB_DOCDB_KEY_BOUNDS_H
@@ -19,8 +19,8 @@
 namespace yb {
 namespace docdb {
 
-QLRocksDBStorage::QLRocksDBStorage(rocksdb::DB *rocksdb)
-    : rocksdb_(rocksdb) {
+QLRocksDBStorage::QLRocksDBStorage(rocksdb::DB *rocksdb, const KeyBounds* key_bounds)
+    : rocksdb_(rocksdb), key_bounds_(key_bounds) {
 
 }
 
@@ -31,7 +31,8 @@ CHECKED_STATUS QLRocksDBStorage::GetIterator(
     const TransactionOperationContextOpt& txn_op_context,
     const ReadHybridTime& read_time,
     std::unique_ptr<common::QLRowwiseIteratorIf> *iter) const {
-  iter->reset(new DocRowwiseIterator(projection, schema, txn_op_context, rocksdb_, read_time));
+  iter->reset(new DocRowwiseIterator(projection, schema, txn_op_context, rocksdb_, read_time,
+                                     nullptr /* pending_op_counter */, key_bounds_));
   return Status::OK();
 }
 
@@ -0,0 +1,83 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+#include "yb/docdb/shared_lock_manager.h"
+
+#include "yb/util/test_util.h"
+
+using namespace std::literals; // NOLINT
+
+DEFINE_int32(shared_lock_manager_bench_duration_ms, 1000,
+             "Duration of a single shared lock manager benchmark run, in milliseconds.");
+
+namespace yb {
+namespace docdb {
+
+class SharedLockManagerBench : public YBTest {
+ protected:
+  // Runs num_threads writers, each one locking its own row key with a strong intent and the
+  // shared table prefix with a weak intent, like a single row write does.
+  // Returns the number of lock batches taken per second.
+  double Run(int num_threads);
+
+  SharedLockManager lm_;
+};
+
+double SharedLockManagerBench::Run(int num_threads) {
+  std::atomic<bool> stop(false);
+  std::atomic<int64_t> total_ops(0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i != num_threads; ++i) {
+    threads.emplace_back([this, i, &stop, &total_ops] {
+      const std::string row_prefix = "table/row" + std::to_string(i) + "/";
+      int64_t ops = 0;
+      while (!stop.load(std::memory_order_acquire)) {
+        KeyToIntentTypeMap batch = {
+            {"table", IntentType::kWeakSnapshotWrite},
+            {row_prefix + std::to_string(ops % 16), IntentType::kStrongSnapshotWrite},
+        };
+        lm_.Lock(batch);
+        lm_.Unlock(batch);
+        ++ops;
+      }
+      total_ops += ops;
+    });
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(FLAGS_shared_lock_manager_bench_duration_ms * 1ms);
+  stop.store(true, std::memory_order_release);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return total_ops.load() / std::chrono::duration<double>(elapsed).count();
+}
+
+TEST_F(SharedLockManagerBench, WriterScaling) {
+  for (int num_threads = 1; num_threads <= 64; num_threads *= 2) {
+    auto ops_per_sec = Run(num_threads);
+    LOG(INFO) << "Writer threads: " << num_threads << ", lock batches/sec: " << ops_per_sec
+              << ", per thread: " << ops_per_sec / num_threads;
+  }
+}
+
+} // namespace docdb
+} // namespace yb
@@ -18,6 +18,7 @@
 #include <boost/range/adaptor/reversed.hpp>
 #include <glog/logging.h>
 
+#include "yb/gutil/atomicops.h"
 #include "yb/util/bytes_formatter.h"
 #include "yb/util/enums.h"
 #include "yb/util/logging.h"
@@ -88,6 +89,61 @@ std::array<LockState, kIntentTypeMapSize> MakeConflicts() {
 // https://docs.google.com/spreadsheets/d/1h8GosY5XnJvrsyjEqyuXdKYlwvfKIaqx_RyDQGd7rSc
 const std::array<LockState, kIntentTypeMapSize> kIntentConflicts = MakeConflicts();
 
+namespace {
+
+// Number of bits used for the holder counter of a single intent type in LockEntry::num_holding.
+constexpr size_t kIntentCounterBits = 10;
+constexpr uint64_t kIntentCounterMask = (1ULL << kIntentCounterBits) - 1;
+static_assert(kIntentCounterBits * kElementsInIntentType <= 64,
+              "Intent counters should fit into a single 64-bit word");
+
+// Number of fast path attempts made by a conflicting locker before it blocks on the condition
+// variable.
+constexpr int kMaxSpinIterations = 64;
+
+// IntentType values are not contiguous, so counters are placed in the order of kIntentTypeList.
+std::array<size_t, kIntentTypeMapSize> MakeCounterShifts() {
+  std::array<size_t, kIntentTypeMapSize> result;
+  result.fill(0);
+  size_t counter_idx = 0;
+  for (auto intent_type : kIntentTypeList) {
+    result[static_cast<size_t>(intent_type)] = counter_idx * kIntentCounterBits;
+    ++counter_idx;
+  }
+  return result;
+}
+
+const std::array<size_t, kIntentTypeMapSize> kCounterShifts = MakeCounterShifts();
+
+inline size_t CounterShift(size_t type_idx) {
+  return kCounterShifts[type_idx];
+}
+
+inline uint64_t HolderCount(uint64_t num_holding, size_t type_idx) {
+  return (num_holding >> CounterShift(type_idx)) & kIntentCounterMask;
+}
+
+std::array<uint64_t, kIntentTypeMapSize> MakeConflictMasks() {
+  std::array<uint64_t, kIntentTypeMapSize> result;
+  result.fill(0);
+  for (auto intent_type : kIntentTypeList) {
+    const size_t i = static_cast<size_t>(intent_type);
+    for (auto other_type : kIntentTypeList) {
+      const size_t j = static_cast<size_t>(other_type);
+      if (kIntentConflicts[i].test(j)) {
+        result[i] |= kIntentCounterMask << CounterShift(j);
+      }
+    }
+  }
+  return result;
+}
+
+// kIntentConflicts in the packed counter format. (num_holding & kIntentConflictMasks[i]) is
+// non-zero iff a lock that conflicts with intent type i is held.
+const std::array<uint64_t, kIntentTypeMapSize> kIntentConflictMasks = MakeConflictMasks();
+
+} // namespace
+
 bool SharedLockManager::VerifyState(const LockState& state) {
   LockState not_allowed;
   for (auto intent : kIntentTypeList) {
@@ -196,36 +252,63 @@ IntentType SharedLockManager::CombineIntents(const IntentType i1, const IntentTy
   FATAL_INVALID_ENUM_VALUE(IntentType, i1);
 }
 
+bool SharedLockManager::LockEntry::TryLock(size_t type_idx) {
+  const uint64_t conflicts = kIntentConflictMasks[type_idx];
+  const uint64_t increment = 1ULL << CounterShift(type_idx);
+  uint64_t old_value = num_holding.load();
+  for (;;) {
+    // A saturated counter is treated as a conflict, so the locker waits for one of the holders
+    // to leave.
+    if ((old_value & conflicts) != 0 || HolderCount(old_value, type_idx) == kIntentCounterMask) {
+      return false;
+    }
+    if (num_holding.compare_exchange_weak(old_value, old_value + increment)) {
+      return true;
+    }
+  }
+}
+
 void SharedLockManager::LockEntry::Lock(IntentType lock_type) {
-  // TODO(bojanserafimov): Implement CAS fast path. Only wait when CAS fails.
-  int type_idx = static_cast<size_t>(lock_type);
+  const size_t type_idx = static_cast<size_t>(lock_type);
+  for (int i = 0; i != kMaxSpinIterations; ++i) {
+    if (TryLock(type_idx)) {
+      return;
+    }
+    base::subtle::PauseCPU();
+  }
+
   std::unique_lock<std::mutex> lock(mutex);
-  auto& state = this->state;
-  cond_var.wait(lock, [&state, type_idx]() {
-    return (state & kIntentConflicts[type_idx]).none();
+  // num_waiters should be incremented before the predicate is checked, so an Unlock that races
+  // with us either sees the waiter or its update is seen by TryLock.
+  ++num_waiters;
+  cond_var.wait(lock, [this, type_idx]() {
+    return TryLock(type_idx);
   });
-  ++num_holding[type_idx];
-  state.set(type_idx);
+  --num_waiters;
 }
 
 void SharedLockManager::LockEntry::Unlock(IntentType lock_type) {
-  int type_idx = static_cast<int>(lock_type);
-  bool should_notify = false;
+  const size_t type_idx = static_cast<size_t>(lock_type);
+  const uint64_t old_value = num_holding.fetch_sub(1ULL << CounterShift(type_idx));
+  const uint64_t old_count = HolderCount(old_value, type_idx);
+  DCHECK_NE(old_count, 0U) << "Unlocking " << docdb::ToString(lock_type) << " that is not held";
+
+  // Notify only if it is possible that a waiting thread can now lock, i.e. the last holder of
+  // this type has left or the counter is no longer saturated.
+  if ((old_count != 1 && old_count != kIntentCounterMask) || num_waiters.load() == 0) {
+    return;
+  }
+
   {
+    // Waiter checks the predicate under the mutex, so taking it here guarantees that the waiter
+    // either observes the updated counters or is already blocked on the condition variable.
     std::lock_guard<std::mutex> lock(mutex);
-    num_holding[type_idx]--;
-    if (num_holding[type_idx] == 0) {
-      state.reset(type_idx);
-      should_notify = (state == Combine({})
-        || state == Combine({IntentType::kWeakSerializableRead})
-        || state == Combine({IntentType::kWeakSerializableWrite}));
-    }
   }
+  cond_var.notify_all();
+}
 
-  // Notify only if it is possible that a waiting thread can now lock
-  if (should_notify) {
-    cond_var.notify_all();
-  }
+SharedLockManager::LockStripe& SharedLockManager::StripeFor(const std::string& key) {
+  return stripes_[std::hash<std::string>()(key) % kNumStripes];
 }
 
 void SharedLockManager::Lock(const KeyToIntentTypeMap& key_to_intent_type) {
@@ -245,26 +328,33 @@ std::vector<SharedLockManager::LockEntry*> SharedLockManager::Reserve(
     const KeyToIntentTypeMap& key_to_intent_type) {
   std::vector<SharedLockManager::LockEntry*> reserved;
   reserved.reserve(key_to_intent_type.size());
-  {
-    std::lock_guard<std::mutex> lock(global_mutex_);
-    for (const auto& key_and_intent_type : key_to_intent_type) {
-      auto it = locks_.emplace(key_and_intent_type.first, std::make_unique<LockEntry>()).first;
-      it->second->num_using++;
-      reserved.push_back(&*it->second);
+  for (const auto& key_and_intent_type : key_to_intent_type) {
+    auto& stripe = StripeFor(key_and_intent_type.first);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    auto& entry = stripe.locks[key_and_intent_type.first];
+    if (!entry) {
+      entry = std::make_unique<LockEntry>();
     }
+    entry->num_using++;
+    reserved.push_back(entry.get());
   }
   return reserved;
 }
 
 void SharedLockManager::Unlock(const KeyToIntentTypeMap& key_to_intent_type) {
   TRACE("Unlocking a batch of $0 keys", key_to_intent_type.size());
-  std::lock_guard<std::mutex> lock(global_mutex_);
   for (const auto& key_and_intent_type : boost::adaptors::reverse(key_to_intent_type)) {
     VLOG(4) << "Unlocking " << docdb::ToString(key_and_intent_type.second) << ": "
             << util::FormatBytesAsStr(key_and_intent_type.first);
-    locks_[key_and_intent_type.first]->Unlock(key_and_intent_type.second);
+    auto& stripe = StripeFor(key_and_intent_type.first);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    auto it = stripe.locks.find(key_and_intent_type.first);
+    DCHECK(it != stripe.locks.end());
+    it->second->Unlock(key_and_intent_type.second);
+    if (--it->second->num_using == 0) {
+      stripe.locks.erase(it);
+    }
   }
-  Cleanup(key_to_intent_type);
 }
 
 void SharedLockManager::LockInTest(const string& key, IntentType intent_type) {
@@ -275,15 +365,5 @@ void SharedLockManager::UnlockInTest(const string& key, IntentType intent_type)
   Unlock({{key, intent_type}});
 }
 
-void SharedLockManager::Cleanup(const KeyToIntentTypeMap& key_to_intent_type) {
-  for (const auto& item : key_to_intent_type) {
-    auto it = locks_.find(item.first);
-    it->second->num_using--;
-    if (it->second->num_using == 0) {
-      locks_.erase(it);
-    }
-  }
-}
-
 }  // namespace docdb
 }  // namespace yb
@@ -14,6 +14,9 @@
 #ifndef YB_DOCDB_SHARED_LOCK_MANAGER_H
 #define YB_DOCDB_SHARED_LOCK_MANAGER_H
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
 #include <map>
 #include <mutex>
 #include <string>
@@ -22,6 +25,7 @@
 
 #include "yb/docdb/shared_lock_manager_fwd.h"
 #include "yb/docdb/lock_batch.h"
+#include "yb/gutil/port.h"
 #include "yb/gutil/spinlock.h"
 #include "yb/util/cross_thread_mutex.h"
 
@@ -57,43 +61,52 @@ class SharedLockManager {
 
  private:
 
+  // Number of independently locked partitions of the lock table. Keys are assigned to stripes by
+  // hash, so operations on different keys rarely contend on the same stripe mutex.
+  static constexpr size_t kNumStripes = 64;
+
   struct LockEntry {
-    // Taken only for short duration, with no blocking wait.
-    std::mutex mutex;
+    // Holder counters for each intent type, packed into a single word, a fixed number of bits
+    // per type. Uncontended lock and unlock are a single compare-and-swap on this word.
+    std::atomic<uint64_t> num_holding{0};
+
+    // Number of threads blocked in Lock on this entry. Unlock only touches the mutex and
+    // condition variable below when there are waiters.
+    std::atomic<size_t> num_waiters{0};
 
+    // Used only by threads that failed the fast path. Taken only for short duration.
+    std::mutex mutex;
     std::condition_variable cond_var;
 
-    // Refcounting for garbage collection. Can only be used while the global lock is held.
+    // Refcounting for garbage collection. Can only be used while the stripe lock is held.
     size_t num_using = 0;
 
-    // Number of holders for each type
-    std::array<size_t, kIntentTypeMapSize> num_holding;
-    LockState state;
-
     void Lock(IntentType lock_type);
 
     void Unlock(IntentType lock_type);
 
-    LockEntry() {
-      num_holding.fill(0);
-    }
+    // Try to acquire the lock without blocking. Returns false if a conflicting lock is held.
+    bool TryLock(size_t type_idx);
   };
 
   typedef std::unordered_map<std::string, std::unique_ptr<LockEntry>> LockEntryMap;
 
-  // Make sure the entries exist in the locks_ map and return pointers so we can access
-  // them without holding the global lock. Returns a vector with pointers in the same order
-  // as the keys in the batch.
-  std::vector<LockEntry*> Reserve(const KeyToIntentTypeMap& batch);
+  struct LockStripe {
+    // Should be taken only for very short duration, with no blocking wait.
+    std::mutex mutex;
+
+    // Can only be modified if the stripe mutex is held.
+    LockEntryMap locks;
+  } CACHELINE_ALIGNED;
 
-  // Update refcounts and maybe collect garbage.
-  void Cleanup(const KeyToIntentTypeMap& key_to_intent_type);
+  LockStripe& StripeFor(const std::string& key);
 
-  // The global mutex should be taken only for very short duration, with no blocking wait.
-  std::mutex global_mutex_;
+  // Make sure the entries exist in the lock table and return pointers so we can access
+  // them without holding the stripe locks. Returns a vector with pointers in the same order
+  // as the keys in the batch.
+  std::vector<LockEntry*> Reserve(const KeyToIntentTypeMap& batch);
 
-  // Can only be modified if the global mutex is held.
-  LockEntryMap locks_;
+  std::array<LockStripe, kNumStripes> stripes_;
 };
 
 extern const std::array<LockState, kIntentTypeMapSize> kIntentConflicts;
@@ -104,6 +104,9 @@ class Value {
   DocHybridTime intent_doc_ht_;
 };
 
+// Consume the intent doc hybrid time portion of the slice if it exists.
+CHECKED_STATUS DecodeIntentDocHT(rocksdb::Slice* slice, DocHybridTime* doc_ht);
+
 }  // namespace docdb
 }  // namespace yb
 
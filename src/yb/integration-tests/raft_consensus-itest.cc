@@ -1381,6 +1381,30 @@ TEST_F(RaftConsensusITest, TestAutomaticLeaderElection) {
   ASSERT_ALL_REPLICAS_AGREE(FLAGS_client_inserts_per_thread * kFinalNumReplicas);
 }
 
+// Checks that followers keep the leader when the heartbeats of idle tablets are batched.
+TEST_F(RaftConsensusITest, TestBatchedHeartbeats) {
+  vector<string> ts_flags = {
+      "--enable_multi_raft_heartbeat_batcher=true",
+      "--multi_raft_heartbeat_batch_window_ms=50"
+  };
+  ASSERT_NO_FATALS(BuildAndStart(ts_flags));
+
+  TServerDetails* leader;
+  ASSERT_OK(GetLeaderReplicaWithRetries(tablet_id_, &leader));
+  InsertTestRowsRemoteThread(0, FLAGS_client_inserts_per_thread,
+                             FLAGS_client_num_batches_per_thread,
+                             vector<CountDownLatch*>());
+
+  // Leave the tablet idle for many heartbeat periods. Followers would start an election if they
+  // did not get the batched heartbeats.
+  SleepFor(MonoDelta::FromSeconds(5));
+  TServerDetails* idle_leader;
+  ASSERT_OK(GetLeaderReplicaWithRetries(tablet_id_, &idle_leader));
+  ASSERT_EQ(leader->uuid(), idle_leader->uuid());
+
+  ASSERT_ALL_REPLICAS_AGREE(FLAGS_client_inserts_per_thread);
+}
+
 // Single-replica leader election test.
 TEST_F(RaftConsensusITest, TestAutomaticLeaderElectionOneReplica) {
   FLAGS_num_tablet_servers = 1;
@@ -73,6 +73,10 @@ constexpr QueryId kDefaultQueryId = 0;
 constexpr QueryId kInMultiTouchId = -1;
 // Query ids to represent values that should not be in any cache.
 constexpr QueryId kNoCacheQueryId = -2;
+// Query ids to represent values read by long scans. They are added to the single touch cache, and
+// the lookups of long scans never move values into the multi touch cache, so a long scan cannot
+// push out the values that other queries use repeatedly.
+constexpr QueryId kLongScanQueryId = -3;
 
 class Cache {
  public:
@@ -28,6 +28,8 @@
 #include <string>
 #include <vector>
 
+#include "yb/rocksdb/metadata.h"
+
 #include "yb/util/slice.h"
 
 namespace rocksdb {
@@ -43,6 +45,26 @@ struct CompactionFilterContext {
   bool is_manual_compaction;
 };
 
+// Whether all the data in an SST file has expired, as seen by the compaction filter.
+enum class FileExpiration {
+  kNotExpired,
+  // The data will expire soon. Compactions should avoid rewriting such files together with newer
+  // data, so that they could be dropped as a whole.
+  kExpiringSoon,
+  // Every key in the file would be removed by the compaction filter.
+  kExpired,
+};
+
+// Decides whether the data in SST files has expired, against the state (e.g. the history cutoff
+// and the TTL) captured once when the checker was created.
+class FileExpirationChecker {
+ public:
+  virtual ~FileExpirationChecker() {}
+
+  // Returns the expiration of the file with the given largest user boundary values.
+  virtual FileExpiration GetFileExpiration(const UserBoundaryValues& largest_user_values) = 0;
+};
+
 // CompactionFilter allows an application to modify/delete a key-value at
 // the time of compaction.
 
@@ -144,6 +166,25 @@ class CompactionFilterFactory {
   virtual std::unique_ptr<CompactionFilter> CreateCompactionFilter(
       const CompactionFilter::Context& context) = 0;
 
+  // Creates a checker for the expiration of files, used by the universal compaction picker to
+  // delete the oldest files that have expired without reading them. Only the oldest files are
+  // considered, so an expired file never hides older versions of its keys that are still live.
+  // Returns nullptr if no file could expire.
+  virtual std::unique_ptr<FileExpirationChecker> CreateFileExpirationChecker() {
+    return nullptr;
+  }
+
+  // Provides the user keys at which a compaction of the given key range could be split into
+  // subcompactions. Each subcompaction has its own compaction filter, so the keys that a filter
+  // has to see together must not be separated by a boundary. Returns false if the factory doesn't
+  // care, in which case the boundaries of the input files are used. Returning true with no
+  // boundaries prevents subcompactions.
+  virtual bool GetSubcompactionBoundaries(
+      const Slice& smallest_user_key, const Slice& largest_user_key, size_t max_boundaries,
+      std::vector<std::string>* boundaries) {
+    return false;
+  }
+
   // Returns a name that identifies this compaction filter factory.
   virtual const char* Name() const = 0;
 };
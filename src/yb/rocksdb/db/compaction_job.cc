@@ -30,6 +30,7 @@
 #include <inttypes.h>
 #include <algorithm>
 #include <functional>
+#include <limits>
 #include <vector>
 #include <memory>
 #include <list>
@@ -37,6 +38,7 @@
 #include <thread>
 #include <utility>
 
+#include "yb/rocksdb/compaction_filter.h"
 #include "yb/rocksdb/db/builder.h"
 #include "yb/rocksdb/db/db_iter.h"
 #include "yb/rocksdb/db/dbformat.h"
@@ -345,11 +347,20 @@ void CompactionJob::Prepare() {
     }
     MeasureTime(stats_, NUM_SUBCOMPACTIONS_SCHEDULED,
                 compact_->sub_compact_states.size());
+    if (c->output_level() == 0 && compact_->sub_compact_states.size() > 1) {
+      // The outputs form a single sorted run in level 0, that is identified by a reserved file
+      // number.
+      sorted_run_id_ = versions_->NewFileNumber();
+    }
   } else {
     compact_->sub_compact_states.emplace_back(c, nullptr, nullptr);
   }
 }
 
+// Number of boundaries requested from the compaction filter factory per subcompaction, so that
+// the ranges between them could be grouped into subcompactions of similar size.
+constexpr size_t kBoundariesPerSubcompaction = 8;
+
 struct RangeWithSize {
   Range range;
   uint64_t size;
@@ -408,15 +419,41 @@ void CompactionJob::GenSubcompactionBoundaries() {
     }
   }
 
-  std::sort(bounds.begin(), bounds.end(),
-    [cfd_comparator] (const Slice& a, const Slice& b) -> bool {
-      return cfd_comparator->Compare(ExtractUserKey(a), ExtractUserKey(b)) < 0;
-    });
-  // Remove duplicated entries from bounds
-  bounds.erase(std::unique(bounds.begin(), bounds.end(),
-    [cfd_comparator] (const Slice& a, const Slice& b) -> bool {
-      return cfd_comparator->Compare(ExtractUserKey(a), ExtractUserKey(b)) == 0;
-    }), bounds.end());
+  auto sort_bounds = [cfd_comparator, &bounds] {
+    std::sort(bounds.begin(), bounds.end(),
+      [cfd_comparator] (const Slice& a, const Slice& b) -> bool {
+        return cfd_comparator->Compare(ExtractUserKey(a), ExtractUserKey(b)) < 0;
+      });
+    // Remove duplicated entries from bounds
+    bounds.erase(std::unique(bounds.begin(), bounds.end(),
+      [cfd_comparator] (const Slice& a, const Slice& b) -> bool {
+        return cfd_comparator->Compare(ExtractUserKey(a), ExtractUserKey(b)) == 0;
+      }), bounds.end());
+  };
+  sort_bounds();
+
+  // The compaction filter factory could restrict where the key range is split. In that case only
+  // the smallest and largest keys of the inputs are kept, and the keys it provides are used in
+  // between.
+  auto* filter_factory = cfd->ioptions()->compaction_filter_factory;
+  std::vector<std::string> filter_boundaries;
+  if (filter_factory != nullptr && bounds.size() >= 2 &&
+      filter_factory->GetSubcompactionBoundaries(
+          ExtractUserKey(bounds.front()), ExtractUserKey(bounds.back()),
+          db_options_.max_subcompactions * kBoundariesPerSubcompaction, &filter_boundaries)) {
+    boundary_keys_.clear();
+    boundary_keys_.reserve(filter_boundaries.size());
+    for (const auto& user_key : filter_boundaries) {
+      boundary_keys_.push_back(InternalKey::MaxPossibleForUserKey(user_key).Encode().ToString());
+    }
+    const Slice smallest = bounds.front();
+    const Slice largest = bounds.back();
+    bounds.clear();
+    bounds.push_back(smallest);
+    bounds.insert(bounds.end(), boundary_keys_.begin(), boundary_keys_.end());
+    bounds.push_back(largest);
+    sort_bounds();
+  }
 
   // Combine consecutive pairs of boundaries into ranges with an approximate
   // size of data covered by keys in that range
@@ -439,9 +476,16 @@ void CompactionJob::GenSubcompactionBoundaries() {
 
   // Group the ranges into subcompactions
   const double min_file_fill_percent = 4.0 / 5;
-  uint64_t max_output_files = static_cast<uint64_t>(std::ceil(
-      sum / min_file_fill_percent /
-      cfd->GetCurrentMutableCFOptions()->MaxFileSizeForLevel(out_lvl)));
+  const uint64_t max_file_size = cfd->GetCurrentMutableCFOptions()->MaxFileSizeForLevel(out_lvl);
+  uint64_t max_output_files;
+  if (max_file_size == std::numeric_limits<uint64_t>::max()) {
+    // Output files are not split by size (universal compaction into level 0), so use the minimal
+    // amount of input data per subcompaction instead.
+    max_output_files = sum / std::max<uint64_t>(db_options_.min_subcompaction_size, 1);
+  } else {
+    max_output_files = static_cast<uint64_t>(std::ceil(
+        sum / min_file_fill_percent / max_file_size));
+  }
   uint64_t subcompactions =
       std::min({static_cast<uint64_t>(ranges.size()),
                 static_cast<uint64_t>(db_options_.max_subcompactions),
@@ -1016,6 +1060,7 @@ Status CompactionJob::OpenCompactionOutputFile(
   SubcompactionState::Output out;
   out.meta.fd =
       FileDescriptor(file_number, sub_compact->compaction->output_path_id(), 0, 0);
+  out.meta.sorted_run_id = sorted_run_id_;
   // Update sequence number boundaries for out.
   for (size_t level_idx = 0; level_idx < compact_->compaction->num_input_levels(); level_idx++) {
     for (FileMetaData *fmd : *compact_->compaction->inputs(level_idx) ) {
@@ -170,8 +170,13 @@ class CompactionJob {
   bool measure_io_stats_;
   // Stores the Slices that designate the boundaries for each subcompaction
   std::vector<Slice> boundaries_;
+  // Owns the keys provided by the compaction filter factory that boundaries_ could point to.
+  std::vector<std::string> boundary_keys_;
   // Stores the approx size of keys covered in the range of each subcompaction
   std::vector<uint64_t> sizes_;
+  // Id of the sorted run formed by the level 0 outputs of subcompactions, 0 if there is only one
+  // subcompaction. See FileMetaData::sorted_run_id.
+  uint64_t sorted_run_id_ = 0;
 };
 
 }  // namespace rocksdb
@@ -28,6 +28,7 @@
 
 #include <inttypes.h>
 
+#include <algorithm>
 #include <limits>
 #include <queue>
 #include <string>
@@ -1148,7 +1149,72 @@ bool LevelCompactionPicker::PickCompactionBySize(VersionStorageInfo* vstorage,
 bool UniversalCompactionPicker::NeedsCompaction(
     const VersionStorageInfo* vstorage) const {
   const int kLevel0 = 0;
-  return vstorage->CompactionScore(kLevel0) >= 1;
+  if (vstorage->CompactionScore(kLevel0) >= 1) {
+    return true;
+  }
+  const auto& level_files = vstorage->LevelFiles(kLevel0);
+  if (level_files.empty() || level_files.back()->being_compacted) {
+    return false;
+  }
+  auto expiration_checker = CreateOldestFilesExpirationChecker(*vstorage);
+  return expiration_checker != nullptr &&
+         expiration_checker->GetFileExpiration(level_files.back()->largest.user_values) ==
+             FileExpiration::kExpired;
+}
+
+std::unique_ptr<FileExpirationChecker>
+UniversalCompactionPicker::CreateOldestFilesExpirationChecker(
+    const VersionStorageInfo& vstorage) const {
+  if (ioptions_.compaction_filter_factory == nullptr) {
+    return nullptr;
+  }
+  // Files at other levels hold older data, dropping a level 0 file above them could expose
+  // the values it has overwritten.
+  for (int level = 1; level < vstorage.num_levels(); level++) {
+    if (vstorage.NumLevelFiles(level) != 0) {
+      return nullptr;
+    }
+  }
+  return ioptions_.compaction_filter_factory->CreateFileExpirationChecker();
+}
+
+Compaction* UniversalCompactionPicker::PickExpiredFilesDeletion(
+    const std::string& cf_name,
+    const MutableCFOptions& mutable_cf_options,
+    VersionStorageInfo* vstorage,
+    LogBuffer* log_buffer,
+    FileExpirationChecker* expiration_checker) {
+  const int kLevel0 = 0;
+  const std::vector<FileMetaData*>& level_files = vstorage->LevelFiles(kLevel0);
+
+  std::vector<CompactionInputFiles> inputs(1);
+  inputs[0].level = kLevel0;
+  // Only a contiguous run of the oldest files could be deleted, any newer file might be shadowing
+  // older versions of its keys.
+  for (auto ritr = level_files.rbegin(); ritr != level_files.rend(); ++ritr) {
+    auto* f = *ritr;
+    if (f->being_compacted ||
+        expiration_checker->GetFileExpiration(f->largest.user_values) !=
+            FileExpiration::kExpired) {
+      break;
+    }
+    inputs[0].files.push_back(f);
+    char tmp_fsize[16];
+    AppendHumanBytes(f->fd.GetTotalFileSize(), tmp_fsize, sizeof(tmp_fsize));
+    LOG_TO_BUFFER(log_buffer, "[%s] Universal: picking expired file %" PRIu64
+                              " with size %s for deletion",
+                  cf_name.c_str(), f->fd.GetNumber(), tmp_fsize);
+  }
+  if (inputs[0].files.empty()) {
+    return nullptr;
+  }
+
+  Compaction* c = new Compaction(
+      vstorage, mutable_cf_options, std::move(inputs), 0, 0, 0, 0,
+      kNoCompression, {}, /* is manual */ false, vstorage->CompactionScore(kLevel0),
+      /* is deletion compaction */ true, CompactionReason::kUniversalExpiredFiles);
+  level0_compactions_in_progress_.insert(c);
+  return c;
 }
 
 struct UniversalCompactionPicker::SortedRun {
@@ -1162,6 +1228,18 @@ struct UniversalCompactionPicker::SortedRun {
     assert(compensated_file_size > 0);
     // Allowed either one of level and file.
     assert((level != 0) != (file != nullptr));
+    if (file != nullptr) {
+      files.push_back(file);
+    }
+  }
+
+  // Adds a level 0 file that belongs to the same sorted run as `file`.
+  void AddSibling(FileMetaData* sibling) {
+    assert(level == 0 && file->IsSameSortedRun(*sibling));
+    files.push_back(sibling);
+    size += sibling->fd.GetTotalFileSize();
+    compensated_file_size += sibling->compensated_file_size;
+    being_compacted = being_compacted || sibling->being_compacted;
   }
 
   void Dump(char* out_buf, size_t out_buf_size,
@@ -1175,6 +1253,9 @@ struct UniversalCompactionPicker::SortedRun {
   // `file` Will be null for level > 0. For level = 0, the sorted run is
   // for this file.
   FileMetaData* file;
+  // For level = 0, `file` followed by the other outputs of the compaction that wrote it, if that
+  // compaction was split into subcompactions. Empty for level > 0.
+  std::vector<FileMetaData*> files;
   // For level > 0, `size` and `compensated_file_size` are sum of sizes all
   // files in the level. `being_compacted` should be the same for all files
   // in a non-zero level. Use the value here.
@@ -1188,13 +1269,18 @@ void UniversalCompactionPicker::SortedRun::Dump(char* out_buf,
                                                 bool print_path) const {
   if (level == 0) {
     assert(file != nullptr);
+    int written;
     if (file->fd.GetPathId() == 0 || !print_path) {
-      snprintf(out_buf, out_buf_size, "file %" PRIu64, file->fd.GetNumber());
+      written = snprintf(out_buf, out_buf_size, "file %" PRIu64, file->fd.GetNumber());
     } else {
-      snprintf(out_buf, out_buf_size, "file %" PRIu64
-                                      "(path "
-                                      "%" PRIu32 ")",
-               file->fd.GetNumber(), file->fd.GetPathId());
+      written = snprintf(out_buf, out_buf_size, "file %" PRIu64
+                                                "(path "
+                                                "%" PRIu32 ")",
+                         file->fd.GetNumber(), file->fd.GetPathId());
+    }
+    if (files.size() > 1 && written >= 0 && static_cast<size_t>(written) < out_buf_size) {
+      snprintf(out_buf + written, out_buf_size - written, " (+%" ROCKSDB_PRIszt " siblings)",
+               files.size() - 1);
     }
   } else {
     snprintf(out_buf, out_buf_size, "level %d", level);
@@ -1208,9 +1294,9 @@ void UniversalCompactionPicker::SortedRun::DumpSizeInfo(
     snprintf(out_buf, out_buf_size,
              "file %" PRIu64 "[%" ROCKSDB_PRIszt
              "] "
-             "with size %" PRIu64 " (compensated size %" PRIu64 ")",
-             file->fd.GetNumber(), sorted_run_count, file->fd.GetTotalFileSize(),
-             file->compensated_file_size);
+             "with size %" PRIu64 " (compensated size %" PRIu64 ")"
+             " in %" ROCKSDB_PRIszt " file(s)",
+             file->fd.GetNumber(), sorted_run_count, size, compensated_file_size, files.size());
   } else {
     snprintf(out_buf, out_buf_size,
              "level %d[%" ROCKSDB_PRIszt
@@ -1225,10 +1311,20 @@ std::vector<std::vector<UniversalCompactionPicker::SortedRun>>
                                                    const ImmutableCFOptions& ioptions,
                                                    uint64_t max_file_size) {
   std::vector<std::vector<SortedRun>> ret(1);
+  // Outputs of a compaction that was split into subcompactions are adjacent, and are collected
+  // into one sorted run, so they are always compacted together.
+  std::vector<SortedRun> level0_runs;
   for (FileMetaData* f : vstorage.LevelFiles(0)) {
-    if (f->fd.GetTotalFileSize() <= max_file_size) {
-      ret.back().emplace_back(0, f, f->fd.GetTotalFileSize(), f->compensated_file_size,
+    if (!level0_runs.empty() && level0_runs.back().file->IsSameSortedRun(*f)) {
+      level0_runs.back().AddSibling(f);
+    } else {
+      level0_runs.emplace_back(0, f, f->fd.GetTotalFileSize(), f->compensated_file_size,
           f->being_compacted);
+    }
+  }
+  for (auto& run : level0_runs) {
+    if (run.size <= max_file_size) {
+      ret.back().push_back(std::move(run));
     // If last sequence is empty it means that there are multiple too-large-to-compact files in
     // a row. So we just don't start new sequence in this case.
     } else if (!ret.back().empty()) {
@@ -1353,11 +1449,43 @@ Compaction* UniversalCompactionPicker::PickCompaction(
     const MutableCFOptions& mutable_cf_options,
     VersionStorageInfo* vstorage,
     LogBuffer* log_buffer) {
+  // The checker captures the expiration state once for all the files checked by this pick.
+  auto expiration_checker = CreateOldestFilesExpirationChecker(*vstorage);
+  if (expiration_checker != nullptr) {
+    Compaction* deletion = PickExpiredFilesDeletion(
+        cf_name, mutable_cf_options, vstorage, log_buffer, expiration_checker.get());
+    if (deletion != nullptr) {
+      return deletion;
+    }
+  }
+
   std::vector<std::vector<SortedRun>> sorted_runs = CalculateSortedRuns(
       *vstorage,
       ioptions_,
       mutable_cf_options.max_file_size_for_compaction);
 
+  // Leave the oldest files that are about to expire alone. Compacting them with newer files would
+  // only rewrite data that is going to be dropped, and the output could not be deleted as a whole.
+  if (expiration_checker != nullptr && !sorted_runs.empty()) {
+    auto& oldest_block = sorted_runs.back();
+    auto is_expiring_file = [&expiration_checker](FileMetaData* f) {
+      return expiration_checker->GetFileExpiration(f->largest.user_values) !=
+             FileExpiration::kNotExpired;
+    };
+    auto is_expiring = [&is_expiring_file](const SortedRun& run) {
+      return !run.files.empty() &&
+             std::all_of(run.files.begin(), run.files.end(), is_expiring_file);
+    };
+    while (!oldest_block.empty() && is_expiring(oldest_block.back())) {
+      RDEBUG(ioptions_.info_log, "[%s] Universal: skipping expiring file %" PRIu64 "\n",
+             cf_name.c_str(), oldest_block.back().file->fd.GetNumber());
+      oldest_block.pop_back();
+    }
+    if (oldest_block.empty()) {
+      sorted_runs.pop_back();
+    }
+  }
+
   for (const auto& block : sorted_runs) {
     Compaction* result = DoPickCompaction(cf_name, mutable_cf_options, vstorage, log_buffer, block);
     if (result != nullptr) {
@@ -1453,14 +1581,20 @@ Compaction* UniversalCompactionPicker::DoPickCompaction(
 
   size_t level_index = 0U;
   if (c->start_level() == 0) {
+    const FileMetaData* prev = nullptr;
     for (auto f : *c->inputs(0)) {
       DCHECK_LE(f->smallest.seqno, f->largest.seqno);
       if (is_first) {
         is_first = false;
+        prev_smallest_seqno = f->smallest.seqno;
+      } else if (prev->IsSameSortedRun(*f)) {
+        // Files of one sorted run share their seqno range, except for zeroed out seqnos.
+        prev_smallest_seqno = std::min(prev_smallest_seqno, f->smallest.seqno);
       } else {
         DCHECK_GT(prev_smallest_seqno, f->largest.seqno);
+        prev_smallest_seqno = f->smallest.seqno;
       }
-      prev_smallest_seqno = f->smallest.seqno;
+      prev = f;
     }
     level_index = 1U;
   }
@@ -1688,8 +1822,8 @@ Compaction* UniversalCompactionPicker::PickCompactionUniversalReadAmp(
   for (size_t i = start_index; i < first_index_after; i++) {
     auto& picking_sr = sorted_runs[i];
     if (picking_sr.level == 0) {
-      FileMetaData* picking_file = picking_sr.file;
-      inputs[0].files.push_back(picking_file);
+      inputs[0].files.insert(
+          inputs[0].files.end(), picking_sr.files.begin(), picking_sr.files.end());
     } else {
       auto& files = inputs[picking_sr.level - start_level].files;
       for (auto* f : vstorage->LevelFiles(picking_sr.level)) {
@@ -1814,8 +1948,8 @@ Compaction* UniversalCompactionPicker::PickCompactionUniversalSizeAmp(
   for (size_t loop = start_index; loop < sorted_runs.size(); loop++) {
     auto& picking_sr = sorted_runs[loop];
     if (picking_sr.level == 0) {
-      FileMetaData* f = picking_sr.file;
-      inputs[0].files.push_back(f);
+      inputs[0].files.insert(
+          inputs[0].files.end(), picking_sr.files.begin(), picking_sr.files.end());
     } else {
       auto& files = inputs[picking_sr.level - start_level].files;
       for (auto* f : vstorage->LevelFiles(picking_sr.level)) {
@@ -32,6 +32,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include "yb/rocksdb/compaction_filter.h"
 #include "yb/rocksdb/db/compaction.h"
 #include "yb/rocksdb/db/version_set.h"
 #include "yb/rocksdb/env.h"
@@ -266,6 +267,18 @@ class UniversalCompactionPicker : public CompactionPicker {
       LogBuffer* log_buffer,
       const std::vector<SortedRun>& sorted_runs);
 
+  // Pick the oldest files that have expired according to the given checker, and could be deleted
+  // without being read.
+  Compaction* PickExpiredFilesDeletion(
+      const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+      VersionStorageInfo* vstorage, LogBuffer* log_buffer,
+      FileExpirationChecker* expiration_checker);
+
+  // Returns a checker for the expiration of level 0 files from the compaction filter factory, or
+  // nullptr if level 0 files are not the oldest data, i.e. when other levels are not empty.
+  std::unique_ptr<FileExpirationChecker> CreateOldestFilesExpirationChecker(
+      const VersionStorageInfo& vstorage) const;
+
   // Pick Universal compaction to limit read amplification
   Compaction* PickCompactionUniversalReadAmp(
       const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
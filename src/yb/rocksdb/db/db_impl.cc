@@ -3101,8 +3101,8 @@ Status DBImpl::BackgroundCompaction(bool* made_progress,
     // file if there is alive snapshot pointing to it
     assert(c->num_input_files(1) == 0);
     assert(c->level() == 0);
-    assert(c->column_family_data()->ioptions()->compaction_style ==
-           kCompactionStyleFIFO);
+    assert(c->column_family_data()->ioptions()->compaction_style == kCompactionStyleFIFO ||
+           c->column_family_data()->ioptions()->compaction_style == kCompactionStyleUniversal);
 
     compaction_job_stats.num_input_files = c->num_input_files(0);
 
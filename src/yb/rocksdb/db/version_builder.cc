@@ -46,12 +46,21 @@
 namespace rocksdb {
 
 bool NewestFirstBySeqNo(FileMetaData* a, FileMetaData* b) {
-  if (a->smallest.seqno != b->smallest.seqno) {
-    return a->smallest.seqno > b->smallest.seqno;
-  }
+  // Files of one sorted run share the largest seqno of the compaction inputs, but their smallest
+  // seqnos could differ, when seqnos of some of them were zeroed out at the bottommost level.
   if (a->largest.seqno != b->largest.seqno) {
     return a->largest.seqno > b->largest.seqno;
   }
+  if (!a->IsSameSortedRun(*b) && a->smallest.seqno != b->smallest.seqno) {
+    return a->smallest.seqno > b->smallest.seqno;
+  }
+  // Keep the files of one sorted run together, their id is a file number reserved before they were
+  // written.
+  const uint64_t a_run = a->sorted_run_id != 0 ? a->sorted_run_id : a->fd.GetNumber();
+  const uint64_t b_run = b->sorted_run_id != 0 ? b->sorted_run_id : b->fd.GetNumber();
+  if (a_run != b_run) {
+    return a_run > b_run;
+  }
   // Break ties by file number
   return a->fd.GetNumber() > b->fd.GetNumber();
 }
@@ -153,7 +162,9 @@ class VersionBuilder::Rep {
           assert(f1->largest.seqno > f2->largest.seqno ||
                  // We can have multiple files with seqno = 0 as a result of
                  // using DB::AddFile()
-                 (f1->largest.seqno == 0 && f2->largest.seqno == 0));
+                 (f1->largest.seqno == 0 && f2->largest.seqno == 0) ||
+                 // Or multiple outputs of a compaction split into subcompactions.
+                 f1->IsSameSortedRun(*f2));
         } else {
           assert(level_nonzero_cmp_(f1, f2));
 
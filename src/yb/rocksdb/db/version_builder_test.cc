@@ -278,6 +278,51 @@ TEST_F(VersionBuilderTest, ApplyMultipleAndSaveTo) {
   UnrefFilesInVersion(&new_vstorage);
 }
 
+// Outputs of a compaction split into subcompactions form one sorted run, even when their smallest
+// seqnos differ.
+TEST_F(VersionBuilderTest, ApplySortedRunAndSaveTo) {
+  UpdateVersionStorageInfo();
+
+  auto make_file = [this](uint64_t number, const char* smallest_key, const char* largest_key,
+                          SequenceNumber smallest_seqno, SequenceNumber largest_seqno,
+                          uint64_t sorted_run_id) {
+    FileMetaData f;
+    f.fd = FileDescriptor(number, 0, 100U, 30U);
+    f.smallest = GetBoundaryValues(smallest_key, smallest_seqno, smallest_seqno);
+    f.largest = GetBoundaryValues(largest_key, largest_seqno, largest_seqno);
+    f.sorted_run_id = sorted_run_id;
+    return f;
+  };
+
+  VersionEdit version_edit;
+  version_edit.AddFile(0, make_file(5, "100", "900", 100U, 200U, 0));
+  // Seqnos of the first output were zeroed out.
+  version_edit.AddFile(0, make_file(10, "100", "499", 0U, 300U, 9));
+  version_edit.AddFile(0, make_file(11, "500", "900", 250U, 300U, 9));
+  version_edit.AddFile(0, make_file(20, "100", "900", 400U, 500U, 0));
+
+  EnvOptions env_options;
+
+  VersionBuilder version_builder(env_options, nullptr, &vstorage_);
+
+  VersionStorageInfo new_vstorage(icmp_, ucmp_, options_.num_levels,
+                                  kCompactionStyleLevel, nullptr);
+  version_builder.Apply(&version_edit);
+  version_builder.SaveTo(&new_vstorage);
+
+  const auto& files = new_vstorage.LevelFiles(0);
+  ASSERT_EQ(4, files.size());
+  ASSERT_EQ(20, files[0]->fd.GetNumber());
+  ASSERT_EQ(11, files[1]->fd.GetNumber());
+  ASSERT_EQ(10, files[2]->fd.GetNumber());
+  ASSERT_EQ(5, files[3]->fd.GetNumber());
+  ASSERT_TRUE(files[1]->IsSameSortedRun(*files[2]));
+  ASSERT_FALSE(files[0]->IsSameSortedRun(*files[1]));
+  ASSERT_FALSE(files[2]->IsSameSortedRun(*files[3]));
+
+  UnrefFilesInVersion(&new_vstorage);
+}
+
 TEST_F(VersionBuilderTest, ApplyDeleteAndSaveTo) {
   UpdateVersionStorageInfo();
 
@@ -201,6 +201,9 @@ bool VersionEdit::EncodeTo(VersionEditPB* dst) const {
     if (f.imported) {
       new_file.set_imported(true);
     }
+    if (f.sorted_run_id != 0) {
+      new_file.set_sorted_run_id(f.sorted_run_id);
+    }
   }
 
   // 0 is default and does not need to be explicitly written
@@ -283,6 +286,7 @@ Status VersionEdit::DecodeFrom(BoundaryValuesExtractor* extractor, const Slice&
     meta.marked_for_compaction = source.marked_for_compaction();
     max_level_ = std::max(max_level_, level);
     meta.imported = source.imported();
+    meta.sorted_run_id = source.sorted_run_id();
   }
 
   column_family_ = pb.column_family();
@@ -124,6 +124,11 @@ struct FileMetaData {
   bool marked_for_compaction;  // True if client asked us nicely to compact this
                                // file.
 
+  // Level 0 files written by the subcompactions of one compaction have disjoint key ranges and
+  // together form a single sorted run. They share this id, which is a file number reserved by the
+  // compaction. 0 if the file is a sorted run by itself.
+  uint64_t sorted_run_id = 0;
+
   FileMetaData();
 
   // REQUIRED: Keys must be given to the function in sorted order (it expects
@@ -132,6 +137,11 @@ struct FileMetaData {
 
   // Update all boundaries except key.
   void UpdateBoundariesExceptKey(const FileBoundaryValuesBase& source, UpdateBoundariesType type);
+
+  // Whether this file and `other` were written by the subcompactions of one compaction.
+  bool IsSameSortedRun(const FileMetaData& other) const {
+    return sorted_run_id != 0 && sorted_run_id == other.sorted_run_id;
+  }
 };
 
 class VersionEdit {
@@ -197,6 +207,7 @@ class VersionEdit {
     nf.largest = f.largest;
     nf.marked_for_compaction = f.marked_for_compaction;
     nf.imported = f.imported;
+    nf.sorted_run_id = f.sorted_run_id;
     new_files_.emplace_back(level, std::move(nf));
   }
 
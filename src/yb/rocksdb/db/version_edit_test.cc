@@ -123,6 +123,31 @@ TEST_F(VersionEditTest, EncodeDecodeNewFile4) {
   ASSERT_EQ(0, new_files[2].second.fd.GetPathId());
 }
 
+TEST_F(VersionEditTest, EncodeDecodeSortedRunId) {
+  VersionEdit edit;
+  for (uint64_t i = 0; i != 2; ++i) {
+    FileMetaData f;
+    f.fd = FileDescriptor(300 + i, 0, 100, 30);
+    f.smallest = MakeFileBoundaryValues("foo", kBig + 500, kTypeValue);
+    f.largest = MakeFileBoundaryValues("zoo", kBig + 600, kTypeDeletion);
+    f.sorted_run_id = i == 0 ? 0 : 299;
+    edit.AddFile(0, f);
+  }
+
+  SetupVersionEdit(&edit);
+  TestEncodeDecode(edit);
+
+  auto extractor = test::MakeBoundaryValuesExtractor();
+  std::string encoded;
+  edit.AppendEncodedTo(&encoded);
+  VersionEdit parsed;
+  Status s = parsed.DecodeFrom(extractor.get(), encoded);
+  ASSERT_TRUE(s.ok()) << s.ToString();
+  auto& new_files = parsed.GetNewFiles();
+  ASSERT_EQ(0, new_files[0].second.sorted_run_id);
+  ASSERT_EQ(299, new_files[1].second.sorted_run_id);
+}
+
 TEST_F(VersionEditTest, ForwardCompatibleNewFile4) {
   static const uint64_t kBig = 1ull << 50;
   VersionEdit edit;
@@ -1236,10 +1236,14 @@ void VersionStorageInfo::ComputeCompactionScore(
       // overwrites/deletions).
       int num_sorted_runs = 0;
       uint64_t total_size = 0;
+      const FileMetaData* prev = nullptr;
       for (auto* f : files_[level]) {
         if (!f->being_compacted) {
           total_size += f->compensated_file_size;
-          num_sorted_runs++;
+          if (prev == nullptr || !prev->IsSameSortedRun(*f)) {
+            num_sorted_runs++;
+          }
+          prev = f;
         }
       }
       if (compaction_style_ == kCompactionStyleUniversal) {
@@ -1873,14 +1877,13 @@ void VersionStorageInfo::CalculateBaseBytes(const ImmutableCFOptions& ioptions,
   // Special logic to set number of sorted runs.
   // It is to match the previous behavior when all files are in L0.
   int num_l0_count = 0;
-  if (options.max_file_size_for_compaction == std::numeric_limits<uint64_t>::max()) {
-    num_l0_count = static_cast<int>(files_[0].size());
-  } else {
-    for (const auto& file : files_[0]) {
-      if (file->fd.GetTotalFileSize() <= options.max_file_size_for_compaction) {
-        ++num_l0_count;
-      }
+  const FileMetaData* prev = nullptr;
+  for (const auto& file : files_[0]) {
+    if (file->fd.GetTotalFileSize() <= options.max_file_size_for_compaction &&
+        (prev == nullptr || !prev->IsSameSortedRun(*file))) {
+      ++num_l0_count;
     }
+    prev = file;
   }
   if (compaction_style_ == kCompactionStyleUniversal) {
     // For universal compaction, we use level0 score to indicate
@@ -2791,6 +2794,24 @@ Status VersionSet::Import(const std::string& source_dir,
   }
   std::vector<FileMetaData> files;
   std::vector<std::pair<SequenceNumber, SequenceNumber>> segments;
+  // Files of one sorted run could have overlapping seqno ranges, so they are checked as a single
+  // segment covering all of them. Ids of imported and live files are not related.
+  typedef std::unordered_map<uint64_t, size_t> SortedRunSegments;
+  SortedRunSegments imported_sorted_runs, live_sorted_runs;
+  auto add_segment = [&segments](SequenceNumber smallest, SequenceNumber largest,
+                                 uint64_t sorted_run_id, SortedRunSegments* sorted_runs) {
+    if (sorted_run_id != 0) {
+      auto it = sorted_runs->find(sorted_run_id);
+      if (it != sorted_runs->end()) {
+        auto& segment = segments[it->second];
+        segment.first = std::min(segment.first, smallest);
+        segment.second = std::max(segment.second, largest);
+        return;
+      }
+      sorted_runs->emplace(sorted_run_id, segments.size());
+    }
+    segments.emplace_back(smallest, largest);
+  };
   for (;;) {
     status = manifest_reader.Next();
     if (!status.ok()) {
@@ -2812,7 +2833,8 @@ Status VersionSet::Import(const std::string& source_dir,
                              seqno);
       }
       files.push_back(filemeta);
-      segments.emplace_back(filemeta.smallest.seqno, filemeta.largest.seqno);
+      add_segment(filemeta.smallest.seqno, filemeta.largest.seqno, filemeta.sorted_run_id,
+                  &imported_sorted_runs);
     }
   }
   if (!status.IsEndOfFile()) {
@@ -2826,7 +2848,7 @@ Status VersionSet::Import(const std::string& source_dir,
   std::vector<LiveFileMetaData> live_files;
   GetLiveFilesMetaData(&live_files);
   for (const auto& file : live_files) {
-    segments.emplace_back(file.smallest.seqno, file.largest.seqno);
+    add_segment(file.smallest.seqno, file.largest.seqno, file.sorted_run_id, &live_sorted_runs);
   }
 
   std::sort(segments.begin(), segments.end(), [](const auto& lhs, const auto& rhs) {
@@ -2847,6 +2869,8 @@ Status VersionSet::Import(const std::string& source_dir,
   }
 
   std::vector<std::string> revert_list;
+  // Sorted run ids are file numbers of the imported DB, so they get new ones too.
+  std::unordered_map<uint64_t, uint64_t> new_sorted_run_ids;
   for (auto file : files) {
     auto source_base = MakeTableFileName(source_dir, file.fd.GetNumber());
     auto source_data = TableBaseToDataFileName(source_base);
@@ -2866,6 +2890,13 @@ Status VersionSet::Import(const std::string& source_dir,
     revert_list.push_back(dest_data);
     file.fd.packed_number_and_path_id = new_number; // path is 0
     file.marked_for_compaction = false;
+    if (file.sorted_run_id != 0) {
+      auto it = new_sorted_run_ids.emplace(file.sorted_run_id, 0).first;
+      if (it->second == 0) {
+        it->second = NewFileNumber();
+      }
+      file.sorted_run_id = it->second;
+    }
     edit->AddCleanedFile(0, file);
   }
 
@@ -3592,6 +3623,7 @@ void VersionSet::GetLiveFilesMetaData(std::vector<LiveFileMetaData>* metadata) {
         filemetadata.smallest = ConvertBoundaryValues(file->smallest);
         filemetadata.largest = ConvertBoundaryValues(file->largest);
         filemetadata.imported = file->imported;
+        filemetadata.sorted_run_id = file->sorted_run_id;
         metadata->push_back(filemetadata);
       }
     }
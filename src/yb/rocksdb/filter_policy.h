@@ -148,6 +148,11 @@ class FilterPolicy {
 
     // Transform a key.
     virtual Slice Transform(Slice key) const = 0;
+
+    // Returns whether all keys starting with the given key have the same transformed key as it.
+    // Filters are not checked on seeks to keys for which it is not true, e.g. to keys that are too
+    // short to contain the whole part of the key taken into account by the filter.
+    virtual bool IsFullFilterKey(Slice key) const { return true; }
   };
 
   // Filter policy can optionally return key transformer to be used before writing key to filter or
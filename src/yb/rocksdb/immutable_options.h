@@ -119,6 +119,10 @@ struct ImmutableCFOptions {
   std::vector<std::shared_ptr<EventListener>> listeners;
 
   std::shared_ptr<Cache> row_cache;
+
+  size_t memtable_huge_page_size;
+
+  std::shared_ptr<yb::MemTracker> memtable_mem_tracker;
 };
 
 }  // namespace rocksdb
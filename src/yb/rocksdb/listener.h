@@ -74,6 +74,8 @@ enum class CompactionReason {
   kManualCompaction,
   // DB::SuggestCompactRange() marked files for compaction
   kFilesMarkedForCompaction,
+  // [Universal] the oldest files have expired according to the compaction filter factory
+  kUniversalExpiredFiles,
 };
 
 #ifndef ROCKSDB_LITE
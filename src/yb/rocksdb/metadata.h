@@ -246,6 +246,8 @@ struct SstFileMetaData {
   BoundaryValues smallest;
   BoundaryValues largest;
   bool imported = false;
+  // Files with the same non-zero id form a single sorted run, see FileMetaData::sorted_run_id.
+  uint64_t sorted_run_id = 0;
   bool being_compacted;  // true if the file is currently being compacted.
 };
 
@@ -39,6 +39,12 @@
 #include "yb/util/result.h"
 #include "yb/rocksdb/universal_compaction.h"
 
+namespace yb {
+
+class MemTracker;
+
+} // namespace yb
+
 #ifdef max
 #undef max
 #endif
@@ -997,6 +1003,12 @@ struct DBOptions {
   // Default: 1 (i.e. no subcompactions)
   uint32_t max_subcompactions;
 
+  // With universal compaction and a single level, compaction output files have no size limit, so
+  // the number of subcompactions is limited by this amount of input data per subcompaction
+  // instead. Set it to 0 to split all such compactions into max_subcompactions.
+  // Default: 1 GB
+  uint64_t min_subcompaction_size = 1ULL << 30;
+
   // Maximum number of concurrent background memtable flush jobs, submitted to
   // the HIGH priority thread pool.
   //
@@ -1316,6 +1328,16 @@ struct DBOptions {
 
   // Invoked after memtable switched.
   std::shared_ptr<std::function<MemTableFilter()>> mem_table_flush_filter_factory;
+
+  // If > 0, memtables allocate their blocks from huge pages of this size (should be the huge page
+  // size of the system), using reserved huge pages if there are any and transparent huge pages
+  // otherwise. Falls back to regular allocations if both fail.
+  // Default: 0 (disabled)
+  size_t memtable_huge_page_size = 0;
+
+  // If set, the memory of the memtable blocks is consumed from this tracker. Memtable blocks that
+  // are mapped from huge pages are not visible to the allocator, so they are only accounted here.
+  std::shared_ptr<yb::MemTracker> memtable_mem_tracker;
 };
 
 // Options to control the behavior of a database (passed to DB::Open)
@@ -157,6 +157,11 @@ struct BlockBasedTableOptions {
   // used to avoid too many index levels in case we have large keys.
   size_t min_keys_per_index_block = 64;
 
+  // For kMultiLevelBinarySearch: when an iterator moves to the next lowest level index block and
+  // that block is not cached, up to this number of lowest level index blocks starting with it are
+  // read with a single file read and added to the block cache. 0 - disabled.
+  size_t index_blocks_prefetch_count = 8;
+
   // Use delta encoding to compress keys in blocks.
   // Iterator::PinData() requires this option to be disabled.
   //
@@ -280,6 +280,10 @@ BloomFilterAwareFileFilter::BloomFilterAwareFileFilter(
 
 bool BloomFilterAwareFileFilter::Filter(TableReader* reader) const {
   auto table = down_cast<BlockBasedTable*>(reader);
+  if (table->rep_->filter_key_transformer &&
+      !table->rep_->filter_key_transformer->IsFullFilterKey(user_key_)) {
+    return true;
+  }
   if (table->rep_->filter_type == FilterType::kFixedSizeFilter) {
     const auto filter_key = table->GetFilterKeyFromUserKey(user_key_);
     auto filter_entry = table->GetFilter(read_options_.query_id,
@@ -1142,6 +1146,115 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
   return iter;
 }
 
+bool BlockBasedTable::CanPrefetchBlock(
+    const ReadOptions& read_options, const Slice& index_value, BlockType block_type) {
+  Cache* block_cache = rep_->table_options.block_cache.get();
+  if (block_cache == nullptr || read_options.read_tier == kBlockCacheTier ||
+      !read_options.fill_cache) {
+    return false;
+  }
+  BlockHandle handle;
+  Slice input = index_value;
+  if (!handle.DecodeFrom(&input).ok()) {
+    return false;
+  }
+  char cache_key[block_based_table::kMaxCacheKeyPrefixSize + kMaxVarint64Length];
+  auto* cache_handle = block_cache->Lookup(
+      GetCacheKey(GetBlockReader(block_type)->cache_key_prefix, handle, cache_key),
+      read_options.query_id);
+  if (cache_handle != nullptr) {
+    block_cache->Release(cache_handle);
+    return false;
+  }
+  return true;
+}
+
+void BlockBasedTable::PrefetchBlocks(
+    const ReadOptions& read_options, const std::vector<std::string>& index_values,
+    BlockType block_type) {
+  Cache* block_cache = rep_->table_options.block_cache.get();
+  if (block_cache == nullptr || read_options.read_tier == kBlockCacheTier ||
+      !read_options.fill_cache) {
+    return;
+  }
+  Cache* block_cache_compressed = rep_->table_options.block_cache_compressed.get();
+  FileReaderWithCachePrefix* reader = GetBlockReader(block_type);
+  char cache_key[block_based_table::kMaxCacheKeyPrefixSize + kMaxVarint64Length];
+  char compressed_cache_key[block_based_table::kMaxCacheKeyPrefixSize + kMaxVarint64Length];
+
+  // Other blocks, e.g. filter blocks, could be written between the requested ones. They are read
+  // as well, as long as they don't take most of the read.
+  constexpr uint64_t kMaxReadSizeToBlocksSizeRatio = 4;
+  std::vector<BlockHandle> handles;
+  handles.reserve(index_values.size());
+  uint64_t blocks_size = 0;
+  for (const auto& index_value : index_values) {
+    BlockHandle handle;
+    Slice input = index_value;
+    if (!handle.DecodeFrom(&input).ok()) {
+      break;
+    }
+    const uint64_t block_end = handle.offset() + handle.size() + kBlockTrailerSize;
+    if (!handles.empty() &&
+        (handle.offset() < handles.back().offset() + handles.back().size() + kBlockTrailerSize ||
+         block_end - handles.front().offset() >
+             kMaxReadSizeToBlocksSizeRatio * (blocks_size + handle.size() + kBlockTrailerSize))) {
+      break;
+    }
+    auto* cache_handle = block_cache->Lookup(
+        GetCacheKey(reader->cache_key_prefix, handle, cache_key), read_options.query_id);
+    if (cache_handle != nullptr) {
+      block_cache->Release(cache_handle);
+      break;
+    }
+    handles.push_back(handle);
+    blocks_size += handle.size() + kBlockTrailerSize;
+  }
+  if (handles.size() < 2) {
+    return;
+  }
+
+  Statistics* statistics = rep_->ioptions.statistics;
+  const uint64_t offset = handles.front().offset();
+  const size_t size = static_cast<size_t>(
+      handles.back().offset() + handles.back().size() + kBlockTrailerSize - offset);
+  std::unique_ptr<char[]> buffer(new char[size]);
+  Slice data;
+  {
+    StopWatch sw(rep_->ioptions.env, statistics, READ_BLOCK_GET_MICROS);
+    if (!reader->reader->Read(offset, size, &data, buffer.get()).ok() || data.size() != size) {
+      return;
+    }
+  }
+
+  for (const auto& handle : handles) {
+    const Slice block_data(
+        data.data() + (handle.offset() - offset), handle.size() + kBlockTrailerSize);
+    BlockContents contents;
+    if (!BlockContentsFromData(rep_->footer, read_options, handle, block_data, &contents,
+                               block_cache_compressed == nullptr).ok()) {
+      return;
+    }
+    const Slice key = GetCacheKey(reader->cache_key_prefix, handle, cache_key);
+    Slice ckey;
+    if (block_cache_compressed != nullptr) {
+      ckey = GetCacheKey(reader->compressed_cache_key_prefix, handle, compressed_cache_key);
+    }
+    CachableEntry<Block> block;
+    const Status s = PutDataBlockToCache(
+        key, ckey, block_cache, block_cache_compressed, read_options, statistics, &block,
+        new Block(std::move(contents)), rep_->table_options.format_version);
+    if (block.cache_handle != nullptr) {
+      block.Release(block_cache);
+    } else {
+      delete block.value;
+    }
+    if (!s.ok()) {
+      return;
+    }
+  }
+}
+
 class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
  public:
   BlockEntryIteratorState(
@@ -1164,6 +1277,18 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
     return table_->PrefixMayMatch(internal_key);
   }
 
+  size_t NumSecondaryBlocksToPrefetch(const Slice& index_value) override {
+    if (block_type_ != BlockType::kIndex ||
+        !table_->CanPrefetchBlock(read_options_, index_value, block_type_)) {
+      return 0;
+    }
+    return table_->rep_->table_options.index_blocks_prefetch_count;
+  }
+
+  void PrefetchSecondaryBlocks(const std::vector<std::string>& index_values) override {
+    table_->PrefetchBlocks(read_options_, index_values, block_type_);
+  }
+
  private:
   // Don't own table_
   BlockBasedTable* const table_;
@@ -28,6 +28,7 @@
 #include <memory>
 #include <utility>
 #include <string>
+#include <vector>
 
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/statistics.h"
@@ -239,6 +240,20 @@ class BlockBasedTable : public TableReader {
   InternalIterator* NewIndexIterator(const ReadOptions& read_options,
                                      BlockIter* input_iter = nullptr);
 
+  // Whether the block referenced by index_value could be prefetched into the block cache, i.e.
+  // the block cache is used by reads with read_options and does not contain the block yet.
+  bool CanPrefetchBlock(
+      const ReadOptions& read_options, const Slice& index_value, BlockType block_type);
+
+  // Reads the blocks referenced by index_values, starting with the first one, with a single file
+  // read, and adds them to the block cache. Stops at the first block that is already cached, or
+  // that is not close enough after the previous one in the file. Does nothing if fewer than two
+  // blocks are left, since a single block is read by the caller anyway. Errors are ignored, they
+  // are reported when the blocks are read regularly.
+  void PrefetchBlocks(
+      const ReadOptions& read_options, const std::vector<std::string>& index_values,
+      BlockType block_type);
+
   // Read block cache from block caches (if set): block_cache and
   // block_cache_compressed.
   // On success, Status::OK with be returned and @block will be populated with
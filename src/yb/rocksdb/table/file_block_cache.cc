@@ -0,0 +1,381 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rocksdb/table/file_block_cache.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/gutil/gscoped_ptr.h"
+#include "yb/rocksdb/table/block.h"
+#include "yb/rocksdb/table/format.h"
+#include "yb/rocksdb/util/hash.h"
+#include "yb/util/env.h"
+#include "yb/util/format.h"
+#include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+
+namespace rocksdb {
+
+namespace {
+
+struct FileBlockCacheHandle : public Cache::Handle {
+  FileBlockCacheHandle(const Slice& key_, Block* block_,
+                       void (*deleter_)(const Slice& key, void* value))
+      : key(key_.ToBuffer()), block(block_), deleter(deleter_) {}
+
+  std::string key;
+  Block* block;
+  void (*deleter)(const Slice& key, void* value);
+};
+
+void DeleteBlock(const Slice& key, void* value) {
+  delete static_cast<Block*>(value);
+}
+
+// One file of the cache. Blocks are appended at the logical offset head_, which only grows, and
+// are stored at head_ % capacity_ in the file. A block never wraps around the end of the file,
+// instead it is moved to the start of the next lap. So a block written at logical offset L is
+// intact as long as head_ <= L + capacity_.
+//
+// The space for a block is reserved under mutex_, and the block is written and read without
+// holding it. Since a region of the file is only written after it was reserved, a block that is
+// still intact after it was read was not overwritten while it was read.
+class FileBlockCacheShard {
+ public:
+  FileBlockCacheShard(std::string path, size_t capacity)
+      : path_(std::move(path)), capacity_(std::max<size_t>(capacity, 1)) {}
+
+  ~FileBlockCacheShard() {
+    if (file_) {
+      WARN_NOT_OK(file_->Close(), "Failed to close " + path_);
+      WARN_NOT_OK(yb::Env::Default()->DeleteFile(path_), "Failed to delete " + path_);
+    }
+  }
+
+  Status Open() {
+    yb::RWFileOptions options;
+    options.mode = yb::RWFileOptions::CREATE_IF_NON_EXISTING_TRUNCATE;
+    return yb::Env::Default()->NewRWFile(options, path_, &file_);
+  }
+
+  // Writes 'data' to the file and makes it available to the lookups of 'key'.
+  void Insert(const Slice& key, const Slice& data, CompressionType compression_type) {
+    if (data.empty() || data.size() > capacity_) {
+      return;
+    }
+
+    uint64_t offset;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      offset = head_;
+      if (offset % capacity_ + data.size() > capacity_) {
+        offset += capacity_ - offset % capacity_;
+      }
+      head_ = offset + data.size();
+      EvictOverwritten();
+      fifo_.emplace_back(offset, key.ToBuffer());
+    }
+
+    Status s;
+    {
+      // Writes of different threads could go to the same region after a full lap.
+      std::lock_guard<std::mutex> lock(write_mutex_);
+      s = file_->Write(offset % capacity_, data);
+    }
+    if (!s.ok()) {
+      YB_LOG_EVERY_N_SECS(WARNING, 10) << "Failed to write block to " << path_ << ": " << s;
+      return;
+    }
+    if (metrics_) {
+      metrics_->inserts->Increment();
+      metrics_->bytes_written->IncrementBy(data.size());
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!IsIntact(offset)) {
+      return;
+    }
+    auto& entry = index_[key.ToBuffer()];
+    if (entry.size != 0) {
+      ChangeUsage(-static_cast<int64_t>(entry.size));
+    }
+    entry = Entry{offset, data.size(), compression_type};
+    ChangeUsage(data.size());
+  }
+
+  // Returns the block stored for 'key', or nullptr if there is no such block.
+  Block* Lookup(const Slice& key) {
+    Entry entry;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = index_.find(key.ToBuffer());
+      if (it == index_.end()) {
+        return nullptr;
+      }
+      entry = it->second;
+    }
+
+    std::unique_ptr<char[]> buffer(new char[entry.size]);
+    Slice result;
+    Status s = file_->Read(entry.offset % capacity_, entry.size, &result,
+                           reinterpret_cast<uint8_t*>(buffer.get()));
+    bool reinsert;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!s.ok()) {
+        YB_LOG_EVERY_N_SECS(WARNING, 10) << "Failed to read block from " << path_ << ": " << s;
+        auto it = index_.find(key.ToBuffer());
+        if (it != index_.end() && it->second.offset == entry.offset) {
+          ChangeUsage(-static_cast<int64_t>(entry.size));
+          index_.erase(it);
+        }
+        return nullptr;
+      }
+      if (!IsIntact(entry.offset)) {
+        return nullptr;
+      }
+      // Blocks that are still used when they are about to be overwritten are moved to the head.
+      reinsert = entry.offset + capacity_ / 2 < head_;
+    }
+    if (metrics_) {
+      metrics_->bytes_read->IncrementBy(entry.size);
+    }
+
+    if (result.data() != buffer.get()) {
+      memmove(buffer.get(), result.data(), entry.size);
+    }
+    if (reinsert) {
+      Insert(key, Slice(buffer.get(), entry.size), entry.compression_type);
+    }
+    return new Block(BlockContents(
+        std::move(buffer), entry.size, true /* cachable */, entry.compression_type));
+  }
+
+  void Erase(const Slice& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key.ToBuffer());
+    if (it != index_.end()) {
+      ChangeUsage(-static_cast<int64_t>(it->second.size));
+      index_.erase(it);
+    }
+  }
+
+  size_t GetUsage() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return usage_;
+  }
+
+  void SetMetrics(std::shared_ptr<yb::SecondaryCacheMetrics> metrics) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    metrics_ = std::move(metrics);
+    metrics_->cache_usage->IncrementBy(usage_);
+  }
+
+ private:
+  struct Entry {
+    // Logical offset of the block, see the class comment.
+    uint64_t offset = 0;
+    size_t size = 0;
+    CompressionType compression_type = kNoCompression;
+  };
+
+  bool IsIntact(uint64_t offset) const {
+    return head_ <= offset + capacity_;
+  }
+
+  // Drops the blocks that are overwritten by the space reserved up to head_.
+  void EvictOverwritten() {
+    while (!fifo_.empty() && !IsIntact(fifo_.front().first)) {
+      auto it = index_.find(fifo_.front().second);
+      // The key could have been erased, or written again at a later offset.
+      if (it != index_.end() && it->second.offset == fifo_.front().first) {
+        ChangeUsage(-static_cast<int64_t>(it->second.size));
+        index_.erase(it);
+        if (metrics_) {
+          metrics_->evictions->Increment();
+        }
+      }
+      fifo_.pop_front();
+    }
+  }
+
+  void ChangeUsage(int64_t delta) {
+    usage_ += delta;
+    if (metrics_) {
+      metrics_->cache_usage->IncrementBy(delta);
+    }
+  }
+
+  const std::string path_;
+  const size_t capacity_;
+  gscoped_ptr<yb::RWFile> file_;
+  std::mutex write_mutex_;
+
+  mutable std::mutex mutex_;
+  uint64_t head_ = 0;
+  size_t usage_ = 0;
+  std::unordered_map<std::string, Entry> index_;
+  // Logical offsets and keys of the written blocks, in the order of their offsets.
+  std::deque<std::pair<uint64_t, std::string>> fifo_;
+  std::shared_ptr<yb::SecondaryCacheMetrics> metrics_;
+};
+
+class FileBlockCache : public Cache {
+ public:
+  FileBlockCache(size_t capacity, int num_shard_bits)
+      : capacity_(capacity), num_shard_bits_(num_shard_bits) {}
+
+  Status Open(const std::string& dir) {
+    auto* env = yb::Env::Default();
+    if (!env->FileExists(dir)) {
+      RETURN_NOT_OK(env->CreateDir(dir));
+    }
+    const size_t num_shards = 1 << num_shard_bits_;
+    const size_t per_shard = capacity_ / num_shards;
+    shards_.reserve(num_shards);
+    for (size_t i = 0; i != num_shards; ++i) {
+      shards_.emplace_back(new FileBlockCacheShard(
+          yb::Format("$0/block_cache.$1", dir, i), per_shard));
+      RETURN_NOT_OK(shards_.back()->Open());
+    }
+    return Status::OK();
+  }
+
+  Status Insert(const Slice& key, const QueryId query_id, void* value, size_t charge,
+                void (*deleter)(const Slice& key, void* value),
+                Handle** handle, Statistics* statistics) override {
+    auto* block = static_cast<Block*>(value);
+    if (query_id != kNoCacheQueryId) {
+      Shard(key)->Insert(key, Slice(block->data(), block->size()), block->compression_type());
+    }
+    if (handle == nullptr) {
+      (*deleter)(key, value);
+    } else {
+      *handle = new FileBlockCacheHandle(key, block, deleter);
+    }
+    return Status::OK();
+  }
+
+  Handle* Lookup(const Slice& key, const QueryId query_id, Statistics* statistics) override {
+    if (query_id == kNoCacheQueryId) {
+      return nullptr;
+    }
+    Block* block = Shard(key)->Lookup(key);
+    if (metrics_) {
+      metrics_->lookups->Increment();
+      if (block != nullptr) {
+        metrics_->cache_hits->Increment();
+      } else {
+        metrics_->cache_misses->Increment();
+      }
+    }
+    if (block == nullptr) {
+      return nullptr;
+    }
+    return new FileBlockCacheHandle(key, block, &DeleteBlock);
+  }
+
+  void Release(Handle* handle) override {
+    auto* h = static_cast<FileBlockCacheHandle*>(handle);
+    (*h->deleter)(h->key, h->block);
+    delete h;
+  }
+
+  void* Value(Handle* handle) override {
+    return static_cast<FileBlockCacheHandle*>(handle)->block;
+  }
+
+  void Erase(const Slice& key) override {
+    Shard(key)->Erase(key);
+  }
+
+  uint64_t NewId() override {
+    return ++last_id_;
+  }
+
+  // The capacity is fixed by the size of the files.
+  void SetCapacity(size_t capacity) override {}
+
+  // Blocks that don't fit are never rejected, older blocks are overwritten instead.
+  void SetStrictCapacityLimit(bool strict_capacity_limit) override {}
+
+  bool HasStrictCapacityLimit() const override {
+    return false;
+  }
+
+  size_t GetCapacity() const override {
+    return capacity_;
+  }
+
+  size_t GetUsage() const override {
+    size_t usage = 0;
+    for (const auto& shard : shards_) {
+      usage += shard->GetUsage();
+    }
+    return usage;
+  }
+
+  size_t GetUsage(Handle* handle) const override {
+    return static_cast<FileBlockCacheHandle*>(handle)->block->size();
+  }
+
+  // Blocks are not pinned in the files, handles own copies of them.
+  size_t GetPinnedUsage() const override {
+    return 0;
+  }
+
+  // The cached blocks are not in memory.
+  void ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe) override {}
+
+  void SetMetrics(const scoped_refptr<yb::MetricEntity>& entity) override {
+    metrics_ = std::make_shared<yb::SecondaryCacheMetrics>(entity);
+    for (auto& shard : shards_) {
+      shard->SetMetrics(metrics_);
+    }
+  }
+
+ private:
+  FileBlockCacheShard* Shard(const Slice& key) {
+    const uint32_t hash = Hash(key.data(), key.size(), 0);
+    // Note, hash >> 32 yields hash in gcc, not the zero we expect!
+    return shards_[num_shard_bits_ > 0 ? hash >> (32 - num_shard_bits_) : 0].get();
+  }
+
+  const size_t capacity_;
+  const int num_shard_bits_;
+  std::vector<std::unique_ptr<FileBlockCacheShard>> shards_;
+  std::atomic<uint64_t> last_id_{0};
+  std::shared_ptr<yb::SecondaryCacheMetrics> metrics_;
+};
+
+} // namespace
+
+Status NewFileBlockCache(const std::string& dir, size_t capacity, int num_shard_bits,
+                         std::shared_ptr<Cache>* cache) {
+  if (num_shard_bits < 0 || num_shard_bits >= 20) {
+    return STATUS_FORMAT(InvalidArgument, "Invalid number of shard bits: $0", num_shard_bits);
+  }
+  auto result = std::make_shared<FileBlockCache>(capacity, num_shard_bits);
+  RETURN_NOT_OK(result->Open(dir));
+  *cache = std::move(result);
+  return Status::OK();
+}
+
+}  // namespace rocksdb
@@ -0,0 +1,44 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_ROCKSDB_TABLE_FILE_BLOCK_CACHE_H
+#define YB_ROCKSDB_TABLE_FILE_BLOCK_CACHE_H
+
+#include <memory>
+#include <string>
+
+#include "yb/rocksdb/cache.h"
+#include "yb/rocksdb/status.h"
+
+namespace rocksdb {
+
+// Creates a cache of compressed blocks that keeps the blocks in files under 'dir' instead of in
+// memory. It is meant to be used as BlockBasedTableOptions::block_cache_compressed, i.e. as the
+// secondary tier behind the in-memory block cache: data block lookups that miss the in-memory
+// cache are served from these files before falling back to the SST files. 'dir' would usually be
+// on a local SSD, or on a DAX mounted NVM device.
+//
+// The cache is sharded into 2^num_shard_bits files of capacity / 2^num_shard_bits bytes each.
+// Every file is written as a ring log, so the oldest blocks are overwritten first. Blocks that
+// are looked up once they are in the older half of the ring are written again at its head, so
+// frequently used blocks are kept.
+//
+// The values inserted into this cache must be Block objects. Lookups return new Block objects
+// that are read back from the files, and that are deleted when their handle is released.
+// The capacity is fixed at creation. The files are deleted when the cache is destroyed.
+Status NewFileBlockCache(const std::string& dir, size_t capacity, int num_shard_bits,
+                         std::shared_ptr<Cache>* cache);
+
+}  // namespace rocksdb
+
+#endif  // YB_ROCKSDB_TABLE_FILE_BLOCK_CACHE_H
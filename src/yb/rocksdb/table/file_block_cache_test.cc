@@ -0,0 +1,126 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <string.h>
+
+#include <string>
+
+#include "yb/rocksdb/table/block.h"
+#include "yb/rocksdb/table/file_block_cache.h"
+#include "yb/rocksdb/table/format.h"
+#include "yb/rocksdb/util/testharness.h"
+
+namespace rocksdb {
+
+namespace {
+
+constexpr size_t kBlockSize = 1000;
+
+std::string BlockData(int i) {
+  return std::string(kBlockSize, static_cast<char>('a' + i % 26));
+}
+
+std::string Key(int i) {
+  return "block" + std::to_string(i);
+}
+
+void DeleteBlock(const Slice& key, void* value) {
+  delete static_cast<Block*>(value);
+}
+
+} // namespace
+
+class FileBlockCacheTest : public testing::Test {
+ protected:
+  void CreateCache(size_t capacity, int num_shard_bits) {
+    ASSERT_OK(NewFileBlockCache(
+        test::TmpDir() + "/file_block_cache_test", capacity, num_shard_bits, &cache_));
+  }
+
+  void Insert(int i, QueryId query_id = kDefaultQueryId) {
+    const auto data = BlockData(i);
+    std::unique_ptr<char[]> buffer(new char[data.size()]);
+    memcpy(buffer.get(), data.data(), data.size());
+    auto* block = new Block(BlockContents(std::move(buffer), data.size(), true, kSnappyCompression));
+    ASSERT_OK(cache_->Insert(Key(i), query_id, block, block->usable_size(), &DeleteBlock));
+  }
+
+  // Returns whether block i was found, and checks its contents if it was.
+  bool Lookup(int i, QueryId query_id = kDefaultQueryId) {
+    auto* handle = cache_->Lookup(Key(i), query_id);
+    if (handle == nullptr) {
+      return false;
+    }
+    auto* block = static_cast<Block*>(cache_->Value(handle));
+    EXPECT_EQ(kSnappyCompression, block->compression_type());
+    EXPECT_EQ(BlockData(i), std::string(block->data(), block->size()));
+    cache_->Release(handle);
+    return true;
+  }
+
+  std::shared_ptr<Cache> cache_;
+};
+
+TEST_F(FileBlockCacheTest, InsertAndLookup) {
+  CreateCache(1 << 20, 2);
+  for (int i = 0; i != 100; ++i) {
+    Insert(i);
+  }
+  for (int i = 0; i != 100; ++i) {
+    ASSERT_TRUE(Lookup(i)) << i;
+  }
+  ASSERT_FALSE(Lookup(100));
+  ASSERT_EQ(100 * kBlockSize, cache_->GetUsage());
+
+  cache_->Erase(Key(0));
+  ASSERT_FALSE(Lookup(0));
+  ASSERT_EQ(99 * kBlockSize, cache_->GetUsage());
+
+  Insert(100, kNoCacheQueryId);
+  ASSERT_FALSE(Lookup(100));
+  ASSERT_FALSE(Lookup(1, kNoCacheQueryId));
+}
+
+TEST_F(FileBlockCacheTest, OldestBlocksAreOverwritten) {
+  constexpr int kBlocksInCache = 10;
+  CreateCache(kBlocksInCache * kBlockSize, 0);
+  for (int i = 0; i != 2 * kBlocksInCache; ++i) {
+    Insert(i);
+  }
+  for (int i = 0; i != kBlocksInCache; ++i) {
+    ASSERT_FALSE(Lookup(i)) << i;
+  }
+  for (int i = kBlocksInCache; i != 2 * kBlocksInCache; ++i) {
+    ASSERT_TRUE(Lookup(i)) << i;
+  }
+  ASSERT_EQ(kBlocksInCache * kBlockSize, cache_->GetUsage());
+}
+
+TEST_F(FileBlockCacheTest, UsedBlocksAreKept) {
+  constexpr int kBlocksInCache = 10;
+  CreateCache(kBlocksInCache * kBlockSize, 0);
+  Insert(0);
+  for (int i = 1; i != 5 * kBlocksInCache; ++i) {
+    Insert(i);
+    ASSERT_TRUE(Lookup(0)) << i;
+  }
+  ASSERT_FALSE(Lookup(1));
+  ASSERT_LE(cache_->GetUsage(), kBlocksInCache * kBlockSize);
+}
+
+}  // namespace rocksdb
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -24,6 +24,7 @@
 #include "yb/rocksdb/table/format.h"
 
 #include <inttypes.h>
+#include <string.h>
 
 #include <string>
 
@@ -268,6 +269,28 @@ Status ReadFooterFromFile(RandomAccessFileReader* file, uint64_t file_size,
 // Without anonymous namespace here, we fail the warning -Wmissing-prototypes
 namespace {
 
+// Check the crc of the type and the contents of a block of size n, followed by its trailer.
+Status VerifyBlockChecksum(const Footer& footer, const char* data, size_t n) {
+  PERF_TIMER_GUARD(block_checksum_time);
+  uint32_t value = DecodeFixed32(data + n + 1);
+  uint32_t actual = 0;
+  switch (footer.checksum()) {
+    case kCRC32c:
+      value = crc32c::Unmask(value);
+      actual = crc32c::Value(data, n + 1);
+      break;
+    case kxxHash:
+      actual = XXH32(data, static_cast<int>(n) + 1, 0);
+      break;
+    default:
+      return STATUS(Corruption, "unknown checksum type");
+  }
+  if (actual != value) {
+    return STATUS(Corruption, "block checksum mismatch");
+  }
+  return Status::OK();
+}
+
 // Read a block and check its CRC
 // contents is the result of reading.
 // According to the implementation of file->Read, contents may not point to buf
@@ -293,28 +316,8 @@ Status ReadBlock(RandomAccessFileReader* file, const Footer& footer,
   }
 
   // Check the crc of the type and the block contents
-  const char* data = contents->cdata();  // Pointer to where Read put the data
   if (options.verify_checksums) {
-    PERF_TIMER_GUARD(block_checksum_time);
-    uint32_t value = DecodeFixed32(data + n + 1);
-    uint32_t actual = 0;
-    switch (footer.checksum()) {
-      case kCRC32c:
-        value = crc32c::Unmask(value);
-        actual = crc32c::Value(data, n + 1);
-        break;
-      case kxxHash:
-        actual = XXH32(data, static_cast<int>(n) + 1, 0);
-        break;
-      default:
-        s = STATUS(Corruption, "unknown checksum type");
-    }
-    if (s.ok() && actual != value) {
-      s = STATUS(Corruption, "block checksum mismatch");
-    }
-    if (!s.ok()) {
-      return s;
-    }
+    return VerifyBlockChecksum(footer, contents->cdata(), n);
   }
   return s;
 }
@@ -371,6 +374,30 @@ Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
   return status;
 }
 
+Status BlockContentsFromData(const Footer& footer, const ReadOptions& options,
+                             const BlockHandle& handle, const Slice& data,
+                             BlockContents* contents, bool decompression_requested) {
+  const size_t n = static_cast<size_t>(handle.size());
+  if (data.size() != n + kBlockTrailerSize) {
+    return STATUS(Corruption, "truncated block read");
+  }
+  if (options.verify_checksums) {
+    RETURN_NOT_OK(VerifyBlockChecksum(footer, data.cdata(), n));
+  }
+
+  PERF_TIMER_GUARD(block_decompress_time);
+
+  const auto compression_type = static_cast<rocksdb::CompressionType>(data.data()[n]);
+  if (decompression_requested && compression_type != kNoCompression) {
+    return UncompressBlockContents(data.cdata(), n, contents, footer.version());
+  }
+
+  std::unique_ptr<char[]> buf(new char[n]);
+  memcpy(buf.get(), data.data(), n);
+  *contents = BlockContents(std::move(buf), n, true, compression_type);
+  return Status::OK();
+}
+
 //
 // The 'data' points to the raw block contents that was read in from file.
 // This method allocates a new heap buffer and the raw block
@@ -236,6 +236,15 @@ extern Status ReadBlockContents(RandomAccessFileReader* file,
                                 BlockContents* contents, Env* env,
                                 bool do_uncompress);
 
+// Same as ReadBlockContents, but takes the block followed by its trailer from 'data', that was
+// already read from the file at the offset of 'handle'.
+extern Status BlockContentsFromData(const Footer& footer,
+                                    const ReadOptions& options,
+                                    const BlockHandle& handle,
+                                    const Slice& data,
+                                    BlockContents* contents,
+                                    bool do_uncompress);
+
 // The 'data' points to the raw block contents read in from file.
 // This method allocates a new heap buffer and the raw block
 // contents are uncompresed into this buffer. This buffer is
@@ -163,14 +163,16 @@ class MultiLevelIterator : public InternalIterator {
   void Next() override {
     DoMove(
         std::bind(&IteratorWrapper::Next, std::placeholders::_1),
-        std::bind(&IteratorWrapper::SeekToFirst, std::placeholders::_1)
+        std::bind(&IteratorWrapper::SeekToFirst, std::placeholders::_1),
+        true /* prefetch */
     );
   }
 
   void Prev() override {
     DoMove(
         std::bind(&IteratorWrapper::Prev, std::placeholders::_1),
-        std::bind(&IteratorWrapper::SeekToLast, std::placeholders::_1)
+        std::bind(&IteratorWrapper::SeekToLast, std::placeholders::_1),
+        false /* prefetch */
     );
   }
 
@@ -227,7 +229,7 @@ class MultiLevelIterator : public InternalIterator {
   }
 
   template <typename F1, typename F2>
-  void DoMove(F1 move_function, F2 lower_levels_init_function) {
+  void DoMove(F1 move_function, F2 lower_levels_init_function, bool prefetch) {
     DCHECK(Valid());
     // First try to move iterator starting with bottom level.
     IteratorWrapper* iter = bottom_level_iter_;
@@ -242,6 +244,9 @@ class MultiLevelIterator : public InternalIterator {
     }
     // Once we've moved iterator at some level, we need to reset iterators at levels below.
     while (iter < bottom_level_iter_) {
+      if (prefetch && iter + 1 == bottom_level_iter_) {
+        PrefetchBottomLevelBlocks(iter);
+      }
       InitSubIterator(iter);
       ++iter;
       lower_levels_init_function(iter);
@@ -265,6 +270,24 @@ class MultiLevelIterator : public InternalIterator {
     }
   }
 
+  // Called when a forward scan moves to another bottom level index block. Index blocks of the same
+  // level are stored one after another, so the following ones could be read together with it.
+  void PrefetchBottomLevelBlocks(IteratorWrapper* parent_iter) {
+    const size_t count = state_->NumSecondaryBlocksToPrefetch(parent_iter->value());
+    if (count == 0) {
+      return;
+    }
+    std::vector<std::string> index_values;
+    index_values.reserve(count);
+    const std::string key = parent_iter->key().ToString();
+    while (index_values.size() < count && parent_iter->Valid()) {
+      index_values.push_back(parent_iter->value().ToString());
+      parent_iter->Next();
+    }
+    parent_iter->Seek(key);
+    state_->PrefetchSecondaryBlocks(index_values);
+  }
+
   TwoLevelIteratorState* const state_;
   boost::container::small_vector<IteratorWrapper, kIterChainInitialCapacity> iter_;
   // If iter_[level] holds non-nullptr, then "index_block_handle_[level-1]" holds the
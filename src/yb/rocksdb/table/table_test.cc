@@ -1504,6 +1504,51 @@ TEST_F(TableTest, MultiLevelIndexTest) {
   }
 }
 
+// Checks that a forward scan of a table with multi-level index reads the lowest level index blocks
+// into the block cache in batches when index_blocks_prefetch_count is set.
+TEST_F(BlockBasedTableTest, MultiLevelIndexPrefetch) {
+  constexpr int kNumKeys = 1000;
+  int64_t index_block_cache_misses[2];
+  for (int prefetch : {0, 1}) {
+    Options options;
+    options.compression = kNoCompression;
+    options.statistics = CreateDBStatistics();
+    auto ikc = std::make_shared<test::PlainInternalKeyComparator>(options.comparator);
+    BlockBasedTableOptions table_options;
+    table_options.index_type = IndexType::kMultiLevelBinarySearch;
+    table_options.block_size = 128;
+    table_options.index_block_size = 256;
+    table_options.min_keys_per_index_block = 2;
+    table_options.index_blocks_prefetch_count = prefetch ? 8 : 0;
+    table_options.block_cache = NewLRUCache(16 * 1024 * 1024);
+    options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+
+    TableConstructor c(BytewiseComparator());
+    for (int i = 0; i != kNumKeys; ++i) {
+      c.Add("key" + ToString(kNumKeys + i), "value" + ToString(i));
+    }
+    std::vector<std::string> keys;
+    stl_wrappers::KVMap kvmap;
+    const ImmutableCFOptions ioptions(options);
+    c.Finish(options, ioptions, table_options, ikc, &keys, &kvmap);
+
+    unique_ptr<InternalIterator> iter(c.NewIterator());
+    auto expected = kvmap.begin();
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++expected) {
+      ASSERT_TRUE(expected != kvmap.end());
+      ASSERT_EQ(expected->first, iter->key().ToString());
+      ASSERT_EQ(expected->second, iter->value().ToString());
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_TRUE(expected == kvmap.end());
+
+    index_block_cache_misses[prefetch] =
+        options.statistics->getTickerCount(BLOCK_CACHE_INDEX_MISS);
+  }
+  ASSERT_GT(index_block_cache_misses[0], 8);
+  ASSERT_LT(index_block_cache_misses[1] * 2, index_block_cache_misses[0]);
+}
+
 // It's very hard to figure out the index block size of a block accurately.
 // To make sure we get the index size, we just make sure as key number
 // grows, the filter block size also grows.
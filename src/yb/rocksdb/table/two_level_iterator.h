@@ -22,6 +22,10 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 
 #pragma once
+
+#include <string>
+#include <vector>
+
 #include "yb/rocksdb/iterator.h"
 #include "yb/rocksdb/env.h"
 #include "yb/rocksdb/table/iterator_wrapper.h"
@@ -40,6 +44,14 @@ struct TwoLevelIteratorState {
   virtual InternalIterator* NewSecondaryIterator(const Slice& handle) = 0;
   virtual bool PrefixMayMatch(const Slice& internal_key) = 0;
 
+  // Number of secondary blocks, starting with the one referenced by index_value that an iterator
+  // moves to, that should be passed to PrefetchSecondaryBlocks when a forward scan moves to another
+  // secondary block. Returns 0 if that block is already cached.
+  virtual size_t NumSecondaryBlocksToPrefetch(const Slice& index_value) { return 0; }
+
+  // Loads the secondary blocks referenced by index_values into the block cache.
+  virtual void PrefetchSecondaryBlocks(const std::vector<std::string>& index_values) {}
+
   // If call PrefixMayMatch()
   bool check_prefix_may_match;
 };
@@ -28,10 +28,28 @@
 #ifndef OS_WIN
 #include <sys/mman.h>
 #endif
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include <gflags/gflags.h>
 #include "yb/rocksdb/port/port.h"
 #include <algorithm>
 #include "yb/rocksdb/env.h"
 
+#include "yb/util/flag_tags.h"
+#include "yb/util/mem_tracker.h"
+#include "yb/util/size_literals.h"
+
+using namespace yb::size_literals;
+
+DEFINE_bool(arena_bind_huge_pages_to_local_numa_node, false,
+            "Prefer the NUMA node of the allocating thread for the huge page blocks of arenas, "
+            "e.g. the memtable blocks when memtable_huge_page_size is set. Memtable blocks are "
+            "allocated by the threads that apply the writes to the tablet, so the memtable stays "
+            "on their node even if the process runs with an interleaving NUMA policy.");
+TAG_FLAG(arena_bind_huge_pages_to_local_numa_node, advanced);
+
 namespace rocksdb {
 
 // MSVC complains that it is already defined since it is static in the header.
@@ -43,6 +61,67 @@ const size_t Arena::kMinBlockSize = 4096;
 const size_t Arena::kMaxBlockSize = 2 << 30;
 static const int kAlignUnit = sizeof(void*);
 
+namespace {
+
+#ifdef MAP_HUGETLB
+constexpr size_t kTransparentHugePageSize = 2_MB;
+
+// Maps 'bytes' aligned to the transparent huge page size, and asks the kernel to back them with
+// huge pages. Used when there are no reserved huge pages. Returns nullptr on failure.
+void* MapTransparentHugePages(size_t bytes) {
+#ifdef MADV_HUGEPAGE
+  if (bytes % kTransparentHugePageSize != 0) {
+    return nullptr;
+  }
+  const size_t length = bytes + kTransparentHugePageSize;
+  void* mapped = mmap(nullptr, length, (PROT_READ | PROT_WRITE),
+                      (MAP_PRIVATE | MAP_ANONYMOUS), -1, 0);
+  if (mapped == MAP_FAILED) {
+    return nullptr;
+  }
+  auto* start = static_cast<char*>(mapped);
+  auto* aligned = reinterpret_cast<char*>(
+      (reinterpret_cast<uintptr_t>(start) + kTransparentHugePageSize - 1) &
+      ~(kTransparentHugePageSize - 1));
+  const size_t head = aligned - start;
+  if (head != 0) {
+    munmap(start, head);
+  }
+  const size_t tail = length - head - bytes;
+  if (tail != 0) {
+    munmap(aligned + bytes, tail);
+  }
+  // If THP is disabled the block is still usable, just backed by regular pages.
+  madvise(aligned, bytes, MADV_HUGEPAGE);
+  return aligned;
+#else
+  return nullptr;
+#endif  // MADV_HUGEPAGE
+}
+
+// Sets the NUMA node of the calling thread as the preferred node of the pages in the given range.
+// Must be called before the pages are touched. Failures are ignored, the pages are then placed
+// according to the policy of the process.
+void BindToLocalNumaNode(void* addr, size_t bytes) {
+#if defined(__linux__) && defined(SYS_getcpu) && defined(SYS_mbind)
+  unsigned cpu = 0;
+  unsigned node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+    return;
+  }
+  constexpr int kMpolPreferred = 1;
+  constexpr size_t kBitsPerWord = sizeof(uint64_t) * 8;
+  std::vector<uint64_t> nodemask(node / kBitsPerWord + 1);
+  nodemask[node / kBitsPerWord] |= 1ULL << (node % kBitsPerWord);
+  // The kernel expects the number of bits in the mask plus one.
+  syscall(SYS_mbind, addr, bytes, kMpolPreferred, nodemask.data(),
+          nodemask.size() * kBitsPerWord + 1, 0);
+#endif
+}
+#endif  // MAP_HUGETLB
+
+} // namespace
+
 size_t OptimizeBlockSize(size_t block_size) {
   // Make sure block_size is in optimal range
   block_size = std::max(Arena::kMinBlockSize, block_size);
@@ -56,8 +135,9 @@ size_t OptimizeBlockSize(size_t block_size) {
   return block_size;
 }
 
-Arena::Arena(size_t block_size, size_t huge_page_size)
-    : kBlockSize(OptimizeBlockSize(block_size)) {
+Arena::Arena(size_t block_size, size_t huge_page_size,
+             std::shared_ptr<yb::MemTracker> mem_tracker)
+    : kBlockSize(OptimizeBlockSize(block_size)), mem_tracker_(std::move(mem_tracker)) {
   assert(kBlockSize >= kMinBlockSize && kBlockSize <= kMaxBlockSize &&
          kBlockSize % kAlignUnit == 0);
   alloc_bytes_remaining_ = sizeof(inline_block_);
@@ -73,6 +153,9 @@ Arena::Arena(size_t block_size, size_t huge_page_size)
 }
 
 Arena::~Arena() {
+  if (mem_tracker_) {
+    mem_tracker_->Release(blocks_memory_ - sizeof(inline_block_));
+  }
   for (const auto& block : blocks_) {
     delete[] block;
   }
@@ -136,11 +219,17 @@ char* Arena::AllocateFromHugePage(size_t bytes) {
                     (MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB), 0, 0);
 
   if (addr == MAP_FAILED) {
-    return nullptr;
+    addr = MapTransparentHugePages(bytes);
+    if (addr == nullptr) {
+      return nullptr;
+    }
+  }
+  if (FLAGS_arena_bind_huge_pages_to_local_numa_node) {
+    BindToLocalNumaNode(addr, bytes);
   }
   // the following shouldn't throw because of the above reserve()
   huge_blocks_.emplace_back(MmapInfo(addr, bytes));
-  blocks_memory_ += bytes;
+  AddBlockMemory(bytes);
   return reinterpret_cast<char*>(addr);
 #else
   return nullptr;
@@ -198,13 +287,20 @@ char* Arena::AllocateNewBlock(size_t block_bytes) {
   char* block = new char[block_bytes];
 
 #ifdef ROCKSDB_MALLOC_USABLE_SIZE
-  blocks_memory_ += malloc_usable_size(block);
+  AddBlockMemory(malloc_usable_size(block));
 #else
-  blocks_memory_ += block_bytes;
+  AddBlockMemory(block_bytes);
 #endif  // ROCKSDB_MALLOC_USABLE_SIZE
   // the following shouldn't throw because of the above reserve()
   blocks_.push_back(block);
   return block;
 }
 
+void Arena::AddBlockMemory(size_t bytes) {
+  blocks_memory_ += bytes;
+  if (mem_tracker_) {
+    mem_tracker_->Consume(bytes);
+  }
+}
+
 }  // namespace rocksdb
@@ -31,12 +31,19 @@
 #endif
 #include <cstddef>
 #include <cerrno>
+#include <memory>
 #include <vector>
 #include <assert.h>
 #include <stdint.h>
 #include "yb/rocksdb/util/allocator.h"
 #include "yb/rocksdb/util/mutexlock.h"
 
+namespace yb {
+
+class MemTracker;
+
+} // namespace yb
+
 namespace rocksdb {
 
 class Arena : public Allocator {
@@ -51,8 +58,12 @@ class Arena : public Allocator {
 
   // huge_page_size: if 0, don't use huge page TLB. If > 0 (should set to the
   // supported hugepage size of the system), block allocation will try huge
-  // page TLB first. If allocation fails, will fall back to normal case.
-  explicit Arena(size_t block_size = kMinBlockSize, size_t huge_page_size = 0);
+  // page TLB first. If there are no reserved huge pages, the block is mapped
+  // with transparent huge pages. If that fails too, will fall back to normal case.
+  // mem_tracker: if set, the memory of all the blocks allocated by the arena is
+  // consumed from it, and released when the arena is destroyed.
+  explicit Arena(size_t block_size = kMinBlockSize, size_t huge_page_size = 0,
+                 std::shared_ptr<yb::MemTracker> mem_tracker = nullptr);
   ~Arena();
 
   char* Allocate(size_t bytes) override;
@@ -123,9 +134,12 @@ class Arena : public Allocator {
   char* AllocateFromHugePage(size_t bytes);
   char* AllocateFallback(size_t bytes, bool aligned);
   char* AllocateNewBlock(size_t block_bytes);
+  void AddBlockMemory(size_t bytes);
 
   // Bytes of memory in blocks allocated so far
   size_t blocks_memory_ = 0;
+
+  std::shared_ptr<yb::MemTracker> mem_tracker_;
 };
 
 inline char* Arena::Allocate(size_t bytes) {
@@ -25,6 +25,8 @@
 #include "yb/rocksdb/util/random.h"
 #include "yb/rocksdb/util/testharness.h"
 
+#include "yb/util/mem_tracker.h"
+
 namespace rocksdb {
 
 namespace {
@@ -203,6 +205,24 @@ TEST_F(ArenaTest, Simple) {
   SimpleTest(0);
   SimpleTest(kHugePageSize);
 }
+
+TEST_F(ArenaTest, MemTracker) {
+  for (size_t huge_page_size : {static_cast<size_t>(0), kHugePageSize}) {
+    auto mem_tracker = yb::MemTracker::CreateTracker(-1, "arena");
+    {
+      Arena arena(Arena::kMinBlockSize, huge_page_size, mem_tracker);
+      ASSERT_EQ(0, mem_tracker->consumption());
+      for (int i = 0; i < 100; i++) {
+        arena.Allocate(1000);
+      }
+      arena.Allocate(1 << 20);
+      ASSERT_EQ(static_cast<int64_t>(arena.MemoryAllocatedBytes() - Arena::kInlineSize),
+                mem_tracker->consumption());
+    }
+    ASSERT_EQ(0, mem_tracker->consumption());
+    mem_tracker->UnregisterFromParent();
+  }
+}
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
@@ -78,6 +78,9 @@ namespace {
 // that are accessed multiple times by different queries.
 // query_id == kNoCacheQueryId means that this Handle is not going to be added
 // into the cache.
+// query_id == kLongScanQueryId means that the value was added by a long scan. Such values are
+// only moved into the multi touch cache when another query touches them, since the lookups of
+// long scans don't upgrade values.
 
 struct LRUHandle {
   void* value;
@@ -170,7 +173,8 @@ class HandleTable {
     }
 
     LRUHandle* val = Lookup(h->key(), h->hash);
-    if (val != nullptr && (val->GetSubCacheType() == MULTI_TOUCH || val->query_id != h->query_id)) {
+    if (val != nullptr && (val->GetSubCacheType() == MULTI_TOUCH ||
+                           (val->query_id != h->query_id && h->query_id != kLongScanQueryId))) {
       h->query_id = kInMultiTouchId;
       return MULTI_TOUCH;
     }
@@ -495,6 +499,9 @@ void LRUCache::EvictFromLRU(size_t charge, autovector<LRUHandle*>* deleted,
     Unref(old);
     sub_cache->DecrementUsage(old->charge);
     deleted->push_back(old);
+    if (metrics_) {
+      metrics_->evictions->Increment();
+    }
   }
 }
 
@@ -535,7 +542,7 @@ Cache::Handle* LRUCache::Lookup(const Slice& key, uint32_t hash, const QueryId q
 
     // Now the handle will be added to the multi touch pool only if it exists.
     if (FLAGS_cache_single_touch_ratio < 1 && e->GetSubCacheType() != MULTI_TOUCH &&
-        e->query_id != query_id) {
+        e->query_id != query_id && query_id != kLongScanQueryId) {
       autovector<LRUHandle*> multi_touch_eviction_list;
       EvictFromLRU(e->charge, &multi_touch_eviction_list, MULTI_TOUCH);
       for (auto entry : multi_touch_eviction_list) {
@@ -610,6 +617,9 @@ void LRUCache::Release(Cache::Handle* handle) {
         Unref(e);
         sub_cache->DecrementUsage(e->charge);
         last_reference = true;
+        if (metrics_) {
+          metrics_->evictions->Increment();
+        }
       } else {
         // put the item on the list to be potentially freed.
         LRU_Append(e);
@@ -785,7 +795,8 @@ class ShardedLRUCache : public Cache {
   }
 
   bool IsValidQueryId(const QueryId query_id) {
-    return query_id >= 0 || query_id == kInMultiTouchId || query_id == kNoCacheQueryId;
+    return query_id >= 0 || query_id == kInMultiTouchId || query_id == kNoCacheQueryId ||
+           query_id == kLongScanQueryId;
   }
 
  public:
@@ -463,6 +463,23 @@ TEST_F(CacheTest, EvictionPolicyMultiTouch) {
   ASSERT_LT(kCacheSize * FLAGS_cache_single_touch_ratio, cache_->GetUsage());
 }
 
+TEST_F(CacheTest, LongScans) {
+  QueryId qid1 = 1000;
+
+  // Values read repeatedly by long scans stay in the single touch cache.
+  ASSERT_OK(Insert(100, 101, 1, kLongScanQueryId));
+  ASSERT_FALSE(LookupAndCheckInMultiTouch(100, 101, kLongScanQueryId));
+
+  // Long scans don't move the values of other queries into the multi touch cache either.
+  ASSERT_OK(Insert(200, 201, 1, qid1));
+  ASSERT_FALSE(LookupAndCheckInMultiTouch(200, 201, kLongScanQueryId));
+  ASSERT_OK(Insert(200, 201, 1, kLongScanQueryId));
+  ASSERT_FALSE(LookupAndCheckInMultiTouch(200, 201, kLongScanQueryId));
+
+  // But values read by long scans are moved once another query uses them.
+  ASSERT_TRUE(LookupAndCheckInMultiTouch(100, 101, qid1));
+}
+
 TEST_F(CacheTest, HeavyEntries) {
   // Add a bunch of light and heavy entries and then count the combined
   // size of items still in the cache, which must be approximately the
@@ -52,12 +52,13 @@ class Logger;
 // shard blocks are allocated from the underlying main arena.
 class ConcurrentArena : public Allocator {
  public:
-  // block_size and huge_page_size are the same as for Arena (and are
+  // block_size, huge_page_size and mem_tracker are the same as for Arena (and are
   // in fact just passed to the constructor of arena_.  The core-local
   // shards compute their shard_block_size as a fraction of block_size
   // that varies according to the hardware concurrency level.
   explicit ConcurrentArena(size_t block_size = Arena::kMinBlockSize,
-                           size_t huge_page_size = 0);
+                           size_t huge_page_size = 0,
+                           std::shared_ptr<yb::MemTracker> mem_tracker = nullptr);
 
   char* Allocate(size_t bytes) override {
     return AllocateImpl(bytes, false /*force_arena*/,
@@ -95,7 +95,9 @@ ImmutableCFOptions::ImmutableCFOptions(const Options& options)
       num_levels(options.num_levels),
       optimize_filters_for_hits(options.optimize_filters_for_hits),
       listeners(options.listeners),
-      row_cache(options.row_cache) {}
+      row_cache(options.row_cache),
+      memtable_huge_page_size(options.memtable_huge_page_size),
+      memtable_mem_tracker(options.memtable_mem_tracker) {}
 
 ColumnFamilyOptions::ColumnFamilyOptions()
     : comparator(BytewiseComparator()),
@@ -415,6 +417,10 @@ void DBOptions::Dump(Logger* log) const {
       RHEADER(log, "                               Options.row_cache: None");
     }
   RHEADER(log, "                           Options.initial_seqno: %" PRIu64, initial_seqno);
+  RHEADER(log, "                 Options.memtable_huge_page_size: %" ROCKSDB_PRIszt,
+      memtable_huge_page_size);
+  RHEADER(log, "                  Options.min_subcompaction_size: %" PRIu64,
+      min_subcompaction_size);
 #ifndef ROCKSDB_LITE
   RHEADER(log, "       Options.wal_filter: %s",
       wal_filter ? wal_filter->Name() : "None");
@@ -344,6 +344,12 @@ static std::unordered_map<std::string, OptionTypeInfo> db_options_type_info = {
     {"max_file_size_for_compaction",
      {offsetof(struct DBOptions, max_file_size_for_compaction),
       OptionType::kUInt64T, OptionVerificationType::kNormal}},
+    {"memtable_huge_page_size",
+     {offsetof(struct DBOptions, memtable_huge_page_size), OptionType::kSizeT,
+      OptionVerificationType::kNormal}},
+    {"min_subcompaction_size",
+     {offsetof(struct DBOptions, min_subcompaction_size), OptionType::kUInt64T,
+      OptionVerificationType::kNormal}},
 };
 
 static std::unordered_map<std::string, OptionTypeInfo> cf_options_type_info = {
@@ -555,6 +561,9 @@ static std::unordered_map<std::string,
     {"min_keys_per_index_block",
      {offsetof(struct BlockBasedTableOptions, min_keys_per_index_block), OptionType::kSizeT,
       OptionVerificationType::kNormal}},
+    {"index_blocks_prefetch_count",
+     {offsetof(struct BlockBasedTableOptions, index_blocks_prefetch_count), OptionType::kSizeT,
+      OptionVerificationType::kNormal}},
     {"filter_policy",
      {offsetof(struct BlockBasedTableOptions, filter_policy),
       OptionType::kFilterPolicy, OptionVerificationType::kByName}},
@@ -489,7 +489,7 @@ TEST_F(OptionsTest, GetBlockBasedTableOptionsFromString) {
             "block_cache=1M;block_cache_compressed=1k;block_size=1024;filter_block_size=4096;"
             "block_size_deviation=8;block_restart_interval=4;index_block_size=16384;"
             "min_keys_per_index_block=16;filter_policy=bloomfilter:4:true;whole_key_filtering=1;"
-            "skip_table_builder_flush=1",
+            "skip_table_builder_flush=1;index_blocks_prefetch_count=4",
             &new_opt));
   ASSERT_TRUE(new_opt.cache_index_and_filter_blocks);
   ASSERT_EQ(new_opt.index_type, IndexType::kHashSearch);
@@ -506,6 +506,7 @@ TEST_F(OptionsTest, GetBlockBasedTableOptionsFromString) {
   ASSERT_EQ(new_opt.block_restart_interval, 4);
   ASSERT_EQ(new_opt.index_block_size, 16384UL);
   ASSERT_EQ(new_opt.min_keys_per_index_block, 16);
+  ASSERT_EQ(new_opt.index_blocks_prefetch_count, 4);
   ASSERT_TRUE(new_opt.filter_policy != nullptr);
   ASSERT_TRUE(new_opt.skip_table_builder_flush);
 
@@ -1622,7 +1623,7 @@ Status GetFromString(BlockBasedTableOptions* source, BlockBasedTableOptions* des
       "block_cache=1M;block_cache_compressed=1k;block_size=1024;filter_block_size=16384;"
       "block_size_deviation=8;block_restart_interval=4; "
       "index_block_restart_interval=4;index_block_size=16384;min_keys_per_index_block=16;"
-      "filter_policy=bloomfilter:4:true;whole_key_filtering=1;"
+      "index_blocks_prefetch_count=4;filter_policy=bloomfilter:4:true;whole_key_filtering=1;"
       "skip_table_builder_flush=1;format_version=1;"
       "hash_index_allow_collision=false;";
 
@@ -1696,6 +1697,8 @@ Status GetFromString(DBOptions* source, DBOptions* destination) {
       "access_hint_on_compaction_start=NONE;"
       "max_file_size_for_compaction=123;"
       "initial_seqno=432;"
+      "memtable_huge_page_size=2097152;"
+      "min_subcompaction_size=1048576;"
       "num_reserved_small_compaction_threads=-1;"
       "compaction_size_threshold_bytes=18446744073709551615;"
       "info_log_level=DEBUG_LEVEL;";
@@ -1924,6 +1927,7 @@ TEST_F(OptionsParserTest, DBOptionsAllFieldsSettable) {
       BLACKLIST_ENTRY(DBOptions, wal_filter),
       BLACKLIST_ENTRY(DBOptions, boundary_extractor),
       BLACKLIST_ENTRY(DBOptions, mem_table_flush_filter_factory),
+      BLACKLIST_ENTRY(DBOptions, memtable_mem_tracker),
   };
 
   TestAllFieldsSettable<DBOptions>(kDBOptionsBlacklist);
@@ -45,7 +45,6 @@
 #include "yb/rpc/rpc_introspection.pb.h"
 #include "yb/rpc/messenger.h"
 #include "yb/rpc/reactor.h"
-#include "yb/rpc/growable_buffer.h"
 #include "yb/rpc/rpc_controller.h"
 
 #include "yb/util/trace.h"
@@ -55,7 +54,6 @@ using std::shared_ptr;
 using std::vector;
 using strings::Substitute;
 
-DEFINE_uint64(rpc_initial_buffer_size, 4096, "Initial buffer size used for RPC calls");
 DEFINE_uint64(rpc_connection_timeout_ms, 15000, "Timeout for RPC connection operations");
 
 METRIC_DEFINE_histogram(
@@ -79,7 +77,7 @@ Connection::Connection(Reactor* reactor,
       remote_(remote),
       direction_(direction),
       last_activity_time_(CoarseMonoClock::Now()),
-      read_buffer_(FLAGS_rpc_initial_buffer_size, context->BufferLimit()),
+      read_buffer_(&reactor->read_buffer_pool(), context->BufferLimit()),
       context_(std::move(context)) {
   const auto metric_entity = reactor->messenger()->metric_entity();
   handler_latency_outbound_transfer_ = metric_entity ?
@@ -339,23 +337,13 @@ Status Connection::ReadHandler() {
 }
 
 Result<bool> Connection::Receive() {
-  RETURN_NOT_OK(read_buffer_.PrepareRead());
-
-  size_t max_receive = context_->MaxReceive(Slice(read_buffer_.begin(), read_buffer_.size()));
-  DCHECK_GT(max_receive, read_buffer_.size());
-  // This should not happen, but at least avoid crash if something went wrong.
-  if (PREDICT_FALSE(max_receive <= read_buffer_.size())) {
-    LOG(ERROR) << "Max receive: " << max_receive << ", less existing data: " << read_buffer_.size();
-    max_receive = std::numeric_limits<size_t>::max();
-  } else {
-    max_receive -= read_buffer_.size();
-  }
-  max_receive = std::min(max_receive, static_cast<size_t>(std::numeric_limits<int32_t>::max()));
-  max_receive = std::min(max_receive, read_buffer_.capacity_left());
+  const size_t pending_call_size =
+      read_buffer_.empty() ? 0 : context_->PendingCallSize(read_buffer_.FirstBlockData());
+  IoVecs iov;
+  RETURN_NOT_OK(read_buffer_.PrepareRead(pending_call_size, &iov));
 
-  const int32_t remaining_buf_capacity = static_cast<int32_t>(max_receive);
   int32_t nread = 0;
-  auto status = socket_.Recv(read_buffer_.write_position(), remaining_buf_capacity, &nread);
+  auto status = socket_.Recvv(iov.data(), static_cast<int>(iov.size()), &nread);
   if (!status.ok()) {
     if (Socket::IsTemporarySocketError(status)) {
       return false;
@@ -374,18 +362,22 @@ Result<bool> Connection::TryProcessCalls() {
     return false;
   }
 
-  Slice bytes_to_process(read_buffer_.begin(), read_buffer_.size());
   size_t consumed = 0;
-  auto result = context_->ProcessCalls(shared_from_this(), bytes_to_process, &consumed);
-  if (PREDICT_FALSE(!result.ok())) {
-    LOG(WARNING) << ToString() << " command sequence failure: " << result.ToString();
-    return result;
+  {
+    // Calls keep references to the blocks they were parsed from, so data is not copied.
+    // Our own reference should be dropped before Consume, so the block could be reused.
+    auto data = read_buffer_.Data();
+    auto result = context_->ProcessCalls(shared_from_this(), data, &consumed);
+    if (PREDICT_FALSE(!result.ok())) {
+      LOG(WARNING) << ToString() << " command sequence failure: " << result.ToString();
+      return result;
+    }
   }
   read_buffer_.Consume(consumed);
   return true;
 }
 
-Status Connection::HandleCallResponse(Slice call_data) {
+Status Connection::HandleCallResponse(const RefCntSlice& call_data) {
   DCHECK(reactor_->IsCurrentThread());
   CallResponse resp;
   RETURN_NOT_OK(resp.ParseFrom(call_data));
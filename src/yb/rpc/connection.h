@@ -53,6 +53,7 @@
 #include "yb/rpc/connection_context.h"
 #include "yb/rpc/outbound_call.h"
 #include "yb/rpc/inbound_call.h"
+#include "yb/rpc/read_buffer.h"
 #include "yb/rpc/server_event.h"
 
 #include "yb/util/enums.h"
@@ -69,7 +70,6 @@ namespace rpc {
 
 class Connection;
 class DumpRunningRpcsRequestPB;
-class GrowableBuffer;
 class Reactor;
 class ReactorTask;
 
@@ -179,7 +179,7 @@ class Connection final : public std::enable_shared_from_this<Connection> {
   // An incoming packet has completed on the client side. This parses the
   // call response, looks up the CallAwaitingResponse, and calls the
   // client callback.
-  CHECKED_STATUS HandleCallResponse(Slice slice);
+  CHECKED_STATUS HandleCallResponse(const RefCntSlice& call_data);
 
   ConnectionContext& context() { return *context_; }
 
@@ -259,7 +259,7 @@ class Connection final : public std::enable_shared_from_this<Connection> {
   ev::timer timer_;
 
   // Data received on this connection that has not been processed yet.
-  GrowableBuffer read_buffer_;
+  ReadBuffer read_buffer_;
 
   // sending_* contain bytes and calls we are currently sending to socket
   std::deque<RefCntBuffer> sending_;
@@ -17,6 +17,7 @@
 #include "yb/rpc/rpc_fwd.h"
 #include "yb/rpc/rpc_introspection.pb.h"
 
+#include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/status.h"
 
 namespace yb {
@@ -28,10 +29,11 @@ class ConnectionContext {
  public:
   virtual ~ConnectionContext() {}
 
-  // Split slice into separate calls and invoke them.
+  // Split data into separate calls and invoke them.
+  // Calls could keep references to parts of `data` instead of copying them.
   // Return number of processed bytes in `consumed`.
   virtual CHECKED_STATUS ProcessCalls(const ConnectionPtr& connection,
-                                      Slice slice,
+                                      const RefCntSlice& data,
                                       size_t* consumed) = 0;
 
   // Dump information about status of this connection context to protobuf.
@@ -44,9 +46,10 @@ class ConnectionContext {
   // The reading buffer will never be larger than this limit.
   virtual size_t BufferLimit() = 0;
 
-  // We could limit receiving of too big amount of data, if packet is big enough to avoid moving
-  // of remainder of the next packet.
-  virtual size_t MaxReceive(Slice existing_data) { return std::numeric_limits<size_t>::max(); }
+  // Returns size of the call that starts at the beginning of `pending_data`, or 0 if it is unknown.
+  // Big calls of known size are received into a dedicated block of the read buffer, so they
+  // don't have to be gathered from several blocks.
+  virtual size_t PendingCallSize(Slice pending_data) { return 0; }
 
   virtual void QueueResponse(const ConnectionPtr& connection, InboundCallPtr call) = 0;
 
@@ -43,7 +43,6 @@
 #include "yb/gutil/ref_counted.h"
 
 #include "yb/rpc/rpc_fwd.h"
-#include "yb/rpc/growable_buffer.h"
 #include "yb/rpc/rpc_call.h"
 #include "yb/rpc/remote_method.h"
 #include "yb/rpc/rpc_header.pb.h"
@@ -53,6 +52,7 @@
 
 #include "yb/util/faststring.h"
 #include "yb/util/monotime.h"
+#include "yb/util/net/net_fwd.h"
 #include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/slice.h"
 #include "yb/util/status.h"
@@ -144,11 +144,12 @@ class InboundCall : public RpcCall {
   void QueueResponse(bool is_success);
 
   // The serialized bytes of the request param protobuf. Set by ParseFrom().
-  // This references memory held by 'transfer_'.
+  // This references memory held by 'request_data_'.
   Slice serialized_request_;
 
-  // Data source of this call.
-  std::vector<char> request_data_;
+  // Data source of this call. Refers to the block of the connection read buffer that this call
+  // was received into.
+  RefCntSlice request_data_;
 
   // The trace buffer.
   scoped_refptr<Trace> trace_;
@@ -547,13 +547,13 @@ Status CallResponse::GetSidecar(int idx, Slice* sidecar) const {
   return Status::OK();
 }
 
-Status CallResponse::ParseFrom(Slice source) {
+Status CallResponse::ParseFrom(const RefCntSlice& source) {
   CHECK(!parsed_);
   Slice entire_message;
 
-  response_data_.assign(source.data(), source.end());
-  source = Slice(response_data_.data(), response_data_.size());
-  RETURN_NOT_OK(serialization::ParseYBMessage(source, &header_, &entire_message));
+  response_data_ = source;
+  RETURN_NOT_OK(serialization::ParseYBMessage(
+      response_data_.AsSlice(), &header_, &entire_message));
 
   // Use information from header to extract the payload slices.
   const size_t sidecars = header_.sidecar_offsets_size();
@@ -133,7 +133,7 @@ class CallResponse {
 
   // Parse the response received from a call. This must be called before any
   // other methods on this object.
-  CHECKED_STATUS ParseFrom(Slice source);
+  CHECKED_STATUS ParseFrom(const RefCntSlice& source);
 
   // Return true if the call succeeded.
   bool is_success() const {
@@ -165,16 +165,16 @@ class CallResponse {
   ResponseHeader header_;
 
   // The slice of data for the encoded protobuf response.
-  // This slice refers to memory allocated by transfer_
+  // This slice refers to memory held by response_data_.
   Slice serialized_response_;
 
-  // Slices of data for rpc sidecars. They point into memory owned by transfer_.
+  // Slices of data for rpc sidecars. They point into memory held by response_data_.
   // Number of sidecars chould be obtained from header_.
   std::array<Slice, kMaxSidecarSlices> sidecar_slices_;
 
-  // The incoming transfer data - retained because serialized_response_
+  // The incoming data - retained because serialized_response_
   // and sidecar_slices_ refer into its data.
-  std::vector<uint8_t> response_data_;
+  RefCntSlice response_data_;
 
   DISALLOW_COPY_AND_ASSIGN(CallResponse);
 };
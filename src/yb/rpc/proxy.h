@@ -38,7 +38,6 @@
 #include <string>
 
 #include "yb/gutil/atomicops.h"
-#include "yb/rpc/growable_buffer.h"
 #include "yb/rpc/outbound_call.h"
 #include "yb/rpc/response_callback.h"
 #include "yb/rpc/rpc_controller.h"
@@ -124,8 +123,6 @@ class Proxy {
   bool IsServiceLocal() const { return call_local_service_; }
 
  private:
-  GrowableBuffer& Buffer() const;
-
   const std::string service_name_;
   std::shared_ptr<Messenger> messenger_;
   std::vector<ConnectionId> conn_ids_;
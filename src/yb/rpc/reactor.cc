@@ -68,13 +68,24 @@
 #include "yb/util/trace.h"
 #include "yb/util/status.h"
 #include "yb/util/net/socket.h"
+#include "yb/util/size_literals.h"
 
 using std::string;
 using std::shared_ptr;
+using yb::operator"" _KB;
 
 DECLARE_string(local_ip_for_outbound_sockets);
 DECLARE_int32(num_connections_to_server);
 
+DEFINE_uint64(rpc_read_buffer_block_size, 16_KB,
+              "Size of blocks used to receive data from RPC connections. Calls that are known to "
+              "be bigger are received into a dedicated block.");
+TAG_FLAG(rpc_read_buffer_block_size, advanced);
+
+DEFINE_uint64(rpc_read_buffer_max_cached_blocks, 256,
+              "Max number of free receive blocks cached by each reactor.");
+TAG_FLAG(rpc_read_buffer_max_cached_blocks, advanced);
+
 namespace yb {
 namespace rpc {
 
@@ -117,7 +128,8 @@ Reactor::Reactor(const shared_ptr<Messenger>& messenger,
     cur_time_(CoarseMonoClock::Now()),
     last_unused_tcp_scan_(cur_time_),
     connection_keepalive_time_(bld.connection_keepalive_time()),
-    coarse_timer_granularity_(bld.coarse_timer_granularity()) {
+    coarse_timer_granularity_(bld.coarse_timer_granularity()),
+    read_buffer_pool_(FLAGS_rpc_read_buffer_block_size, FLAGS_rpc_read_buffer_max_cached_blocks) {
   static std::once_flag libev_once;
   std::call_once(libev_once, DoInitLibEv);
 
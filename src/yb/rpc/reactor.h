@@ -49,6 +49,7 @@
 #include "yb/gutil/ref_counted.h"
 
 #include "yb/rpc/outbound_call.h"
+#include "yb/rpc/read_buffer.h"
 
 #include "yb/util/thread.h"
 #include "yb/util/locks.h"
@@ -293,6 +294,10 @@ class Reactor {
     ScheduleReactorTask(MakeFunctorReactorTask(f));
   }
 
+  // Pool of blocks used to receive data from connections of this reactor.
+  // Must be used only from the reactor thread.
+  ReadBufferPool& read_buffer_pool() { return read_buffer_pool_; }
+
  private:
   friend class Connection;
   friend class AssignOutboundCallTask;
@@ -390,6 +395,8 @@ class Reactor {
   // Scan for idle connections on this granularity.
   CoarseMonoClock::Duration coarse_timer_granularity_;
 
+  ReadBufferPool read_buffer_pool_;
+
   simple_spinlock outbound_queue_lock_;
   bool outbound_queue_stopped_ = false;
   // We found that should shutdown, but not all connections are ready for it.
@@ -0,0 +1,144 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+
+#include <deque>
+
+#include <gtest/gtest.h>
+
+#include "yb/rpc/read_buffer.h"
+
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace rpc {
+
+class ReadBufferTest : public YBTest {
+ protected:
+  // Emulates receive of `len` bytes, filling them with consecutive values of counter_.
+  // Returns number of bytes actually received.
+  size_t Receive(ReadBuffer* buffer, size_t len, size_t pending_call_size = 0) {
+    IoVecs iov;
+    EXPECT_OK(buffer->PrepareRead(pending_call_size, &iov));
+    size_t received = 0;
+    for (const auto& entry : iov) {
+      auto* data = static_cast<uint8_t*>(entry.iov_base);
+      for (size_t i = 0; i != entry.iov_len && received != len; ++i, ++received) {
+        data[i] = static_cast<uint8_t>(counter_++);
+      }
+    }
+    buffer->DataAppended(received);
+    return received;
+  }
+
+  ReadBufferPool pool_{kBlockSize, 16};
+  size_t counter_ = 0;
+
+  static constexpr size_t kBlockSize = 0x100;
+  static constexpr size_t kSizeLimit = 0x1000;
+};
+
+constexpr size_t ReadBufferTest::kBlockSize;
+constexpr size_t ReadBufferTest::kSizeLimit;
+
+TEST_F(ReadBufferTest, TestLimit) {
+  ReadBuffer buffer(&pool_, kSizeLimit);
+
+  while (buffer.size() != buffer.limit()) {
+    Receive(&buffer, kBlockSize / 3);
+  }
+
+  IoVecs iov;
+  ASSERT_NOK(buffer.PrepareRead(0, &iov));
+}
+
+TEST_F(ReadBufferTest, TestConsume) {
+  ReadBuffer buffer(&pool_, kSizeLimit);
+
+  unsigned int seed = SeedRandom();
+  size_t consumed = 0;
+  // Emulates calls that keep references to the processed data, with offsets of their first bytes.
+  std::deque<std::pair<size_t, RefCntSlice>> calls;
+
+  for (auto i = 10000; i--;) {
+    size_t step = 1 + rand_r(&seed) % (buffer.limit() - buffer.size());
+    Receive(&buffer, step);
+    ASSERT_EQ(consumed + buffer.size(), counter_);
+
+    // Data referenced by calls should not be overwritten by subsequent receives.
+    for (const auto& call : calls) {
+      for (size_t j = 0; j != call.second.size(); ++j) {
+        ASSERT_EQ(static_cast<uint8_t>(call.first + j), call.second.data()[j]);
+      }
+    }
+
+    size_t consume_size = 1 + rand_r(&seed) % buffer.size();
+    {
+      auto data = buffer.Data();
+      ASSERT_EQ(data.size(), buffer.size());
+      for (size_t j = 0; j != data.size(); ++j) {
+        ASSERT_EQ(static_cast<uint8_t>(consumed + j), data.data()[j]) << "Byte " << j;
+      }
+      calls.emplace_back(consumed, data.SubSlice(data.data(), consume_size));
+      if (calls.size() > 10) {
+        calls.pop_front();
+      }
+    }
+
+    buffer.Consume(consume_size);
+    consumed += consume_size;
+    ASSERT_EQ(consumed + buffer.size(), counter_);
+  }
+}
+
+TEST_F(ReadBufferTest, TestZeroCopy) {
+  ReadBuffer buffer(&pool_, kSizeLimit);
+
+  ASSERT_EQ(kBlockSize / 2, Receive(&buffer, kBlockSize / 2));
+  auto first = buffer.Data();
+  const uint8_t* first_data = first.data();
+  buffer.Consume(first.size());
+
+  // Next data should be received into the same block right after the processed data.
+  ASSERT_EQ(kBlockSize / 4, Receive(&buffer, kBlockSize / 4));
+  auto second = buffer.Data();
+  ASSERT_EQ(first_data + kBlockSize / 2, second.data());
+  ASSERT_EQ(first.holder().data(), second.holder().data());
+}
+
+TEST_F(ReadBufferTest, TestBigCall) {
+  ReadBuffer buffer(&pool_, kSizeLimit);
+
+  const size_t kCallSize = kBlockSize * 5;
+  Receive(&buffer, 10);
+
+  // When the size of the call is known, it is received into a single block of sufficient size.
+  IoVecs iov;
+  ASSERT_OK(buffer.PrepareRead(kCallSize, &iov));
+  ASSERT_FALSE(iov.empty());
+  ASSERT_GE(iov[0].iov_len, kCallSize - 10);
+
+  while (buffer.size() < kCallSize) {
+    Receive(&buffer, kCallSize - buffer.size(), kCallSize);
+  }
+  auto data = buffer.Data();
+  ASSERT_EQ(kCallSize, data.size());
+  ASSERT_EQ(kCallSize, data.holder().size());
+  for (size_t j = 0; j != data.size(); ++j) {
+    ASSERT_EQ(static_cast<uint8_t>(j), data.data()[j]);
+  }
+}
+
+} // namespace rpc
+} // namespace yb
@@ -0,0 +1,215 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+
+#include "yb/rpc/read_buffer.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+#include <glog/logging.h>
+
+namespace yb {
+namespace rpc {
+
+namespace {
+
+// Max number of spare blocks used by a single read.
+constexpr size_t kMaxReadBlocks = 4;
+
+} // namespace
+
+ReadBufferPool::ReadBufferPool(size_t block_size, size_t max_cached_blocks)
+    : block_size_(block_size), max_cached_blocks_(max_cached_blocks) {
+}
+
+RefCntBuffer ReadBufferPool::Take() {
+  if (free_blocks_.empty()) {
+    return RefCntBuffer(block_size_);
+  }
+  auto result = std::move(free_blocks_.back());
+  free_blocks_.pop_back();
+  return result;
+}
+
+void ReadBufferPool::Release(RefCntBuffer block) {
+  if (block.unique() && block.size() == block_size_ &&
+      free_blocks_.size() < max_cached_blocks_) {
+    free_blocks_.push_back(std::move(block));
+  }
+}
+
+ReadBuffer::ReadBuffer(ReadBufferPool* pool, size_t limit)
+    : pool_(pool), limit_(limit) {
+}
+
+Slice ReadBuffer::FirstBlockData() const {
+  if (blocks_.empty()) {
+    return Slice();
+  }
+  const auto& block = blocks_.front();
+  const size_t end = blocks_.size() == 1 ? filled_ : block.size();
+  return Slice(block.udata() + pos_, end - pos_);
+}
+
+size_t ReadBuffer::FreeSpaceInLastBlock() const {
+  return blocks_.empty() ? 0 : blocks_.back().size() - filled_;
+}
+
+Status ReadBuffer::PrepareRead(size_t pending_call_size, IoVecs* iov) {
+  if (size_ >= limit_) {
+    return STATUS_FORMAT(
+        RuntimeError, "Prepare read when buffer already full size: $0, limit: $1", size_, limit_);
+  }
+
+  if (size_ == 0) {
+    // Calls that referenced the last block could be already processed since the last check.
+    ResetProcessedBlock();
+  } else if (pending_call_size > pool_->block_size() && pending_call_size <= limit_ &&
+             (blocks_.size() != 1 || blocks_.front().size() - pos_ < pending_call_size)) {
+    // The call is known to be big, receive it into a dedicated block, so it is not gathered
+    // from several blocks later.
+    Gather(pending_call_size);
+  }
+
+  size_t left = std::min<size_t>(limit_ - size_, std::numeric_limits<int32_t>::max());
+  iov->clear();
+  const size_t free_space = FreeSpaceInLastBlock();
+  if (free_space != 0) {
+    const size_t len = std::min(free_space, left);
+    iov->push_back(iovec{blocks_.back().data() + filled_, len});
+    left -= len;
+  }
+  size_t idx = 0;
+  while (left != 0 && idx != kMaxReadBlocks) {
+    if (idx == spare_blocks_.size()) {
+      spare_blocks_.push_back(pool_->Take());
+    }
+    auto& block = spare_blocks_[idx++];
+    const size_t len = std::min(block.size(), left);
+    iov->push_back(iovec{block.data(), len});
+    left -= len;
+  }
+  return Status::OK();
+}
+
+void ReadBuffer::DataAppended(size_t len) {
+  size_ += len;
+  const size_t appended_to_last = std::min(FreeSpaceInLastBlock(), len);
+  filled_ += appended_to_last;
+  len -= appended_to_last;
+
+  size_t used_spare_blocks = 0;
+  while (len != 0) {
+    if (used_spare_blocks == spare_blocks_.size()) {
+      LOG(DFATAL) << "Data appended over prepared space: " << len << " extra bytes";
+      size_ -= len;
+      break;
+    }
+    auto& block = spare_blocks_[used_spare_blocks++];
+    if (blocks_.empty()) {
+      pos_ = 0;
+    }
+    filled_ = std::min(block.size(), len);
+    len -= filled_;
+    blocks_.push_back(std::move(block));
+  }
+  spare_blocks_.erase(spare_blocks_.begin(), spare_blocks_.begin() + used_spare_blocks);
+}
+
+RefCntSlice ReadBuffer::Data() {
+  if (blocks_.empty()) {
+    return RefCntSlice();
+  }
+  if (blocks_.size() > 1) {
+    // Reserve extra space, so the rest of an incomplete call is received into the same block.
+    // Doubling keeps the total amount of copying linear in the size of the call.
+    Gather(std::max({size_, pool_->block_size(), std::min(size_ * 2, limit_)}));
+  }
+  const auto& block = blocks_.front();
+  return RefCntSlice(block, Slice(block.udata() + pos_, size_));
+}
+
+void ReadBuffer::Consume(size_t count) {
+  if (count > size_) {
+    LOG(DFATAL) << "Consume more bytes than contained: " << size_ << " vs " << count;
+    count = size_;
+  }
+  size_ -= count;
+  pos_ += count;
+  while (blocks_.size() > 1 && pos_ >= blocks_.front().size()) {
+    pos_ -= blocks_.front().size();
+    pool_->Release(std::move(blocks_.front()));
+    blocks_.pop_front();
+  }
+  if (size_ == 0) {
+    ResetProcessedBlock();
+  }
+}
+
+void ReadBuffer::ResetProcessedBlock() {
+  DCHECK_EQ(size_, 0U);
+  if (blocks_.empty()) {
+    return;
+  }
+  DCHECK_EQ(blocks_.size(), 1U);
+  if (blocks_.back().unique()) {
+    // Nobody references data in this block, so start filling it from the beginning.
+    pos_ = 0;
+    filled_ = 0;
+  } else if (FreeSpaceInLastBlock() == 0) {
+    pool_->Release(std::move(blocks_.back()));
+    blocks_.clear();
+    pos_ = 0;
+    filled_ = 0;
+  }
+}
+
+void ReadBuffer::Gather(size_t capacity) {
+  DCHECK_GE(capacity, size_);
+  RefCntBuffer block = capacity == pool_->block_size() ? pool_->Take() : RefCntBuffer(capacity);
+  auto* out = block.data();
+  size_t left = size_;
+  size_t pos = pos_;
+  for (auto& source : blocks_) {
+    if (left == 0) {
+      break;
+    }
+    const size_t len = std::min(source.size() - pos, left);
+    memcpy(out, source.data() + pos, len);
+    out += len;
+    left -= len;
+    pos = 0;
+  }
+  for (auto& source : blocks_) {
+    pool_->Release(std::move(source));
+  }
+  blocks_.clear();
+  blocks_.push_back(std::move(block));
+  pos_ = 0;
+  filled_ = size_;
+}
+
+void ReadBuffer::DumpTo(std::ostream& out) const {
+  out << "size: " << size_ << ", blocks: " << blocks_.size() << ", limit: " << limit_;
+}
+
+std::ostream& operator<<(std::ostream& out, const ReadBuffer& buffer) {
+  buffer.DumpTo(out);
+  return out;
+}
+
+} // namespace rpc
+} // namespace yb
@@ -0,0 +1,133 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+#ifndef YB_RPC_READ_BUFFER_H
+#define YB_RPC_READ_BUFFER_H
+
+#include <sys/uio.h>
+
+#include <deque>
+#include <iosfwd>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
+
+#include "yb/util/ref_cnt_buffer.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace rpc {
+
+typedef boost::container::small_vector<iovec, 4> IoVecs;
+
+// Pool of fixed size blocks used by read buffers of connections of a single reactor.
+// Not thread safe, should be used only from the reactor thread.
+class ReadBufferPool {
+ public:
+  ReadBufferPool(size_t block_size, size_t max_cached_blocks);
+
+  size_t block_size() const { return block_size_; }
+
+  // Returns a block of block_size() bytes, reusing a cached one if possible.
+  RefCntBuffer Take();
+
+  // Returns the block to the pool. The block is cached only if nobody else references it,
+  // otherwise it is freed when the last reference is dropped.
+  void Release(RefCntBuffer block);
+
+ private:
+  const size_t block_size_;
+  const size_t max_cached_blocks_;
+  std::vector<RefCntBuffer> free_blocks_;
+};
+
+// Receive buffer of a connection. Consists of a chain of blocks, usually taken from the reactor
+// pool. Data is received into the free space of the blocks using scatter read.
+//
+// Processed data is never moved: calls parsed from the buffer keep references to the blocks they
+// were parsed from, and fully processed blocks are dropped from the chain. The only case when
+// data is copied is when unprocessed data spans several blocks, since parsers require
+// contiguous input. To keep the total amount of copying linear, gathered blocks are allocated
+// with extra capacity, and calls that are known to be big are received into a dedicated block of
+// the appropriate size.
+class ReadBuffer {
+ public:
+  ReadBuffer(ReadBufferPool* pool, size_t limit);
+
+  ReadBuffer(const ReadBuffer&) = delete;
+  void operator=(const ReadBuffer&) = delete;
+
+  // Whether there is unprocessed data in buffer.
+  bool empty() const { return size_ == 0; }
+
+  // Number of unprocessed bytes.
+  size_t size() const { return size_; }
+
+  size_t limit() const { return limit_; }
+
+  // Unprocessed data that is stored in the first block.
+  Slice FirstBlockData() const;
+
+  // Fills `iov` with free space that could be used to receive data.
+  // pending_call_size - size of the call at the beginning of unprocessed data, if it is known,
+  // or 0 otherwise.
+  CHECKED_STATUS PrepareRead(size_t pending_call_size, IoVecs* iov);
+
+  // Mark next `len` bytes of space returned by PrepareRead as received.
+  void DataAppended(size_t len);
+
+  // Returns all unprocessed data as a single slice, gathering it to a single block if necessary.
+  RefCntSlice Data();
+
+  // Removes first `count` bytes of unprocessed data.
+  void Consume(size_t count);
+
+  void DumpTo(std::ostream& out) const;
+
+ private:
+  size_t FreeSpaceInLastBlock() const;
+
+  // Copies all unprocessed data to a new block with at least `capacity` bytes.
+  void Gather(size_t capacity);
+
+  // Called when all data is processed, to reuse the last block or return it to the pool.
+  void ResetProcessedBlock();
+
+  ReadBufferPool* const pool_;
+
+  // Max number of unprocessed bytes.
+  const size_t limit_;
+
+  // Blocks that contain unprocessed data. All blocks except the last one are completely filled.
+  std::deque<RefCntBuffer> blocks_;
+
+  // Blocks prepared for the next read, but not filled yet.
+  std::vector<RefCntBuffer> spare_blocks_;
+
+  // Offset of the first unprocessed byte in the first block.
+  size_t pos_ = 0;
+
+  // Number of bytes filled in the last block.
+  size_t filled_ = 0;
+
+  // Number of unprocessed bytes.
+  size_t size_ = 0;
+};
+
+std::ostream& operator<<(std::ostream& out, const ReadBuffer& buffer);
+
+} // namespace rpc
+} // namespace yb
+
+#endif // YB_RPC_READ_BUFFER_H
@@ -59,5 +59,9 @@ ServiceIf::~ServiceIf() {
 void ServiceIf::Shutdown() {
 }
 
+ThreadPoolTaskPriority ServiceIf::CallPriority(const InboundCall& call) const {
+  return ThreadPoolTaskPriority::kNormal;
+}
+
 } // namespace rpc
 } // namespace yb
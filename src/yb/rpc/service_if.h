@@ -37,6 +37,7 @@
 #include "yb/gutil/macros.h"
 #include "yb/gutil/ref_counted.h"
 #include "yb/rpc/rpc_fwd.h"
+#include "yb/rpc/thread_pool.h"
 #include "yb/util/metrics.h"
 #include "yb/util/net/sockaddr.h"
 
@@ -68,6 +69,10 @@ class ServiceIf {
 
   virtual void Shutdown();
   virtual std::string service_name() const = 0;
+
+  // Priority of the thread pool task that handles 'call'. Services that must stay responsive
+  // under load, e.g. Raft, should return a higher priority than bulk data transfers.
+  virtual ThreadPoolTaskPriority CallPriority(const InboundCall& call) const;
 };
 
 }  // namespace rpc
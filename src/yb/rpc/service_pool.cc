@@ -32,6 +32,7 @@
 
 #include "yb/rpc/service_pool.h"
 
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
@@ -48,6 +49,7 @@
 
 #include "yb/gutil/strings/substitute.h"
 #include "yb/util/metrics.h"
+#include "yb/util/monotime.h"
 #include "yb/util/status.h"
 #include "yb/util/thread.h"
 #include "yb/util/trace.h"
@@ -61,6 +63,27 @@ METRIC_DEFINE_histogram(server, rpc_incoming_queue_time,
                         "Number of microseconds incoming RPC requests spend in the worker queue",
                         60000000LU, 3);
 
+METRIC_DEFINE_histogram(server, rpc_incoming_queue_time_high_priority,
+                        "RPC Queue Time (High Priority)",
+                        yb::MetricUnit::kMicroseconds,
+                        "Number of microseconds high priority incoming RPC requests, e.g. Raft "
+                        "requests, spend in the worker queue",
+                        60000000LU, 3);
+
+METRIC_DEFINE_histogram(server, rpc_incoming_queue_time_normal_priority,
+                        "RPC Queue Time (Normal Priority)",
+                        yb::MetricUnit::kMicroseconds,
+                        "Number of microseconds normal priority incoming RPC requests spend in "
+                        "the worker queue",
+                        60000000LU, 3);
+
+METRIC_DEFINE_histogram(server, rpc_incoming_queue_time_low_priority,
+                        "RPC Queue Time (Low Priority)",
+                        yb::MetricUnit::kMicroseconds,
+                        "Number of microseconds low priority incoming RPC requests, e.g. bulk "
+                        "data transfers, spend in the worker queue",
+                        60000000LU, 3);
+
 METRIC_DEFINE_counter(server, rpcs_timed_out_in_queue,
                       "RPC Queue Timeouts",
                       yb::MetricUnit::kRequests,
@@ -80,8 +103,8 @@ namespace {
 
 class InboundCallTask final {
  public:
-  InboundCallTask(ServicePoolImpl* pool, InboundCallPtr call)
-      : pool_(pool), call_(std::move(call)) {
+  InboundCallTask(ServicePoolImpl* pool, InboundCallPtr call, ThreadPoolTaskPriority priority)
+      : pool_(pool), call_(std::move(call)), priority_(priority), enqueue_time_(MonoTime::Now()) {
   }
 
   void Run();
@@ -90,6 +113,8 @@ class InboundCallTask final {
  private:
   ServicePoolImpl* pool_;
   InboundCallPtr call_;
+  ThreadPoolTaskPriority priority_;
+  MonoTime enqueue_time_;
 };
 
 } // namespace
@@ -106,6 +131,12 @@ class ServicePoolImpl {
         rpcs_timed_out_in_queue_(METRIC_rpcs_timed_out_in_queue.Instantiate(entity)),
         rpcs_queue_overflow_(METRIC_rpcs_queue_overflow.Instantiate(entity)),
         tasks_pool_(max_tasks) {
+    priority_queue_time_[util::to_underlying(ThreadPoolTaskPriority::kHigh)] =
+        METRIC_rpc_incoming_queue_time_high_priority.Instantiate(entity);
+    priority_queue_time_[util::to_underlying(ThreadPoolTaskPriority::kNormal)] =
+        METRIC_rpc_incoming_queue_time_normal_priority.Instantiate(entity);
+    priority_queue_time_[util::to_underlying(ThreadPoolTaskPriority::kLow)] =
+        METRIC_rpc_incoming_queue_time_low_priority.Instantiate(entity);
   }
 
   ~ServicePoolImpl() {
@@ -122,7 +153,8 @@ class ServicePoolImpl {
   void Enqueue(InboundCallPtr call) {
     TRACE_TO(call->trace(), "Inserting onto call queue");
 
-    if (!tasks_pool_.Enqueue(thread_pool_, this, std::move(call))) {
+    const auto priority = service_->CallPriority(*call);
+    if (!tasks_pool_.Enqueue(thread_pool_, priority, this, std::move(call), priority)) {
       Overflow(call, "service", tasks_pool_.size());
     }
   }
@@ -169,6 +201,11 @@ class ServicePoolImpl {
     call->RespondFailure(ErrorStatusPB::FATAL_SERVER_SHUTTING_DOWN, response_status);
   }
 
+  // Records the time that a call of 'priority' waited for a worker.
+  void RecordQueueTime(ThreadPoolTaskPriority priority, const MonoDelta& queue_time) {
+    priority_queue_time_[util::to_underlying(priority)]->Increment(queue_time.ToMicroseconds());
+  }
+
   void Handle(InboundCallPtr incoming) {
     incoming->RecordHandlingStarted(incoming_queue_time_);
     ADOPT_TRACE(incoming->trace());
@@ -197,12 +234,14 @@ class ServicePoolImpl {
   scoped_refptr<Histogram> incoming_queue_time_;
   scoped_refptr<Counter> rpcs_timed_out_in_queue_;
   scoped_refptr<Counter> rpcs_queue_overflow_;
+  std::array<scoped_refptr<Histogram>, kThreadPoolTaskPriorityMapSize> priority_queue_time_;
 
   std::atomic<bool> closing_ = {false};
   TasksPool<InboundCallTask> tasks_pool_;
 };
 
 void InboundCallTask::Run() {
+  pool_->RecordQueueTime(priority_, MonoTime::Now() - enqueue_time_);
   pool_->Handle(call_);
 }
 
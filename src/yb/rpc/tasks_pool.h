@@ -18,11 +18,11 @@
 #ifndef YB_RPC_TASKS_POOL_H
 #define YB_RPC_TASKS_POOL_H
 
+#include "yb/rpc/thread_pool.h"
+
 namespace yb {
 namespace rpc {
 
-class ThreadPool;
-
 // Tasks pool that could be used in conjunction with ThreadPool, to preallocate a buffer for a fixed
 // number of tasks and avoid allocating memory for each task separately.
 template <class Task>
@@ -35,12 +35,12 @@ class TasksPool {
   }
 
   template <class... Args>
-  bool Enqueue(ThreadPool* thread_pool, Args&&... args) {
+  bool Enqueue(ThreadPool* thread_pool, ThreadPoolTaskPriority priority, Args&&... args) {
     WrappedTask* task = nullptr;
     if (queue_.pop(task)) {
       task->pool = this;
       new (&task->storage) Task(std::forward<Args>(args)...);
-      thread_pool->Enqueue(task);
+      thread_pool->Enqueue(task, priority);
       return true;
     } else {
       return false;
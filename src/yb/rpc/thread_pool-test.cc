@@ -14,7 +14,9 @@
 //
 
 #include <atomic>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -23,6 +25,8 @@
 #include "yb/util/test_util.h"
 #include "yb/util/countdown_latch.h"
 
+DECLARE_int32(rpc_thread_pool_lower_priority_share);
+
 namespace yb {
 namespace rpc {
 
@@ -208,5 +212,128 @@ TEST_F(ThreadPoolTest, TestShutdown) {
   }
 }
 
+class OrderedTask final : public ThreadPoolTask {
+ public:
+  OrderedTask(size_t index, std::mutex* mutex, std::vector<size_t>* order, CountDownLatch* latch)
+      : index_(index), mutex_(mutex), order_(order), latch_(latch) {}
+
+  void Run() override {
+    std::lock_guard<std::mutex> lock(*mutex_);
+    order_->push_back(index_);
+  }
+
+  void Done(const Status& status) override {
+    latch_->CountDown();
+  }
+
+ private:
+  size_t index_;
+  std::mutex* mutex_;
+  std::vector<size_t>* order_;
+  CountDownLatch* latch_;
+};
+
+class BlockingTask final : public ThreadPoolTask {
+ public:
+  explicit BlockingTask(CountDownLatch* started) : started_(started) {}
+
+  void Run() override {
+    started_->CountDown();
+    unblock_.Wait();
+  }
+
+  void Done(const Status& status) override {}
+
+  void Unblock() {
+    unblock_.CountDown();
+  }
+
+ private:
+  CountDownLatch* started_;
+  CountDownLatch unblock_{1};
+};
+
+TEST_F(ThreadPoolTest, TestPriority) {
+  google::FlagSaver flag_saver;
+  FLAGS_rpc_thread_pool_lower_priority_share = 0;
+
+  constexpr size_t kTasksPerPriority = 10;
+  ThreadPool pool("test", kTasksPerPriority * kThreadPoolTaskPriorityMapSize, 1);
+
+  // Occupy the only worker, so that the tasks below are queued.
+  CountDownLatch started(1);
+  BlockingTask blocking_task(&started);
+  ASSERT_TRUE(pool.Enqueue(&blocking_task));
+  started.Wait();
+
+  std::mutex mutex;
+  std::vector<size_t> order;
+  CountDownLatch latch(kTasksPerPriority * kThreadPoolTaskPriorityMapSize);
+  std::vector<std::unique_ptr<OrderedTask>> tasks;
+  // Enqueue the tasks in the order of increasing priority, the index of a task is its expected
+  // execution position.
+  for (auto priority : {ThreadPoolTaskPriority::kLow, ThreadPoolTaskPriority::kNormal,
+                        ThreadPoolTaskPriority::kHigh}) {
+    const size_t base = util::to_underlying(priority) * kTasksPerPriority;
+    for (size_t i = 0; i != kTasksPerPriority; ++i) {
+      tasks.emplace_back(new OrderedTask(base + i, &mutex, &order, &latch));
+      ASSERT_TRUE(pool.Enqueue(tasks.back().get(), priority));
+    }
+  }
+
+  blocking_task.Unblock();
+  latch.Wait();
+  ASSERT_EQ(tasks.size(), order.size());
+  for (size_t i = 0; i != order.size(); ++i) {
+    ASSERT_EQ(i, order[i]);
+  }
+}
+
+// Tests that low priority tasks get their share of the workers while high priority tasks are
+// queued.
+TEST_F(ThreadPoolTest, TestLowerPriorityShare) {
+  google::FlagSaver flag_saver;
+  constexpr int kShare = 4;
+  FLAGS_rpc_thread_pool_lower_priority_share = kShare;
+
+  constexpr size_t kHighTasks = 12;
+  constexpr size_t kLowTasks = 3;
+  constexpr size_t kLowTaskBase = 100;
+  ThreadPool pool("test", kHighTasks, 1);
+
+  // Occupy the only worker, so that the tasks below are queued. It is the first popped task.
+  CountDownLatch started(1);
+  BlockingTask blocking_task(&started);
+  ASSERT_TRUE(pool.Enqueue(&blocking_task));
+  started.Wait();
+
+  std::mutex mutex;
+  std::vector<size_t> order;
+  CountDownLatch latch(kHighTasks + kLowTasks);
+  std::vector<std::unique_ptr<OrderedTask>> tasks;
+  for (size_t i = 0; i != kLowTasks; ++i) {
+    tasks.emplace_back(new OrderedTask(kLowTaskBase + i, &mutex, &order, &latch));
+    ASSERT_TRUE(pool.Enqueue(tasks.back().get(), ThreadPoolTaskPriority::kLow));
+  }
+  for (size_t i = 0; i != kHighTasks; ++i) {
+    tasks.emplace_back(new OrderedTask(i, &mutex, &order, &latch));
+    ASSERT_TRUE(pool.Enqueue(tasks.back().get(), ThreadPoolTaskPriority::kHigh));
+  }
+
+  blocking_task.Unblock();
+  latch.Wait();
+  ASSERT_EQ(tasks.size(), order.size());
+  // Every kShare-th popped task, counting the blocking one, is a low priority task.
+  size_t next_high = 0;
+  size_t next_low = kLowTaskBase;
+  for (size_t i = 0; i != order.size(); ++i) {
+    if ((i + 2) % kShare == 0 && next_low != kLowTaskBase + kLowTasks) {
+      ASSERT_EQ(next_low++, order[i]) << "i: " << i;
+    } else {
+      ASSERT_EQ(next_high++, order[i]) << "i: " << i;
+    }
+  }
+}
+
 } // namespace rpc
 } // namespace yb
@@ -15,15 +15,27 @@
 
 #include "yb/rpc/thread_pool.h"
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include <boost/lockfree/queue.hpp>
 #include <boost/scope_exit.hpp>
 
+#include <gflags/gflags.h>
+
+#include "yb/util/flag_tags.h"
 #include "yb/util/thread.h"
 
+DEFINE_int32(rpc_thread_pool_lower_priority_share, 8,
+             "Every Nth task executed by an RPC thread pool is taken from a queue of lower than "
+             "high priority first, so that a steady stream of higher priority tasks cannot starve "
+             "them. The lower priorities take turns at this slot. 0 means strict priority order.");
+TAG_FLAG(rpc_thread_pool_lower_priority_share, advanced);
+TAG_FLAG(rpc_thread_pool_lower_priority_share, runtime);
+
 namespace yb {
 namespace rpc {
 
@@ -36,13 +48,51 @@ typedef boost::lockfree::queue<Worker*> WaitingWorkers;
 
 struct ThreadPoolShare {
   ThreadPoolOptions options;
-  TaskQueue task_queue;
+  // One queue per task priority, each of them limited by queue_limit.
+  std::vector<std::unique_ptr<TaskQueue>> task_queues;
   WaitingWorkers waiting_workers;
+  // Number of tasks popped so far, used to reserve a share of them for lower priorities.
+  std::atomic<size_t> popped_tasks{0};
 
   explicit ThreadPoolShare(ThreadPoolOptions o)
       : options(std::move(o)),
-        task_queue(options.queue_limit),
         waiting_workers(options.max_workers) {
+    task_queues.reserve(kThreadPoolTaskPriorityMapSize);
+    while (task_queues.size() != kThreadPoolTaskPriorityMapSize) {
+      task_queues.emplace_back(new TaskQueue(options.queue_limit));
+    }
+  }
+
+  TaskQueue& task_queue(ThreadPoolTaskPriority priority) {
+    return *task_queues[util::to_underlying(priority)];
+  }
+
+  // Pops the task of the highest priority, except for every
+  // rpc_thread_pool_lower_priority_share-th task, that is taken from lower priorities first.
+  bool PopTask(ThreadPoolTask** task) {
+    const auto share = FLAGS_rpc_thread_pool_lower_priority_share;
+    if (share > 0) {
+      const size_t popped = popped_tasks.load(std::memory_order_relaxed);
+      if (popped % share == share - 1) {
+        // Lower priorities take turns to be tried first, so that normal priority tasks do not
+        // starve low priority ones at this slot either.
+        const size_t num_lower = task_queues.size() - 1;
+        const size_t first = popped / share % num_lower;
+        for (size_t i = 0; i != num_lower; ++i) {
+          if (task_queues[1 + (first + i) % num_lower]->pop(*task)) {
+            popped_tasks.fetch_add(1, std::memory_order_relaxed);
+            return true;
+          }
+        }
+      }
+    }
+    for (const auto& queue : task_queues) {
+      if (queue->pop(*task)) {
+        popped_tasks.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    return false;
   }
 };
 
@@ -104,7 +154,7 @@ class Worker {
   bool PopTask(ThreadPoolTask** task) {
     // First of all we try to get already queued task, w/o locking.
     // If there is no task, so we could go to waiting state.
-    if (share_->task_queue.pop(*task)) {
+    if (share_->PopTask(task)) {
       return true;
     }
     std::unique_lock<std::mutex> lock(mutex_);
@@ -120,7 +170,7 @@ class Worker {
       // the worker queue. So worker queue could be empty in this case, and nobody was notified
       // about new task. So we check there for this case. This technique is similar to
       // double check.
-      if (share_->task_queue.pop(*task)) {
+      if (share_->PopTask(task)) {
         return true;
       }
 
@@ -128,7 +178,7 @@ class Worker {
 
       // Sometimes another worker could steal task before we wake up. In this case we will
       // just enqueue ourselves back.
-      if (share_->task_queue.pop(*task)) {
+      if (share_->PopTask(task)) {
         return true;
       }
     }
@@ -171,14 +221,14 @@ class ThreadPool::Impl {
     return share_.options;
   }
 
-  bool Enqueue(ThreadPoolTask* task) {
+  bool Enqueue(ThreadPoolTask* task, ThreadPoolTaskPriority priority) {
     ++adding_;
     if (closing_) {
       --adding_;
       task->Done(shutdown_status_);
       return false;
     }
-    bool added = share_.task_queue.bounded_push(task);
+    bool added = share_.task_queue(priority).bounded_push(task);
     --adding_;
     if (!added) {
       task->Done(queue_full_status_);
@@ -212,7 +262,9 @@ class ThreadPool::Impl {
     {
       std::lock_guard<std::mutex> lock(mutex_);
       if (closing_) {
-        CHECK(share_.task_queue.empty());
+        for (const auto& queue : share_.task_queues) {
+          CHECK(queue->empty());
+        }
         CHECK(workers_.empty());
         return;
       }
@@ -231,7 +283,7 @@ class ThreadPool::Impl {
       std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
     ThreadPoolTask* task = nullptr;
-    while (share_.task_queue.pop(task)) {
+    while (share_.PopTask(&task)) {
       task->Done(shutdown_status_);
     }
   }
@@ -271,8 +323,8 @@ bool ThreadPool::IsCurrentThreadRpcWorker() {
   return thread != nullptr && thread->category() == kRpcThreadCategory;
 }
 
-bool ThreadPool::Enqueue(ThreadPoolTask* task) {
-  return impl_->Enqueue(task);
+bool ThreadPool::Enqueue(ThreadPoolTask* task, ThreadPoolTaskPriority priority) {
+  return impl_->Enqueue(task, priority);
 }
 
 void ThreadPool::Shutdown() {
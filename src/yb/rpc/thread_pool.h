@@ -19,6 +19,8 @@
 #include <memory>
 #include <string>
 
+#include "yb/util/enums.h"
+
 namespace yb {
 
 class Status;
@@ -36,6 +38,11 @@ class ThreadPoolTask {
   ~ThreadPoolTask() {}
 };
 
+// Workers pick tasks of higher priority first, so that e.g. Raft RPCs do not wait behind bulk
+// scans. A small share of tasks is still taken from lower priorities first, see
+// rpc_thread_pool_lower_priority_share. Tasks of the same priority are executed in FIFO order.
+YB_DEFINE_ENUM(ThreadPoolTaskPriority, (kHigh)(kNormal)(kLow));
+
 struct ThreadPoolOptions {
   std::string name;
   size_t queue_limit;
@@ -59,7 +66,8 @@ class ThreadPool {
 
   const ThreadPoolOptions& options() const;
 
-  bool Enqueue(ThreadPoolTask* task);
+  bool Enqueue(ThreadPoolTask* task,
+               ThreadPoolTaskPriority priority = ThreadPoolTaskPriority::kNormal);
   void Shutdown();
 
   static bool IsCurrentThreadRpcWorker();
@@ -90,12 +90,6 @@ using google::protobuf::Message;
 using google::protobuf::MessageLite;
 using google::protobuf::io::CodedOutputStream;
 
-namespace {
-
-constexpr size_t kBigPacket = 128_KB;
-
-} // namespace
-
 YBConnectionContext::YBConnectionContext() {}
 
 YBConnectionContext::~YBConnectionContext() {}
@@ -105,8 +99,9 @@ size_t YBConnectionContext::BufferLimit() {
 }
 
 Status YBConnectionContext::ProcessCalls(const ConnectionPtr& connection,
-                                         Slice slice,
+                                         const RefCntSlice& data,
                                          size_t* consumed) {
+  const Slice& slice = data.AsSlice();
   auto pos = slice.data();
   const auto end = slice.end();
 
@@ -139,7 +134,7 @@ Status YBConnectionContext::ProcessCalls(const ConnectionPtr& connection,
       break;
     }
     pos += kMsgLengthPrefixLength;
-    const auto status = HandleCall(connection, Slice(pos, stop - pos));
+    const auto status = HandleCall(connection, data.SubSlice(pos, stop));
     if (!status.ok()) {
       return status;
     }
@@ -150,16 +145,16 @@ Status YBConnectionContext::ProcessCalls(const ConnectionPtr& connection,
   return Status::OK();
 }
 
-size_t YBConnectionContext::MaxReceive(Slice existing_data) {
-  if (existing_data.size() >= kMsgLengthPrefixLength) {
-    const size_t data_length = NetworkByteOrder::Load32(existing_data.data());
-    return std::max(kBigPacket, data_length + kMsgLengthPrefixLength);
+size_t YBConnectionContext::PendingCallSize(Slice pending_data) {
+  if (state_ == RpcConnectionPB::OPEN && pending_data.size() >= kMsgLengthPrefixLength) {
+    return NetworkByteOrder::Load32(pending_data.data()) + kMsgLengthPrefixLength;
   }
-  return kBigPacket;
+  return 0;
 }
 
 
-Status YBConnectionContext::HandleCall(const ConnectionPtr& connection, Slice call_data) {
+Status YBConnectionContext::HandleCall(const ConnectionPtr& connection,
+                                       const RefCntSlice& call_data) {
   const auto direction = connection->direction();
   switch (direction) {
     case ConnectionDirection::CLIENT:
@@ -170,7 +165,8 @@ Status YBConnectionContext::HandleCall(const ConnectionPtr& connection, Slice ca
   LOG(FATAL) << "Invalid direction: " << direction;
 }
 
-Status YBConnectionContext::HandleInboundCall(const ConnectionPtr& connection, Slice call_data) {
+Status YBConnectionContext::HandleInboundCall(const ConnectionPtr& connection,
+                                              const RefCntSlice& call_data) {
   auto reactor = connection->reactor();
   DCHECK(reactor->IsCurrentThread());
 
@@ -226,13 +222,13 @@ MonoTime YBInboundCall::GetClientDeadline() const {
   return deadline;
 }
 
-Status YBInboundCall::ParseFrom(Slice source) {
+Status YBInboundCall::ParseFrom(const RefCntSlice& source) {
   TRACE_EVENT_FLOW_BEGIN0("rpc", "YBInboundCall", this);
   TRACE_EVENT0("rpc", "YBInboundCall::ParseFrom");
 
-  request_data_.assign(source.data(), source.end());
-  source = Slice(request_data_.data(), request_data_.size());
-  RETURN_NOT_OK(serialization::ParseYBMessage(source, &header_, &serialized_request_));
+  request_data_ = source;
+  RETURN_NOT_OK(serialization::ParseYBMessage(
+      request_data_.AsSlice(), &header_, &serialized_request_));
 
   // Adopt the service/method info from the header as soon as it's available.
   if (PREDICT_FALSE(!header_.has_remote_method())) {
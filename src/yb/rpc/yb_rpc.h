@@ -33,15 +33,15 @@ class YBConnectionContext : public ConnectionContextWithCallId {
   size_t BufferLimit() override;
 
   CHECKED_STATUS ProcessCalls(const ConnectionPtr& connection,
-                              Slice slice,
+                              const RefCntSlice& data,
                               size_t* consumed) override;
 
-  size_t MaxReceive(Slice existing_data) override;
+  size_t PendingCallSize(Slice pending_data) override;
   void Connected(const ConnectionPtr& connection) override;
   void AssignConnection(const ConnectionPtr& connection) override;
 
-  CHECKED_STATUS HandleCall(const ConnectionPtr& connection, Slice call_data);
-  CHECKED_STATUS HandleInboundCall(const ConnectionPtr& connection, Slice call_data);
+  CHECKED_STATUS HandleCall(const ConnectionPtr& connection, const RefCntSlice& call_data);
+  CHECKED_STATUS HandleInboundCall(const ConnectionPtr& connection, const RefCntSlice& call_data);
 
   RpcConnectionPB::StateType State() override { return state_; }
 
@@ -63,7 +63,7 @@ class YBInboundCall : public InboundCall {
   // 'serialized_request_' member variables. The actual call parameter is
   // not deserialized, as this may be CPU-expensive, and this is called
   // from the reactor thread.
-  CHECKED_STATUS ParseFrom(Slice source);
+  CHECKED_STATUS ParseFrom(const RefCntSlice& source);
 
   int32_t call_id() const {
     return header_.call_id();
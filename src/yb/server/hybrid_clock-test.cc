@@ -31,6 +31,7 @@
 //
 
 #include <algorithm>
+#include <atomic>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 
@@ -258,6 +259,44 @@ TEST_F(HybridClockTest, TestClockDoesntGoBackwardsWithUpdates) {
   }
 }
 
+// Thread which alternates reading the clock and updating it with the time it just read, counting
+// the calls.
+void NowAndUpdateThread(HybridClock* clock, AtomicBool* stop, std::atomic<uint64_t>* num_calls) {
+  uint64_t calls = 0;
+  while (!stop->Load()) {
+    HybridTime t = clock->Now();
+    clock->Update(t);
+    calls += 2;
+  }
+  num_calls->fetch_add(calls);
+}
+
+// Measures the throughput of Now() and Update() with an increasing number of threads.
+TEST_F(HybridClockTest, NowAndUpdatePerf) {
+  const MonoDelta duration = MonoDelta::FromMilliseconds(AllowSlowTests() ? 2000 : 200);
+  for (int num_threads = 1; num_threads <= 64; num_threads *= 2) {
+    vector<scoped_refptr<yb::Thread> > threads;
+    AtomicBool stop(false);
+    std::atomic<uint64_t> num_calls(0);
+    for (int i = 0; i < num_threads; i++) {
+      scoped_refptr<Thread> thread;
+      ASSERT_OK(Thread::Create("test", "now_and_update",
+                               &NowAndUpdateThread, clock_.get(), &stop, &num_calls,
+                               &thread));
+      threads.push_back(thread);
+    }
+
+    SleepFor(duration);
+    stop.Store(true);
+    for (const scoped_refptr<Thread> t : threads) {
+      t->Join();
+    }
+    LOG(INFO) << num_threads << " threads: "
+              << static_cast<uint64_t>(num_calls.load() / duration.ToSeconds())
+              << " Now/Update calls per second";
+  }
+}
+
 TEST_F(HybridClockTest, CompareHybridClocksToDelta) {
   EXPECT_EQ(1, HybridClock::CompareHybridClocksToDelta(
       HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(1000, 10),
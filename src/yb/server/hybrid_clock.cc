@@ -33,7 +33,6 @@
 #include "yb/server/hybrid_clock.h"
 
 #include <algorithm>
-#include <mutex>
 
 #include <glog/logging.h>
 #include "yb/gutil/bind.h"
@@ -61,6 +60,11 @@ DEFINE_bool(use_hybrid_clock, true,
             " implementation. This should be disabled for testing purposes only.");
 TAG_FLAG(use_hybrid_clock, hidden);
 
+DEFINE_int32(hybrid_clock_error_refresh_interval_ms, 100,
+             "How often the hybrid clock reads the maximum clock error from NTP. Between the "
+             "reads the error is bounded by the last read error plus the maximum drift.");
+TAG_FLAG(hybrid_clock_error_refresh_interval_ms, advanced);
+
 DEFINE_bool(use_mock_wall_clock, false,
             "Whether HybridClock should use a mock wall clock which is updated manually"
             "instead of reading time from the system clock, for tests.");
@@ -98,6 +102,15 @@ Status CheckDeadlineNotWithinMicros(const MonoTime& deadline, int64_t wait_for_u
   return Status::OK();
 }
 
+constexpr int kCachedErrorBits = 24;
+constexpr uint64_t kCachedErrorMask = (1ULL << kCachedErrorBits) - 1;
+
+// The kernel grows the NTP maximum error by 500 ppm between NTP updates.
+constexpr uint64_t kMaxErrorGrowthPpm = 500;
+
+constexpr uint64_t kMicrosecondsPerMillisecond = 1000;
+constexpr uint64_t kMicrosecondsPerSecond = 1000000;
+
 }  // anonymous namespace
 
 const int HybridClock::kBitsToShift = HybridTime::kBitsForLogicalComponent;
@@ -115,8 +128,9 @@ HybridClock::HybridClock()
       divisor_(1),
 #endif
       tolerance_adjustment_(1),
-      last_usec_(0),
-      next_logical_(0),
+      error_epoch_usec_(0),
+      next_hybrid_time_(0),
+      cached_error_(0),
       state_(kNotInitialized) {
 }
 
@@ -176,14 +190,16 @@ Status HybridClock::Init() {
     state_ = kInitialized;
     return Status::OK();
   }
+  // Read the current time. This will return an error if the clock is not synchronized.
+  uint64_t now_usec;
+  uint64_t error_usec;
+  error_epoch_usec_ = GetCurrentTimeMicros();
+  RETURN_NOT_OK(RefreshCachedError(&now_usec, &error_usec));
+
 #if defined(__APPLE__)
   LOG(WARNING) << "HybridClock initialized in local mode (OS X only). "
                << "Not suitable for distributed clusters.";
 #else
-  // Read the current time. This will return an error if the clock is not synchronized.
-  uint64_t now_usec;
-  uint64_t error_usec;
-  RETURN_NOT_OK(WalltimeWithError(&now_usec, &error_usec));
 
   timex timex;
   RETURN_NOT_OK(GetClockModes(&timex));
@@ -214,20 +230,14 @@ Status HybridClock::Init() {
 HybridTime HybridClock::Now() {
   HybridTime now;
   uint64_t error;
-
-  std::lock_guard<simple_spinlock> lock(lock_);
-  NowWithErrorUnlocked(&now, &error);
+  NowWithError(&now, &error);
   return now;
 }
 
 HybridTime HybridClock::NowLatest() {
   HybridTime now;
   uint64_t error;
-
-  {
-    std::lock_guard<simple_spinlock> lock(lock_);
-    NowWithErrorUnlocked(&now, &error);
-  }
+  NowWithError(&now, &error);
 
   uint64_t now_latest = GetPhysicalValueMicros(now) + error;
   uint64_t now_logical = GetLogicalValue(now);
@@ -244,28 +254,27 @@ Status HybridClock::GetGlobalLatest(HybridTime* t) {
 }
 
 void HybridClock::NowWithError(HybridTime *hybrid_time, uint64_t *max_error_usec) {
-  std::lock_guard<simple_spinlock> lock(lock_);
-  NowWithErrorUnlocked(hybrid_time, max_error_usec);
-}
-
-void HybridClock::NowWithErrorUnlocked(HybridTime *hybrid_time, uint64_t *max_error_usec) {
-
-  DCHECK(lock_.is_locked());
   DCHECK_EQ(state_, kInitialized) << "Clock not initialized. Must call Init() first.";
 
   uint64_t now_usec;
   uint64_t error_usec;
-  Status s = WalltimeWithError(&now_usec, &error_usec);
+  Status s = WalltimeWithCachedError(&now_usec, &error_usec);
   if (PREDICT_FALSE(!s.ok())) {
     LOG(FATAL) << Substitute("Couldn't get the current time: Clock unsynchronized. "
         "Status: $0", s.ToString());
   }
 
-  // If the current time surpasses the last update just return it
-  if (PREDICT_TRUE(now_usec > last_usec_)) {
-    last_usec_ = now_usec;
-    next_logical_ = 1;
-    *hybrid_time = HybridTimeFromMicroseconds(last_usec_);
+  // Return the current time if it surpasses the last issued hybrid time, otherwise increment the
+  // logical component of the last issued hybrid time.
+  const uint64_t wall_hybrid_time = HybridTimeFromMicroseconds(now_usec).ToUint64();
+  uint64_t next = next_hybrid_time_.load(std::memory_order_acquire);
+  uint64_t result;
+  do {
+    result = std::max(wall_hybrid_time, next);
+  } while (!next_hybrid_time_.compare_exchange_weak(next, result + 1, std::memory_order_acq_rel));
+  *hybrid_time = HybridTime(result);
+
+  if (PREDICT_TRUE(result == wall_hybrid_time)) {
     *max_error_usec = error_usec;
     if (PREDICT_FALSE(VLOG_IS_ON(2))) {
       VLOG(2) << "Current clock is higher than the last one. Resetting logical values."
@@ -292,14 +301,12 @@ void HybridClock::NowWithErrorUnlocked(HybridTime *hybrid_time, uint64_t *max_er
   // This broadens the error interval for both cases but always returns
   // a correct error interval.
 
-  *max_error_usec = last_usec_ - (now_usec - error_usec);
-  *hybrid_time = HybridTimeFromMicrosecondsAndLogicalValue(last_usec_, next_logical_);
+  *max_error_usec = GetPhysicalValueMicros(*hybrid_time) - (now_usec - error_usec);
   if (PREDICT_FALSE(VLOG_IS_ON(2))) {
     VLOG(2) << "Current clock is lower than the last one. Returning last read and incrementing"
         " logical values. Physical Value: " << now_usec << " usec Logical Value: "
-        << next_logical_ << " Error: " << *max_error_usec;
+        << GetLogicalValue(*hybrid_time) << " Error: " << *max_error_usec;
   }
-  next_logical_++;
 }
 
 void HybridClock::Update(const HybridTime& to_update) {
@@ -307,17 +314,12 @@ void HybridClock::Update(const HybridTime& to_update) {
     return;
   }
 
-  std::lock_guard<simple_spinlock> lock(lock_);
-  HybridTime now;
-  uint64_t error_ignored;
-  NowWithErrorUnlocked(&now, &error_ignored);
-
-  if (PREDICT_TRUE(now.CompareTo(to_update) > 0)) {
-    return;
+  // The next hybrid time should be after the incoming one.
+  const uint64_t min_next = to_update.ToUint64() + 1;
+  uint64_t next = next_hybrid_time_.load(std::memory_order_acquire);
+  while (next < min_next &&
+         !next_hybrid_time_.compare_exchange_weak(next, min_next, std::memory_order_acq_rel)) {
   }
-
-  last_usec_ = GetPhysicalValueMicros(to_update);
-  next_logical_ = GetLogicalValue(to_update) + 1;
 }
 
 Status HybridClock::WaitUntilAfter(const HybridTime& then_latest,
@@ -325,10 +327,7 @@ Status HybridClock::WaitUntilAfter(const HybridTime& then_latest,
   TRACE_EVENT0("clock", "HybridClock::WaitUntilAfter");
   HybridTime now;
   uint64_t error;
-  {
-    std::lock_guard<simple_spinlock> lock(lock_);
-    NowWithErrorUnlocked(&now, &error);
-  }
+  NowWithError(&now, &error);
 
   // "unshift" the hybrid_times so that we can measure actual time
   uint64_t now_usec = GetPhysicalValueMicros(now);
@@ -369,10 +368,7 @@ Status HybridClock::WaitUntilAfterLocally(const HybridTime& then,
   while (true) {
     HybridTime now;
     uint64_t error;
-    {
-      std::lock_guard<simple_spinlock> lock(lock_);
-      NowWithErrorUnlocked(&now, &error);
-    }
+    NowWithError(&now, &error);
     if (now.CompareTo(then) > 0) {
       return Status::OK();
     }
@@ -388,21 +384,12 @@ bool HybridClock::IsAfter(HybridTime t) {
   // a time update.
   uint64_t now_usec;
   uint64_t error_usec;
-  CHECK_OK(WalltimeWithError(&now_usec, &error_usec));
-
-  std::lock_guard<simple_spinlock> lock(lock_);
-  now_usec = std::max(now_usec, last_usec_);
-
-  HybridTime now;
-  if (now_usec > last_usec_) {
-    now = HybridTimeFromMicroseconds(now_usec);
-  } else {
-    // last_usec_ may be in the future if we were updated from a remote
-    // node.
-    now = HybridTimeFromMicrosecondsAndLogicalValue(last_usec_, next_logical_);
-  }
+  CHECK_OK(WalltimeWithCachedError(&now_usec, &error_usec));
 
-  return t.value() < now.value();
+  // next_hybrid_time_ may be in the future if we were updated from a remote node.
+  const uint64_t now = std::max(HybridTimeFromMicroseconds(now_usec).ToUint64(),
+                                next_hybrid_time_.load(std::memory_order_acquire));
+  return t.value() < now;
 }
 
 yb::Status HybridClock::CheckClockSyncError(uint64_t error_usec) {
@@ -442,16 +429,49 @@ yb::Status HybridClock::WalltimeWithError(uint64_t* now_usec, uint64_t* error_us
   return yb::Status::OK();
 }
 
+Status HybridClock::WalltimeWithCachedError(uint64_t* now_usec, uint64_t* error_usec) {
+  if (PREDICT_FALSE(FLAGS_use_mock_wall_clock)) {
+    return WalltimeWithError(now_usec, error_usec);
+  }
+
+  *now_usec = GetCurrentTimeMicros();
+  const uint64_t cached_error = cached_error_.load(std::memory_order_acquire);
+  const uint64_t refresh_usec =
+      error_epoch_usec_ + (cached_error >> kCachedErrorBits) * kMicrosecondsPerMillisecond;
+  if (PREDICT_FALSE(*now_usec < refresh_usec ||
+                    *now_usec - refresh_usec >= static_cast<uint64_t>(
+                        FLAGS_hybrid_clock_error_refresh_interval_ms) *
+                        kMicrosecondsPerMillisecond)) {
+    return RefreshCachedError(now_usec, error_usec);
+  }
+
+  // Round the drift up, so that the error is never underestimated.
+  *error_usec = (cached_error & kCachedErrorMask) +
+                ((*now_usec - refresh_usec) * kMaxErrorGrowthPpm + kMicrosecondsPerSecond -
+                 1) / kMicrosecondsPerSecond;
+  return CheckClockSyncError(*error_usec);
+}
+
+Status HybridClock::RefreshCachedError(uint64_t* now_usec, uint64_t* error_usec) {
+  RETURN_NOT_OK(WalltimeWithError(now_usec, error_usec));
+
+  // The refresh time is rounded down, which overestimates the drift since the refresh. The kernel
+  // caps the NTP maximum error at 16 seconds, so it fits into kCachedErrorBits.
+  const uint64_t refresh_ms = *now_usec > error_epoch_usec_
+      ? (*now_usec - error_epoch_usec_) / kMicrosecondsPerMillisecond : 0;
+  cached_error_.store((refresh_ms << kCachedErrorBits) | std::min(*error_usec, kCachedErrorMask),
+                      std::memory_order_release);
+  return Status::OK();
+}
+
 void HybridClock::SetMockClockWallTimeForTests(uint64_t now_usec) {
   CHECK(FLAGS_use_mock_wall_clock);
-  std::lock_guard<simple_spinlock> lock(lock_);
-  CHECK_GE(now_usec, mock_clock_time_usec_);
+  CHECK_GE(now_usec, mock_clock_time_usec_.load());
   mock_clock_time_usec_ = now_usec;
 }
 
 void HybridClock::SetMockMaxClockErrorForTests(uint64_t max_error_usec) {
   CHECK(FLAGS_use_mock_wall_clock);
-  std::lock_guard<simple_spinlock> lock(lock_);
   mock_clock_max_error_usec_ = max_error_usec;
 }
 
@@ -465,8 +485,7 @@ uint64_t HybridClock::ErrorForMetrics() {
   HybridTime now;
   uint64_t error;
 
-  std::lock_guard<simple_spinlock> lock(lock_);
-  NowWithErrorUnlocked(&now, &error);
+  NowWithError(&now, &error);
   return error;
 }
 
@@ -33,11 +33,13 @@
 #ifndef YB_SERVER_HYBRID_CLOCK_H_
 #define YB_SERVER_HYBRID_CLOCK_H_
 
+#include <atomic>
 #include <string>
 #if !defined(__APPLE__)
 #include <sys/timex.h>
 #endif // !defined(__APPLE__)
 
+#include "yb/gutil/port.h"
 #include "yb/gutil/ref_counted.h"
 #include "yb/server/clock.h"
 #include "yb/util/locks.h"
@@ -130,9 +132,10 @@ class HybridClock : public Clock {
   // error in micros. This may fail if the clock is unsynchronized or synchronized
   // but the error is too high and, since we can't do anything about it,
   // LOG(FATAL)'s in that case.
-  void NowWithErrorUnlocked(HybridTime* hybrid_time, uint64_t* max_error_usec);
-
-  // Variation of above method with locking.
+  //
+  // Takes no lock: the last issued hybrid time is advanced with a compare-and-swap, and the NTP
+  // maximum error is read from a cache that is refreshed every
+  // hybrid_clock_error_refresh_interval_ms.
   void NowWithError(HybridTime* hybrid_time, uint64_t* max_error_usec);
 
   virtual std::string Stringify(HybridTime hybrid_time) override;
@@ -205,6 +208,13 @@ class HybridClock : public Clock {
   // On OS X, the error will always be 0.
   CHECKED_STATUS WalltimeWithError(uint64_t* now_usec, uint64_t* error_usec);
 
+  // Same as above, but only reads the wall clock and bounds the maximum error using the cached
+  // NTP error, unless the cache is due for a refresh.
+  CHECKED_STATUS WalltimeWithCachedError(uint64_t* now_usec, uint64_t* error_usec);
+
+  // Reads the time and the maximum error from NTP and caches the error.
+  CHECKED_STATUS RefreshCachedError(uint64_t* now_usec, uint64_t* error_usec);
+
   // Returns Status::OK if the clock error_usec provided is within acceptable limits, otherwise
   // it returns a not OK status if disable_clock_sync_error is not true.
   static CHECKED_STATUS CheckClockSyncError(uint64_t error_usec);
@@ -217,11 +227,11 @@ class HybridClock : public Clock {
 
   // Set by calls to SetMockClockWallTimeForTests().
   // For testing purposes only.
-  uint64_t mock_clock_time_usec_;
+  std::atomic<uint64_t> mock_clock_time_usec_;
 
   // Set by calls to SetMockClockErrorForTests().
   // For testing purposes only.
-  uint64_t mock_clock_max_error_usec_;
+  std::atomic<uint64_t> mock_clock_max_error_usec_;
 
 #if !defined(__APPLE__)
   uint64_t divisor_;
@@ -229,12 +239,18 @@ class HybridClock : public Clock {
 
   double tolerance_adjustment_;
 
-  mutable simple_spinlock lock_;
+  // Wall time in microseconds that the refresh times in cached_error_ are relative to.
+  uint64_t error_epoch_usec_;
+
+  // The hybrid time that is returned next if the wall clock did not advance past it, i.e. the last
+  // issued hybrid time plus one. Every thread that reads the clock writes it, so it is kept in its
+  // own cache line.
+  CACHELINE_ALIGNED std::atomic<uint64_t> next_hybrid_time_;
 
-  // the last clock read/update, in microseconds.
-  uint64_t last_usec_;
-  // the next logical value to be assigned to a hybrid_time
-  uint64_t next_logical_;
+  // The NTP maximum error in microseconds in the low kCachedErrorBits bits, and the time it was
+  // read, in milliseconds since error_epoch_usec_, in the other bits. A single word, so that both
+  // are read consistently without a lock.
+  CACHELINE_ALIGNED std::atomic<uint64_t> cached_error_;
 
   // How many bits to left shift a microseconds clock read. The remainder
   // of the hybrid_time will be reserved for logical values.
@@ -0,0 +1,98 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/tablet/hot_key_sampler.h"
+#include "yb/tablet/tablet.pb.h"
+#include "yb/util/random_util.h"
+#include "yb/util/test_util.h"
+
+DECLARE_int32(tablet_hot_key_sample_rate);
+DECLARE_int32(tablet_hot_key_top_k);
+
+namespace yb {
+namespace tablet {
+
+class HotKeySamplerTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    FLAGS_tablet_hot_key_sample_rate = 1;
+    FLAGS_tablet_hot_key_top_k = 4;
+  }
+};
+
+TEST_F(HotKeySamplerTest, TopKeys) {
+  HotKeySampler sampler(0x1000, 0x2000);
+  constexpr int kHotHashCode = 0x1234;
+  constexpr int kWarmHashCode = 0x1f00;
+  for (int i = 0; i != 10000; ++i) {
+    if (i % 4 == 0) {
+      sampler.Sample(HotKeyOperation::kRead, kHotHashCode);
+    } else if (i % 4 == 1) {
+      sampler.Sample(HotKeyOperation::kWrite, kHotHashCode);
+    } else if (i % 4 == 2) {
+      sampler.Sample(HotKeyOperation::kWrite, kWarmHashCode);
+    } else {
+      sampler.Sample(HotKeyOperation::kRead, RandomUniformInt<uint16_t>(0x1000, 0x1fff));
+    }
+  }
+
+  TabletHotKeysPB pb;
+  sampler.ToPB(&pb);
+  ASSERT_EQ(1, pb.sample_rate());
+  ASSERT_EQ(5000, pb.sampled_reads());
+  ASSERT_EQ(5000, pb.sampled_writes());
+  ASSERT_EQ(4, pb.hot_keys_size());
+  ASSERT_EQ(kHotHashCode, pb.hot_keys(0).hash_code());
+  ASSERT_GE(pb.hot_keys(0).sampled_reads(), 2500);
+  ASSERT_EQ(2500, pb.hot_keys(0).sampled_writes());
+  ASSERT_EQ(kWarmHashCode, pb.hot_keys(1).hash_code());
+  ASSERT_EQ(2500, pb.hot_keys(1).sampled_writes());
+
+  uint64_t reads = 0;
+  uint64_t writes = 0;
+  uint32_t prev_end = 0x1000;
+  for (const auto& range : pb.hot_ranges()) {
+    ASSERT_GE(range.start_hash_code(), prev_end);
+    ASSERT_LT(range.start_hash_code(), range.end_hash_code());
+    prev_end = range.end_hash_code();
+    reads += range.sampled_reads();
+    writes += range.sampled_writes();
+    if (range.start_hash_code() <= kHotHashCode && kHotHashCode < range.end_hash_code()) {
+      ASSERT_GE(range.sampled_reads(), 2500);
+      ASSERT_GE(range.sampled_writes(), 2500);
+    }
+  }
+  ASSERT_LE(prev_end, 0x2000);
+  ASSERT_EQ(5000, reads);
+  ASSERT_EQ(5000, writes);
+}
+
+TEST_F(HotKeySamplerTest, SamplingDisabled) {
+  FLAGS_tablet_hot_key_sample_rate = 0;
+  HotKeySampler sampler(0, 0x10000);
+  for (int i = 0; i != 100; ++i) {
+    sampler.Sample(HotKeyOperation::kWrite, i);
+  }
+
+  TabletHotKeysPB pb;
+  sampler.ToPB(&pb);
+  ASSERT_EQ(0, pb.sampled_writes());
+  ASSERT_EQ(0, pb.hot_keys_size());
+  ASSERT_EQ(0, pb.hot_ranges_size());
+}
+
+} // namespace tablet
+} // namespace yb
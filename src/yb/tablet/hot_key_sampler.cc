@@ -0,0 +1,166 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/hot_key_sampler.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include "yb/tablet/tablet.pb.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/random_util.h"
+
+DEFINE_int32(tablet_hot_key_sample_rate, 64,
+             "One in this many reads and writes of a tablet is sampled to find its hot keys and "
+             "hash ranges. 0 disables the sampling.");
+TAG_FLAG(tablet_hot_key_sample_rate, advanced);
+TAG_FLAG(tablet_hot_key_sample_rate, runtime);
+
+DEFINE_int32(tablet_hot_key_top_k, 16,
+             "Number of the most frequently sampled key hash codes tracked per tablet.");
+TAG_FLAG(tablet_hot_key_top_k, advanced);
+TAG_FLAG(tablet_hot_key_top_k, runtime);
+
+DEFINE_int32(tablet_hot_key_decay_period_s, 60,
+             "The sampled hot key and hash range counts of a tablet are halved this often.");
+TAG_FLAG(tablet_hot_key_decay_period_s, advanced);
+
+namespace yb {
+namespace tablet {
+
+constexpr size_t HotKeySampler::kNumRanges;
+
+void HotKeySampler::Counts::Halve() {
+  for (auto& count : ops) {
+    count /= 2;
+  }
+  overcount /= 2;
+}
+
+HotKeySampler::HotKeySampler(uint32_t start_hash_code, uint32_t end_hash_code)
+    : start_hash_code_(start_hash_code),
+      end_hash_code_(std::max(end_hash_code, start_hash_code + 1)),
+      last_decay_(MonoTime::Now()) {
+}
+
+void HotKeySampler::Sample(HotKeyOperation op, uint16_t hash_code) {
+  const int32_t sample_rate = FLAGS_tablet_hot_key_sample_rate;
+  if (sample_rate <= 0 || (sample_rate > 1 && !RandomWithChance(sample_rate))) {
+    return;
+  }
+  Record(op, hash_code);
+}
+
+void HotKeySampler::Record(HotKeyOperation op, uint16_t hash_code) {
+  const auto op_index = util::to_underlying(op);
+  const size_t top_k = std::max(FLAGS_tablet_hot_key_top_k, 1);
+
+  std::lock_guard<simple_spinlock> lock(mutex_);
+  DecayIfNeeded();
+  ++sampled_[op_index];
+
+  if (hash_code >= start_hash_code_ && hash_code < end_hash_code_) {
+    const size_t range = (hash_code - start_hash_code_) * kNumRanges /
+                         (end_hash_code_ - start_hash_code_);
+    ++ranges_[range].ops[op_index];
+  }
+
+  auto it = top_keys_.find(hash_code);
+  if (it == top_keys_.end()) {
+    uint64_t overcount = 0;
+    while (top_keys_.size() >= top_k) {
+      // Replace the least frequent key, the new key could have been sampled as often as it.
+      auto min_it = std::min_element(
+          top_keys_.begin(), top_keys_.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.second.Total() < rhs.second.Total();
+      });
+      overcount = min_it->second.Total();
+      top_keys_.erase(min_it);
+    }
+    it = top_keys_.emplace(hash_code, Counts()).first;
+    it->second.overcount = overcount;
+  }
+  ++it->second.ops[op_index];
+}
+
+void HotKeySampler::DecayIfNeeded() {
+  const auto now = MonoTime::Now();
+  if (now.GetDeltaSince(last_decay_).ToSeconds() < FLAGS_tablet_hot_key_decay_period_s) {
+    return;
+  }
+  last_decay_ = now;
+
+  for (auto& count : sampled_) {
+    count /= 2;
+  }
+  for (auto& range : ranges_) {
+    range.Halve();
+  }
+  for (auto it = top_keys_.begin(); it != top_keys_.end();) {
+    it->second.Halve();
+    if (it->second.Total() == 0) {
+      it = top_keys_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void HotKeySampler::ToPB(TabletHotKeysPB* pb) const {
+  const auto read_index = util::to_underlying(HotKeyOperation::kRead);
+  const auto write_index = util::to_underlying(HotKeyOperation::kWrite);
+
+  std::vector<std::pair<uint16_t, Counts>> top_keys;
+  std::array<Counts, kNumRanges> ranges;
+  {
+    std::lock_guard<simple_spinlock> lock(mutex_);
+    pb->set_sampled_reads(sampled_[read_index]);
+    pb->set_sampled_writes(sampled_[write_index]);
+    top_keys.assign(top_keys_.begin(), top_keys_.end());
+    ranges = ranges_;
+  }
+  pb->set_sample_rate(std::max(FLAGS_tablet_hot_key_sample_rate, 0));
+
+  std::sort(top_keys.begin(), top_keys.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.second.Total() > rhs.second.Total();
+  });
+  for (const auto& entry : top_keys) {
+    auto* key_pb = pb->add_hot_keys();
+    key_pb->set_hash_code(entry.first);
+    key_pb->set_sampled_reads(entry.second.ops[read_index]);
+    key_pb->set_sampled_writes(entry.second.ops[write_index]);
+    key_pb->set_max_overcount(entry.second.overcount);
+  }
+
+  const uint64_t range_size = end_hash_code_ - start_hash_code_;
+  for (size_t i = 0; i != kNumRanges; ++i) {
+    if (ranges[i].Total() == 0) {
+      continue;
+    }
+    auto* range_pb = pb->add_hot_ranges();
+    // The first hash code that maps to range i, i.e. the smallest h with h * N / size >= i.
+    range_pb->set_start_hash_code(
+        start_hash_code_ + (i * range_size + kNumRanges - 1) / kNumRanges);
+    range_pb->set_end_hash_code(
+        start_hash_code_ + ((i + 1) * range_size + kNumRanges - 1) / kNumRanges);
+    range_pb->set_sampled_reads(ranges[i].ops[read_index]);
+    range_pb->set_sampled_writes(ranges[i].ops[write_index]);
+  }
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,80 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_HOT_KEY_SAMPLER_H
+#define YB_TABLET_HOT_KEY_SAMPLER_H
+
+#include <array>
+#include <unordered_map>
+
+#include "yb/gutil/macros.h"
+#include "yb/util/enums.h"
+#include "yb/util/locks.h"
+#include "yb/util/monotime.h"
+
+namespace yb {
+namespace tablet {
+
+class TabletHotKeysPB;
+
+YB_DEFINE_ENUM(HotKeyOperation, (kRead)(kWrite));
+
+// Samples the hash codes of the keys that a tablet reads and writes, to find the keys and hash
+// ranges that drive its load. A random 1 in tablet_hot_key_sample_rate of the operations is
+// recorded. The hash codes of the recorded operations are counted in two ways:
+// - The top tablet_hot_key_top_k hash codes are tracked with the Space-Saving algorithm, which
+//   never underestimates the count of a tracked hash code and overestimates it by at most the
+//   count of the hash code it has replaced.
+// - The hash range of the tablet is split into kNumRanges equal ranges with one counter each.
+// All the counts are halved every tablet_hot_key_decay_period_s, so that they follow the load.
+class HotKeySampler {
+ public:
+  static constexpr size_t kNumRanges = 64;
+
+  // [start_hash_code, end_hash_code) is the hash range of the tablet.
+  HotKeySampler(uint32_t start_hash_code, uint32_t end_hash_code);
+
+  // Called for every read or write of a key with the given hash code.
+  void Sample(HotKeyOperation op, uint16_t hash_code);
+
+  void ToPB(TabletHotKeysPB* pb) const;
+
+ private:
+  struct Counts {
+    uint64_t ops[kHotKeyOperationMapSize] = {0, 0};
+    // For top keys: the count of the key that was replaced when this key was added.
+    uint64_t overcount = 0;
+
+    uint64_t Total() const { return ops[0] + ops[1] + overcount; }
+    void Halve();
+  };
+
+  void Record(HotKeyOperation op, uint16_t hash_code);
+  void DecayIfNeeded();
+
+  const uint32_t start_hash_code_;
+  const uint32_t end_hash_code_;
+
+  mutable simple_spinlock mutex_;
+  uint64_t sampled_[kHotKeyOperationMapSize] = {0, 0};
+  std::unordered_map<uint16_t, Counts> top_keys_;
+  std::array<Counts, kNumRanges> ranges_;
+  MonoTime last_decay_;
+
+  DISALLOW_COPY_AND_ASSIGN(HotKeySampler);
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_HOT_KEY_SAMPLER_H
@@ -108,6 +108,25 @@ TEST_F(TestTabletMetadata, TestLoadFromSuperBlock) {
             << superblock_pb_1.DebugString();
 }
 
+// Test that the parent of a tablet created by a split survives a superblock round trip.
+TEST_F(TestTabletMetadata, TestSplitParentTabletId) {
+  TabletMetadata* meta = harness_->tablet()->metadata();
+  ASSERT_TRUE(meta->split_parent_tablet_id().empty());
+
+  TabletSuperBlockPB superblock_pb;
+  ASSERT_OK(meta->ToSuperBlock(&superblock_pb));
+  ASSERT_FALSE(superblock_pb.has_split_parent_tablet_id());
+
+  meta->set_split_parent_tablet_id("parent");
+  ASSERT_OK(meta->Flush());
+
+  ASSERT_OK(meta->ReadSuperBlockFromDisk(&superblock_pb));
+  ASSERT_EQ("parent", superblock_pb.split_parent_tablet_id());
+
+  meta->set_split_parent_tablet_id("");
+  ASSERT_OK(meta->ReplaceSuperBlock(superblock_pb));
+  ASSERT_EQ("parent", meta->split_parent_tablet_id());
+}
 
 } // namespace tablet
 } // namespace yb
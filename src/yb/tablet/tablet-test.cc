@@ -172,6 +172,25 @@ TYPED_TEST(TestTablet, TestMultipleUpdates) {
   ASSERT_EQ(this->setup_.FormatDebugRow(1, 0, false), out_rows[1]);
 }
 
+// Test that compactions of a tablet that was not created by a split never drop keys.
+TYPED_TEST(TestTablet, TestCompactionKeepsAllKeys) {
+  ASSERT_TRUE(this->tablet()->key_bounds().unbounded());
+
+  const int32_t kNumRows = 100;
+  LocalTabletWriter writer(this->tablet().get());
+  for (int32_t i = 0; i < kNumRows; i++) {
+    ASSERT_OK(this->InsertTestRow(&writer, i, 0));
+    if (i % 25 == 24) {
+      ASSERT_OK(this->tablet()->Flush(tablet::FlushMode::kSync));
+    }
+  }
+  this->tablet()->ForceRocksDBCompactInTest();
+
+  vector<string> rows;
+  ASSERT_OK(this->IterateToStringList(&rows));
+  ASSERT_EQ(kNumRows, rows.size());
+}
+
 // Test that metrics behave properly during tablet initialization
 TYPED_TEST(TestTablet, TestMetricsInit) {
   // Create a tablet, but do not open it
@@ -270,7 +270,23 @@ struct WriteOperationData {
   }
 };
 
+namespace {
+
+uint32_t PartitionStartHashCode(const Partition& partition) {
+  const auto& key = partition.partition_key_start();
+  return key.empty() ? 0 : PartitionSchema::DecodeMultiColumnHashValue(key);
+}
+
+uint32_t PartitionEndHashCode(const Partition& partition) {
+  const auto& key = partition.partition_key_end();
+  return key.empty() ? PartitionSchema::kMaxPartitionKey + 1
+                     : PartitionSchema::DecodeMultiColumnHashValue(key);
+}
+
+} // namespace
+
 const char* Tablet::kDMSMemTrackerId = "DeltaMemStores";
+const char* Tablet::kMemTablesMemTrackerId = "MemTables";
 
 Tablet::Tablet(
     const scoped_refptr<TabletMetadata>& metadata,
@@ -288,11 +304,23 @@ Tablet::Tablet(
       mem_tracker_(
           MemTracker::CreateTracker(-1, Substitute("tablet-$0", tablet_id()), parent_mem_tracker)),
       dms_mem_tracker_(MemTracker::CreateTracker(-1, kDMSMemTrackerId, mem_tracker_)),
+      memtables_mem_tracker_(MemTracker::CreateTracker(-1, kMemTablesMemTrackerId, mem_tracker_)),
+      hot_key_sampler_(PartitionStartHashCode(metadata->partition()),
+                       PartitionEndHashCode(metadata->partition())),
       clock_(clock),
       mvcc_(Format("T $0 ", static_cast<void*>(this)), clock),
       tablet_options_(tablet_options) {
   CHECK(schema()->has_column_ids());
 
+  // Tables with a reserved part of the block cache use it instead of the shared block cache.
+  auto block_cache_it = tablet_options_.table_block_caches.find(metadata_->table_id());
+  if (block_cache_it == tablet_options_.table_block_caches.end()) {
+    block_cache_it = tablet_options_.table_block_caches.find(metadata_->table_name());
+  }
+  if (block_cache_it != tablet_options_.table_block_caches.end()) {
+    tablet_options_.block_cache = block_cache_it->second;
+  }
+
   if (metric_registry) {
     MetricEntity::AttributeMap attrs;
     // TODO(KUDU-745): table_id is apparently not set in the metadata.
@@ -340,6 +368,7 @@ Tablet::Tablet(
 Tablet::~Tablet() {
   Shutdown();
   dms_mem_tracker_->UnregisterFromParent();
+  memtables_mem_tracker_->UnregisterFromParent();
   mem_tracker_->UnregisterFromParent();
 }
 
@@ -365,12 +394,25 @@ Status Tablet::Open() {
 
 Status Tablet::OpenKeyValueTablet() {
   rocksdb::Options rocksdb_options;
-  docdb::InitRocksDBOptions(&rocksdb_options, tablet_id(), rocksdb_statistics_, tablet_options_);
+  docdb::InitRocksDBOptions(
+      &rocksdb_options, tablet_id(), rocksdb_statistics_, tablet_options_,
+      metadata_->schema().table_properties().num_bloom_filter_range_components());
+  if (rocksdb_options.memtable_huge_page_size > 0) {
+    rocksdb_options.memtable_mem_tracker = memtables_mem_tracker_;
+    memtables_mem_tracker_attached_ = true;
+  }
+
+  if (!metadata_->split_parent_tablet_id().empty()) {
+    key_bounds_ = docdb::KeyBounds::FromHashPartition(
+        metadata_->partition().partition_key_start(), metadata_->partition().partition_key_end());
+    LOG(INFO) << "Tablet " << tablet_id() << " split from " << metadata_->split_parent_tablet_id()
+              << ", key bounds: " << key_bounds_.ToString();
+  }
 
   // Install the history cleanup handler. Note that TabletRetentionPolicy is going to hold a raw ptr
   // to this tablet. So, we ensure that rocksdb_ is reset before this tablet gets destroyed.
   rocksdb_options.compaction_filter_factory = make_shared<DocDBCompactionFilterFactory>(
-      make_shared<TabletRetentionPolicy>(this));
+      make_shared<TabletRetentionPolicy>(this), &key_bounds_);
 
   auto mem_table_flush_filter_factory = [this] {
     if (mem_table_flush_filter_factory_) {
@@ -408,14 +450,90 @@ Status Tablet::OpenKeyValueTablet() {
     return STATUS(IllegalState, rocksdb_open_status.ToString());
   }
   rocksdb_.reset(db);
-  ql_storage_.reset(new docdb::QLRocksDBStorage(rocksdb_.get()));
+  ql_storage_.reset(new docdb::QLRocksDBStorage(rocksdb_.get(), &key_bounds_));
+  LOG(INFO) << "Successfully opened a RocksDB database at " << db_dir << ", obj: " << db;
+
   if (transaction_participant_) {
-    transaction_participant_->SetDB(db);
+    RETURN_NOT_OK(OpenIntentsDB(rocksdb_options));
+    transaction_participant_->SetDB(intents_db_.get());
   }
-  LOG(INFO) << "Successfully opened a RocksDB database at " << db_dir << ", obj: " << db;
   return Status::OK();
 }
 
+Status Tablet::OpenIntentsDB(const rocksdb::Options& regular_options) {
+  rocksdb::Options intents_options = regular_options;
+  // Intents are removed as soon as their transaction is applied, so there is no history to clean
+  // up during compactions.
+  intents_options.compaction_filter_factory = nullptr;
+
+  auto mem_table_flush_filter_factory = [this] {
+    return IntentsMemTableFlushFilter();
+  };
+  typedef decltype(intents_options.mem_table_flush_filter_factory)::element_type
+      MemTableFlushFilterFactoryType;
+  intents_options.mem_table_flush_filter_factory =
+      std::make_shared<MemTableFlushFilterFactoryType>(mem_table_flush_filter_factory);
+
+  const string db_dir = metadata()->intents_rocksdb_dir();
+  RETURN_NOT_OK_PREPEND(metadata()->fs_manager()->CreateDirIfMissing(db_dir),
+                        Substitute("Failed to create RocksDB intents directory $0", db_dir));
+
+  LOG(INFO) << "Opening intents RocksDB at: " << db_dir;
+  rocksdb::DB* db = nullptr;
+  rocksdb::Status rocksdb_open_status = rocksdb::DB::Open(intents_options, db_dir, &db);
+  if (!rocksdb_open_status.ok()) {
+    LOG(ERROR) << "Failed to open intents RocksDB in directory " << db_dir << ": "
+               << rocksdb_open_status.ToString();
+    if (db != nullptr) {
+      delete db;
+    }
+    return STATUS(IllegalState, rocksdb_open_status.ToString());
+  }
+  intents_db_.reset(db);
+  LOG(INFO) << "Successfully opened intents RocksDB at " << db_dir << ", obj: " << db;
+  return Status::OK();
+}
+
+rocksdb::MemTableFilter Tablet::IntentsMemTableFlushFilter() {
+  // Intents of an operation could be flushed only after regular records of the same operation,
+  // otherwise we could lose records of applied transactions during bootstrap. When the regular
+  // RocksDB does not have unflushed records, all operations applied so far are already persistent
+  // in it.
+  int64_t regular_flushed_index = std::numeric_limits<int64_t>::max();
+  uint64_t active_entries = 0, immutable_entries = 0;
+  rocksdb_->GetIntProperty(
+      rocksdb::DB::Properties::kNumEntriesActiveMemTable, &active_entries);
+  rocksdb_->GetIntProperty(
+      rocksdb::DB::Properties::kNumEntriesImmMemTables, &immutable_entries);
+  if (active_entries + immutable_entries != 0) {
+    auto flushed_frontier = rocksdb_->GetFlushedFrontier();
+    regular_flushed_index = flushed_frontier
+        ? down_cast<docdb::ConsensusFrontier*>(flushed_frontier.get())->op_id().index
+        : 0;
+  }
+
+  return [this, regular_flushed_index](const rocksdb::MemTable& memtable) -> Result<bool> {
+    auto frontiers = memtable.Frontiers();
+    if (!frontiers) {
+      return STATUS(IllegalState, "Intents memtable with no frontiers set");
+    }
+    const auto& largest = down_cast<const docdb::ConsensusFrontier&>(frontiers->Largest());
+    if (largest.op_id().index <= regular_flushed_index) {
+      return true;
+    }
+    // Regular records of this memtable are not flushed yet, so ask for it. The intents flush is
+    // rescheduled by RocksDB until this memtable passes the filter.
+    uint64_t flush_pending = 0;
+    rocksdb_->GetIntProperty(rocksdb::DB::Properties::kMemTableFlushPending, &flush_pending);
+    if (!flush_pending) {
+      rocksdb::FlushOptions options;
+      options.wait = false;
+      rocksdb_->Flush(options);
+    }
+    return false;
+  };
+}
+
 void Tablet::MarkFinishedBootstrapping() {
   CHECK_EQ(state_, kBootstrapping);
   state_ = kOpen;
@@ -439,7 +557,9 @@ void Tablet::Shutdown() {
   }
 
   std::lock_guard<rw_spinlock> lock(component_lock_);
-  // Shutdown the RocksDB instance for this table, if present.
+  // Shutdown the RocksDB instances for this table, if present.
+  // The intents RocksDB is destroyed first, because its flush filter refers to the regular one.
+  intents_db_.reset();
   rocksdb_.reset();
   state_ = kShutdown;
 }
@@ -466,7 +586,7 @@ Result<std::unique_ptr<common::QLRowwiseIteratorIf>> Tablet::NewRowIterator(
   auto read_time = ReadHybridTime::SingleTime(HybridTime::kMax);
   auto result = std::make_unique<DocRowwiseIterator>(
       std::move(mapped_projection), *schema(), txn_op_ctx, rocksdb_.get(), read_time,
-      &pending_op_counter_);
+      &pending_op_counter_, &key_bounds_);
   RETURN_NOT_OK(result->Init());
   return std::move(result);
 }
@@ -482,7 +602,8 @@ void Tablet::StartOperation(WriteOperationState* operation_state) {
   }
 }
 
-void Tablet::ApplyRowOperations(WriteOperationState* operation_state) {
+void Tablet::ApplyRowOperations(WriteOperationState* operation_state,
+                                AlreadyAppliedToRegularDB already_applied_to_regular_db) {
   last_committed_write_index_.store(operation_state->op_id().index(), std::memory_order_release);
   const KeyValueWriteBatchPB& put_batch =
       operation_state->consensus_round() && operation_state->consensus_round()->replicate_msg()
@@ -494,7 +615,44 @@ void Tablet::ApplyRowOperations(WriteOperationState* operation_state) {
   docdb::ConsensusFrontiers frontiers;
   set_op_id({operation_state->op_id().term(), operation_state->op_id().index()}, &frontiers);
   set_hybrid_time(operation_state->hybrid_time(), &frontiers);
-  ApplyKeyValueRowOperations(put_batch, &frontiers, operation_state->hybrid_time());
+  ApplyKeyValueRowOperations(
+      put_batch, &frontiers, operation_state->hybrid_time(), already_applied_to_regular_db);
+}
+
+bool Tablet::AppendRowOperations(WriteOperationState* operation_state,
+                                 AlreadyAppliedToRegularDB already_applied_to_regular_db,
+                                 RegularWriteBatch* batch) {
+  const KeyValueWriteBatchPB& put_batch = operation_state->request()->write_batch();
+  if (put_batch.has_transaction()) {
+    return false;
+  }
+  last_committed_write_index_.store(operation_state->op_id().index(), std::memory_order_release);
+  if (put_batch.kv_pairs_size() == 0 || already_applied_to_regular_db) {
+    return true;
+  }
+
+  docdb::ConsensusFrontiers frontiers;
+  set_op_id({operation_state->op_id().term(), operation_state->op_id().index()}, &frontiers);
+  set_hybrid_time(operation_state->hybrid_time(), &frontiers);
+  if (batch->num_operations == 0) {
+    batch->frontiers = frontiers;
+  } else {
+    batch->frontiers.Merge(frontiers);
+  }
+  batch->max_hybrid_time.MakeAtLeast(operation_state->hybrid_time());
+  ++batch->num_operations;
+  PrepareNonTransactionWriteBatch(put_batch, operation_state->hybrid_time(), &batch->write_batch);
+  return true;
+}
+
+void Tablet::WriteRegularBatch(RegularWriteBatch* batch) {
+  if (batch->num_operations == 0) {
+    return;
+  }
+  WriteToRocksDB(&batch->frontiers, batch->max_hybrid_time, &batch->write_batch, rocksdb_.get());
+  batch->write_batch.Clear();
+  batch->max_hybrid_time = HybridTime::kMin;
+  batch->num_operations = 0;
 }
 
 Status Tablet::CreateCheckpoint(const std::string& dir,
@@ -504,31 +662,37 @@ Status Tablet::CreateCheckpoint(const std::string& dir,
 
   std::lock_guard<std::mutex> lock(create_checkpoint_lock_);
 
-  rocksdb::Status status = rocksdb::checkpoint::CreateCheckpoint(rocksdb_.get(), dir);
+  // Intents checkpoint is created before the regular one, so regular records of all operations
+  // flushed to the intents checkpoint are also present in the regular checkpoint.
+  const auto intents_dir = JoinPathSegments(dir, kIntentsSubdir);
+  const auto intents_tmp_dir = dir + "." + kIntentsSubdir;
+  rocksdb::Status status;
+  if (intents_db_) {
+    status = rocksdb::checkpoint::CreateCheckpoint(intents_db_.get(), intents_tmp_dir);
+    if (!status.ok()) {
+      LOG(WARNING) << "Create intents checkpoint status: " << status.ToString();
+      return STATUS(IllegalState, Substitute("Unable to create intents checkpoint: $0",
+                                             status.ToString()));
+    }
+  }
+
+  status = rocksdb::checkpoint::CreateCheckpoint(rocksdb_.get(), dir);
 
   if (!status.ok()) {
     LOG(WARNING) << "Create checkpoint status: " << status.ToString();
     return STATUS(IllegalState, Substitute("Unable to create checkpoint: $0", status.ToString()));
   }
+
+  if (intents_db_) {
+    RETURN_NOT_OK_PREPEND(metadata_->fs_manager()->env()->RenameFile(intents_tmp_dir, intents_dir),
+                          "Unable to move intents checkpoint");
+  }
   LOG(INFO) << "Checkpoint created in " << dir;
 
   if (rocksdb_files != nullptr) {
-    vector<rocksdb::Env::FileAttributes> files_attrs;
-    status = rocksdb_->GetEnv()->GetChildrenFileAttributes(dir, &files_attrs);
-    if (!status.ok()) {
-      return STATUS(IllegalState, Substitute("Unable to get RocksDB files in dir $0: $1", dir,
-                                             status.ToString()));
-    }
-
-    for (const auto& file_attrs : files_attrs) {
-      if (file_attrs.name == "." || file_attrs.name == "..") {
-        continue;
-      }
-      auto rocksdb_file_pb = rocksdb_files->Add();
-      rocksdb_file_pb->set_name(file_attrs.name);
-      rocksdb_file_pb->set_size_bytes(file_attrs.size_bytes);
-      rocksdb_file_pb->set_inode(VERIFY_RESULT(
-          metadata_->fs_manager()->env()->GetFileINode(JoinPathSegments(dir, file_attrs.name))));
+    RETURN_NOT_OK(AddCheckpointFiles(dir, "", rocksdb_files));
+    if (intents_db_) {
+      RETURN_NOT_OK(AddCheckpointFiles(intents_dir, kIntentsSubdir, rocksdb_files));
     }
   }
 
@@ -537,6 +701,30 @@ Status Tablet::CreateCheckpoint(const std::string& dir,
   return Status::OK();
 }
 
+Status Tablet::AddCheckpointFiles(const std::string& dir,
+                                  const std::string& prefix,
+                                  google::protobuf::RepeatedPtrField<FilePB>* rocksdb_files) {
+  vector<rocksdb::Env::FileAttributes> files_attrs;
+  auto status = rocksdb_->GetEnv()->GetChildrenFileAttributes(dir, &files_attrs);
+  if (!status.ok()) {
+    return STATUS(IllegalState, Substitute("Unable to get RocksDB files in dir $0: $1", dir,
+                                           status.ToString()));
+  }
+
+  for (const auto& file_attrs : files_attrs) {
+    if (file_attrs.name == "." || file_attrs.name == ".." || file_attrs.name == kIntentsSubdir) {
+      continue;
+    }
+    auto rocksdb_file_pb = rocksdb_files->Add();
+    rocksdb_file_pb->set_name(
+        prefix.empty() ? file_attrs.name : JoinPathSegments(prefix, file_attrs.name));
+    rocksdb_file_pb->set_size_bytes(file_attrs.size_bytes);
+    rocksdb_file_pb->set_inode(VERIFY_RESULT(
+        metadata_->fs_manager()->env()->GetFileINode(JoinPathSegments(dir, file_attrs.name))));
+  }
+  return Status::OK();
+}
+
 void Tablet::PrepareTransactionWriteBatch(
     const KeyValueWriteBatchPB& put_batch,
     HybridTime hybrid_time,
@@ -558,35 +746,43 @@ void Tablet::PrepareTransactionWriteBatch(
 void Tablet::ApplyKeyValueRowOperations(const KeyValueWriteBatchPB& put_batch,
                                         const rocksdb::UserFrontiers* frontiers,
                                         const HybridTime hybrid_time,
-                                        rocksdb::WriteBatch* rocksdb_write_batch) {
-  // Write batch could be preallocated, here we handle opposite case.
-  if (rocksdb_write_batch == nullptr) {
-    WriteBatch write_batch;
-    ApplyKeyValueRowOperations(put_batch, frontiers, hybrid_time, &write_batch);
+                                        AlreadyAppliedToRegularDB already_applied_to_regular_db) {
+  if (put_batch.kv_pairs_size() == 0) {
     return;
   }
 
-  if (put_batch.kv_pairs_size() == 0 && rocksdb_write_batch->Count() == 0) {
-    return;
+  WriteBatch write_batch;
+  if (put_batch.has_transaction()) {
+    // Intents could be missing from the intents RocksDB even when the operation is already present
+    // in the regular one, so transactional writes are always replayed.
+    PrepareTransactionWriteBatch(put_batch, hybrid_time, &write_batch);
+    WriteToRocksDB(frontiers, hybrid_time, &write_batch,
+                   intents_db_ ? intents_db_.get() : rocksdb_.get());
+  } else if (!already_applied_to_regular_db) {
+    PrepareNonTransactionWriteBatch(put_batch, hybrid_time, &write_batch);
+    WriteToRocksDB(frontiers, hybrid_time, &write_batch, rocksdb_.get());
   }
+}
 
-  rocksdb_write_batch->SetFrontiers(frontiers);
-
-  if (put_batch.has_transaction()) {
-    PrepareTransactionWriteBatch(put_batch, hybrid_time, rocksdb_write_batch);
-  } else {
-    PrepareNonTransactionWriteBatch(put_batch, hybrid_time, rocksdb_write_batch);
+void Tablet::WriteToRocksDB(const rocksdb::UserFrontiers* frontiers,
+                            const HybridTime hybrid_time,
+                            rocksdb::WriteBatch* write_batch,
+                            rocksdb::DB* dest_db) {
+  if (write_batch->Count() == 0) {
+    return;
   }
 
+  write_batch->SetFrontiers(frontiers);
+
   // We are using Raft replication index for the RocksDB sequence number for
   // all members of this write batch.
   rocksdb::WriteOptions write_options;
   InitRocksDBWriteOptions(&write_options);
 
   flush_stats_->AboutToWriteToDb(hybrid_time);
-  auto rocksdb_write_status = rocksdb_->Write(write_options, rocksdb_write_batch);
+  auto rocksdb_write_status = dest_db->Write(write_options, write_batch);
   if (!rocksdb_write_status.ok()) {
-    LOG(FATAL) << "Failed to write a batch with " << rocksdb_write_batch->Count() << " operations"
+    LOG(FATAL) << "Failed to write a batch with " << write_batch->Count() << " operations"
                << " into RocksDB: " << rocksdb_write_status.ToString();
   }
 }
@@ -621,6 +817,10 @@ Status Tablet::KeyValueBatchFromRedisWriteBatch(const WriteOperationData& data)
 
   doc_ops.reserve(redis_write_batch->size());
   for (size_t i = 0; i < redis_write_batch->size(); i++) {
+    const auto& key_value = redis_write_batch->Get(i).key_value();
+    if (key_value.has_hash_code()) {
+      hot_key_sampler_.Sample(HotKeyOperation::kWrite, key_value.hash_code());
+    }
     doc_ops.emplace_back(new RedisWriteOperation(redis_write_batch->Mutable(i)));
   }
   RETURN_NOT_OK(StartDocWriteOperation(doc_ops, data));
@@ -644,6 +844,10 @@ Status Tablet::HandleRedisReadRequest(const ReadHybridTime& read_time,
 
   ScopedTabletMetricsTracker metrics_tracker(metrics_->redis_read_latency);
 
+  if (redis_read_request.has_key_value() && redis_read_request.key_value().has_hash_code()) {
+    hot_key_sampler_.Sample(HotKeyOperation::kRead, redis_read_request.key_value().hash_code());
+  }
+
   docdb::RedisReadOperation doc_op(redis_read_request, rocksdb_.get(), read_time);
   RETURN_NOT_OK(doc_op.Execute());
   *response = std::move(doc_op.response());
@@ -664,6 +868,11 @@ Status Tablet::HandleQLReadRequest(
     return Status::OK();
   }
 
+  // Scans are not attributed to any key.
+  if (!ql_read_request.hashed_column_values().empty()) {
+    hot_key_sampler_.Sample(HotKeyOperation::kRead, ql_read_request.hash_code());
+  }
+
   Result<TransactionOperationContextOpt> txn_op_ctx =
       CreateTransactionOperationContext(transaction_metadata);
   RETURN_NOT_OK(txn_op_ctx);
@@ -688,9 +897,11 @@ CHECKED_STATUS Tablet::CreatePagingStateForRead(const QLReadRequestPB& ql_read_r
 
     // Check we did not reach the results limit.
     // If return_paging_state is set, it means the request limit is actually just the page size.
+    // An aggregate read returns partial aggregates, so it always needs to read all tablets.
     if (!ql_read_request.has_limit() ||
         row_count < ql_read_request.limit() ||
-        ql_read_request.return_paging_state()) {
+        ql_read_request.return_paging_state() ||
+        ql_read_request.is_aggregate()) {
 
       // Check we did not reach the last tablet.
       const string& next_partition_key = metadata_->partition().partition_key_end();
@@ -734,6 +945,7 @@ Status Tablet::KeyValueBatchFromQLWriteBatch(const WriteOperationData& data) {
     if (metadata_->schema_version() != req->schema_version()) {
       resp->set_status(QLResponsePB::YQL_STATUS_SCHEMA_VERSION_MISMATCH);
     } else {
+      hot_key_sampler_.Sample(HotKeyOperation::kWrite, req->hash_code());
       const auto& schema = metadata_->schema();
       auto write_op = std::make_unique<QLWriteOperation>(schema, *txn_op_ctx);
       RETURN_NOT_OK(write_op->Init(req, resp));
@@ -808,9 +1020,54 @@ Status Tablet::Flush(FlushMode mode) {
   rocksdb::FlushOptions options;
   options.wait = mode == FlushMode::kSync;
   rocksdb_->Flush(options);
+  // Intents are flushed after regular records, see IntentsMemTableFlushFilter.
+  if (intents_db_) {
+    intents_db_->Flush(options);
+  }
   return Status::OK();
 }
 
+Result<bool> Tablet::IsFlushInProgress() const {
+  ScopedPendingOperation scoped_read_operation(&pending_op_counter_);
+  RETURN_NOT_OK(scoped_read_operation);
+
+  for (auto* db : {rocksdb_.get(), intents_db_.get()}) {
+    if (!db) {
+      continue;
+    }
+    uint64_t flush_pending = 0;
+    uint64_t running_flushes = 0;
+    db->GetIntProperty(rocksdb::DB::Properties::kMemTableFlushPending, &flush_pending);
+    db->GetIntProperty(rocksdb::DB::Properties::kNumRunningFlushes, &running_flushes);
+    if (flush_pending || running_flushes) {
+      return true;
+    }
+  }
+  return false;
+}
+
+int64_t Tablet::MemTablesMemoryUsage() const {
+  if (memtables_mem_tracker_attached_) {
+    return memtables_mem_tracker_->consumption();
+  }
+
+  ScopedPendingOperation scoped_read_operation(&pending_op_counter_);
+  if (!scoped_read_operation.ok()) {
+    return 0;
+  }
+
+  uint64_t result = 0;
+  for (auto* db : {rocksdb_.get(), intents_db_.get()}) {
+    if (!db) {
+      continue;
+    }
+    uint64_t memtables_size = 0;
+    db->GetIntProperty(rocksdb::DB::Properties::kCurSizeAllMemTables, &memtables_size);
+    result += memtables_size;
+  }
+  return result;
+}
+
 Status Tablet::ImportData(const std::string& source_dir) {
   return rocksdb_->Import(source_dir);
 }
@@ -827,27 +1084,45 @@ Status Tablet::ImportData(const std::string& source_dir) {
 // We apply intents using by iterating over whole transaction reverse index.
 // Using value of reverse index record we find original intent record and apply it.
 // After that we delete both intent record and reverse index record.
+// Applied records are written to the regular RocksDB, while deletions go to the intents RocksDB.
 // TODO(dtxn) use separate thread for applying intents.
 // TODO(dtxn) use multiple batches when applying really big transaction.
 Status Tablet::ApplyIntents(const TransactionApplyData& data) {
+  rocksdb::DB* intents_db = intents_db_ ? intents_db_.get() : rocksdb_.get();
   auto reverse_index_iter = docdb::CreateRocksDBIterator(
-      rocksdb_.get(),
+      intents_db,
       docdb::BloomFilterMode::DONT_USE_BLOOM_FILTER,
       boost::none,
       rocksdb::kDefaultQueryId);
 
-  auto intent_iter = docdb::CreateRocksDBIterator(rocksdb_.get(),
+  auto intent_iter = docdb::CreateRocksDBIterator(intents_db,
                                                   docdb::BloomFilterMode::DONT_USE_BLOOM_FILTER,
                                                   boost::none,
                                                   rocksdb::kDefaultQueryId);
 
+  // During bootstrap this operation could be already present in the regular RocksDB, while
+  // intents RocksDB is behind it. In this case we just remove intents.
+  auto already_applied_to_regular_db = AlreadyAppliedToRegularDB::kFalse;
+  if (intents_db_) {
+    auto flushed_frontier = rocksdb_->GetFlushedFrontier();
+    if (flushed_frontier) {
+      const auto& flushed_op_id =
+          down_cast<docdb::ConsensusFrontier*>(flushed_frontier.get())->op_id();
+      already_applied_to_regular_db = AlreadyAppliedToRegularDB(
+          data.op_id.index() <= flushed_op_id.index);
+    }
+  }
+
   KeyBytes txn_reverse_index_prefix;
   Slice transaction_id_slice(data.transaction_id.data, TransactionId::static_size());
   AppendTransactionKeyPrefix(data.transaction_id, &txn_reverse_index_prefix);
 
   reverse_index_iter->Seek(txn_reverse_index_prefix.data());
 
-  WriteBatch rocksdb_write_batch;
+  WriteBatch regular_write_batch;
+  WriteBatch intents_write_batch;
+  // Without separate intents RocksDB everything is written in a single batch.
+  WriteBatch& remove_write_batch = intents_db_ ? intents_write_batch : regular_write_batch;
 
   docdb::DocHybridTimeBuffer doc_ht_buffer;
 
@@ -891,25 +1166,34 @@ Status Tablet::ApplyIntents(const TransactionApplyData& data) {
             intent->doc_ht,
             intent_value,
         }};
-        rocksdb_write_batch.Put(key_parts, value_parts);
+        if (!already_applied_to_regular_db) {
+          regular_write_batch.Put(key_parts, value_parts);
+        }
         ++write_id;
       }
 
-      rocksdb_write_batch.Delete(intent_iter->key());
+      // Intent and reverse index records are written exactly once, so single delete is enough.
+      // It allows to drop both records as soon as they meet each other in flush or compaction.
+      remove_write_batch.SingleDelete(intent_iter->key());
+      remove_write_batch.SingleDelete(reverse_index_iter->key());
+    } else {
+      // Transaction metadata could be written multiple times.
+      remove_write_batch.Delete(reverse_index_iter->key());
     }
 
-    rocksdb_write_batch.Delete(reverse_index_iter->key());
-
     reverse_index_iter->Next();
   }
 
   // data.hybrid_time contains transaction commit time.
-  // We don't set transaction field of put_batch, otherwise we would write another bunch of intents.
   docdb::ConsensusFrontiers frontiers;
   set_op_id({data.op_id.term(), data.op_id.index()}, &frontiers);
   set_hybrid_time(data.log_ht, &frontiers);
-  ApplyKeyValueRowOperations(
-      KeyValueWriteBatchPB(), &frontiers, data.commit_ht, &rocksdb_write_batch);
+  // Regular records are written first, so intents are never removed before their values are
+  // stored.
+  WriteToRocksDB(&frontiers, data.commit_ht, &regular_write_batch, rocksdb_.get());
+  if (intents_db_) {
+    WriteToRocksDB(&frontiers, data.commit_ht, &intents_write_batch, intents_db_.get());
+  }
   return Status::OK();
 }
 
@@ -997,13 +1281,19 @@ Result<ScopedPendingOperationPause> Tablet::PauseReadWriteOperations() {
 }
 
 Status Tablet::SetFlushedFrontier(const docdb::ConsensusFrontier& frontier) {
-  const Status s = rocksdb_->SetFlushedFrontier(frontier.Clone());
-  if (PREDICT_FALSE(!s.ok())) {
-    auto status = STATUS(IllegalState, "Failed to set flushed frontier", s.ToString());
-    LOG(WARNING) << status;
-    return status;
+  // Both RocksDBs are reset to the same frontier, regular one first.
+  for (auto* db : {rocksdb_.get(), intents_db_.get()}) {
+    if (!db) {
+      continue;
+    }
+    const Status s = db->SetFlushedFrontier(frontier.Clone());
+    if (PREDICT_FALSE(!s.ok())) {
+      auto status = STATUS(IllegalState, "Failed to set flushed frontier", s.ToString());
+      LOG(WARNING) << status;
+      return status;
+    }
+    DCHECK_EQ(frontier, *db->GetFlushedFrontier());
   }
-  DCHECK_EQ(frontier, *rocksdb_->GetFlushedFrontier());
   return Flush(FlushMode::kAsync);
 }
 
@@ -1018,19 +1308,27 @@ Status Tablet::Truncate(TruncateOperationState *state) {
 
   const rocksdb::SequenceNumber sequence_number = rocksdb_->GetLatestSequenceNumber();
   const string db_dir = rocksdb_->GetName();
+  const string intents_db_dir = intents_db_ ? intents_db_->GetName() : string();
 
+  intents_db_ = nullptr;
   rocksdb_ = nullptr;
   rocksdb::Options rocksdb_options;
   docdb::InitRocksDBOptions(&rocksdb_options, tablet_id(), rocksdb_statistics_, tablet_options_);
-  Status s = rocksdb::DestroyDB(db_dir, rocksdb_options);
-  if (PREDICT_FALSE(!s.ok())) {
-    LOG(WARNING) << "Failed to clean up db dir " << db_dir << ": " << s;
-    return STATUS(IllegalState, "Failed to clean up db dir", s.ToString());
+  // Intents RocksDB lives in the subdirectory of the regular one, so it is destroyed first.
+  for (const auto& dir : {intents_db_dir, db_dir}) {
+    if (dir.empty()) {
+      continue;
+    }
+    Status s = rocksdb::DestroyDB(dir, rocksdb_options);
+    if (PREDICT_FALSE(!s.ok())) {
+      LOG(WARNING) << "Failed to clean up db dir " << dir << ": " << s;
+      return STATUS(IllegalState, "Failed to clean up db dir", s.ToString());
+    }
   }
 
   // Creata a new database.
   // Note: db_dir == metadata()->rocksdb_dir() is still valid db dir.
-  s = OpenKeyValueTablet();
+  Status s = OpenKeyValueTablet();
   if (PREDICT_FALSE(!s.ok())) {
     LOG(WARNING) << "Failed to create a new db: " << s;
     return s;
@@ -1072,6 +1370,22 @@ Result<bool> Tablet::HasSSTables() const {
   return !live_files_metadata.empty();
 }
 
+Result<uint16_t> Tablet::GetSplitHashCode() const {
+  ScopedPendingOperation scoped_read_operation(&pending_op_counter_);
+  RETURN_NOT_OK(scoped_read_operation);
+
+  const auto& partition = metadata_->partition();
+  const uint32_t start = partition.partition_key_start().empty()
+      ? 0 : PartitionSchema::DecodeMultiColumnHashValue(partition.partition_key_start());
+  const uint32_t end = partition.partition_key_end().empty()
+      ? PartitionSchema::kMaxPartitionKey + 1
+      : PartitionSchema::DecodeMultiColumnHashValue(partition.partition_key_end());
+
+  std::vector<rocksdb::LiveFileMetaData> live_files_metadata;
+  rocksdb_->GetLiveFilesMetaData(&live_files_metadata);
+  return docdb::GetSplitHashCode(live_files_metadata, start, end);
+}
+
 Result<yb::OpId> Tablet::MaxPersistentOpId() const {
   ScopedPendingOperation scoped_read_operation(&pending_op_counter_);
   RETURN_NOT_OK(scoped_read_operation);
@@ -1083,6 +1397,35 @@ Result<yb::OpId> Tablet::MaxPersistentOpId() const {
   return down_cast<docdb::ConsensusFrontier*>(temp.get())->op_id();
 }
 
+Result<yb::OpId> Tablet::MaxPersistentIntentsOpId() const {
+  if (!intents_db_) {
+    return MaxPersistentOpId();
+  }
+
+  ScopedPendingOperation scoped_read_operation(&pending_op_counter_);
+  RETURN_NOT_OK(scoped_read_operation);
+
+  auto temp = intents_db_->GetFlushedFrontier();
+  if (!temp) {
+    return yb::OpId();
+  }
+  return down_cast<docdb::ConsensusFrontier*>(temp.get())->op_id();
+}
+
+bool Tablet::HasUnflushedIntents() const {
+  ScopedPendingOperation scoped_read_operation(&pending_op_counter_);
+  if (!scoped_read_operation.ok() || !intents_db_) {
+    return false;
+  }
+
+  uint64_t active_entries = 0, immutable_entries = 0;
+  intents_db_->GetIntProperty(
+      rocksdb::DB::Properties::kNumEntriesActiveMemTable, &active_entries);
+  intents_db_->GetIntProperty(
+      rocksdb::DB::Properties::kNumEntriesImmMemTables, &immutable_entries);
+  return active_entries + immutable_entries != 0;
+}
+
 Status Tablet::DebugDump(vector<string> *lines) {
   switch (table_type_) {
     case TableType::YQL_TABLE_TYPE:
@@ -1097,6 +1440,11 @@ void Tablet::DocDBDebugDump(vector<string> *lines) {
   LOG_STRING(INFO, lines) << "Dumping tablet:";
   LOG_STRING(INFO, lines) << "---------------------------";
   yb::docdb::DocDBDebugDump(rocksdb_.get(), LOG_STRING(INFO, lines));
+  if (intents_db_) {
+    LOG_STRING(INFO, lines) << "Dumping intents:";
+    LOG_STRING(INFO, lines) << "---------------------------";
+    yb::docdb::DocDBDebugDump(intents_db_.get(), LOG_STRING(INFO, lines));
+  }
 }
 
 namespace {
@@ -1148,7 +1496,8 @@ Status Tablet::StartDocWriteOperation(const docdb::DocOperations &doc_ops,
       metadata_->schema().table_properties().is_transactional()) {
     auto now = clock_->Now();
     auto result = docdb::ResolveOperationConflicts(
-        doc_ops, now, rocksdb_.get(), transaction_participant_.get());
+        doc_ops, now, rocksdb_.get(), intents_db_ ? intents_db_.get() : rocksdb_.get(),
+        transaction_participant_.get());
     RETURN_NOT_OK(result);
     if (now != *result) {
       clock_->Update(*result);
@@ -1172,6 +1521,8 @@ Status Tablet::StartDocWriteOperation(const docdb::DocOperations &doc_ops,
     auto result = docdb::ResolveTransactionConflicts(*write_batch,
                                                      clock_->Now(),
                                                      rocksdb_.get(),
+                                                     intents_db_ ? intents_db_.get()
+                                                                 : rocksdb_.get(),
                                                      transaction_participant_.get());
     if (!result.ok()) {
       *data.keys_locked = LockBatch();  // Unlock the keys.
@@ -1267,7 +1618,11 @@ uint64_t Tablet::GetTotalSSTFileSizes() const {
   if (!pending_op_counter_.IsReady() || !rocksdb_) {
     return 0;
   }
-  return rocksdb_->GetTotalSSTFileSize();
+  auto result = rocksdb_->GetTotalSSTFileSize();
+  if (intents_db_) {
+    result += intents_db_->GetTotalSSTFileSize();
+  }
+  return result;
 }
 
 Result<TransactionOperationContextOpt> Tablet::CreateTransactionOperationContext(
@@ -1278,12 +1633,13 @@ Result<TransactionOperationContextOpt> Tablet::CreateTransactionOperationContext
           transaction_metadata.transaction_id());
       RETURN_NOT_OK(txn_id);
       return Result<TransactionOperationContextOpt>(boost::make_optional(
-          TransactionOperationContext(*txn_id, transaction_participant())));
+          TransactionOperationContext(*txn_id, transaction_participant(), intents_db_.get())));
     } else {
       // We still need context with transaction participant in order to resolve intents during
       // possible reads.
       return Result<TransactionOperationContextOpt>(boost::make_optional(
-          TransactionOperationContext(GenerateTransactionId(), transaction_participant())));
+          TransactionOperationContext(
+              GenerateTransactionId(), transaction_participant(), intents_db_.get())));
     }
   } else {
     return Result<TransactionOperationContextOpt>(boost::none);
@@ -1294,11 +1650,13 @@ TransactionOperationContextOpt Tablet::CreateTransactionOperationContext(
     const boost::optional<TransactionId>& transaction_id) const {
   if (metadata_->schema().table_properties().is_transactional()) {
     if (transaction_id.is_initialized()) {
-      return TransactionOperationContext(transaction_id.get(), transaction_participant());
+      return TransactionOperationContext(
+          transaction_id.get(), transaction_participant(), intents_db_.get());
     } else {
       // We still need context with transaction participant in order to resolve intents during
       // possible reads.
-      return TransactionOperationContext(GenerateTransactionId(), transaction_participant());
+      return TransactionOperationContext(
+          GenerateTransactionId(), transaction_participant(), intents_db_.get());
     }
   } else {
     return boost::none;
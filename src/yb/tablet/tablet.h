@@ -52,9 +52,11 @@
 #include "yb/common/transaction.h"
 #include "yb/common/ql_storage_interface.h"
 
+#include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/docdb.pb.h"
 #include "yb/docdb/docdb_compaction_filter.h"
 #include "yb/docdb/doc_operation.h"
+#include "yb/docdb/key_bounds.h"
 #include "yb/docdb/ql_rocksdb_storage.h"
 #include "yb/docdb/shared_lock_manager.h"
 
@@ -63,6 +65,7 @@
 #include "yb/gutil/macros.h"
 
 #include "yb/tablet/abstract_tablet.h"
+#include "yb/tablet/hot_key_sampler.h"
 #include "yb/tablet/lock_manager.h"
 #include "yb/tablet/tablet_options.h"
 #include "yb/tablet/mvcc.h"
@@ -154,6 +157,15 @@ YB_DEFINE_ENUM(FlushMode, (kSync)(kAsync));
 
 struct WriteOperationData;
 
+// Non-transactional writes of consecutive operations, collected to be applied to the regular
+// RocksDB with a single write during bootstrap.
+struct RegularWriteBatch {
+  rocksdb::WriteBatch write_batch;
+  docdb::ConsensusFrontiers frontiers;
+  HybridTime max_hybrid_time = HybridTime::kMin;
+  size_t num_operations = 0;
+};
+
 class Tablet : public AbstractTablet, public TransactionIntentApplier {
  public:
   class CompactionFaultHooks;
@@ -226,15 +238,30 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   void StartOperation(WriteOperationState* operation_state);
 
   // Apply all of the row operations associated with this transaction.
-  void ApplyRowOperations(WriteOperationState* operation_state);
+  // already_applied_to_regular_db is set during bootstrap for operations that are already present
+  // in the regular RocksDB, but could be missing in the intents RocksDB.
+  void ApplyRowOperations(
+      WriteOperationState* operation_state,
+      AlreadyAppliedToRegularDB already_applied_to_regular_db = AlreadyAppliedToRegularDB::kFalse);
+
+  // Same as ApplyRowOperations, but the writes of a non-transactional operation are appended to
+  // 'batch' instead of being written to the regular RocksDB right away. Returns false and does
+  // nothing for a transactional operation, which should be applied with ApplyRowOperations after
+  // 'batch' is written.
+  bool AppendRowOperations(
+      WriteOperationState* operation_state, AlreadyAppliedToRegularDB already_applied_to_regular_db,
+      RegularWriteBatch* batch);
+
+  // Writes the operations collected in 'batch' to the regular RocksDB, and clears it.
+  void WriteRegularBatch(RegularWriteBatch* batch);
 
   // Apply a set of RocksDB row operations.
-  // If rocksdb_write_batch is specified it could contain preencoded RocksDB operations.
+  // Transactional operations are written to the intents RocksDB, all others to the regular one.
   void ApplyKeyValueRowOperations(
       const docdb::KeyValueWriteBatchPB& put_batch,
       const rocksdb::UserFrontiers* frontiers,
       HybridTime hybrid_time,
-      rocksdb::WriteBatch* rocksdb_write_batch = nullptr);
+      AlreadyAppliedToRegularDB already_applied_to_regular_db = AlreadyAppliedToRegularDB::kFalse);
 
   // Takes a Redis WriteRequestPB as input with its redis_write_batch.
   // Constructs a WriteRequestPB containing a serialized WriteBatch that will be
@@ -279,6 +306,12 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // Makes RocksDB Flush.
   CHECKED_STATUS Flush(FlushMode mode);
 
+  // Returns whether a flush of the regular or intents RocksDB is scheduled or running.
+  Result<bool> IsFlushInProgress() const;
+
+  // Returns the memory used by the memtables of the regular and intents RocksDBs.
+  int64_t MemTablesMemoryUsage() const;
+
   // Prepares the transaction context for the alter schema operation.
   // An error will be returned if the specified schema is invalid (e.g.
   // key mismatch, or missing IDs)
@@ -323,6 +356,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // May be NULL in unit tests, etc.
   TabletMetrics* metrics() { return metrics_.get(); }
 
+  // Returns the sampled load of this tablet by key hash code.
+  const HotKeySampler& hot_key_sampler() const { return hot_key_sampler_; }
+
   // Return handle to the metric entity of this tablet.
   const scoped_refptr<MetricEntity>& GetMetricEntity() const { return metric_entity_; }
 
@@ -334,9 +370,29 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // Returns true if a RocksDB-backed tablet has any SSTables.
   Result<bool> HasSSTables() const;
 
+  // Returns the hash code that splits the data of this hash partitioned tablet into two halves.
+  // Children created by the split get TabletMetadata::split_parent_tablet_id() set.
+  Result<uint16_t> GetSplitHashCode() const;
+
+  // Range of document keys served by this tablet. Only bounded for a tablet created by a split,
+  // which shares the SST files of its parent, so that keys outside of this range are ignored.
+  // Unbounded for all other tablets, so their compactions never drop keys.
+  const docdb::KeyBounds& key_bounds() const {
+    return key_bounds_;
+  }
+
   // Returns the maximum persistent op id from all SSTables in RocksDB.
   Result<yb::OpId> MaxPersistentOpId() const;
 
+  // Returns the maximum persistent op id from all SSTables in the intents RocksDB.
+  // Intents are flushed only after regular records written by the same operations, so all
+  // operations up to this op id are fully persistent. Returns MaxPersistentOpId for tablets
+  // without intents RocksDB.
+  Result<yb::OpId> MaxPersistentIntentsOpId() const;
+
+  // Returns true if the intents RocksDB has records that are not flushed to SSTables yet.
+  bool HasUnflushedIntents() const;
+
   // Returns the location of the last rocksdb checkpoint. Used for tests only.
   std::string GetLastRocksDBCheckpointDirForTest() { return last_rocksdb_checkpoint_dir_; }
 
@@ -346,6 +402,7 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
       WriteOperationState *state, HybridTime* restart_read_ht);
 
   static const char* kDMSMemTrackerId;
+  static const char* kMemTablesMemTrackerId;
 
   // Returns the timestamp corresponding to the oldest active reader. If none exists returns
   // the latest timestamp that is safe to read.
@@ -407,6 +464,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
     return rocksdb_.get();
   }
 
+  rocksdb::DB* TEST_intents_db() const {
+    return intents_db_.get();
+  }
+
   CHECKED_STATUS TEST_SwitchMemtable();
 
  protected:
@@ -421,6 +482,20 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   CHECKED_STATUS OpenKeyValueTablet();
 
+  // Opens the RocksDB that stores transaction intents. Only used by transactional tablets.
+  CHECKED_STATUS OpenIntentsDB(const rocksdb::Options& regular_options);
+
+  // Writes prepared batch to the specified RocksDB, fails the process if write is not possible.
+  void WriteToRocksDB(
+      const rocksdb::UserFrontiers* frontiers,
+      HybridTime hybrid_time,
+      rocksdb::WriteBatch* write_batch,
+      rocksdb::DB* dest_db);
+
+  // Returns filter that allows the intents RocksDB to flush a memtable only after the regular
+  // RocksDB has flushed all operations from this memtable.
+  rocksdb::MemTableFilter IntentsMemTableFlushFilter();
+
   void DocDBDebugDump(std::vector<std::string> *lines);
 
   // Register/Unregister a read operation, with an associated timestamp, for the purpose of
@@ -442,6 +517,12 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // Pause any new read/write operations and wait for all pending read/write operations to finish.
   Result<util::ScopedPendingOperationPause> PauseReadWriteOperations();
 
+  // Adds files of the checkpoint located in dir to rocksdb_files, prefix is prepended to their
+  // names.
+  CHECKED_STATUS AddCheckpointFiles(const std::string& dir,
+                                    const std::string& prefix,
+                                    google::protobuf::RepeatedPtrField<FilePB>* rocksdb_files);
+
   // Initialize RocksDB's max persistent op id and hybrid time to that of the operation state.
   // Necessary for cases like truncate or restore snapshot when RocksDB is reset.
   CHECKED_STATUS SetFlushedFrontier(const docdb::ConsensusFrontier& value);
@@ -488,11 +569,17 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   scoped_refptr<log::LogAnchorRegistry> log_anchor_registry_;
   std::shared_ptr<MemTracker> mem_tracker_;
   std::shared_ptr<MemTracker> dms_mem_tracker_;
+  std::shared_ptr<MemTracker> memtables_mem_tracker_;
+  // Whether memtable arenas consume their blocks from memtables_mem_tracker_. Only done when they
+  // allocate huge pages, which tcmalloc does not see.
+  bool memtables_mem_tracker_attached_ = false;
 
   MetricEntityPtr metric_entity_;
   gscoped_ptr<TabletMetrics> metrics_;
   FunctionGaugeDetacher metric_detacher_;
 
+  HotKeySampler hot_key_sampler_;
+
   int64_t next_mrs_id_ = 0;
 
   // A pointer to the server's clock.
@@ -537,6 +624,13 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // RocksDB database for key-value tables.
   std::unique_ptr<rocksdb::DB> rocksdb_;
 
+  // RocksDB database for provisional records (intents) of transactions. Present only for tablets
+  // that have a transaction participant. Keeping intents apart from regular records means that
+  // reads and compactions of regular records do not have to skip over short-lived intents.
+  std::unique_ptr<rocksdb::DB> intents_db_;
+
+  docdb::KeyBounds key_bounds_;
+
   std::unique_ptr<common::QLStorageIf> ql_storage_;
 
   // This is for docdb fine-grained locking.
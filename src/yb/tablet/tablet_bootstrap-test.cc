@@ -333,5 +333,39 @@ TEST_F(BootstrapTest, TestConsensusOnlyOperationOutOfOrderHybridTime) {
   ASSERT_EQ(1, results.size());
 }
 
+// Tests that consecutive writes, that are applied to RocksDB together, are all replayed, also when
+// other operations are interleaved with them.
+TEST_F(BootstrapTest, TestBatchedWrites) {
+  BuildLog();
+
+  constexpr int kNumWrites = 100;
+  OpId prev_opid = MakeOpId(0, 0);
+  for (int i = 1; i <= kNumWrites; ++i) {
+    const OpId opid = MakeOpId(1, i);
+    if (i % 30 == 0) {
+      auto noop_replicate = std::make_shared<ReplicateMsg>();
+      noop_replicate->set_op_type(consensus::NO_OP);
+      *noop_replicate->mutable_id() = opid;
+      noop_replicate->set_hybrid_time(i);
+      *noop_replicate->mutable_committed_op_id() = prev_opid;
+      AppendReplicateBatch(noop_replicate);
+    } else {
+      AppendReplicateBatch(opid, prev_opid, {TupleForAppend(i, i, "this is a test insert")});
+    }
+    prev_opid = opid;
+  }
+  AppendReplicateBatch(MakeOpId(1, kNumWrites + 1), prev_opid, {}, true /* sync */);
+
+  ConsensusBootstrapInfo boot_info;
+  shared_ptr<TabletClass> tablet;
+  ASSERT_OK(BootstrapTestTablet(-1, -1, &tablet, &boot_info));
+  ASSERT_EQ(boot_info.orphaned_replicates.size(), 1);
+  ASSERT_OPID_EQ(boot_info.last_committed_id, prev_opid);
+
+  vector<string> results;
+  IterateTabletRows(tablet.get(), &results);
+  ASSERT_EQ(kNumWrites - kNumWrites / 30, results.size());
+}
+
 } // namespace tablet
 } // namespace yb
@@ -45,6 +45,7 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/opid.h"
 #include "yb/util/logging.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/stopwatch.h"
 
 DEFINE_bool(skip_remove_old_recovery_dir, false,
@@ -55,8 +56,16 @@ DEFINE_test_flag(double, fault_crash_during_log_replay, 0.0,
                  "Fraction of the time when the tablet will crash immediately "
                  "after processing a log entry during log replay.");
 
+DEFINE_uint64(tablet_bootstrap_write_batch_size_bytes, 4_MB,
+              "Consecutive non-transactional writes replayed during tablet bootstrap are applied to "
+              "RocksDB with a single write, once their data reaches this size. 0 - apply every "
+              "write separately.");
+TAG_FLAG(tablet_bootstrap_write_batch_size_bytes, advanced);
+
 DECLARE_uint64(max_clock_sync_error_usec);
 
+using namespace yb::size_literals;
+
 namespace yb {
 namespace tablet {
 
@@ -108,7 +117,7 @@ typedef std::map<int64_t, std::unique_ptr<log::LogEntryPB>> OpIndexToEntryMap;
 
 // State kept during replay.
 struct ReplayState {
-  explicit ReplayState(const consensus::OpId& last_op_id);
+  ReplayState(const consensus::OpId& regular_op_id, const consensus::OpId& intents_op_id);
 
   // Return true if 'b' is allowed to immediately follow 'a' in the log.
   static bool IsValidSequence(const consensus::OpId& a, const consensus::OpId& b);
@@ -153,8 +162,13 @@ struct ReplayState {
   // ----------------------------------------------------------------------------------------------
   // State specific to RocksDB-backed tables
 
+  // Last operation flushed to the regular RocksDB.
   const consensus::OpId last_stored_op_id;
 
+  // Last operation flushed to the intents RocksDB. Operations up to this one are not replayed.
+  // Operations between this one and last_stored_op_id are replayed only to restore intents.
+  const consensus::OpId last_stored_intents_op_id;
+
   // Total number of log entries applied to RocksDB.
   int64_t num_entries_applied_to_rocksdb = 0;
 
@@ -165,11 +179,11 @@ struct ReplayState {
   HybridTime rocksdb_last_entry_hybrid_time = HybridTime::kMin;
 };
 
-ReplayState::ReplayState(const OpId& last_op_id)
-    : last_stored_op_id(last_op_id) {
+ReplayState::ReplayState(const OpId& regular_op_id, const OpId& intents_op_id)
+    : last_stored_op_id(regular_op_id), last_stored_intents_op_id(intents_op_id) {
   // If we know last flushed op id, then initialize committed_op_id with it.
-  if (last_op_id.term() > yb::OpId::kUnknownTerm) {
-    committed_op_id = last_op_id;
+  if (regular_op_id.term() > yb::OpId::kUnknownTerm) {
+    committed_op_id = regular_op_id;
   }
 }
 
@@ -227,11 +241,13 @@ void ReplayState::DumpReplayStateToStrings(std::vector<std::string>* strings)  c
       "Previous OpId: $0, "
       "Committed OpId: $1, "
       "Pending Replicates: $2, "
-      "Flushed: $3",
+      "Flushed: $3, "
+      "Flushed intents: $4",
       OpIdToString(prev_op_id),
       OpIdToString(committed_op_id),
       pending_replicates.size(),
-      OpIdToString(last_stored_op_id)));
+      OpIdToString(last_stored_op_id),
+      OpIdToString(last_stored_intents_op_id)));
   if (num_entries_applied_to_rocksdb > 0) {
     strings->push_back(Substitute("Log entries applied to RocksDB: $0",
                                   num_entries_applied_to_rocksdb));
@@ -256,7 +272,8 @@ TabletBootstrap::TabletBootstrap(const BootstrapTabletData& data)
       metric_registry_(data.metric_registry),
       listener_(data.listener),
       log_anchor_registry_(data.log_anchor_registry),
-      tablet_options_(data.tablet_options) {}
+      tablet_options_(data.tablet_options),
+      pending_writes_(new RegularWriteBatch) {}
 
 TabletBootstrap::~TabletBootstrap() {}
 
@@ -557,7 +574,7 @@ Status TabletBootstrap::HandleReplicateMessage(ReplayState* state,
   // Append the replicate message to the log as is
   RETURN_NOT_OK(log_->Append(replicate_entry_ptr->get()));
 
-  if (op_id.index() <= state->last_stored_op_id.index()) {
+  if (op_id.index() <= state->last_stored_intents_op_id.index()) {
     // Do not update the bootstrap in-memory state for log records that have already been applied to
     // RocksDB, or were overwritten by a later entry with a higher term that has already been
     // applied to RocksDB.
@@ -636,6 +653,11 @@ Status TabletBootstrap::HandleEntryPair(LogEntryPB* replicate_entry) {
   ReplicateMsg* replicate = replicate_entry->mutable_replicate();
   const OperationType op_type = replicate_entry->replicate().op_type();
 
+  // Other operations could read or modify the data written by the collected writes.
+  if (op_type != consensus::WRITE_OP) {
+    WritePendingWrites();
+  }
+
   {
     const auto status = HandleOperation(op_type, replicate);
     if (!status.ok()) {
@@ -676,13 +698,24 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
   auto persistent_op_id = MinimumOpId();
   Result<yb::OpId> flushed_op_id = tablet_->MaxPersistentOpId();
   RETURN_NOT_OK(flushed_op_id);
+  persistent_op_id.set_term(flushed_op_id->term);
+  persistent_op_id.set_index(flushed_op_id->index);
 
-  persistent_op_id.set_term(flushed_op_id.get_ptr()->term);
-  persistent_op_id.set_index(flushed_op_id.get_ptr()->index);
-  ReplayState state(persistent_op_id);
+  // Intents RocksDB could be ahead of the regular one only when operations after the regular
+  // frontier did not write regular records. So all operations up to the intents frontier are
+  // fully applied.
+  auto persistent_intents_op_id = MinimumOpId();
+  Result<yb::OpId> flushed_intents_op_id = tablet_->MaxPersistentIntentsOpId();
+  RETURN_NOT_OK(flushed_intents_op_id);
+  persistent_intents_op_id.set_term(flushed_intents_op_id->term);
+  persistent_intents_op_id.set_index(flushed_intents_op_id->index);
+
+  ReplayState state(persistent_op_id, persistent_intents_op_id);
+  regular_db_flushed_index_ = persistent_op_id.index();
 
   LOG_WITH_PREFIX(INFO) << "Max persistent index in RocksDB's SSTables before bootstrap: "
-                        << state.last_stored_op_id.ShortDebugString();
+                        << state.last_stored_op_id.ShortDebugString() << ", intents: "
+                        << state.last_stored_intents_op_id.ShortDebugString();
 
   log::SegmentSequence segments;
   RETURN_NOT_OK(log_reader_->GetSegmentsSnapshot(&segments));
@@ -692,10 +725,12 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
   RETURN_NOT_OK_PREPEND(OpenNewLog(), "Failed to open new log");
 
   int segment_count = 0;
-  for (const scoped_refptr<ReadableLogSegment>& segment : segments) {
-    log::LogEntries entries;
-    // TODO: Optimize this to not read the whole thing into memory?
-    Status read_status = segment->ReadEntries(&entries);
+  // The following segments are read and CRC-checked in parallel, while the entries of the current
+  // one are replayed.
+  auto replay_segment = [this, &state, &segment_count](
+      const scoped_refptr<ReadableLogSegment>& segment, log::LogEntries* entries_ptr,
+      const Status& read_status) -> Status {
+    log::LogEntries& entries = *entries_ptr;
     for (int entry_idx = 0; entry_idx < entries.size(); ++entry_idx) {
       Status s = HandleEntry(&state, &entries[entry_idx]);
       if (!s.ok()) {
@@ -730,7 +765,10 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
                                         stats_.ToString(),
                                         state.pending_replicates.size()));
     segment_count++;
-  }
+    return Status::OK();
+  };
+  RETURN_NOT_OK(log::LogReader::ReadSegmentsEntries(segments, replay_segment));
+  WritePendingWrites();
 
   LOG(INFO) << "Dumping replay state to log at the end of " << __FUNCTION__;
   DumpReplayStateToLog(state);
@@ -773,11 +811,27 @@ void TabletBootstrap::PlayWriteRequest(ReplicateMsg* replicate_msg) {
   // Use committed OpId for mem store anchoring.
   operation_state.mutable_op_id()->CopyFrom(replicate_msg->id());
 
-  tablet_->ApplyRowOperations(&operation_state);
+  const AlreadyAppliedToRegularDB already_applied_to_regular_db(
+      replicate_msg->id().index() <= regular_db_flushed_index_);
+  if (FLAGS_tablet_bootstrap_write_batch_size_bytes != 0 &&
+      tablet_->AppendRowOperations(
+          &operation_state, already_applied_to_regular_db, pending_writes_.get())) {
+    if (pending_writes_->write_batch.GetDataSize() >=
+            FLAGS_tablet_bootstrap_write_batch_size_bytes) {
+      WritePendingWrites();
+    }
+  } else {
+    WritePendingWrites();
+    tablet_->ApplyRowOperations(&operation_state, already_applied_to_regular_db);
+  }
 
   tablet_->mvcc_manager()->Replicated(operation_state.hybrid_time());
 }
 
+void TabletBootstrap::WritePendingWrites() {
+  tablet_->WriteRegularBatch(pending_writes_.get());
+}
+
 Status TabletBootstrap::PlayAlterSchemaRequest(ReplicateMsg* replicate_msg) {
   AlterSchemaRequestPB* alter_schema = replicate_msg->mutable_alter_schema_request();
 
@@ -830,6 +884,11 @@ Status TabletBootstrap::PlayNoOpRequest(ReplicateMsg* replicate_msg) {
 }
 
 Status TabletBootstrap::PlayTruncateRequest(ReplicateMsg* replicate_msg) {
+  if (replicate_msg->id().index() <= regular_db_flushed_index_) {
+    // Truncate resets flushed frontiers of both RocksDBs, so it is already reflected in them.
+    return Status::OK();
+  }
+
   TruncateRequestPB* req = replicate_msg->mutable_truncate_request();
 
   TruncateOperationState operation_state(nullptr, req);
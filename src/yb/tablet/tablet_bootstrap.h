@@ -40,6 +40,7 @@
 namespace yb {
 namespace tablet {
 
+struct RegularWriteBatch;
 struct ReplayState;
 class WriteOperationState;
 
@@ -110,6 +111,9 @@ class TabletBootstrap {
 
   void PlayWriteRequest(consensus::ReplicateMsg* replicate_msg);
 
+  // Writes the non-transactional writes collected by PlayWriteRequest to RocksDB.
+  void WritePendingWrites();
+
   CHECKED_STATUS PlayUpdateTransactionRequest(consensus::ReplicateMsg* replicate_msg);
 
   CHECKED_STATUS PlayAlterSchemaRequest(consensus::ReplicateMsg* replicate_msg);
@@ -153,6 +157,14 @@ class TabletBootstrap {
   std::unique_ptr<consensus::ConsensusMetadata> cmeta_;
   TabletOptions tablet_options_;
 
+  // Index of the last operation flushed to the regular RocksDB before bootstrap. Operations up to
+  // this index are replayed only to restore intents of transactions.
+  int64_t regular_db_flushed_index_ = 0;
+
+  // Non-transactional writes of consecutive operations that are not written to RocksDB yet. They
+  // are written together, before any other operation is played.
+  std::unique_ptr<RegularWriteBatch> pending_writes_;
+
   // Statistics on the replay of entries in the log.
   struct Stats {
     Stats()
@@ -31,6 +31,7 @@ typedef YB_EDITION_NS_PREFIX Tablet TabletClass;
 typedef YB_EDITION_NS_PREFIX TabletPeer TabletPeerClass;
 
 YB_STRONGLY_TYPED_BOOL(RequireLease);
+YB_STRONGLY_TYPED_BOOL(AlreadyAppliedToRegularDB);
 
 }  // namespace tablet
 }  // namespace yb
@@ -80,6 +80,7 @@ namespace yb {
 namespace tablet {
 
 const int64 kNoDurableMemStore = -1;
+const char* const kIntentsSubdir = "intents";
 
 // ============================================================================
 //  Tablet Metadata
@@ -204,6 +205,16 @@ Status TabletMetadata::DeleteTabletData(TabletDataState delete_type,
   docdb::InitRocksDBOptions(
       &rocksdb_options, tablet_id_, nullptr /* statistics */, tablet_options);
 
+  const auto intents_dir = intents_rocksdb_dir();
+  if (fs_manager_->env()->FileExists(intents_dir)) {
+    LOG(INFO) << "Destroying intents RocksDB at: " << intents_dir;
+    rocksdb::Status status = rocksdb::DestroyDB(intents_dir, rocksdb_options);
+    if (!status.ok()) {
+      LOG(ERROR) << "Failed to destroy intents RocksDB at: " << intents_dir << ": "
+                 << status.ToString();
+    }
+  }
+
   LOG(INFO) << "Destroying RocksDB at: " << rocksdb_dir_;
   rocksdb::Status status = rocksdb::DestroyDB(rocksdb_dir_, rocksdb_options);
 
@@ -344,6 +355,7 @@ Status TabletMetadata::LoadFromSuperBlock(const TabletSuperBlockPB& superblock)
     }
 
     tablet_data_state_ = superblock.tablet_data_state();
+    split_parent_tablet_id_ = superblock.split_parent_tablet_id();
 
     deleted_cols_.clear();
     for (const DeletedColumnPB& deleted_col : superblock.deleted_cols()) {
@@ -530,6 +542,9 @@ Status TabletMetadata::ToSuperBlockUnlocked(TabletSuperBlockPB* super_block) con
                         "Couldn't serialize schema into superblock");
 
   pb.set_tablet_data_state(tablet_data_state_);
+  if (!split_parent_tablet_id_.empty()) {
+    pb.set_split_parent_tablet_id(split_parent_tablet_id_);
+  }
   if (tombstone_last_logged_opid_) {
     tombstone_last_logged_opid_.ToPB(pb.mutable_tombstone_last_logged_opid());
   }
@@ -603,6 +618,10 @@ uint32_t TabletMetadata::schema_version() const {
   return schema_version_;
 }
 
+string TabletMetadata::intents_rocksdb_dir() const {
+  return JoinPathSegments(rocksdb_dir_, kIntentsSubdir);
+}
+
 string TabletMetadata::data_root_dir() const {
   if (rocksdb_dir_.empty()) {
     return "";
@@ -641,5 +660,15 @@ TabletDataState TabletMetadata::tablet_data_state() const {
   return tablet_data_state_;
 }
 
+void TabletMetadata::set_split_parent_tablet_id(const string& tablet_id) {
+  std::lock_guard<LockType> l(data_lock_);
+  split_parent_tablet_id_ = tablet_id;
+}
+
+string TabletMetadata::split_parent_tablet_id() const {
+  std::lock_guard<LockType> l(data_lock_);
+  return split_parent_tablet_id_;
+}
+
 } // namespace tablet
 } // namespace yb
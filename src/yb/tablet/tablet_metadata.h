@@ -63,6 +63,9 @@ namespace tablet {
 
 extern const int64 kNoDurableMemStore;
 
+// Name of the subdirectory of the tablet's RocksDB directory that holds the intents RocksDB.
+extern const char* const kIntentsSubdir;
+
 // Manages the "blocks tracking" for the specified tablet.
 //
 // TabletMetadata is owned by the Tablet. As new blocks are written to store
@@ -135,6 +138,9 @@ class TabletMetadata : public RefCountedThreadSafe<TabletMetadata> {
 
   std::string rocksdb_dir() const { return rocksdb_dir_; }
 
+  // Directory of the RocksDB instance that stores provisional records of transactions.
+  std::string intents_rocksdb_dir() const;
+
   std::string wal_dir() const { return wal_dir_; }
 
   // Given the data directory of a tablet, returns the data root dir for that tablet.
@@ -177,6 +183,11 @@ class TabletMetadata : public RefCountedThreadSafe<TabletMetadata> {
   void set_tablet_data_state(TabletDataState state);
   TabletDataState tablet_data_state() const;
 
+  // Set / get the id of the tablet this tablet was split from. Empty unless this tablet was
+  // created by a split.
+  void set_split_parent_tablet_id(const std::string& tablet_id);
+  std::string split_parent_tablet_id() const;
+
   // Increments flush pin count by one: if flush pin count > 0,
   // metadata will _not_ be flushed to disk during Flush().
   void PinFlush();
@@ -357,6 +368,9 @@ class TabletMetadata : public RefCountedThreadSafe<TabletMetadata> {
   // The current state of remote bootstrap for the tablet.
   TabletDataState tablet_data_state_;
 
+  // The tablet this tablet was split from, empty if it was not created by a split.
+  std::string split_parent_tablet_id_;
+
   // Record of the last opid logged by the tablet before it was last
   // tombstoned. Has no meaning for non-tombstoned tablets.
   yb::OpId tombstone_last_logged_opid_;
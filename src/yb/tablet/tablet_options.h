@@ -13,6 +13,11 @@
 #ifndef YB_TABLET_TABLET_OPTIONS_H
 #define YB_TABLET_TABLET_OPTIONS_H
 
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace rocksdb {
 class Cache;
 class EventListener;
@@ -24,6 +29,11 @@ namespace tablet {
 
 struct TabletOptions {
   std::shared_ptr<rocksdb::Cache> block_cache;
+  // Secondary tier of block_cache that keeps compressed blocks on disk, null when disabled.
+  std::shared_ptr<rocksdb::Cache> secondary_block_cache;
+  // Parts of the block cache reserved for single tables, keyed by table id or name. Used instead of
+  // block_cache by the tablets of these tables.
+  std::unordered_map<std::string, std::shared_ptr<rocksdb::Cache>> table_block_caches;
   std::shared_ptr<rocksdb::MemoryMonitor> memory_monitor;
   std::vector<std::shared_ptr<rocksdb::EventListener>> listeners;
 };
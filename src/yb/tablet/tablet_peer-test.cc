@@ -164,7 +164,8 @@ class TabletPeerTest : public YBTabletTest,
                                            log,
                                            metric_entity_,
                                            raft_pool_.get(),
-                                           tablet_prepare_pool_.get()));
+                                           tablet_prepare_pool_.get(),
+                                           nullptr /* multi_raft_manager */));
   }
 
   Status StartPeer(const ConsensusBootstrapInfo& info) {
@@ -158,7 +158,8 @@ Status TabletPeer::InitTabletPeer(const shared_ptr<TabletClass> &tablet,
                                   const scoped_refptr<Log> &log,
                                   const scoped_refptr<MetricEntity> &metric_entity,
                                   ThreadPool* raft_pool,
-                                  ThreadPool* tablet_prepare_pool) {
+                                  ThreadPool* tablet_prepare_pool,
+                                  consensus::MultiRaftManager* multi_raft_manager) {
 
   DCHECK(tablet) << "A TabletPeer must be provided with a Tablet";
   DCHECK(log) << "A TabletPeer must be provided with a Log";
@@ -214,7 +215,8 @@ Status TabletPeer::InitTabletPeer(const shared_ptr<TabletClass> &tablet,
         mark_dirty_clbk_,
         tablet_->table_type(),
         std::bind(&Tablet::LostLeadership, tablet.get()),
-        raft_pool);
+        raft_pool,
+        multi_raft_manager);
 
     auto ht_lease_provider = [this](MicrosTime min_allowed, MonoTime deadline) {
       auto lease = consensus_->MajorityReplicatedHtLeaseExpiration(min_allowed, deadline);
@@ -597,6 +599,14 @@ Status TabletPeer::GetEarliestNeededLogIndex(int64_t* min_index) const {
     *min_index = std::min(*min_index, max_persistent_index);
   }
 
+  // Intents that are still in memory could be restored only by replaying the log starting from
+  // the last operation flushed to the intents RocksDB.
+  if (tablet_->HasUnflushedIntents()) {
+    Result<yb::OpId> max_persistent_intents_op_id = tablet_->MaxPersistentIntentsOpId();
+    RETURN_NOT_OK(max_persistent_intents_op_id);
+    *min_index = std::min(*min_index, max_persistent_intents_op_id->index);
+  }
+
   // We keep at least one committed operation in the log so that we can always recover safe time
   // during bootstrap.
   OpId committed_op_id;
@@ -63,6 +63,7 @@ using yb::consensus::StateChangeContext;
 namespace yb {
 
 namespace consensus {
+class MultiRaftManager;
 class RaftConsensus;
 }
 
@@ -114,7 +115,8 @@ class TabletPeer : public RefCountedThreadSafe<TabletPeer>,
                                 const scoped_refptr<log::Log> &log,
                                 const scoped_refptr<MetricEntity> &metric_entity,
                                 ThreadPool* raft_pool,
-                                ThreadPool* tablet_prepare_pool);
+                                ThreadPool* tablet_prepare_pool,
+                                consensus::MultiRaftManager* multi_raft_manager);
 
   // Starts the TabletPeer, making it available for Write()s. If this
   // TabletPeer is part of a consensus configuration this will connect it to other peers
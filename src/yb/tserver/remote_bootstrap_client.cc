@@ -32,6 +32,10 @@
 
 #include "yb/tserver/remote_bootstrap_client.h"
 
+#include <algorithm>
+#include <deque>
+#include <unordered_set>
+
 #include <gflags/gflags.h>
 #include <glog/logging.h>
 
@@ -54,6 +58,7 @@
 #include "yb/tserver/remote_bootstrap.proxy.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
+#include "yb/util/countdown_latch.h"
 #include "yb/util/crc.h"
 #include "yb/util/env.h"
 #include "yb/util/env_util.h"
@@ -61,6 +66,10 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/net/net_util.h"
+#include "yb/util/size_literals.h"
+#include "yb/util/threadpool.h"
+
+using namespace yb::size_literals;
 
 DEFINE_int32(remote_bootstrap_begin_session_timeout_ms, 3000,
              "Tablet server RPC client timeout for BeginRemoteBootstrapSession calls.");
@@ -84,6 +93,30 @@ DEFINE_int32(committed_config_change_role_timeout_sec, 30,
              "timing out. ");
 TAG_FLAG(committed_config_change_role_timeout_sec, hidden);
 
+DEFINE_int32(remote_bootstrap_max_concurrent_files, 4,
+             "Maximum number of RocksDB files that a remote bootstrap client downloads at the "
+             "same time.");
+TAG_FLAG(remote_bootstrap_max_concurrent_files, advanced);
+
+DEFINE_int32(remote_bootstrap_max_chunks_in_flight, 4,
+             "Maximum number of FetchData requests that a remote bootstrap client has "
+             "outstanding for a single file.");
+TAG_FLAG(remote_bootstrap_max_chunks_in_flight, advanced);
+
+DEFINE_int32(remote_bootstrap_max_chunk_size, 8_MB,
+             "Maximum size of the data requested by a single FetchData RPC.");
+TAG_FLAG(remote_bootstrap_max_chunk_size, advanced);
+
+DEFINE_int32(remote_bootstrap_max_chunk_retries, 5,
+             "How many times in a row a chunk that failed with a transient error, such as a "
+             "timeout, is requested again before the remote bootstrap fails.");
+TAG_FLAG(remote_bootstrap_max_chunk_retries, advanced);
+
+DEFINE_int32(remote_bootstrap_max_session_restarts, 3,
+             "How many times a remote bootstrap begins a new session with the same remote peer "
+             "after its session was lost, e.g. because it expired on the remote.");
+TAG_FLAG(remote_bootstrap_max_session_restarts, advanced);
+
 DECLARE_int32(rpc_max_message_size);
 
 DEFINE_test_flag(double, fault_crash_bootstrap_client_before_changing_role, 0.0,
@@ -117,6 +150,59 @@ using tablet::TabletMetadata;
 using tablet::TabletStatusListener;
 using tablet::TabletSuperBlockPB;
 
+namespace {
+
+// SST files never change once written, unlike e.g. the MANIFEST.
+bool IsImmutableRocksDBFile(const string& name) {
+  return HasSuffixString(name, ".sst") || HasSuffixString(name, ".sst.sblock.0");
+}
+
+// FetchData request that is sent asynchronously.
+struct FetchDataCall {
+  FetchDataRequestPB req;
+  FetchDataResponsePB resp;
+  rpc::RpcController controller;
+  CountDownLatch latch{1};
+};
+
+typedef std::shared_ptr<FetchDataCall> FetchDataCallPtr;
+
+// Outstanding chunk requests for a single file, in the order of their offsets.
+class FetchDataPipeline {
+ public:
+  ~FetchDataPipeline() {
+    Clear();
+  }
+
+  size_t size() const { return calls_.size(); }
+
+  FetchDataCallPtr Add() {
+    calls_.push_back(std::make_shared<FetchDataCall>());
+    return calls_.back();
+  }
+
+  // Removes the first request and waits for its response.
+  FetchDataCallPtr Pop() {
+    auto call = std::move(calls_.front());
+    calls_.pop_front();
+    call->latch.Wait();
+    return call;
+  }
+
+  // Drops all the requests once they are responded.
+  void Clear() {
+    for (const auto& call : calls_) {
+      call->latch.Wait();
+    }
+    calls_.clear();
+  }
+
+ private:
+  std::deque<FetchDataCallPtr> calls_;
+};
+
+} // namespace
+
 RemoteBootstrapClient::RemoteBootstrapClient(std::string tablet_id,
                                              FsManager* fs_manager,
                                              shared_ptr<Messenger> messenger,
@@ -203,47 +289,9 @@ Status RemoteBootstrapClient::Start(const string& bootstrap_peer_uuid,
 
   // Set up an RPC proxy for the RemoteBootstrapService.
   proxy_.reset(new RemoteBootstrapServiceProxy(messenger_, addr));
+  bootstrap_peer_uuid_ = bootstrap_peer_uuid;
 
-  BeginRemoteBootstrapSessionRequestPB req;
-  req.set_requestor_uuid(permanent_uuid_);
-  req.set_tablet_id(tablet_id_);
-
-  rpc::RpcController controller;
-  controller.set_timeout(MonoDelta::FromMilliseconds(
-      FLAGS_remote_bootstrap_begin_session_timeout_ms));
-
-  // Begin the remote bootstrap session with the remote peer.
-  BeginRemoteBootstrapSessionResponsePB resp;
-  RETURN_NOT_OK_UNWIND_PREPEND(proxy_->BeginRemoteBootstrapSession(req, &resp, &controller),
-                               controller,
-                               "Unable to begin remote bootstrap session");
-
-  if (resp.superblock().tablet_data_state() != tablet::TABLET_DATA_READY) {
-    Status s = STATUS(IllegalState, "Remote peer (" + bootstrap_peer_uuid + ")" +
-                                    " is currently remotely bootstrapping itself!",
-                                    resp.superblock().ShortDebugString());
-    LOG_WITH_PREFIX(WARNING) << s.ToString();
-    return s;
-  }
-
-  LOG(INFO) << "Received superblock: " << resp.superblock().ShortDebugString();
-  LOG(INFO) << "RocksDB files: " << yb::ToString(resp.superblock().rocksdb_files());
-  LOG(INFO) << "Snapshot files: " << yb::ToString(resp.superblock().snapshot_files());
-
-  session_id_ = resp.session_id();
-  LOG(INFO) << "Began remote bootstrap session " << session_id_;
-
-  session_idle_timeout_millis_ = resp.session_idle_timeout_millis();
-  superblock_.reset(resp.release_superblock());
-
-  // Clear fields rocksdb_dir and wal_dir so we get an error if we try to use them without setting
-  // them to the right path.
-  superblock_->clear_rocksdb_dir();
-  superblock_->clear_wal_dir();
-
-  superblock_->set_tablet_data_state(tablet::TABLET_DATA_COPYING);
-  wal_seqnos_.assign(resp.wal_segment_seqnos().begin(), resp.wal_segment_seqnos().end());
-  remote_committed_cstate_.reset(resp.release_initial_committed_cstate());
+  RETURN_NOT_OK(BeginRemoteSession());
 
   Schema schema;
   RETURN_NOT_OK_PREPEND(SchemaFromPB(superblock_->schema(), &schema),
@@ -266,7 +314,7 @@ Status RemoteBootstrapClient::Start(const string& bootstrap_peer_uuid,
                       tablet_id_,
                       remote_committed_cstate_->current_term(),
                       last_logged_term,
-                      bootstrap_peer_uuid));
+                      bootstrap_peer_uuid_));
     }
     // Replace rocksdb_dir in the received superblock with our rocksdb_dir.
     superblock_->set_rocksdb_dir(meta_->rocksdb_dir());
@@ -344,8 +392,73 @@ Status RemoteBootstrapClient::FetchAll(TabletStatusListener* status_listener) {
   status_listener_ = CHECK_NOTNULL(status_listener);
 
   VLOG(2) << "Fetching table_type: " << TableType_Name(meta_->table_type());
-  RETURN_NOT_OK(DownloadRocksDBFiles());
-  RETURN_NOT_OK(DownloadWALs());
+  for (int restarts = 0;; ++restarts) {
+    Status s = DownloadRocksDBFiles();
+    if (s.ok()) {
+      s = DownloadWALs();
+    }
+    if (s.ok() || !session_lost_ || restarts >= FLAGS_remote_bootstrap_max_session_restarts) {
+      return s;
+    }
+    LOG_WITH_PREFIX(WARNING) << "Lost remote bootstrap session " << session_id_ << ": " << s;
+    RETURN_NOT_OK(RestartRemoteSession());
+  }
+}
+
+Status RemoteBootstrapClient::RestartRemoteSession() {
+  UpdateStatusMessage("Restarting remote bootstrap session");
+  RETURN_NOT_OK_PREPEND(BeginRemoteSession(), "Unable to restart remote bootstrap session");
+  session_lost_ = false;
+
+  superblock_->set_rocksdb_dir(meta_->rocksdb_dir());
+  superblock_->set_wal_dir(meta_->wal_dir());
+  downloaded_rocksdb_files_ = false;
+  downloaded_wal_ = false;
+  return Status::OK();
+}
+
+Status RemoteBootstrapClient::BeginRemoteSession() {
+  BeginRemoteBootstrapSessionRequestPB req;
+  req.set_requestor_uuid(permanent_uuid_);
+  req.set_tablet_id(tablet_id_);
+
+  rpc::RpcController controller;
+  controller.set_timeout(MonoDelta::FromMilliseconds(
+      FLAGS_remote_bootstrap_begin_session_timeout_ms));
+
+  // Begin the remote bootstrap session with the remote peer.
+  BeginRemoteBootstrapSessionResponsePB resp;
+  RETURN_NOT_OK_UNWIND_PREPEND(proxy_->BeginRemoteBootstrapSession(req, &resp, &controller),
+                               controller,
+                               "Unable to begin remote bootstrap session");
+
+  if (resp.superblock().tablet_data_state() != tablet::TABLET_DATA_READY) {
+    Status s = STATUS(IllegalState, "Remote peer (" + bootstrap_peer_uuid_ + ")" +
+                                    " is currently remotely bootstrapping itself!",
+                                    resp.superblock().ShortDebugString());
+    LOG_WITH_PREFIX(WARNING) << s.ToString();
+    return s;
+  }
+
+  LOG(INFO) << "Received superblock: " << resp.superblock().ShortDebugString();
+  LOG(INFO) << "RocksDB files: " << yb::ToString(resp.superblock().rocksdb_files());
+  LOG(INFO) << "Snapshot files: " << yb::ToString(resp.superblock().snapshot_files());
+
+  session_id_ = resp.session_id();
+  LOG(INFO) << "Began remote bootstrap session " << session_id_;
+
+  session_idle_timeout_millis_ = resp.session_idle_timeout_millis();
+  superblock_.reset(resp.release_superblock());
+
+  // Clear fields rocksdb_dir and wal_dir so we get an error if we try to use them without setting
+  // them to the right path.
+  superblock_->clear_rocksdb_dir();
+  superblock_->clear_wal_dir();
+
+  superblock_->set_tablet_data_state(tablet::TABLET_DATA_COPYING);
+  wal_seqnos_.assign(resp.wal_segment_seqnos().begin(), resp.wal_segment_seqnos().end());
+  remote_committed_cstate_.reset(resp.release_initial_committed_cstate());
+
   return Status::OK();
 }
 
@@ -523,22 +636,26 @@ Status RemoteBootstrapClient::DownloadWALs() {
   return Status::OK();
 }
 
-Status RemoteBootstrapClient::DownloadFile(
-    const tablet::FilePB& file_pb, const std::string& dir, DataIdPB *data_id) {
+Status RemoteBootstrapClient::DownloadFile(const tablet::FilePB& file_pb, const string& dir) {
   auto file_path = JoinPathSegments(dir, file_pb.name());
-  if (file_pb.inode() != 0) {
-    auto it = inode2file_.find(file_pb.inode());
-    if (it != inode2file_.end()) {
-      VLOG(2) << "File with the same inode already found: " << file_path
-              << " => " << it->second;
-      auto link_status = fs_manager_->env()->LinkFile(it->second, file_path);
-      if (link_status.ok()) {
-        return Status::OK();
+  {
+    std::lock_guard<std::mutex> lock(files_mutex_);
+    if (file_pb.inode() != 0) {
+      auto it = inode2file_.find(file_pb.inode());
+      if (it != inode2file_.end()) {
+        VLOG(2) << "File with the same inode already found: " << file_path
+                << " => " << it->second;
+        auto link_status = fs_manager_->env()->LinkFile(it->second, file_path);
+        if (link_status.ok()) {
+          created_files_[file_path] = file_pb.size_bytes();
+          return Status::OK();
+        }
+        // TODO fallback to copy.
+        LOG(ERROR) << "Failed to link file: " << file_path << " => " << it->second
+                   << ": " << link_status;
       }
-      // TODO fallback to copy.
-      LOG(ERROR) << "Failed to link file: " << file_path << " => " << it->second
-                 << ": " << link_status;
     }
+    created_files_[file_path] = -1;
   }
 
   WritableFileOptions opts;
@@ -546,12 +663,17 @@ Status RemoteBootstrapClient::DownloadFile(
   gscoped_ptr<WritableFile> file;
   RETURN_NOT_OK(fs_manager_->env()->NewWritableFile(opts, file_path, &file));
 
-  data_id->set_file_name(file_pb.name());
-  RETURN_NOT_OK_PREPEND(DownloadFile(*data_id, file.get()),
+  DataIdPB data_id;
+  data_id.set_type(DataIdPB::ROCKSDB_FILE);
+  data_id.set_file_name(file_pb.name());
+  RETURN_NOT_OK_PREPEND(DownloadFile(data_id, file.get()),
                         Format("Unable to download $0 file $1",
-                               DataIdPB::IdType_Name(data_id->type()), file_path));
+                               DataIdPB::IdType_Name(data_id.type()), file_path));
+  RETURN_NOT_OK_PREPEND(file->Close(), Format("Unable to close file $0", file_path));
   VLOG(2) << "Downloaded file " << file_path;
 
+  std::lock_guard<std::mutex> lock(files_mutex_);
+  created_files_[file_path] = file_pb.size_bytes();
   if (file_pb.inode() != 0) {
     inode2file_.emplace(file_pb.inode(), file_path);
   }
@@ -575,10 +697,79 @@ Status RemoteBootstrapClient::DownloadRocksDBFiles() {
                         Substitute("Failed to create RocksDB tablet directory $0",
                                    rocksdb_dir));
 
-  DataIdPB data_id;
-  data_id.set_type(DataIdPB::ROCKSDB_FILE);
-  for (auto const& file_pb : new_sb->rocksdb_files()) {
-    RETURN_NOT_OK(DownloadFile(file_pb, rocksdb_dir, &data_id));
+  // Intents RocksDB files are listed relative to the tablet directory, e.g. "intents/000010.sst".
+  const auto intents_dir = meta_->intents_rocksdb_dir();
+  RETURN_NOT_OK_PREPEND(meta_->fs_manager()->CreateDirIfMissing(intents_dir),
+                        Substitute("Failed to create RocksDB intents directory $0",
+                                   intents_dir));
+
+  // Only the first file with a given inode is downloaded, the others are linked to it afterwards.
+  vector<const tablet::FilePB*> files_to_download;
+  vector<const tablet::FilePB*> files_to_link;
+  {
+    std::lock_guard<std::mutex> lock(files_mutex_);
+    // A restarted session keeps the SST files that the previous sessions downloaded completely.
+    // Other files, e.g. the MANIFEST, could have changed on the remote.
+    std::unordered_map<string, int64_t> kept_files;
+    std::unordered_set<uint64_t> inodes;
+    for (const auto& file_pb : new_sb->rocksdb_files()) {
+      auto file_path = JoinPathSegments(rocksdb_dir, file_pb.name());
+      auto it = created_files_.find(file_path);
+      if (it != created_files_.end() && IsImmutableRocksDBFile(file_pb.name()) &&
+          it->second == static_cast<int64_t>(file_pb.size_bytes())) {
+        kept_files.insert(*it);
+        continue;
+      }
+      if (file_pb.inode() != 0 && !inodes.insert(file_pb.inode()).second) {
+        files_to_link.push_back(&file_pb);
+      } else {
+        files_to_download.push_back(&file_pb);
+      }
+    }
+    for (const auto& entry : created_files_) {
+      if (!kept_files.count(entry.first) && fs_manager_->env()->FileExists(entry.first)) {
+        RETURN_NOT_OK(fs_manager_->env()->DeleteFile(entry.first));
+      }
+    }
+    if (!kept_files.empty()) {
+      LOG_WITH_PREFIX(INFO) << "Reusing " << kept_files.size() << " downloaded RocksDB files";
+    }
+    created_files_.swap(kept_files);
+    inode2file_.clear();
+  }
+
+  UpdateStatusMessage(Substitute("Downloading $0 RocksDB files",
+                                 files_to_download.size() + files_to_link.size()));
+  {
+    std::mutex status_mutex;
+    Status status;
+    std::unique_ptr<ThreadPool> pool;
+    RETURN_NOT_OK(ThreadPoolBuilder("rb-download")
+                  .set_max_threads(std::max(FLAGS_remote_bootstrap_max_concurrent_files, 1))
+                  .Build(&pool));
+    for (const auto* file_pb : files_to_download) {
+      RETURN_NOT_OK(pool->SubmitFunc([this, file_pb, &rocksdb_dir, &status_mutex, &status] {
+        {
+          std::lock_guard<std::mutex> lock(status_mutex);
+          if (!status.ok()) {
+            return;
+          }
+        }
+        auto s = DownloadFile(*file_pb, rocksdb_dir);
+        if (!s.ok()) {
+          std::lock_guard<std::mutex> lock(status_mutex);
+          if (status.ok()) {
+            status = s;
+          }
+        }
+      }));
+    }
+    pool->Wait();
+    RETURN_NOT_OK(status);
+  }
+
+  for (const auto* file_pb : files_to_link) {
+    RETURN_NOT_OK(DownloadFile(*file_pb, rocksdb_dir));
   }
   new_superblock_.swap(new_sb);
   downloaded_rocksdb_files_ = true;
@@ -652,39 +843,93 @@ Status RemoteBootstrapClient::DownloadBlock(const BlockId& old_block_id,
 template<class Appendable>
 Status RemoteBootstrapClient::DownloadFile(const DataIdPB& data_id,
                                            Appendable* appendable) {
+  // Leave 1K for message headers.
+  int64_t max_length = std::min<int64_t>(FLAGS_remote_bootstrap_max_chunk_size,
+                                         FLAGS_rpc_max_message_size - 1024);
+  const size_t max_chunks_in_flight = std::max(FLAGS_remote_bootstrap_max_chunks_in_flight, 1);
+
+  // All the data before 'offset' was verified and appended.
   uint64_t offset = 0;
-  int32_t max_length = FLAGS_rpc_max_message_size - 1024; // Leave 1K for message headers.
+  // Offset of the next chunk to request.
+  uint64_t next_offset = 0;
+  // Not known before the first chunk arrives, so only one chunk is requested until then.
+  int64_t total_data_length = -1;
+  int retries = 0;
+  FetchDataPipeline pipeline;
+
+  for (;;) {
+    while (pipeline.size() < (total_data_length < 0 ? 1 : max_chunks_in_flight) &&
+           (total_data_length < 0 || next_offset < static_cast<uint64_t>(total_data_length))) {
+      auto call = pipeline.Add();
+      call->req.set_session_id(session_id_);
+      call->req.mutable_data_id()->CopyFrom(data_id);
+      call->req.set_offset(next_offset);
+      call->req.set_max_length(max_length);
+      call->controller.set_timeout(MonoDelta::FromMilliseconds(session_idle_timeout_millis_));
+      proxy_->FetchDataAsync(call->req, &call->resp, &call->controller,
+                             [call] { call->latch.CountDown(); });
+      next_offset += max_length;
+    }
 
-  rpc::RpcController controller;
-  controller.set_timeout(MonoDelta::FromMilliseconds(session_idle_timeout_millis_));
-  FetchDataRequestPB req;
+    auto call = pipeline.Pop();
+    if (call->req.offset() != offset) {
+      // The remote returned a shorter chunk than asked for, so the chunks requested after it do not
+      // line up with the appended data.
+      pipeline.Clear();
+      next_offset = offset;
+      continue;
+    }
 
-  bool done = false;
-  while (!done) {
-    controller.Reset();
-    req.set_session_id(session_id_);
-    req.mutable_data_id()->CopyFrom(data_id);
-    req.set_offset(offset);
-    req.set_max_length(max_length);
-
-    FetchDataResponsePB resp;
-    RETURN_NOT_OK_UNWIND_PREPEND(proxy_->FetchData(req, &resp, &controller),
-                                controller,
-                                "Unable to fetch data from remote");
-    // Sanity-check for corruption.
-    RETURN_NOT_OK_PREPEND(VerifyData(offset, resp.chunk()),
-                          Substitute("Error validating data item $0", data_id.ShortDebugString()));
+    Status s = call->controller.status();
+    if (s.ok()) {
+      // Sanity-check for corruption.
+      s = VerifyData(offset, call->resp.chunk());
+    }
+    if (!s.ok()) {
+      pipeline.Clear();
+      if (retries >= FLAGS_remote_bootstrap_max_chunk_retries ||
+          !ShouldRetryFetchData(s, call->controller)) {
+        return UnwindRemoteError(s, call->controller).CloneAndPrepend(
+            Substitute("Unable to fetch data item $0 at offset $1",
+                       data_id.ShortDebugString(), offset));
+      }
+      ++retries;
+      LOG_WITH_PREFIX(WARNING) << "Retrying fetch of " << data_id.ShortDebugString()
+                               << " at offset " << offset << " (attempt " << retries << "): " << s;
+      SleepFor(MonoDelta::FromMilliseconds(100 << std::min(retries, 6)));
+      next_offset = offset;
+      continue;
+    }
+    retries = 0;
 
+    const auto& chunk = call->resp.chunk();
     // Write the data.
-    RETURN_NOT_OK(appendable->Append(resp.chunk().data()));
-
-    if (offset + resp.chunk().data().size() == resp.chunk().total_data_length()) {
-      done = true;
+    RETURN_NOT_OK(appendable->Append(chunk.data()));
+    offset += chunk.data().size();
+    total_data_length = chunk.total_data_length();
+    if (offset == static_cast<uint64_t>(total_data_length)) {
+      return Status::OK();
+    }
+    if (static_cast<int64_t>(chunk.data().size()) < max_length) {
+      max_length = chunk.data().size();
     }
-    offset += resp.chunk().data().size();
   }
+}
 
-  return Status::OK();
+bool RemoteBootstrapClient::ShouldRetryFetchData(const Status& status,
+                                                 const rpc::RpcController& controller) {
+  if (status.IsRemoteError()) {
+    const auto* remote_error = controller.error_response();
+    if (remote_error != nullptr &&
+        remote_error->HasExtension(RemoteBootstrapErrorPB::remote_bootstrap_error_ext) &&
+        remote_error->GetExtension(RemoteBootstrapErrorPB::remote_bootstrap_error_ext).code() ==
+            RemoteBootstrapErrorPB::NO_SESSION) {
+      session_lost_ = true;
+    }
+    return false;
+  }
+  return status.IsTimedOut() || status.IsNetworkError() || status.IsServiceUnavailable() ||
+         status.IsCorruption();
 }
 
 Status RemoteBootstrapClient::VerifyData(uint64_t offset, const DataChunkPB& chunk) {
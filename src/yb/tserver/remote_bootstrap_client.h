@@ -32,8 +32,10 @@
 #ifndef YB_TSERVER_REMOTE_BOOTSTRAP_CLIENT_H
 #define YB_TSERVER_REMOTE_BOOTSTRAP_CLIENT_H
 
+#include <atomic>
 #include <string>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <unordered_map>
 
@@ -77,8 +79,13 @@ class TSTabletManager;
 // Client class for using remote bootstrap to copy a tablet from another host.
 // This class is not thread-safe.
 //
+// RocksDB files are downloaded concurrently, each of them with several pipelined FetchData
+// requests. A chunk that failed with a transient error is requested again, and the download
+// continues from the last verified chunk. If the session is lost on the remote, a new session is
+// started and the immutable files that were already downloaded are kept.
+//
 // TODO:
-// * Parallelize download of blocks and WAL segments.
+// * Download WAL segments concurrently, the way RocksDB files are.
 //
 class RemoteBootstrapClient {
  public:
@@ -134,6 +141,8 @@ class RemoteBootstrapClient {
  protected:
   FRIEND_TEST(RemoteBootstrapRocksDBClientTest, TestBeginEndSession);
   FRIEND_TEST(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles);
+  FRIEND_TEST(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFilesInSmallChunks);
+  FRIEND_TEST(RemoteBootstrapRocksDBClientTest, TestRestartLostSession);
 
   // Extract the embedded Status message from the given ErrorStatusPB.
   // The given ErrorStatusPB must extend RemoteBootstrapErrorPB.
@@ -149,6 +158,15 @@ class RemoteBootstrapClient {
   // End the remote bootstrap session.
   CHECKED_STATUS EndRemoteSession();
 
+  // Begin a new session with the same remote peer after the previous one was lost, e.g. because
+  // it expired on the remote. Takes the file lists, the superblock and the committed consensus
+  // state from the new session.
+  CHECKED_STATUS RestartRemoteSession();
+
+  // Send BeginRemoteBootstrapSession to the remote peer and set session_id_, superblock_,
+  // wal_seqnos_ and remote_committed_cstate_ from its response.
+  CHECKED_STATUS BeginRemoteSession();
+
   // Download all WAL files sequentially.
   CHECKED_STATUS DownloadWALs();
 
@@ -170,6 +188,10 @@ class RemoteBootstrapClient {
   // Download a single remote file. The block and WAL implementations delegate
   // to this method when downloading files.
   //
+  // Up to remote_bootstrap_max_chunks_in_flight chunks are requested at a time, and they are
+  // appended in order once verified. A chunk that failed with a transient error is requested
+  // again from the last appended offset.
+  //
   // An Appendable is typically a WritableBlock (block) or WritableFile (WAL).
   //
   // Only used in one compilation unit, otherwise the implementation would
@@ -177,12 +199,19 @@ class RemoteBootstrapClient {
   template<class Appendable>
   CHECKED_STATUS DownloadFile(const DataIdPB& data_id, Appendable* appendable);
 
+  // Download the RocksDB files of the superblock, up to remote_bootstrap_max_concurrent_files of
+  // them at a time.
   CHECKED_STATUS DownloadRocksDBFiles();
 
   CHECKED_STATUS VerifyData(uint64_t offset, const DataChunkPB& resp);
 
-  CHECKED_STATUS DownloadFile(
-      const tablet::FilePB& file_pb, const std::string& dir, DataIdPB* data_id);
+  // Download a single RocksDB file to 'dir', or hard link it to an already downloaded file with
+  // the same inode on the remote. Thread-safe.
+  CHECKED_STATUS DownloadFile(const tablet::FilePB& file_pb, const std::string& dir);
+
+  // Whether the chunk request that failed with 'status' should be sent again. Sets session_lost_
+  // if the remote does not know the session.
+  bool ShouldRetryFetchData(const Status& status, const rpc::RpcController& controller);
 
   // Return standard log prefix.
   std::string LogPrefix();
@@ -201,6 +230,7 @@ class RemoteBootstrapClient {
 
   // Session-specific data items.
   bool replace_tombstoned_tablet_;
+  std::string bootstrap_peer_uuid_;
 
   // Local tablet metadata file.
   scoped_refptr<tablet::TabletMetadata> meta_;
@@ -225,7 +255,15 @@ class RemoteBootstrapClient {
   bool succeeded_;
 
  private:
+  // Set when the remote no longer knows session_id_, so the download is retried in a new session.
+  std::atomic<bool> session_lost_{false};
+
+  // Protects the members below, which are updated by concurrent file downloads.
+  std::mutex files_mutex_;
   std::unordered_map<uint64_t, std::string> inode2file_;
+  // Sizes of the RocksDB files created by this client, by path. Files that were not downloaded
+  // completely have size -1.
+  std::unordered_map<std::string, int64_t> created_files_;
 
   DISALLOW_COPY_AND_ASSIGN(RemoteBootstrapClient);
 };
@@ -15,6 +15,9 @@
 
 #include "yb/tserver/remote_bootstrap_client-test.h"
 
+DECLARE_int32(remote_bootstrap_max_chunk_size);
+DECLARE_int32(remote_bootstrap_max_chunks_in_flight);
+DECLARE_int32(remote_bootstrap_max_concurrent_files);
 
 using std::shared_ptr;
 
@@ -33,6 +36,38 @@ class RemoteBootstrapRocksDBClientTest : public RemoteBootstrapClientTest {
   void SetUp() override {
     RemoteBootstrapClientTest::SetUp();
   }
+
+  // Verify that the client has the same files that the leader has.
+  void CompareDirectories(const std::string& local_dir, const std::string& tablet_peer_dir) {
+    vector<std::string> rocksdb_files;
+    ASSERT_OK(fs_manager_->ListDir(local_dir, &rocksdb_files));
+
+    vector<std::string> tablet_peer_checkpoint_files;
+    ASSERT_OK(tablet_peer_->tablet_metadata()->fs_manager()->ListDir(
+        tablet_peer_dir, &tablet_peer_checkpoint_files));
+
+    ASSERT_EQ(rocksdb_files.size(), tablet_peer_checkpoint_files.size());
+    std::sort(rocksdb_files.begin(), rocksdb_files.end());
+    std::sort(tablet_peer_checkpoint_files.begin(), tablet_peer_checkpoint_files.end());
+    for (int i = 0; i < rocksdb_files.size(); ++i) {
+      auto local_rocksdb_file = rocksdb_files[i];
+      auto tablet_peer_rocksdb_file = tablet_peer_checkpoint_files[i];
+      ASSERT_EQ(local_rocksdb_file, tablet_peer_rocksdb_file);
+
+      if (local_rocksdb_file == "." || local_rocksdb_file == ".." ||
+          local_rocksdb_file == tablet::kIntentsSubdir) {
+        continue;
+      }
+
+      auto local_rocksdb_file_path = JoinPathSegments(local_dir, local_rocksdb_file);
+      auto tablet_peer_rocksdb_file_path = JoinPathSegments(tablet_peer_dir,
+                                                            tablet_peer_rocksdb_file);
+
+      LOG(INFO) << "Comparing file " << local_rocksdb_file_path
+                << " and file " << tablet_peer_rocksdb_file_path;
+      ASSERT_OK(CompareFileContents(local_rocksdb_file_path, tablet_peer_rocksdb_file_path));
+    }
+  }
 };
 
 // Basic begin / end remote bootstrap session.
@@ -48,34 +83,36 @@ TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
   ASSERT_OK(client_->DownloadRocksDBFiles());
   auto tablet_peer_checkpoint_dir = tablet_peer_->tablet()->GetLastRocksDBCheckpointDirForTest();
 
-  vector<std::string> rocksdb_files;
-  ASSERT_OK(fs_manager_->ListDir(meta_->rocksdb_dir(), &rocksdb_files));
-
-  vector<std::string> tablet_peer_checkpoint_files;
-  ASSERT_OK(tablet_peer_->tablet_metadata()->fs_manager()->ListDir(tablet_peer_checkpoint_dir,
-                                                                   &tablet_peer_checkpoint_files));
+  ASSERT_NO_FATALS(CompareDirectories(meta_->rocksdb_dir(), tablet_peer_checkpoint_dir));
+  ASSERT_NO_FATALS(CompareDirectories(
+      JoinPathSegments(meta_->rocksdb_dir(), tablet::kIntentsSubdir),
+      JoinPathSegments(tablet_peer_checkpoint_dir, tablet::kIntentsSubdir)));
+}
 
-  ASSERT_EQ(rocksdb_files.size(), tablet_peer_checkpoint_files.size());
-  std::sort(rocksdb_files.begin(), rocksdb_files.end());
-  std::sort(tablet_peer_checkpoint_files.begin(), tablet_peer_checkpoint_files.end());
-  // Verify that the client has the same files that the leader has.
-  for (int i = 0; i < rocksdb_files.size(); ++i) {
-    auto local_rocksdb_file = rocksdb_files[i];
-    auto tablet_peer_rocksdb_file = tablet_peer_checkpoint_files[i];
-    ASSERT_EQ(local_rocksdb_file, tablet_peer_rocksdb_file);
+// Download the RocksDB files in many small chunks, several of them at a time.
+TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFilesInSmallChunks) {
+  FLAGS_remote_bootstrap_max_chunk_size = 100;
+  FLAGS_remote_bootstrap_max_chunks_in_flight = 3;
+  FLAGS_remote_bootstrap_max_concurrent_files = 2;
+  ASSERT_OK(client_->DownloadRocksDBFiles());
+  auto tablet_peer_checkpoint_dir = tablet_peer_->tablet()->GetLastRocksDBCheckpointDirForTest();
 
-    if (local_rocksdb_file == "." || local_rocksdb_file == "..") {
-      continue;
-    }
+  ASSERT_NO_FATALS(CompareDirectories(meta_->rocksdb_dir(), tablet_peer_checkpoint_dir));
+  ASSERT_NO_FATALS(CompareDirectories(
+      JoinPathSegments(meta_->rocksdb_dir(), tablet::kIntentsSubdir),
+      JoinPathSegments(tablet_peer_checkpoint_dir, tablet::kIntentsSubdir)));
+}
 
-    auto local_rocksdb_file_path = JoinPathSegments(meta_->rocksdb_dir(), local_rocksdb_file);
-    auto tablet_peer_rocksdb_file_path = JoinPathSegments(tablet_peer_checkpoint_dir,
-                                                          tablet_peer_rocksdb_file);
+// The client begins a new session when the remote no longer knows its session.
+TEST_F(RemoteBootstrapRocksDBClientTest, TestRestartLostSession) {
+  ASSERT_OK(client_->DownloadRocksDBFiles());
+  auto old_session_id = client_->session_id_;
+  ASSERT_OK(client_->EndRemoteSession());
 
-    LOG(INFO) << "Comparing file " << local_rocksdb_file_path
-              << " and file " << tablet_peer_rocksdb_file_path;
-    ASSERT_OK(CompareFileContents(local_rocksdb_file_path, tablet_peer_rocksdb_file_path));
-  }
+  TabletStatusListener listener(meta_);
+  ASSERT_OK(client_->FetchAll(&listener));
+  ASSERT_NE(old_session_id, client_->session_id_);
+  ASSERT_OK(client_->Finish());
 }
 
 } // namespace tserver
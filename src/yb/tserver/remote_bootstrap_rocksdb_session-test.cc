@@ -60,9 +60,13 @@ TEST_F(RemoteBootstrapRocksDBTest, CheckSuperBlockHasRocksDBFields) {
   const auto& checkpoint_dir = session_->checkpoint_dir_;
   vector<string> checkpoint_files;
   ASSERT_OK(env_->GetChildren(checkpoint_dir, &checkpoint_files));
+  vector<string> intents_checkpoint_files;
+  ASSERT_OK(env_->GetChildren(JoinPathSegments(checkpoint_dir, tablet::kIntentsSubdir),
+                              &intents_checkpoint_files));
 
-  // Ignore "." and ".." entries in session_->checkpoint_dir_.
-  ASSERT_EQ(superblock.rocksdb_files().size(), checkpoint_files.size() - 2);
+  // Ignore "." and ".." entries in both directories, and intents subdirectory itself.
+  ASSERT_EQ(superblock.rocksdb_files().size(),
+            checkpoint_files.size() - 3 + intents_checkpoint_files.size() - 2);
   for (int i = 0; i < superblock.rocksdb_files().size(); ++i) {
     const auto& rocksdb_file_name = superblock.rocksdb_files(i).name();
     auto rocksdb_file_size_bytes = superblock.rocksdb_files(i).size_bytes();
@@ -45,6 +45,8 @@
 #include "yb/fs/fs_manager.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/gutil/map-util.h"
+#include "yb/rocksdb/rate_limiter.h"
+#include "yb/rpc/inbound_call.h"
 #include "yb/rpc/rpc_context.h"
 #include "yb/tserver/tablet_peer_lookup.h"
 #include "yb/tablet/tablet_peer.h"
@@ -101,6 +103,12 @@ DEFINE_test_flag(double, fault_crash_leader_after_changing_role, 0.0,
 DEFINE_uint64(remote_bootstrap_change_role_timeout_ms, 15000,
               "Timeout for change role operation during remote bootstrap.");
 
+DEFINE_int64(remote_bootstrap_rate_limit_bytes_per_sec, 0,
+             "Maximum transmission rate of the data sent by all the remote bootstrap sessions of "
+             "this server together. 0 means no limit. Throttling blocks the RPC worker serving the "
+             "data request.");
+TAG_FLAG(remote_bootstrap_rate_limit_bytes_per_sec, advanced);
+
 namespace yb {
 namespace tserver {
 
@@ -130,11 +138,24 @@ RemoteBootstrapServiceImpl::RemoteBootstrapServiceImpl(
       fs_manager_(CHECK_NOTNULL(fs_manager)),
       tablet_peer_lookup_(CHECK_NOTNULL(tablet_peer_lookup)),
       shutdown_latch_(1) {
+  if (FLAGS_remote_bootstrap_rate_limit_bytes_per_sec > 0) {
+    rate_limiter_.reset(
+        rocksdb::NewGenericRateLimiter(FLAGS_remote_bootstrap_rate_limit_bytes_per_sec));
+  }
   CHECK_OK(Thread::Create("remote-bootstrap", "rb-session-exp",
                           &RemoteBootstrapServiceImpl::EndExpiredSessions, this,
                           &session_expiration_thread_));
 }
 
+RemoteBootstrapServiceImpl::~RemoteBootstrapServiceImpl() {
+}
+
+rpc::ThreadPoolTaskPriority RemoteBootstrapServiceImpl::CallPriority(
+    const rpc::InboundCall& call) const {
+  // FetchData transfers large chunks of data and could wait for the rate limiter.
+  return rpc::ThreadPoolTaskPriority::kLow;
+}
+
 void RemoteBootstrapServiceImpl::BeginRemoteBootstrapSession(
         const BeginRemoteBootstrapSessionRequestPB* req,
         BeginRemoteBootstrapSessionResponsePB* resp,
@@ -295,6 +316,15 @@ void RemoteBootstrapServiceImpl::FetchData(const FetchDataRequestPB* req,
   data_chunk->set_total_data_length(total_data_length);
   data_chunk->set_offset(offset);
 
+  if (rate_limiter_) {
+    // A single request cannot be larger than the burst of the rate limiter.
+    for (int64_t left = data->size(); left > 0;) {
+      auto bytes = std::min(left, rate_limiter_->GetSingleBurstBytes());
+      rate_limiter_->Request(bytes, rocksdb::Env::IO_HIGH);
+      left -= bytes;
+    }
+  }
+
   // Calculate checksum.
   uint32_t crc32 = Crc32c(data->data(), data->length());
   data_chunk->set_crc32(crc32);
@@ -32,6 +32,7 @@
 #ifndef YB_TSERVER_REMOTE_BOOTSTRAP_SERVICE_H_
 #define YB_TSERVER_REMOTE_BOOTSTRAP_SERVICE_H_
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -46,6 +47,10 @@
 #include "yb/util/status.h"
 #include "yb/util/thread.h"
 
+namespace rocksdb {
+class RateLimiter;
+} // namespace rocksdb
+
 namespace yb {
 class FsManager;
 
@@ -63,6 +68,8 @@ class RemoteBootstrapServiceImpl : public RemoteBootstrapServiceIf {
                              TabletPeerLookupIf* tablet_peer_lookup,
                              const scoped_refptr<MetricEntity>& metric_entity);
 
+  ~RemoteBootstrapServiceImpl();
+
   virtual void BeginRemoteBootstrapSession(const BeginRemoteBootstrapSessionRequestPB* req,
                                            BeginRemoteBootstrapSessionResponsePB* resp,
                                            rpc::RpcContext context) override;
@@ -81,6 +88,8 @@ class RemoteBootstrapServiceImpl : public RemoteBootstrapServiceIf {
 
   virtual void Shutdown() override;
 
+  rpc::ThreadPoolTaskPriority CallPriority(const rpc::InboundCall& call) const override;
+
  protected:
   typedef YB_EDITION_NS_PREFIX RemoteBootstrapSession RemoteBootstrapSessionClass;
 
@@ -127,6 +136,9 @@ class RemoteBootstrapServiceImpl : public RemoteBootstrapServiceIf {
   SessionMap sessions_;
   MonoTimeMap session_expirations_;
 
+  // Limits the rate of the data sent by all the sessions together, null if unlimited.
+  std::unique_ptr<rocksdb::RateLimiter> rate_limiter_;
+
   // Session expiration thread.
   // TODO: this is a hack, replace with some kind of timer impl. See KUDU-286.
   CountDownLatch shutdown_latch_;
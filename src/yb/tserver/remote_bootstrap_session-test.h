@@ -158,7 +158,8 @@ class RemoteBootstrapTest : public YBTabletTest {
                                           log,
                                           metric_entity,
                                           raft_pool_.get(),
-                                          tablet_prepare_pool_.get()));
+                                          tablet_prepare_pool_.get(),
+                                          nullptr /* multi_raft_manager */));
     consensus::ConsensusBootstrapInfo boot_info;
     CHECK_OK(tablet_peer_->Start(boot_info));
 
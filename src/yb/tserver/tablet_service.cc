@@ -52,6 +52,7 @@
 #include "yb/gutil/stl_util.h"
 #include "yb/gutil/stringprintf.h"
 #include "yb/gutil/strings/escaping.h"
+#include "yb/rpc/inbound_call.h"
 #include "yb/server/hybrid_clock.h"
 #include "yb/tablet/tablet_bootstrap_if.h"
 #include "yb/tserver/remote_bootstrap_service.h"
@@ -113,6 +114,13 @@ DEFINE_int32(max_wait_for_safe_time_ms, 5000,
              "Maximum time in milliseconds to wait for the safe time to advance when trying to "
              "scan at the given hybrid_time.");
 
+DEFINE_int32(max_wait_for_follower_safe_time_ms, 500,
+             "Maximum time in milliseconds a follower waits for its safe time to advance when "
+             "serving a read with bounded staleness. After that the read is rejected, so the "
+             "client can retry it on another replica.");
+TAG_FLAG(max_wait_for_follower_safe_time_ms, advanced);
+TAG_FLAG(max_wait_for_follower_safe_time_ms, runtime);
+
 DEFINE_bool(tserver_noop_read_write, false, "Respond NOOP to read/write.");
 TAG_FLAG(tserver_noop_read_write, unsafe);
 TAG_FLAG(tserver_noop_read_write, hidden);
@@ -136,6 +144,8 @@ using consensus::GetNodeInstanceResponsePB;
 using consensus::LeaderStepDownRequestPB;
 using consensus::LeaderStepDownResponsePB;
 using consensus::LeaderLeaseStatus;
+using consensus::MultiRaftConsensusRequestPB;
+using consensus::MultiRaftConsensusResponsePB;
 using consensus::RunLeaderElectionRequestPB;
 using consensus::RunLeaderElectionResponsePB;
 using consensus::StartRemoteBootstrapRequestPB;
@@ -187,6 +197,27 @@ Status GetTabletRef(const scoped_refptr<TabletPeer>& tablet_peer,
   return Status::OK();
 }
 
+// Returns the hybrid time to serve a read with bounded staleness at. It is at most
+// max_staleness_ms behind the current time of this server.
+Result<HybridTime> BoundedStalenessSafeTime(const tablet::AbstractTablet& tablet,
+                                            const ReadRequestPB& req,
+                                            server::Clock* clock,
+                                            MonoTime client_deadline) {
+  const MicrosTime now = clock->Now().GetPhysicalValueMicros();
+  const MicrosTime max_staleness = req.max_staleness_ms() * 1000;
+  const HybridTime min_allowed = now > max_staleness ? HybridTime::FromMicros(now - max_staleness)
+                                                     : HybridTime::kMin;
+  const MonoTime deadline = MonoTime::Earliest(
+      client_deadline,
+      MonoTime::Now() + MonoDelta::FromMilliseconds(FLAGS_max_wait_for_follower_safe_time_ms));
+  const HybridTime result = tablet.SafeTime(tablet::RequireLease::kFalse, min_allowed, deadline);
+  if (!result.is_valid()) {
+    return STATUS_FORMAT(TryAgain, "Safe time of replica lags behind $0 by more than $1 ms",
+                         min_allowed, req.max_staleness_ms());
+  }
+  return result;
+}
+
 } // namespace
 
 // Prepares modification operation, checks limits, fetches tablet_peer and tablet etc.
@@ -810,7 +841,21 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
   tablet::RequireLease require_lease(req->consistency_level() == YBConsistencyLevel::STRONG);
   bool transactional = tablet->SchemaRef().table_properties().is_transactional();
   if (!read_time) {
-    safe_ht_to_read = tablet->SafeTime(require_lease);
+    if (!require_lease && req->has_max_staleness_ms()) {
+      // Clock should be at least the latest hybrid time seen by the client, so that the client
+      // reads its own writes when max_staleness_ms is 0.
+      server::UpdateClock(*req, server_->Clock());
+      auto safe_time = BoundedStalenessSafeTime(
+          *tablet, *req, server_->Clock(), context.GetClientDeadline());
+      if (!safe_time.ok()) {
+        SetupErrorAndRespond(resp->mutable_error(), safe_time.status(),
+                             TabletServerErrorPB::REPLICA_SAFE_TIME_LAGGING, &context);
+        return;
+      }
+      safe_ht_to_read = *safe_time;
+    } else {
+      safe_ht_to_read = tablet->SafeTime(require_lease);
+    }
     // If the read time is not specified, then it is non transactional read.
     // So we should restart it in server in case of failure.
     read_time.read = safe_ht_to_read;
@@ -941,6 +986,16 @@ ConsensusServiceImpl::ConsensusServiceImpl(const scoped_refptr<MetricEntity>& me
 ConsensusServiceImpl::~ConsensusServiceImpl() {
 }
 
+rpc::ThreadPoolTaskPriority ConsensusServiceImpl::CallPriority(
+    const rpc::InboundCall& call) const {
+  // Raft requests should not wait behind user requests, otherwise leader leases could expire under
+  // heavy load. Remote bootstrap is only started here but waits for the whole download.
+  if (call.method_name() == "StartRemoteBootstrap") {
+    return rpc::ThreadPoolTaskPriority::kNormal;
+  }
+  return rpc::ThreadPoolTaskPriority::kHigh;
+}
+
 void ConsensusServiceImpl::UpdateConsensus(const ConsensusRequestPB* req,
                                            ConsensusResponsePB* resp,
                                            rpc::RpcContext context) {
@@ -975,6 +1030,73 @@ void ConsensusServiceImpl::UpdateConsensus(const ConsensusRequestPB* req,
   context.RespondSuccess();
 }
 
+namespace {
+
+// Same as UpdateConsensus, but reports the error through the return value and 'error_code' instead
+// of responding to the RPC, so that it can be used for a single entry of a batch.
+Status UpdateConsensusForBatchEntry(TabletPeerLookupIf* tablet_manager,
+                                    ConsensusRequestPB* req,
+                                    ConsensusResponsePB* resp,
+                                    TabletServerErrorPB::Code* error_code) {
+  const string& local_uuid = tablet_manager->NodeInstance().permanent_uuid();
+  if (PREDICT_FALSE(req->dest_uuid() != local_uuid)) {
+    *error_code = TabletServerErrorPB::WRONG_SERVER_UUID;
+    return STATUS_SUBSTITUTE(InvalidArgument,
+        "MultiRaftUpdateConsensus: Wrong destination UUID requested. Local UUID: $0. "
+        "Requested UUID: $1", local_uuid, req->dest_uuid());
+  }
+
+  scoped_refptr<TabletPeer> tablet_peer;
+  Status s = tablet_manager->GetTabletPeer(req->tablet_id(), &tablet_peer);
+  if (PREDICT_FALSE(!s.ok())) {
+    *error_code = s.IsServiceUnavailable() ? TabletServerErrorPB::UNKNOWN_ERROR
+                                           : TabletServerErrorPB::TABLET_NOT_FOUND;
+    return s;
+  }
+
+  tablet::TabletStatePB state = tablet_peer->state();
+  if (PREDICT_FALSE(state != tablet::RUNNING)) {
+    *error_code = TabletServerErrorPB::TABLET_NOT_RUNNING;
+    s = STATUS(IllegalState, "Tablet not RUNNING", tablet::TabletStatePB_Name(state));
+    if (state == tablet::FAILED) {
+      s = s.CloneAndAppend(tablet_peer->error().ToString());
+    }
+    return s;
+  }
+
+  scoped_refptr<Consensus> consensus = tablet_peer->shared_consensus();
+  if (PREDICT_FALSE(!consensus)) {
+    *error_code = TabletServerErrorPB::TABLET_NOT_RUNNING;
+    return STATUS(ServiceUnavailable, "Consensus unavailable. Tablet not running");
+  }
+
+  *error_code = TabletServerErrorPB::UNKNOWN_ERROR;
+  return consensus->Update(req, resp);
+}
+
+} // namespace
+
+void ConsensusServiceImpl::MultiRaftUpdateConsensus(const MultiRaftConsensusRequestPB* req,
+                                                    MultiRaftConsensusResponsePB* resp,
+                                                    rpc::RpcContext context) {
+  DVLOG(3) << "Received Batched Consensus Update RPC: " << req->ShortDebugString();
+  // See UpdateConsensus for why const_cast is needed here.
+  auto* mutable_req = const_cast<MultiRaftConsensusRequestPB*>(req);
+  for (auto& consensus_req : *mutable_req->mutable_consensus_request()) {
+    auto* consensus_resp = resp->add_consensus_response();
+    TabletServerErrorPB::Code error_code;
+    Status s = UpdateConsensusForBatchEntry(
+        tablet_manager_, &consensus_req, consensus_resp, &error_code);
+    if (PREDICT_FALSE(!s.ok())) {
+      // Errors are reported per tablet, so that one of them does not fail the whole batch.
+      consensus_resp->Clear();
+      StatusToPB(s, consensus_resp->mutable_error()->mutable_status());
+      consensus_resp->mutable_error()->set_code(error_code);
+    }
+  }
+  context.RespondSuccess();
+}
+
 void ConsensusServiceImpl::RequestConsensusVote(const VoteRequestPB* req,
                                                 VoteResponsePB* resp,
                                                 rpc::RpcContext context) {
@@ -1253,6 +1375,39 @@ void TabletServiceImpl::ListTabletsForTabletServer(const ListTabletsForTabletSer
   context.RespondSuccess();
 }
 
+void TabletServiceImpl::GetTabletHotKeys(const GetTabletHotKeysRequestPB* req,
+                                         GetTabletHotKeysResponsePB* resp,
+                                         rpc::RpcContext context) {
+  std::vector<scoped_refptr<TabletPeer>> peers;
+  if (req->tablet_ids().empty()) {
+    server_->tablet_manager()->GetTabletPeers(&peers);
+  } else {
+    for (const auto& tablet_id : req->tablet_ids()) {
+      scoped_refptr<TabletPeer> peer;
+      if (!LookupTabletPeerOrRespond(server_->tablet_manager(), tablet_id, resp, &context, &peer)) {
+        return;
+      }
+      peers.push_back(std::move(peer));
+    }
+  }
+
+  for (const auto& peer : peers) {
+    auto tablet = peer->shared_tablet();
+    if (!tablet) {
+      continue;
+    }
+    auto* entry = resp->add_entries();
+    entry->set_tablet_id(peer->tablet_id());
+    entry->set_table_id(tablet->metadata()->table_id());
+    entry->set_table_name(tablet->metadata()->table_name());
+    scoped_refptr<consensus::Consensus> consensus = peer->shared_consensus();
+    entry->set_is_leader(consensus && consensus->role() == consensus::RaftPeerPB::LEADER);
+    tablet->hot_key_sampler().ToPB(entry->mutable_hot_keys());
+  }
+
+  context.RespondSuccess();
+}
+
 namespace {
 
 Result<uint64_t> CalcChecksum(tablet::Tablet* tablet) {
@@ -1317,6 +1472,14 @@ void TabletServiceImpl::ImportData(const ImportDataRequestPB* req,
 void TabletServiceImpl::Shutdown() {
 }
 
+rpc::ThreadPoolTaskPriority TabletServiceImpl::CallPriority(const rpc::InboundCall& call) const {
+  // These calls process a whole tablet or a large batch of rows.
+  if (call.method_name() == "ImportData" || call.method_name() == "Checksum") {
+    return rpc::ThreadPoolTaskPriority::kLow;
+  }
+  return rpc::ThreadPoolTaskPriority::kNormal;
+}
+
 scoped_refptr<Histogram> TabletServer::GetMetricsHistogram(
     TabletServerServiceIf::RpcMetricIndexes metric) {
   // Returns the metric Histogram by holding a lock to make sure tablet_server_service_ remains
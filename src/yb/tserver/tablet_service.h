@@ -104,8 +104,14 @@ class TabletServiceImpl : public TabletServerServiceIf {
                 TruncateResponsePB* resp,
                 rpc::RpcContext context) override;
 
+  void GetTabletHotKeys(const GetTabletHotKeysRequestPB* req,
+                        GetTabletHotKeysResponsePB* resp,
+                        rpc::RpcContext context) override;
+
   void Shutdown() override;
 
+  rpc::ThreadPoolTaskPriority CallPriority(const rpc::InboundCall& call) const override;
+
  private:
   // Check if the tablet peer is the leader and is in ready state for servicing IOs.
   CHECKED_STATUS CheckPeerIsLeaderAndReady(const tablet::TabletPeer& tablet_peer,
@@ -181,6 +187,10 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                                consensus::ConsensusResponsePB *resp,
                                rpc::RpcContext context) override;
 
+  virtual void MultiRaftUpdateConsensus(const consensus::MultiRaftConsensusRequestPB *req,
+                                        consensus::MultiRaftConsensusResponsePB *resp,
+                                        rpc::RpcContext context) override;
+
   virtual void RequestConsensusVote(const consensus::VoteRequestPB* req,
                                     consensus::VoteResponsePB* resp,
                                     rpc::RpcContext context) override;
@@ -217,6 +227,8 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                                     consensus::StartRemoteBootstrapResponsePB* resp,
                                     rpc::RpcContext context) override;
 
+  rpc::ThreadPoolTaskPriority CallPriority(const rpc::InboundCall& call) const override;
+
  private:
   TabletPeerLookupIf* tablet_manager_;
 };
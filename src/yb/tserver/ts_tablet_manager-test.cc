@@ -43,12 +43,16 @@
 #include "yb/consensus/consensus.pb.h"
 #include "yb/fs/fs_manager.h"
 #include "yb/master/master.pb.h"
+#include "yb/rocksdb/db.h"
+#include "yb/rocksdb/table.h"
+#include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/tablet-test-util.h"
 #include "yb/tserver/mini_tablet_server.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/util/test_util.h"
 #include "yb/util/format.h"
+#include "yb/util/jsonwriter.h"
 
 #define ASSERT_REPORT_HAS_UPDATED_TABLET(report, tablet_id) \
   ASSERT_NO_FATALS(AssertReportHasUpdatedTablet(report, tablet_id))
@@ -57,6 +61,10 @@
   ASSERT_NO_FATALS(AssertMonotonicReportSeqno(report_seqno, tablet_report))
 
 DECLARE_bool(pretend_memory_exceeded_enforce_flush);
+DECLARE_int32(max_concurrent_memstore_flushes_per_disk);
+DECLARE_double(memstore_flush_wal_retention_weight);
+DECLARE_int32(memstore_flush_age_scale_secs);
+DECLARE_string(db_block_cache_table_reservations);
 
 namespace yb {
 namespace tserver {
@@ -193,6 +201,113 @@ TEST_F(TsTabletManagerTest, TestProperBackgroundFlushOnStartup) {
   }
 }
 
+static TabletFlushCandidate MakeFlushCandidate(const std::string& disk, int64_t memstore_size,
+                                               int64_t wal_size, int64_t age_secs,
+                                               bool flush_in_progress = false) {
+  TabletFlushCandidate result;
+  result.data_root_dir = disk;
+  result.memstore_size = memstore_size;
+  result.wal_size = wal_size;
+  result.oldest_write_age_us = age_secs * 1000000;
+  result.flush_in_progress = flush_in_progress;
+  return result;
+}
+
+TEST(TsTabletManagerFlushTest, TestSelectTabletsToFlush) {
+  FlagSaver flag_saver;
+  FLAGS_max_concurrent_memstore_flushes_per_disk = 0;
+  FLAGS_memstore_flush_wal_retention_weight = 0.25;
+  FLAGS_memstore_flush_age_scale_secs = 300;
+
+  constexpr int64_t kMB = 1 << 20;
+  std::vector<TabletFlushCandidate> candidates = {
+      MakeFlushCandidate("/disk1", 10 * kMB, 0, 0),        // Priority 10.
+      MakeFlushCandidate("/disk1", 4 * kMB, 40 * kMB, 0),  // Priority 4 + 40 / 4 = 14.
+      MakeFlushCandidate("/disk2", 6 * kMB, 0, 600),       // Priority 6 * (1 + 600 / 300) = 18.
+      MakeFlushCandidate("/disk2", 1 * kMB, 0, 0),         // Priority 1.
+  };
+  ASSERT_EQ(std::vector<size_t>({2, 1, 0, 3}), SelectTabletsToFlush(candidates, 100 * kMB));
+
+  // Stops once enough memory would be freed.
+  ASSERT_EQ(std::vector<size_t>({2, 1, 0}), SelectTabletsToFlush(candidates, 15 * kMB));
+  ASSERT_EQ(std::vector<size_t>({2}), SelectTabletsToFlush(candidates, 6 * kMB));
+
+  // Memstores that are already flushing count towards the memory to free.
+  candidates.push_back(MakeFlushCandidate("/disk1", 5 * kMB, 0, 0, true /* flush_in_progress */));
+  ASSERT_EQ(std::vector<size_t>({2}), SelectTabletsToFlush(candidates, 11 * kMB));
+  ASSERT_TRUE(SelectTabletsToFlush(candidates, 5 * kMB).empty());
+
+  // The flush in progress on disk1 uses up its limit.
+  FLAGS_max_concurrent_memstore_flushes_per_disk = 1;
+  ASSERT_EQ(std::vector<size_t>({2}), SelectTabletsToFlush(candidates, 100 * kMB));
+  FLAGS_max_concurrent_memstore_flushes_per_disk = 2;
+  ASSERT_EQ(std::vector<size_t>({2, 1, 3}), SelectTabletsToFlush(candidates, 100 * kMB));
+}
+
+TEST(TsTabletManagerBlockCacheTest, TestParseBlockCacheReservations) {
+  constexpr int64_t kMB = 1 << 20;
+  auto reservations = ParseBlockCacheReservations("", 10 * kMB);
+  ASSERT_OK(reservations);
+  ASSERT_TRUE(reservations->empty());
+
+  reservations = ParseBlockCacheReservations("table1:1048576, table2:2097152", 10 * kMB);
+  ASSERT_OK(reservations);
+  ASSERT_EQ(BlockCacheReservations({{"table1", 1 * kMB}, {"table2", 2 * kMB}}), *reservations);
+
+  for (const auto& value : {"table1", "table1:", ":1048576", "table1:1MB", "table1:1:2",
+                            "table1:0", "table1:-1048576", "table1:1048576,table2"}) {
+    auto status = ParseBlockCacheReservations(value, 10 * kMB).status();
+    ASSERT_TRUE(status.IsInvalidArgument()) << value << ": " << status;
+  }
+
+  // Reservations must leave some of the block cache to the other tables.
+  ASSERT_OK(ParseBlockCacheReservations("table1:6291456,table2:4194303", 10 * kMB));
+  auto status = ParseBlockCacheReservations("table1:6291456,table2:4194304", 10 * kMB).status();
+  ASSERT_TRUE(status.IsInvalidArgument()) << status;
+  status = ParseBlockCacheReservations("table1:20971520", 10 * kMB).status();
+  ASSERT_TRUE(status.IsInvalidArgument()) << status;
+}
+
+TEST_F(TsTabletManagerTest, TestBlockCacheReservation) {
+  FlagSaver flag_saver;
+  const std::string kReservedTabletId = "reserved-tablet";
+  constexpr int64_t kReservedBytes = 1 << 20;
+  // CreateNewTablet uses the tablet id as the table id and name.
+  FLAGS_db_block_cache_table_reservations = Format("$0:$1", kReservedTabletId, kReservedBytes);
+
+  mini_server_->Shutdown();
+  CreateMiniTabletServer();
+  ASSERT_OK(mini_server_->Start());
+  mini_server_->FailHeartbeats();
+  config_ = mini_server_->CreateLocalConfig();
+  tablet_manager_ = mini_server_->server()->tablet_manager();
+  fs_manager_ = mini_server_->server()->fs_manager();
+
+  scoped_refptr<TabletPeer> reserved_peer;
+  ASSERT_OK(CreateNewTablet(kReservedTabletId, schema_, &reserved_peer));
+  scoped_refptr<TabletPeer> shared_peer;
+  ASSERT_OK(CreateNewTablet(kTabletId, schema_, &shared_peer));
+
+  auto get_block_cache = [](const scoped_refptr<TabletPeer>& peer) {
+    const auto& options = peer->tablet()->TEST_db()->GetOptions();
+    return static_cast<rocksdb::BlockBasedTableOptions*>(
+        options.table_factory->GetOptions())->block_cache;
+  };
+  auto reserved_cache = get_block_cache(reserved_peer);
+  ASSERT_NE(nullptr, reserved_cache);
+  ASSERT_EQ(kReservedBytes, reserved_cache->GetCapacity());
+  auto shared_cache = get_block_cache(shared_peer);
+  ASSERT_NE(nullptr, shared_cache);
+  ASSERT_NE(reserved_cache, shared_cache);
+
+  // The reserved block cache reports its metrics as a separate entity.
+  std::stringstream out;
+  JsonWriter writer(&out, JsonWriter::COMPACT);
+  ASSERT_OK(mini_server_->server()->metric_registry()->WriteAsJson(
+      &writer, { "block_cache." + kReservedTabletId }, MetricJsonOptions()));
+  ASSERT_STR_CONTAINS(out.str(), "block_cache_lookups");
+}
+
 static void AssertMonotonicReportSeqno(int64_t* report_seqno,
                                        const TabletReportPB &report) {
   ASSERT_LT(*report_seqno, report.sequence_number());
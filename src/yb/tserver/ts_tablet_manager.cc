@@ -49,11 +49,14 @@
 #include "yb/consensus/log.h"
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/metadata.pb.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/quorum_util.h"
 
 #include "yb/fs/fs_manager.h"
 
+#include "yb/gutil/strings/numbers.h"
+#include "yb/gutil/strings/split.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/gutil/strings/util.h"
 
@@ -61,6 +64,7 @@
 #include "yb/master/sys_catalog.h"
 
 #include "yb/rocksdb/memory_monitor.h"
+#include "yb/rocksdb/table/file_block_cache.h"
 
 #include "yb/rpc/messenger.h"
 
@@ -85,11 +89,13 @@
 #include "yb/util/mem_tracker.h"
 #include "yb/util/metrics.h"
 #include "yb/util/pb_util.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/stopwatch.h"
 #include "yb/util/trace.h"
 #include "yb/util/tsan_util.h"
 
 using namespace std::literals; // NOLINT
+using namespace yb::size_literals;
 
 DEFINE_int32(num_tablets_to_open_simultaneously, 0,
              "Number of threads available to open tablets during startup. If this "
@@ -134,7 +140,31 @@ constexpr int kDbCacheSizeCacheDisabled = -2;
 DEFINE_int32(flush_background_task_interval_msec, 0,
              "The tick interval time for the flush background task. "
              "This defaults to 0, which means disable the background task "
-             "And only use callbacks on memstore allocations. ");
+             "And only use callbacks on memstore allocations, so "
+             "memstore_flush_memory_usage_percentage is only checked then.");
+
+DEFINE_int32(memstore_flush_memory_usage_percentage, 80,
+             "Percentage of the memory limit of the root memory tracker. When the tserver uses "
+             "more memory than that, memstores are flushed until the excess is freed, at most all of "
+             "the memstore memory. Should be "
+             "below memory_limit_soft_percentage, at which writes start being rejected. 0 to only "
+             "flush on the global memstore limit.");
+TAG_FLAG(memstore_flush_memory_usage_percentage, advanced);
+
+DEFINE_int32(max_concurrent_memstore_flushes_per_disk, 2,
+             "The flush background task does not flush the memstore of a tablet if this many "
+             "tablets on the same data disk are already flushing. 0 means no limit.");
+TAG_FLAG(max_concurrent_memstore_flushes_per_disk, advanced);
+
+DEFINE_double(memstore_flush_wal_retention_weight, 0.25,
+              "When choosing the tablets to flush, each byte of WAL retained by a tablet counts "
+              "as this many bytes of its memstore.");
+TAG_FLAG(memstore_flush_wal_retention_weight, advanced);
+
+DEFINE_int32(memstore_flush_age_scale_secs, 300,
+             "When choosing the tablets to flush, the memstore of a tablet whose oldest unflushed "
+             "write is this old counts twice as much as a memstore with a new oldest write.");
+TAG_FLAG(memstore_flush_age_scale_secs, advanced);
 
 DEFINE_int64(global_memstore_size_percentage, 10,
              "Percentage of total available memory to use for the global memstore. "
@@ -155,6 +185,23 @@ DEFINE_int32(db_block_cache_size_percentage, 50,
              "Default percentage of total available memory to use as block cache size, if not "
              "asking for a raw number, through FLAGS_db_block_cache_size_bytes.");
 
+DEFINE_string(db_block_cache_table_reservations, "",
+              "Comma separated list of <table id or name>:<bytes> pairs. Each listed table gets a "
+              "part of the block cache of the given size for itself, so that the reads of other "
+              "tables cannot evict its blocks. The reserved bytes are taken from the shared block "
+              "cache.");
+TAG_FLAG(db_block_cache_table_reservations, advanced);
+
+DEFINE_string(db_secondary_block_cache_dir, "",
+              "Directory of the files of the secondary block cache tier, which keeps compressed "
+              "data blocks evicted from the block cache. Should be on a local SSD, or on a DAX "
+              "mounted NVM device. Empty disables the secondary tier.");
+TAG_FLAG(db_secondary_block_cache_dir, advanced);
+
+DEFINE_int64(db_secondary_block_cache_size_bytes, 16_GB,
+             "Size of the files of the secondary block cache tier.");
+TAG_FLAG(db_secondary_block_cache_size_bytes, advanced);
+
 DEFINE_test_flag(int32, sleep_after_tombstoning_tablet_secs, 0,
                  "Whether we sleep in LogAndTombstone after calling DeleteTabletData.");
 
@@ -214,39 +261,144 @@ using tablet::TabletPeerClass;
 using tablet::TabletStatusListener;
 using tablet::TabletStatusPB;
 
+Result<BlockCacheReservations> ParseBlockCacheReservations(
+    const std::string& value, int64_t block_cache_size) {
+  BlockCacheReservations result;
+  int64_t total_bytes = 0;
+  for (const std::string& entry : strings::Split(value, ",", strings::SkipWhitespace())) {
+    std::vector<std::string> parts = strings::Split(entry, ":");
+    int64 bytes = 0;
+    if (parts.size() != 2 || parts[0].empty() || !safe_strto64(parts[1], &bytes) || bytes <= 0) {
+      return STATUS_FORMAT(InvalidArgument, "Invalid block cache reservation: $0", entry);
+    }
+    total_bytes += bytes;
+    result.emplace_back(parts[0], bytes);
+  }
+  if (!result.empty() && total_bytes >= block_cache_size) {
+    return STATUS_FORMAT(InvalidArgument,
+                         "Block cache reservations of $0 bytes leave nothing of the $1 bytes block "
+                         "cache: $2", total_bytes, block_cache_size, value);
+  }
+  return result;
+}
+
+std::vector<size_t> SelectTabletsToFlush(
+    const std::vector<TabletFlushCandidate>& candidates, int64_t memory_to_free) {
+  std::unordered_map<std::string, int> flushes_per_disk;
+  std::vector<std::pair<double, size_t>> ranked;
+  ranked.reserve(candidates.size());
+  for (size_t i = 0; i != candidates.size(); ++i) {
+    const auto& candidate = candidates[i];
+    if (candidate.flush_in_progress) {
+      ++flushes_per_disk[candidate.data_root_dir];
+      memory_to_free -= candidate.memstore_size;
+      continue;
+    }
+    // Prefer large memstores, with old writes, that keep a lot of WAL from being GCed.
+    const double age_factor = FLAGS_memstore_flush_age_scale_secs > 0
+        ? 1.0 + candidate.oldest_write_age_us / (FLAGS_memstore_flush_age_scale_secs * 1e6)
+        : 1.0;
+    const double priority =
+        (candidate.memstore_size + FLAGS_memstore_flush_wal_retention_weight * candidate.wal_size) *
+        age_factor;
+    ranked.emplace_back(priority, i);
+  }
+
+  std::stable_sort(ranked.begin(), ranked.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.first > rhs.first;
+  });
+  std::vector<size_t> result;
+  for (const auto& entry : ranked) {
+    if (memory_to_free <= 0) {
+      break;
+    }
+    const auto& candidate = candidates[entry.second];
+    auto& disk_flushes = flushes_per_disk[candidate.data_root_dir];
+    if (FLAGS_max_concurrent_memstore_flushes_per_disk > 0 &&
+        disk_flushes >= FLAGS_max_concurrent_memstore_flushes_per_disk) {
+      continue;
+    }
+    ++disk_flushes;
+    memory_to_free -= std::max<int64_t>(candidate.memstore_size, 1);
+    result.push_back(entry.second);
+  }
+  return result;
+}
+
 // Only called from the background task to ensure it's synchronized
 void TSTabletManager::MaybeFlushTablet() {
-  int iteration = 0;
-  while (memory_monitor()->Exceeded() ||
-         (iteration++ == 0 && FLAGS_pretend_memory_exceeded_enforce_flush)) {
-    scoped_refptr<TabletPeer> tablet_to_flush = TabletToFlush();
-    // TODO(bojanserafimov): If tablet_to_flush flushes now because of other reasons,
+  int64_t memory_to_free = MemoryToFreeByFlushes();
+  if (memory_to_free <= 0) {
+    return;
+  }
+
+  std::vector<scoped_refptr<TabletPeer>> peers;
+  std::vector<TabletFlushCandidate> candidates;
+  CollectFlushCandidates(&peers, &candidates);
+  for (size_t index : SelectTabletsToFlush(candidates, memory_to_free)) {
+    const auto& peer = peers[index];
+    const auto tablet = peer->shared_tablet();
+    if (!tablet) {
+      continue;
+    }
+    // TODO(bojanserafimov): If the tablet flushes now because of other reasons,
     // we will schedule a second flush, which will unnecessarily stall writes for a short time. This
     // will not happen often, but should be fixed.
-    if (tablet_to_flush) {
-      WARN_NOT_OK(tablet_to_flush->tablet()->Flush(tablet::FlushMode::kAsync),
-          Substitute("Flush failed on $0", tablet_to_flush->tablet_id()));
-    }
+    WARN_NOT_OK(tablet->Flush(tablet::FlushMode::kAsync),
+                Substitute("Flush failed on $0", peer->tablet_id()));
   }
 }
 
-// Return the tablet with the oldest write in memstore, or nullptr if all
-// tablet memstores are empty or about to flush.
-scoped_refptr<TabletPeer> TSTabletManager::TabletToFlush() {
+int64_t TSTabletManager::MemoryToFreeByFlushes() {
+  int64_t result = FLAGS_pretend_memory_exceeded_enforce_flush ? 1 : 0;
+  auto* monitor = memory_monitor();
+  if (monitor->Exceeded()) {
+    result = std::max<int64_t>(result, monitor->memory_usage() - monitor->limit() + 1);
+  }
+  const auto root_tracker = MemTracker::GetRootTracker();
+  if (FLAGS_memstore_flush_memory_usage_percentage > 0 && root_tracker->has_limit()) {
+    const int64_t usage_limit =
+        root_tracker->limit() * FLAGS_memstore_flush_memory_usage_percentage / 100;
+    // Other consumers, like the block cache, can keep the root tracker over the limit. Flushes
+    // cannot free more than the memstores hold.
+    result = std::max(result, std::min<int64_t>(root_tracker->consumption() - usage_limit,
+                                                monitor->memory_usage()));
+  }
+  return result;
+}
+
+void TSTabletManager::CollectFlushCandidates(
+    std::vector<scoped_refptr<TabletPeer>>* peers,
+    std::vector<TabletFlushCandidate>* candidates) {
   boost::shared_lock<rw_spinlock> lock(lock_); // For using the tablet map
-  HybridTime oldest_write_in_memstores = HybridTime::kMax;
-  scoped_refptr<TabletPeer> tablet_to_flush;
   for (const TabletMap::value_type& entry : tablet_map_) {
     const auto tablet = entry.second->shared_tablet();
-    if (tablet) {
-      const HybridTime oldest_write_in_memstore = tablet->flush_stats()->oldest_write_in_memstore();
-      if (oldest_write_in_memstore < oldest_write_in_memstores) {
-        oldest_write_in_memstores = oldest_write_in_memstore;
-        tablet_to_flush = entry.second;
+    if (!tablet) {
+      continue;
+    }
+    auto flush_in_progress = tablet->IsFlushInProgress();
+    if (!flush_in_progress.ok()) {
+      continue;
+    }
+    TabletFlushCandidate candidate;
+    candidate.data_root_dir = tablet->metadata()->data_root_dir();
+    candidate.memstore_size = tablet->MemTablesMemoryUsage();
+    candidate.flush_in_progress = *flush_in_progress;
+    if (!candidate.flush_in_progress) {
+      const HybridTime oldest_write_in_memstore =
+          tablet->flush_stats()->oldest_write_in_memstore();
+      if (oldest_write_in_memstore == HybridTime::kMax) {
+        continue;
       }
+      auto* log = entry.second->log();
+      candidate.wal_size = log ? log->OnDiskSize() : 0;
+      const MicrosTime oldest_write_us = oldest_write_in_memstore.GetPhysicalValueMicros();
+      candidate.oldest_write_age_us = std::max<MicrosTime>(
+          tablet->clock()->Now().GetPhysicalValueMicros(), oldest_write_us) - oldest_write_us;
     }
+    peers->push_back(entry.second);
+    candidates->push_back(std::move(candidate));
   }
-  return tablet_to_flush;
 }
 
 TSTabletManager::TSTabletManager(FsManager* fs_manager,
@@ -299,8 +451,38 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
     block_cache_size_bytes = total_ram_avail * FLAGS_db_block_cache_size_percentage / 100;
   }
   if (FLAGS_db_block_cache_size_bytes != kDbCacheSizeCacheDisabled) {
+    const auto reservations = CHECK_RESULT(ParseBlockCacheReservations(
+        FLAGS_db_block_cache_table_reservations, block_cache_size_bytes));
+    for (const auto& reservation : reservations) {
+      block_cache_size_bytes -= reservation.second;
+    }
+
     tablet_options_.block_cache = rocksdb::NewLRUCache(block_cache_size_bytes);
     tablet_options_.block_cache->SetMetrics(server_->metric_entity());
+
+    for (const auto& reservation : reservations) {
+      auto cache = rocksdb::NewLRUCache(reservation.second);
+      // The metrics of a reserved part are reported as a separate entity with the block_cache_*
+      // metrics of the shared block cache.
+      MetricEntity::AttributeMap attrs;
+      attrs["table"] = reservation.first;
+      cache->SetMetrics(METRIC_ENTITY_server.Instantiate(
+          server_->metric_registry(), "block_cache." + reservation.first, attrs));
+      tablet_options_.table_block_caches.emplace(reservation.first, std::move(cache));
+    }
+
+    if (!FLAGS_db_secondary_block_cache_dir.empty()) {
+      Status s = rocksdb::NewFileBlockCache(
+          FLAGS_db_secondary_block_cache_dir, FLAGS_db_secondary_block_cache_size_bytes,
+          4 /* num_shard_bits */, &tablet_options_.secondary_block_cache);
+      if (s.ok()) {
+        tablet_options_.secondary_block_cache->SetMetrics(server_->metric_entity());
+      } else {
+        LOG(WARNING) << "Failed to create secondary block cache in "
+                     << FLAGS_db_secondary_block_cache_dir << ", running without it: " << s;
+        tablet_options_.secondary_block_cache.reset();
+      }
+    }
   }
 
   // Calculate memstore_size_bytes
@@ -349,6 +531,8 @@ Status TSTabletManager::Init() {
                 .set_max_threads(max_bootstrap_threads)
                 .Build(&open_tablet_pool_));
 
+  multi_raft_manager_ = std::make_unique<consensus::MultiRaftManager>(server_->messenger());
+
   // Search for tablets in the metadata dir.
   vector<string> tablet_ids;
   RETURN_NOT_OK(fs_manager_->ListTabletIds(&tablet_ids));
@@ -890,7 +1074,8 @@ void TSTabletManager::OpenTablet(const scoped_refptr<TabletMetadata>& meta,
                                     log,
                                     tablet->GetMetricEntity(),
                                     raft_pool(),
-                                    tablet_prepare_pool());
+                                    tablet_prepare_pool(),
+                                    multi_raft_manager_.get());
 
     if (!s.ok()) {
       LOG(ERROR) << kLogPrefix << "Tablet failed to init: "
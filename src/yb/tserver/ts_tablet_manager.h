@@ -56,6 +56,7 @@
 #include "yb/tserver/tserver_admin.pb.h"
 #include "yb/util/locks.h"
 #include "yb/util/metrics.h"
+#include "yb/util/result.h"
 #include "yb/util/status.h"
 #include "yb/util/threadpool.h"
 #include "yb/tablet/tablet_options.h"
@@ -70,6 +71,7 @@ class Schema;
 class BackgroundTask;
 
 namespace consensus {
+class MultiRaftManager;
 class RaftConfigPB;
 } // namespace consensus
 
@@ -89,6 +91,31 @@ typedef std::unordered_map<std::string, std::string> TransitionInProgressMap;
 
 class TransitionInProgressDeleter;
 
+// Memstore flush statistics of a tablet, used to choose the tablets to flush.
+struct TabletFlushCandidate {
+  std::string data_root_dir;
+  int64_t memstore_size = 0;
+  int64_t wal_size = 0;
+  // Age of the oldest write in the memstore.
+  int64_t oldest_write_age_us = 0;
+  bool flush_in_progress = false;
+};
+
+// Returns the indexes of the candidates to flush to free 'memory_to_free' bytes of memstores, best
+// candidates first. Memstores that are already flushing count towards 'memory_to_free' and towards
+// the max_concurrent_memstore_flushes_per_disk limit of their disk.
+std::vector<size_t> SelectTabletsToFlush(
+    const std::vector<TabletFlushCandidate>& candidates, int64_t memory_to_free);
+
+// Bytes of the block cache reserved for tables, by table id or name.
+typedef std::vector<std::pair<std::string, int64_t>> BlockCacheReservations;
+
+// Parses the value of db_block_cache_table_reservations, comma separated <table>:<bytes> entries.
+// Returns InvalidArgument for a malformed entry, for a reservation that is not positive, or if the
+// reservations would leave nothing of the 'block_cache_size' bytes to the shared block cache.
+Result<BlockCacheReservations> ParseBlockCacheReservations(
+    const std::string& value, int64_t block_cache_size);
+
 // If 'expr' fails, log a message, tombstone the given tablet, and return the
 // error status.
 #define TOMBSTONE_NOT_OK(expr, meta, uuid, msg, ts_manager_ptr) \
@@ -273,7 +300,8 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
 
   MemoryMonitor* memory_monitor() { return tablet_options_.memory_monitor.get(); }
 
-  // Flush some tablet if the memstore memory limit is exceeded
+  // Flush the memstores of the best candidate tablets if the global memstore limit is exceeded,
+  // or if the root MemTracker is over FLAGS_memstore_flush_memory_usage_percentage of its limit.
   void MaybeFlushTablet();
 
  private:
@@ -366,8 +394,13 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   // TABLET_DATA_READY state. Generally, we tombstone the replica.
   CHECKED_STATUS HandleNonReadyTabletOnStartup(const scoped_refptr<tablet::TabletMetadata>& meta);
 
-  // Return the tablet with oldest write still in its memstore
-  scoped_refptr<tablet::TabletPeer> TabletToFlush();
+  // Returns how much memstore memory should be freed by flushes.
+  int64_t MemoryToFreeByFlushes();
+
+  // Fills 'candidates' with the flush statistics of the tablets that are flushing or have writes
+  // still in their memstores, and 'peers' with the corresponding tablet peers.
+  void CollectFlushCandidates(std::vector<scoped_refptr<tablet::TabletPeer>>* peers,
+                              std::vector<TabletFlushCandidate>* candidates);
 
   TSTabletManagerStatePB state() const {
     boost::shared_lock<rw_spinlock> lock(lock_);
@@ -433,6 +466,9 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   // Thread pool for Raft-related operations, shared between all tablets.
   std::unique_ptr<ThreadPool> raft_pool_;
 
+  // Batches the heartbeats that the leaders on this server send to other tablet servers.
+  std::unique_ptr<consensus::MultiRaftManager> multi_raft_manager_;
+
   // Used for scheduling flushes
   std::unique_ptr<BackgroundTask> background_task_;
 
@@ -34,6 +34,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <map>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -42,6 +43,7 @@
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/quorum_util.h"
 #include "yb/gutil/map-util.h"
+#include "yb/gutil/stringprintf.h"
 #include "yb/gutil/strings/human_readable.h"
 #include "yb/gutil/strings/join.h"
 #include "yb/gutil/strings/numbers.h"
@@ -69,6 +71,7 @@ using yb::tablet::MaintenanceManagerStatusPB;
 using yb::tablet::MaintenanceManagerStatusPB_CompletedOpPB;
 using yb::tablet::MaintenanceManagerStatusPB_MaintenanceOpPB;
 using yb::tablet::Tablet;
+using yb::tablet::TabletHotKeysPB;
 using yb::tablet::TabletPeer;
 using yb::tablet::TabletStatusPB;
 using yb::tablet::Operation;
@@ -108,6 +111,9 @@ Status TabletServerPathHandlers::Register(Webserver* server) {
       "/", "Dashboards",
       std::bind(&TabletServerPathHandlers::HandleDashboardsPage, this, _1, _2), true /* styled */,
       true /* is_on_nav_bar */, "fa fa-dashboard");
+  server->RegisterPathHandler(
+      "/hot-keys", "", std::bind(&TabletServerPathHandlers::HandleHotKeysPage, this, _1, _2),
+      true /* styled */, false /* is_on_nav_bar */);
   server->RegisterPathHandler(
       "/maintenance-manager", "",
       std::bind(&TabletServerPathHandlers::HandleMaintenanceManagerPage, this, _1, _2),
@@ -349,6 +355,12 @@ void TabletServerPathHandlers::HandleTabletPage(const Webserver::WebRequest& req
                                   "Tablet Log Anchors")
           << "</li>" << endl;
 
+  // Hot keys page.
+  *output << "<li>" << Substitute("<a href=\"/hot-keys?id=$0\">$1</a>",
+                                  UrlEncodeToString(tablet_id),
+                                  "Hot Keys")
+          << "</li>" << endl;
+
   // End list
   *output << "</ul>\n";
 }
@@ -405,6 +417,8 @@ void TabletServerPathHandlers::HandleDashboardsPage(const Webserver::WebRequest&
   *output << GetDashboardLine("maintenance-manager", "Maintenance Manager",
                               "List of operations that are currently running and those "
                               "that are registered.");
+  *output << GetDashboardLine("hot-keys", "Hot Keys",
+                              "Sampled load of tables and tablets by key hash code.");
 }
 
 string TabletServerPathHandlers::GetDashboardLine(const std::string& link,
@@ -474,5 +488,126 @@ void TabletServerPathHandlers::HandleMaintenanceManagerPage(const Webserver::Web
   *output << "</table>\n";
 }
 
+namespace {
+
+string HashCodeToString(uint32_t hash_code) {
+  return StringPrintf("0x%04x", hash_code);
+}
+
+}  // anonymous namespace
+
+void TabletServerPathHandlers::HandleHotKeysPage(const Webserver::WebRequest& req,
+                                                 std::stringstream* output) {
+  vector<scoped_refptr<TabletPeer> > peers;
+  if (ContainsKey(req.parsed_args, "id")) {
+    string tablet_id;
+    scoped_refptr<TabletPeer> peer;
+    if (!LoadTablet(tserver_, req, &tablet_id, &peer, output)) return;
+    peers.push_back(peer);
+  } else {
+    tserver_->tablet_manager()->GetTabletPeers(&peers);
+    std::sort(peers.begin(), peers.end(), &CompareByTabletId);
+  }
+
+  struct TableLoad {
+    uint64_t reads = 0;
+    uint64_t writes = 0;
+    string hottest_tablet_id;
+    uint64_t hottest_tablet_ops = 0;
+  };
+  std::map<string, TableLoad> tables;
+  vector<std::pair<scoped_refptr<TabletPeer>, TabletHotKeysPB>> tablets;
+  for (const auto& peer : peers) {
+    auto tablet = peer->shared_tablet();
+    if (!tablet) {
+      continue;
+    }
+    TabletHotKeysPB pb;
+    tablet->hot_key_sampler().ToPB(&pb);
+    if (pb.sampled_reads() + pb.sampled_writes() == 0) {
+      continue;
+    }
+    auto& table = tables[peer->tablet_metadata()->table_name()];
+    table.reads += pb.sampled_reads() * pb.sample_rate();
+    table.writes += pb.sampled_writes() * pb.sample_rate();
+    const uint64_t tablet_ops = (pb.sampled_reads() + pb.sampled_writes()) * pb.sample_rate();
+    if (tablet_ops > table.hottest_tablet_ops) {
+      table.hottest_tablet_id = peer->tablet_id();
+      table.hottest_tablet_ops = tablet_ops;
+    }
+    tablets.emplace_back(peer, std::move(pb));
+  }
+
+  if (ContainsKey(req.parsed_args, "raw")) {
+    for (const auto& entry : tablets) {
+      *output << "Tablet: " << entry.first->tablet_id() << endl;
+      *output << entry.second.DebugString() << endl;
+    }
+    return;
+  }
+
+  *output << "<h1>Hot Keys</h1>\n";
+  *output << "<p>Operation counts are estimated from sampled reads and writes of single keys, "
+          << "and are decayed over time.</p>\n";
+
+  *output << "<h3>Tables</h3>\n";
+  *output << "<table class='table table-striped'>\n";
+  *output << "  <tr><th>Table name</th><th>Reads</th><th>Writes</th><th>Hottest tablet</th>"
+          << "</tr>\n";
+  for (const auto& table : tables) {
+    *output << Substitute("<tr><td>$0</td><td>$1</td><td>$2</td><td>$3</td></tr>\n",
+                          EscapeForHtmlToString(table.first),
+                          table.second.reads,
+                          table.second.writes,
+                          TabletLink(table.second.hottest_tablet_id));
+  }
+  *output << "</table>\n";
+
+  *output << "<h3>Tablets</h3>\n";
+  *output << "<table class='table table-striped'>\n";
+  *output << "  <tr><th>Table name</th><th>Tablet ID</th><th>Reads</th><th>Writes</th>"
+          << "<th>Hottest hash codes (reads/writes)</th><th>Hottest hash range (reads/writes)</th>"
+          << "</tr>\n";
+  for (const auto& entry : tablets) {
+    const auto& pb = entry.second;
+    const uint64_t rate = pb.sample_rate();
+
+    string hot_keys;
+    for (const auto& key : pb.hot_keys()) {
+      hot_keys += Substitute("$0: $1/$2<br>",
+                             HashCodeToString(key.hash_code()),
+                             key.sampled_reads() * rate,
+                             key.sampled_writes() * rate);
+    }
+
+    string hot_range;
+    const TabletHotKeysPB::HotRangePB* hottest_range = nullptr;
+    for (const auto& range : pb.hot_ranges()) {
+      if (!hottest_range ||
+          range.sampled_reads() + range.sampled_writes() >
+              hottest_range->sampled_reads() + hottest_range->sampled_writes()) {
+        hottest_range = &range;
+      }
+    }
+    if (hottest_range) {
+      hot_range = Substitute("[$0, $1): $2/$3",
+                             HashCodeToString(hottest_range->start_hash_code()),
+                             HashCodeToString(hottest_range->end_hash_code()),
+                             hottest_range->sampled_reads() * rate,
+                             hottest_range->sampled_writes() * rate);
+    }
+
+    *output << Substitute(
+        "<tr><td>$0</td><td>$1</td><td>$2</td><td>$3</td><td>$4</td><td>$5</td></tr>\n",
+        EscapeForHtmlToString(entry.first->tablet_metadata()->table_name()),
+        TabletLink(entry.first->tablet_id()),
+        pb.sampled_reads() * rate,
+        pb.sampled_writes() * rate,
+        hot_keys,
+        hot_range);
+  }
+  *output << "</table>\n";
+}
+
 }  // namespace tserver
 }  // namespace yb
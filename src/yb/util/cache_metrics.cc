@@ -71,6 +71,33 @@ METRIC_DEFINE_gauge_uint64(server, block_cache_multi_touch_usage,
                            "Multi Cache Block Cache Memory Usage",
                            yb::MetricUnit::kBytes,
                            "Memory consumed by the multi cache block cache");
+
+METRIC_DEFINE_counter(server, secondary_block_cache_inserts,
+                      "Secondary Block Cache Inserts", yb::MetricUnit::kBlocks,
+                      "Number of compressed blocks written to the secondary block cache");
+METRIC_DEFINE_counter(server, secondary_block_cache_lookups,
+                      "Secondary Block Cache Lookups", yb::MetricUnit::kBlocks,
+                      "Number of blocks looked up from the secondary block cache");
+METRIC_DEFINE_counter(server, secondary_block_cache_evictions,
+                      "Secondary Block Cache Evictions", yb::MetricUnit::kBlocks,
+                      "Number of blocks overwritten in the secondary block cache");
+METRIC_DEFINE_counter(server, secondary_block_cache_hits,
+                      "Secondary Block Cache Hits", yb::MetricUnit::kBlocks,
+                      "Number of lookups that found a block in the secondary block cache");
+METRIC_DEFINE_counter(server, secondary_block_cache_misses,
+                      "Secondary Block Cache Misses", yb::MetricUnit::kBlocks,
+                      "Number of lookups that didn't find a block in the secondary block cache");
+METRIC_DEFINE_counter(server, secondary_block_cache_bytes_read,
+                      "Secondary Block Cache Bytes Read", yb::MetricUnit::kBytes,
+                      "Number of bytes read from the secondary block cache");
+METRIC_DEFINE_counter(server, secondary_block_cache_bytes_written,
+                      "Secondary Block Cache Bytes Written", yb::MetricUnit::kBytes,
+                      "Number of bytes written to the secondary block cache");
+
+METRIC_DEFINE_gauge_uint64(server, secondary_block_cache_usage, "Secondary Block Cache Usage",
+                           yb::MetricUnit::kBytes,
+                           "Size of the blocks stored in the secondary block cache");
+
 namespace yb {
 
 #define MINIT(member, x) member(METRIC_##x.Instantiate(entity))
@@ -87,6 +114,17 @@ CacheMetrics::CacheMetrics(const scoped_refptr<MetricEntity>& entity)
     GINIT(single_touch_cache_usage, block_cache_single_touch_usage),
     GINIT(multi_touch_cache_usage, block_cache_multi_touch_usage) {
 }
+
+SecondaryCacheMetrics::SecondaryCacheMetrics(const scoped_refptr<MetricEntity>& entity)
+  : MINIT(inserts, secondary_block_cache_inserts),
+    MINIT(lookups, secondary_block_cache_lookups),
+    MINIT(evictions, secondary_block_cache_evictions),
+    MINIT(cache_hits, secondary_block_cache_hits),
+    MINIT(cache_misses, secondary_block_cache_misses),
+    MINIT(bytes_read, secondary_block_cache_bytes_read),
+    MINIT(bytes_written, secondary_block_cache_bytes_written),
+    GINIT(cache_usage, secondary_block_cache_usage) {
+}
 #undef MINIT
 #undef GINIT
 
@@ -60,5 +60,20 @@ struct CacheMetrics {
   scoped_refptr<AtomicGauge<uint64_t> > multi_touch_cache_usage;
 };
 
+// Metrics of the secondary, on-disk tier of the block cache.
+struct SecondaryCacheMetrics {
+  explicit SecondaryCacheMetrics(const scoped_refptr<MetricEntity>& metric_entity);
+
+  scoped_refptr<Counter> inserts;
+  scoped_refptr<Counter> lookups;
+  scoped_refptr<Counter> evictions;
+  scoped_refptr<Counter> cache_hits;
+  scoped_refptr<Counter> cache_misses;
+  scoped_refptr<Counter> bytes_read;
+  scoped_refptr<Counter> bytes_written;
+
+  scoped_refptr<AtomicGauge<uint64_t> > cache_usage;
+};
+
 } // namespace yb
 #endif /* YB_UTIL_CACHE_METRICS_H */
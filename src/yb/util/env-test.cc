@@ -543,6 +543,31 @@ TEST_F(TestEnv, TestRandomData) {
   ASSERT_NO_FATALS(TestAppendRandomData(true, opts));
 }
 
+TEST_F(TestEnv, TestODirectSize) {
+  string test_path = GetTestPath("test_env_odirect_size");
+  WritableFileOptions opts;
+  opts.o_direct = true;
+  shared_ptr<WritableFile> writer;
+  ASSERT_OK(env_util::OpenFileForWrite(opts, env_.get(), test_path, &writer));
+  if (fallocate_supported_) {
+    ASSERT_OK(writer->PreAllocate(1024 * 1024));
+  }
+
+  // Sizes are deliberately not multiples of the O_DIRECT block size.
+  string first(1000, 'a');
+  string second(3000, 'b');
+  ASSERT_OK(writer->Append(first));
+  ASSERT_EQ(first.length(), writer->Size());
+  ASSERT_OK(writer->Append(second));
+  ASSERT_EQ(first.length() + second.length(), writer->Size());
+  ASSERT_OK(writer->Sync());
+  ASSERT_EQ(first.length() + second.length(), writer->Size());
+  ASSERT_OK(writer->Close());
+
+  uint64_t size = ASSERT_RESULT(env_->GetFileSize(test_path));
+  ASSERT_EQ(first.length() + second.length(), size);
+}
+
 TEST_F(TestEnv, TestGetExecutablePath) {
   string p;
   ASSERT_OK(Env::Default()->GetExecutablePath(&p));
@@ -362,12 +362,18 @@ struct WritableFileOptions {
 
   bool o_direct;
 
+  // Only used with o_direct. Open the file with O_SYNC, so every write is durable when it
+  // returns. Otherwise Flush() only writes out the buffered blocks and Sync() also calls
+  // fdatasync().
+  bool o_direct_sync_writes;
+
   // See CreateMode for details.
   Env::CreateMode mode;
 
   WritableFileOptions()
     : sync_on_close(false),
       o_direct(false),
+      o_direct_sync_writes(true),
       mode(Env::CREATE_IF_NON_EXISTING_TRUNCATE) { }
 };
 
@@ -528,8 +528,9 @@ class PosixWritableFile : public WritableFile {
 class PosixDirectIOWritableFile : public PosixWritableFile {
  public:
   PosixDirectIOWritableFile(const std::string &fname, int fd, uint64_t file_size,
-                            bool sync_on_close)
-      : PosixWritableFile(fname, fd, file_size, false /* sync_on_close */) {
+                            bool sync_on_close, bool sync_writes)
+      : PosixWritableFile(fname, fd, file_size, false /* sync_on_close */),
+        sync_writes_(sync_writes) {
 
     if (file_size != 0) {
       // For now, we don't support appending to an already existing file (of non-zero size).
@@ -569,7 +570,7 @@ class PosixDirectIOWritableFile : public PosixWritableFile {
 
       if (data_slice.size() >= max_data) {
         data_slice.remove_prefix(max_data);
-        RETURN_NOT_OK(Sync());
+        RETURN_NOT_OK(DoWrite());
       } else {
         break;
       }
@@ -614,18 +615,56 @@ class PosixDirectIOWritableFile : public PosixWritableFile {
 
   Status Flush(FlushMode mode) override {
     ThreadRestrictions::AssertIOAllowed();
-    return Sync();
+    return DoWrite();
   }
 
   Status Sync() override {
     ThreadRestrictions::AssertIOAllowed();
-    return DoWrite();
+    RETURN_NOT_OK(DoWrite());
+    if (!sync_writes_ && pending_sync_) {
+      pending_sync_ = false;
+      LOG_SLOW_EXECUTION(WARNING, 1000, Substitute("sync call for $0", filename_)) {
+        RETURN_NOT_OK(DoSync(fd_, filename_));
+      }
+    }
+    return Status::OK();
   }
 
   uint64_t Size() const override {
     return real_size_;
   }
 
+  // Without O_SYNC the preallocated range is filled with zeros, instead of just being reserved
+  // by fallocate(). Writing over already written blocks does not change the file metadata, so
+  // a single fdatasync() on any file of the device makes such writes durable.
+  Status PreAllocate(uint64_t size) override {
+    if (sync_writes_) {
+      return PosixWritableFile::PreAllocate(size);
+    }
+    TRACE_EVENT1("io", "PosixDirectIOWritableFile::PreAllocate", "path", filename_);
+    ThreadRestrictions::AssertIOAllowed();
+    uint64_t offset = std::max<uint64_t>(filesize_, pre_allocated_size_);
+    const uint64_t end = align_up(offset + size, block_size_);
+    constexpr size_t kZeroBufferSize = 1024 * 1024;
+    void* zeros = nullptr;
+    auto err = posix_memalign(&zeros, FLAGS_o_direct_block_alignment_bytes, kZeroBufferSize);
+    if (err) {
+      return STATUS(RuntimeError, "Unable to allocate memory", ErrnoToString(err), err);
+    }
+    std::unique_ptr<void, decltype(&free)> zeros_holder(zeros, &free);
+    memset(zeros, 0, kZeroBufferSize);
+    while (offset < end) {
+      const size_t len = std::min<uint64_t>(end - offset, kZeroBufferSize);
+      ssize_t written = pwrite(fd_, zeros, len, offset);
+      if (PREDICT_FALSE(written < 0)) {
+        return IOError(filename_, errno);
+      }
+      offset += written;
+    }
+    pre_allocated_size_ = end;
+    return DoSync(fd_, filename_);
+  }
+
  private:
   // The number of bytes buffered so far (that will be written out as part of the next write).
   size_t BufferedByteCount() {
@@ -703,6 +742,7 @@ class PosixDirectIOWritableFile : public PosixWritableFile {
 
     filesize_ = next_write_offset_ + written;
     CHECK_EQ(filesize_, align_up(filesize_, block_size_));
+    pending_sync_ = true;
 
     next_write_offset_ = filesize_;
 
@@ -755,6 +795,7 @@ class PosixDirectIOWritableFile : public PosixWritableFile {
   int block_size_;
   bool has_new_data_;
   size_t real_size_;
+  const bool sync_writes_;
 };
 #endif
 
@@ -1025,7 +1066,7 @@ class PosixEnv : public Env {
     int extra_flags = 0;
 #if defined(__linux__)
     if (opts.o_direct) {
-      extra_flags = O_DIRECT | O_NOATIME | O_SYNC;
+      extra_flags = O_DIRECT | O_NOATIME | (opts.o_direct_sync_writes ? O_SYNC : 0);
     }
 #endif
     RETURN_NOT_OK(DoOpen(fname, opts.mode, &fd, extra_flags));
@@ -1043,7 +1084,8 @@ class PosixEnv : public Env {
     int fd = -1;
 #if defined(__linux__)
     if (opts.o_direct)
-      fd = ::mkostemp(fname.get(), O_DIRECT | O_NOATIME | O_SYNC);
+      fd = ::mkostemp(fname.get(),
+                      O_DIRECT | O_NOATIME | (opts.o_direct_sync_writes ? O_SYNC : 0));
     else
 #endif
       fd = ::mkstemp(fname.get());
@@ -1445,7 +1487,8 @@ class PosixEnv : public Env {
     PosixWritableFile *posix_writable_file;
 #if defined(__linux)
     if (opts.o_direct)
-      posix_writable_file = new PosixDirectIOWritableFile(fname, fd, file_size, opts.sync_on_close);
+      posix_writable_file = new PosixDirectIOWritableFile(
+          fname, fd, file_size, opts.sync_on_close, opts.o_direct_sync_writes);
     else
 #endif
       posix_writable_file = new PosixWritableFile(fname, fd, file_size, opts.sync_on_close);
@@ -529,6 +529,45 @@ Status Socket::Recv(uint8_t *buf, int32_t amt, int32_t *nread) {
   return Status::OK();
 }
 
+Status Socket::Recvv(struct ::iovec *iov, int iov_len, int32_t *nread) {
+  if (PREDICT_FALSE(iov_len <= 0)) {
+    return STATUS(NetworkError,
+                  StringPrintf("recvmsg: invalid io vector length of %d", iov_len),
+                  Slice(), EINVAL);
+  }
+
+  // Same as in Recv, simulate short reads by limiting the total length of the io vector.
+  if (PREDICT_FALSE(FLAGS_socket_inject_short_recvs)) {
+    size_t total = 0;
+    for (int i = 0; i != iov_len; ++i) {
+      total += iov[i].iov_len;
+    }
+    if (total > 1) {
+      Random r(GetRandomSeed32());
+      return Recv(static_cast<uint8_t*>(iov[0].iov_base),
+                  1 + r.Uniform(std::min<size_t>(iov[0].iov_len, total - 1)),
+                  nread);
+    }
+  }
+
+  DCHECK_GE(fd_, 0);
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(struct msghdr));
+  msg.msg_iov = iov;
+  msg.msg_iovlen = iov_len;
+  int res = ::recvmsg(fd_, &msg, 0);
+  if (res <= 0) {
+    if (res == 0) {
+      return STATUS(NetworkError, "Recv() got EOF from remote", Slice(), ESHUTDOWN);
+    }
+    int err = errno;
+    return STATUS(NetworkError, std::string("recvmsg error: ") +
+                                ErrnoToString(err), Slice(), err);
+  }
+  *nread = res;
+  return Status::OK();
+}
+
 // Mostly follows readn() from Stevens (2004) or Kerrisk (2010).
 // One place where we deviate: we consider EOF a failure if < amt bytes are read.
 Status Socket::BlockingRecv(uint8_t *buf, size_t amt, size_t *nread, const MonoTime& deadline) {
@@ -143,6 +143,9 @@ class Socket {
 
   CHECKED_STATUS Recv(uint8_t *buf, int32_t amt, int32_t *nread);
 
+  // Scatter version of Recv, fills buffers of the io vector in order.
+  CHECKED_STATUS Recvv(struct ::iovec *iov, int iov_len, int32_t *nread);
+
   // Blocking Recv call, returns IOError unless requested amt bytes are read.
   // Underlying Socket expected to be in blocking mode. Fails if any Recv() reads 0 bytes.
   // Returns OK if amt bytes were read, otherwise IOError.
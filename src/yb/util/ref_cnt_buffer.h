@@ -22,6 +22,8 @@
 #include <atomic>
 #include <string>
 
+#include "yb/util/slice.h"
+
 namespace yb {
 
 class faststring;
@@ -98,6 +100,11 @@ class RefCntBuffer {
     return std::string(begin(), end());
   }
 
+  // Whether this is the only reference to the underlying block.
+  bool unique() const {
+    return data_ != nullptr && counter_reference().load(std::memory_order_acquire) == 1;
+  }
+
  private:
   void DoReset(char* data);
 
@@ -115,6 +122,53 @@ class RefCntBuffer {
   char *data_;
 };
 
+// Slice that points into the data of a RefCntBuffer and keeps this buffer alive.
+// Used to pass received data around without copying it.
+class RefCntSlice {
+ public:
+  RefCntSlice() {}
+
+  RefCntSlice(RefCntBuffer holder, const Slice& slice)
+      : holder_(std::move(holder)), slice_(slice) {}
+
+  const Slice& AsSlice() const {
+    return slice_;
+  }
+
+  const uint8_t* data() const {
+    return slice_.data();
+  }
+
+  const uint8_t* end() const {
+    return slice_.end();
+  }
+
+  size_t size() const {
+    return slice_.size();
+  }
+
+  bool empty() const {
+    return slice_.empty();
+  }
+
+  const RefCntBuffer& holder() const {
+    return holder_;
+  }
+
+  // Returns slice of the same holder, [begin, end) should lie inside this slice.
+  RefCntSlice SubSlice(const uint8_t* begin, const uint8_t* end) const {
+    return RefCntSlice(holder_, Slice(begin, end));
+  }
+
+  RefCntSlice SubSlice(const uint8_t* begin, size_t size) const {
+    return SubSlice(begin, begin + size);
+  }
+
+ private:
+  RefCntBuffer holder_;
+  Slice slice_;
+};
+
 } // namespace yb
 
 #endif // YB_UTIL_REF_CNT_BUFFER_H
@@ -58,8 +58,9 @@ CQLConnectionContext::CQLConnectionContext()
 }
 
 Status CQLConnectionContext::ProcessCalls(const rpc::ConnectionPtr& connection,
-                                          Slice slice,
+                                          const RefCntSlice& data,
                                           size_t* consumed) {
+  const Slice& slice = data.AsSlice();
   auto pos = slice.data();
   const auto end = slice.end();
   while (end - pos >= CQLMessage::kMessageHeaderLength) {
@@ -78,7 +79,7 @@ Status CQLConnectionContext::ProcessCalls(const rpc::ConnectionPtr& connection,
       break;
     }
 
-    RETURN_NOT_OK(HandleInboundCall(connection, Slice(pos, total_length)));
+    RETURN_NOT_OK(HandleInboundCall(connection, data.SubSlice(pos, total_length)));
     pos += total_length;
   }
 
@@ -93,7 +94,16 @@ size_t CQLConnectionContext::BufferLimit() {
   return FLAGS_max_message_length;
 }
 
-Status CQLConnectionContext::HandleInboundCall(const rpc::ConnectionPtr& connection, Slice slice) {
+size_t CQLConnectionContext::PendingCallSize(Slice pending_data) {
+  if (pending_data.size() >= CQLMessage::kMessageHeaderLength) {
+    return CQLMessage::kMessageHeaderLength +
+           NetworkByteOrder::Load32(pending_data.data() + CQLMessage::kHeaderPosLength);
+  }
+  return 0;
+}
+
+Status CQLConnectionContext::HandleInboundCall(const rpc::ConnectionPtr& connection,
+                                               const RefCntSlice& slice) {
   auto reactor = connection->reactor();
   DCHECK(reactor->IsCurrentThread());
 
@@ -137,13 +147,13 @@ CQLInboundCall::CQLInboundCall(rpc::ConnectionPtr conn,
       ql_session_(std::move(ql_session)) {
 }
 
-Status CQLInboundCall::ParseFrom(Slice source) {
+Status CQLInboundCall::ParseFrom(const RefCntSlice& source) {
   TRACE_EVENT_FLOW_BEGIN0("rpc", "CQLInboundCall", this);
   TRACE_EVENT0("rpc", "CQLInboundCall::ParseFrom");
 
   // Parsing of CQL message is deferred to CQLServiceImpl::Handle. Just save the serialized data.
-  request_data_.assign(source.data(), source.end());
-  serialized_request_ = Slice(request_data_.data(), request_data_.size());
+  request_data_ = source;
+  serialized_request_ = source.AsSlice();
 
   // Fill the service name method name to transfer the call to. The method name is for debug
   // tracing only. Inside CQLServiceImpl::Handle, we rely on the opcode to dispatch the execution.
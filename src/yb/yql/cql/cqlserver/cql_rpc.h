@@ -53,11 +53,12 @@ class CQLConnectionContext : public rpc::ConnectionContextWithCallId {
 
   uint64_t ExtractCallId(rpc::InboundCall* call) override;
   CHECKED_STATUS ProcessCalls(const rpc::ConnectionPtr& connection,
-                              Slice slice,
+                              const RefCntSlice& data,
                               size_t* consumed) override;
   size_t BufferLimit() override;
+  size_t PendingCallSize(Slice pending_data) override;
 
-  CHECKED_STATUS HandleInboundCall(const rpc::ConnectionPtr& connection, Slice slice);
+  CHECKED_STATUS HandleInboundCall(const rpc::ConnectionPtr& connection, const RefCntSlice& slice);
 
   // SQL session of this CQL client connection.
   ql::QLSession::SharedPtr ql_session_;
@@ -72,7 +73,7 @@ class CQLInboundCall : public rpc::InboundCall {
                           CallProcessedListener call_processed_listener,
                           ql::QLSession::SharedPtr ql_session);
 
-  CHECKED_STATUS ParseFrom(Slice source);
+  CHECKED_STATUS ParseFrom(const RefCntSlice& source);
 
   // Serialize the response packet for the finished call.
   // The resulting slices refer to memory in this object.
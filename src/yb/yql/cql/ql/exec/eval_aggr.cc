@@ -23,6 +23,66 @@ using yb::bfql::TSOpcode;
 
 //--------------------------------------------------------------------------------------------------
 
+namespace {
+
+// Type of the partial sum that tablet servers return for AVG() of the given type.
+CHECKED_STATUS AvgSumType(DataType data_type, DataType *sum_type) {
+  switch (data_type) {
+    case DataType::INT8: FALLTHROUGH_INTENDED;
+    case DataType::INT16: FALLTHROUGH_INTENDED;
+    case DataType::INT32: FALLTHROUGH_INTENDED;
+    case DataType::INT64:
+      *sum_type = DataType::INT64;
+      return Status::OK();
+    case DataType::FLOAT: FALLTHROUGH_INTENDED;
+    case DataType::DOUBLE:
+      *sum_type = DataType::DOUBLE;
+      return Status::OK();
+    default:
+      return STATUS_SUBSTITUTE(NotSupported, "Function AVG() of $0 not yet supported",
+                               QLType::ToCQLString(data_type));
+  }
+}
+
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+
+CHECKED_STATUS Executor::AggregateExprsToPB(const PTSelectStmt *tnode, QLReadRequestPB *req) {
+  // Tablet servers return the sum for AVG(), so the row count is added for each AVG() column.
+  QLRSRowDescPB *rsrow_desc_pb = req->mutable_rsrow_desc();
+  int column_index = 0;
+  for (auto expr_node : tnode->selected_exprs()) {
+    if (expr_node->aggregate_opcode() == TSOpcode::kAvg) {
+      if (!req->selected_exprs(column_index).has_tscall()) {
+        return STATUS(NotSupported, "Function AVG() with result conversion not yet supported");
+      }
+      DataType sum_type;
+      RETURN_NOT_OK(AvgSumType(expr_node->ql_type()->main(), &sum_type));
+      QLType::Create(sum_type)->ToQLTypePB(
+          rsrow_desc_pb->mutable_rscol_descs(column_index)->mutable_ql_type());
+
+      QLExpressionPB *count_pb = req->add_selected_exprs();
+      count_pb->CopyFrom(req->selected_exprs(column_index));
+      count_pb->mutable_tscall()->set_opcode(static_cast<int32_t>(TSOpcode::kCount));
+      QLRSColDescPB *rscol_desc_pb = rsrow_desc_pb->add_rscol_descs();
+      rscol_desc_pb->set_name(expr_node->QLName());
+      QLType::Create(DataType::INT64)->ToQLTypePB(rscol_desc_pb->mutable_ql_type());
+    }
+    column_index++;
+  }
+
+  // The GROUP BY columns are returned to merge the partial aggregates of the same group.
+  for (const ColumnDesc *col_desc : tnode->group_by_columns()) {
+    req->add_group_by_column_ids(col_desc->id());
+    req->add_selected_exprs()->set_column_id(col_desc->id());
+    QLRSColDescPB *rscol_desc_pb = rsrow_desc_pb->add_rscol_descs();
+    rscol_desc_pb->set_name(col_desc->name());
+    col_desc->ql_type()->ToQLTypePB(rscol_desc_pb->mutable_ql_type());
+  }
+  return Status::OK();
+}
+
 CHECKED_STATUS Executor::AggregateResultSets() {
   DCHECK(exec_context_->tnode()->opcode() == TreeNodeOpcode::kPTSelectStmt);
   const PTSelectStmt *pt_select = static_cast<const PTSelectStmt*>(exec_context_->tnode());
@@ -30,123 +90,200 @@ CHECKED_STATUS Executor::AggregateResultSets() {
     return Status::OK();
   }
 
+  // The rows are deserialized with the schema of the read request, i.e. the selected aggregates
+  // followed by the counts for AVG() and the GROUP BY columns as laid out by AggregateExprsToPB().
   shared_ptr<RowsResult> rows = std::static_pointer_cast<RowsResult>(result_);
   DCHECK(rows->client() == QLClient::YQL_CLIENT_CQL);
-  shared_ptr<QLRowBlock> row_block = rows->GetRowBlock();
-  int column_index = 0;
-  faststring buffer;
+  std::unique_ptr<QLRowBlock> row_block = rows->GetRowBlock();
 
-  CQLEncodeLength(1, &buffer);
-  for (auto expr_node : pt_select->selected_exprs()) {
-    QLValue ql_value;
-
-    switch (expr_node->aggregate_opcode()) {
-      case TSOpcode::kNoOp:
-        break;
-      case TSOpcode::kAvg:
-        RETURN_NOT_OK(STATUS(NotSupported, "Function AVG() not yet supported"));
-        break;
-      case TSOpcode::kCount:
-        RETURN_NOT_OK(EvalCount(row_block, column_index, &ql_value));
-        break;
-      case TSOpcode::kMax:
-        RETURN_NOT_OK(EvalMax(row_block, column_index, &ql_value));
-        break;
-      case TSOpcode::kMin:
-        RETURN_NOT_OK(EvalMin(row_block, column_index, &ql_value));
-        break;
-      case TSOpcode::kSum:
-        RETURN_NOT_OK(EvalSum(row_block, column_index, expr_node->ql_type()->main(), &ql_value));
-        break;
-      default:
-        return STATUS(RuntimeError, "Unexpected operator while evaluating aggregate expressions");
+  const MCList<PTExpr::SharedPtr>& selected_exprs = pt_select->selected_exprs();
+  const int num_exprs = selected_exprs.size();
+  std::vector<TSOpcode> opcodes;
+  std::vector<int> avg_count_index;
+  int num_aggregate_columns = num_exprs;
+  for (auto expr_node : selected_exprs) {
+    opcodes.push_back(expr_node->aggregate_opcode());
+    avg_count_index.push_back(opcodes.back() == TSOpcode::kAvg ? num_aggregate_columns++ : -1);
+  }
+  const int num_columns = num_aggregate_columns + pt_select->group_by_columns().size();
+  for (int i = num_exprs; i < num_columns; i++) {
+    opcodes.push_back(i < num_aggregate_columns ? TSOpcode::kCount : TSOpcode::kNoOp);
+  }
+
+  // Each tablet server returns one row per group, and the rows of a group are read by a single
+  // tablet. Merge the adjacent rows of the same group anyway in case a group is returned in parts.
+  // Without GROUP BY, all rows form a single group which is returned even when no rows are read.
+  std::vector<std::vector<QLValue>> groups;
+  if (pt_select->group_by_columns().empty()) {
+    groups.emplace_back(num_columns);
+  }
+  for (const QLRow& row : row_block->rows()) {
+    bool same_group = !groups.empty();
+    for (int i = num_aggregate_columns; same_group && i < num_columns; i++) {
+      same_group = groups.back()[i].value() == row.column(i).value();
+    }
+    if (!same_group) {
+      groups.emplace_back(num_columns);
     }
 
-    // Serialize the return value.
-    ql_value.Serialize(expr_node->ql_type(), rows->client(), &buffer);
-    column_index++;
+    std::vector<QLValue>& group = groups.back();
+    int column_index = 0;
+    for (TSOpcode opcode : opcodes) {
+      const QLValue& partial_value = row.column(column_index);
+      QLValue *ql_value = &group[column_index];
+      switch (opcode) {
+        case TSOpcode::kNoOp:
+          if (ql_value->IsNull()) {
+            *ql_value = partial_value;
+          }
+          break;
+        case TSOpcode::kCount:
+          RETURN_NOT_OK(EvalCount(partial_value, ql_value));
+          break;
+        case TSOpcode::kMax:
+          RETURN_NOT_OK(EvalMax(partial_value, ql_value));
+          break;
+        case TSOpcode::kMin:
+          RETURN_NOT_OK(EvalMin(partial_value, ql_value));
+          break;
+        case TSOpcode::kSum: FALLTHROUGH_INTENDED;
+        case TSOpcode::kAvg:
+          RETURN_NOT_OK(EvalSum(partial_value,
+                                row_block->schema().column(column_index).type()->main(),
+                                ql_value));
+          break;
+        default:
+          return STATUS(RuntimeError, "Unexpected operator while evaluating aggregate expressions");
+      }
+      column_index++;
+    }
+  }
+
+  // Apply the LIMIT clause to the groups.
+  size_t group_count = groups.size();
+  if (pt_select->has_limit()) {
+    QLExpressionPB limit_pb;
+    RETURN_NOT_OK(PTExprToPB(pt_select->limit(), &limit_pb));
+    group_count = std::min<size_t>(group_count, limit_pb.value().int32_value());
+  }
+
+  faststring buffer;
+  CQLEncodeLength(group_count, &buffer);
+  for (size_t group_index = 0; group_index < group_count; group_index++) {
+    std::vector<QLValue>& group = groups[group_index];
+    int column_index = 0;
+    for (auto expr_node : selected_exprs) {
+      QLValue *ql_value = &group[column_index];
+      if (opcodes[column_index] == TSOpcode::kCount && ql_value->IsNull()) {
+        ql_value->set_int64_value(0);
+      } else if (opcodes[column_index] == TSOpcode::kAvg) {
+        QLValue avg_value;
+        RETURN_NOT_OK(EvalAvg(*ql_value, group[avg_count_index[column_index]],
+                              expr_node->ql_type()->main(), &avg_value));
+        *ql_value = avg_value;
+      }
+
+      // Serialize the return value.
+      ql_value->Serialize(expr_node->ql_type(), rows->client(), &buffer);
+      column_index++;
+    }
   }
 
   // Change the result set to the aggregate result.
-  std::static_pointer_cast<RowsResult>(result_)->set_rows_data(buffer.c_str(), buffer.size());
+  result_ = std::make_shared<RowsResult>(rows->table_name(), pt_select->selected_schemas(),
+                                         buffer.ToString());
   return Status::OK();
 }
 
-CHECKED_STATUS Executor::EvalCount(const shared_ptr<QLRowBlock>& row_block,
-                                   int column_index,
-                                   QLValue *ql_value) {
-  int64_t total_count = 0;
-  for (auto row : row_block->rows()) {
-    total_count += row.column(column_index).int64_value();
+CHECKED_STATUS Executor::EvalCount(const QLValue& partial_count, QLValue *ql_value) {
+  const int64_t count = partial_count.IsNull() ? 0 : partial_count.int64_value();
+  ql_value->set_int64_value((ql_value->IsNull() ? 0 : ql_value->int64_value()) + count);
+  return Status::OK();
+}
+
+CHECKED_STATUS Executor::EvalMax(const QLValue& partial_max, QLValue *ql_value) {
+  if (!partial_max.IsNull() && (ql_value->IsNull() || *ql_value < partial_max)) {
+    *ql_value = partial_max;
   }
-  ql_value->set_int64_value(total_count);
   return Status::OK();
 }
 
-CHECKED_STATUS Executor::EvalMax(const shared_ptr<QLRowBlock>& row_block,
-                                 int column_index,
-                                 QLValue *ql_value) {
-  for (auto row : row_block->rows()) {
-    if (ql_value->IsNull() ||
-        (!row.column(column_index).IsNull() && *ql_value < row.column(column_index))) {
-      *ql_value = row.column(column_index);
-    }
+CHECKED_STATUS Executor::EvalMin(const QLValue& partial_min, QLValue *ql_value) {
+  if (!partial_min.IsNull() && (ql_value->IsNull() || *ql_value > partial_min)) {
+    *ql_value = partial_min;
   }
   return Status::OK();
 }
 
-CHECKED_STATUS Executor::EvalMin(const shared_ptr<QLRowBlock>& row_block,
-                                 int column_index,
+CHECKED_STATUS Executor::EvalSum(const QLValue& partial_sum,
+                                 DataType data_type,
                                  QLValue *ql_value) {
-  for (auto row : row_block->rows()) {
-    if (ql_value->IsNull() ||
-        (!row.column(column_index).IsNull() && *ql_value > row.column(column_index))) {
-      *ql_value = row.column(column_index);
-    }
+  // CQL doesn't return overflow for sum.
+  if (partial_sum.IsNull()) {
+    return Status::OK();
+  }
+  if (ql_value->IsNull()) {
+    *ql_value = partial_sum;
+    return Status::OK();
+  }
+  switch (data_type) {
+    case DataType::INT8:
+      ql_value->set_int8_value(ql_value->int8_value() + partial_sum.int8_value());
+      break;
+    case DataType::INT16:
+      ql_value->set_int16_value(ql_value->int16_value() + partial_sum.int16_value());
+      break;
+    case DataType::INT32:
+      ql_value->set_int32_value(ql_value->int32_value() + partial_sum.int32_value());
+      break;
+    case DataType::INT64:
+      ql_value->set_int64_value(ql_value->int64_value() + partial_sum.int64_value());
+      break;
+    case DataType::VARINT:
+      ql_value->set_varint_value(ql_value->varint_value() + partial_sum.varint_value());
+      break;
+    case DataType::FLOAT:
+      ql_value->set_float_value(ql_value->float_value() + partial_sum.float_value());
+      break;
+    case DataType::DOUBLE:
+      ql_value->set_double_value(ql_value->double_value() + partial_sum.double_value());
+      break;
+    default:
+      return STATUS(RuntimeError, "Unexpected datatype for argument of SUM()");
   }
   return Status::OK();
 }
 
-CHECKED_STATUS Executor::EvalSum(const shared_ptr<QLRowBlock>& row_block,
-                                 int column_index,
+CHECKED_STATUS Executor::EvalAvg(const QLValue& sum,
+                                 const QLValue& count,
                                  DataType data_type,
                                  QLValue *ql_value) {
-  // CQL doesn't return overflow for sum.
-  for (auto row : row_block->rows()) {
-    if (row.column(column_index).IsNull()) {
-      continue;
-    }
-    if (ql_value->IsNull()) {
-      *ql_value = row.column(column_index);
-      continue;
-    }
-    switch (data_type) {
-      case DataType::INT8:
-        ql_value->set_int8_value(ql_value->int8_value() + row.column(column_index).int8_value());
-        break;
-      case DataType::INT16:
-        ql_value->set_int16_value(ql_value->int16_value() + row.column(column_index).int16_value());
-        break;
-      case DataType::INT32:
-        ql_value->set_int32_value(ql_value->int32_value() + row.column(column_index).int32_value());
-        break;
-      case DataType::INT64:
-        ql_value->set_int64_value(ql_value->int64_value() + row.column(column_index).int64_value());
-        break;
-      case DataType::VARINT:
-        ql_value->set_varint_value(ql_value->varint_value() +
-                                   row.column(column_index).varint_value());
-        break;
-      case DataType::FLOAT:
-        ql_value->set_float_value(ql_value->float_value() + row.column(column_index).float_value());
-        break;
-      case DataType::DOUBLE:
-        ql_value->set_double_value(ql_value->double_value() +
-                                   row.column(column_index).double_value());
-        break;
-      default:
-        return STATUS(RuntimeError, "Unexpected datatype for argument of SUM()");
-    }
+  // AVG() of no values is null.
+  if (sum.IsNull() || count.IsNull() || count.int64_value() == 0) {
+    ql_value->SetNull();
+    return Status::OK();
+  }
+  switch (data_type) {
+    case DataType::INT8:
+      ql_value->set_int8_value(sum.int64_value() / count.int64_value());
+      break;
+    case DataType::INT16:
+      ql_value->set_int16_value(sum.int64_value() / count.int64_value());
+      break;
+    case DataType::INT32:
+      ql_value->set_int32_value(sum.int64_value() / count.int64_value());
+      break;
+    case DataType::INT64:
+      ql_value->set_int64_value(sum.int64_value() / count.int64_value());
+      break;
+    case DataType::FLOAT:
+      ql_value->set_float_value(sum.double_value() / count.int64_value());
+      break;
+    case DataType::DOUBLE:
+      ql_value->set_double_value(sum.double_value() / count.int64_value());
+      break;
+    default:
+      return STATUS(RuntimeError, "Unexpected datatype for argument of AVG()");
   }
   return Status::OK();
 }
@@ -41,10 +41,7 @@ CHECKED_STATUS Executor::PTConstToPB(const PTExpr::SharedPtr& expr,
   }
 
   if (expr->expr_op() == ExprOperator::kBindVar) {
-    QLExpressionPB expr_pb;
-    RETURN_NOT_OK(PTExprToPB(static_cast<const PTBindVar*>(expr.get()), &expr_pb));
-    const_pb->Swap(expr_pb.mutable_value());
-    return Status::OK();
+    return PTExprToPB(static_cast<const PTBindVar*>(expr.get()), const_pb);
   }
 
   const PTExpr *const_pt = expr.get();
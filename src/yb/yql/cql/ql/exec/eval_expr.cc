@@ -84,6 +84,10 @@ Status Executor::PTExprToPB(const PTExpr::SharedPtr& expr, QLExpressionPB *expr_
 //--------------------------------------------------------------------------------------------------
 
 CHECKED_STATUS Executor::PTExprToPB(const PTBindVar *bind_pt, QLExpressionPB *expr_pb) {
+  return PTExprToPB(bind_pt, expr_pb->mutable_value());
+}
+
+CHECKED_STATUS Executor::PTExprToPB(const PTBindVar *bind_pt, QLValuePB *value_pb) {
   // TODO(neil) This error should be raised by CQL when it compares between bind variables and
   // bind arguments before calling QL layer to execute.
   if (exec_context_->params() == nullptr) {
@@ -95,7 +99,11 @@ CHECKED_STATUS Executor::PTExprToPB(const PTBindVar *bind_pt, QLExpressionPB *ex
                                                          bind_pt->pos(),
                                                          bind_pt->ql_type(),
                                                          &ql_bind));
-  expr_pb->mutable_value()->Swap(ql_bind.mutable_value());
+  value_pb->Swap(ql_bind.mutable_value());
+  // Remember where the value was placed if a request template is being built.
+  if (template_bind_values_ != nullptr) {
+    template_bind_values_->push_back({bind_pt, value_pb});
+  }
   return Status::OK();
 }
 
@@ -22,6 +22,14 @@
 #include "yb/util/decimal.h"
 #include "yb/common/common.pb.h"
 
+DEFINE_bool(cql_use_request_templates, true,
+            "Execute prepared INSERT and SELECT statements from a request template that is built "
+            "by their first execution, converting only the bind variables.");
+
+DEFINE_int32(cql_follower_read_max_staleness_ms, -1,
+             "Maximum staleness in milliseconds of reads at consistency level ONE, which may be "
+             "served by followers. Negative means no bound.");
+
 namespace yb {
 namespace ql {
 
@@ -42,6 +50,14 @@ using client::YBqlWriteOp;
 using client::YBqlWriteOpPtr;
 using strings::Substitute;
 
+namespace {
+
+bool IsBindVar(const PTExpr::SharedPtr& expr) {
+  return expr != nullptr && expr->expr_op() == ExprOperator::kBindVar;
+}
+
+} // namespace
+
 //--------------------------------------------------------------------------------------------------
 
 Executor::Executor(QLEnv *ql_env, const QLMetrics* ql_metrics)
@@ -547,43 +563,18 @@ Status Executor::ExecPTNode(const PTGrantPermission *tnode) {
 
 //--------------------------------------------------------------------------------------------------
 
-Status Executor::ExecPTNode(const PTSelectStmt *tnode) {
-  const shared_ptr<client::YBTable>& table = tnode->table();
-  if (table == nullptr) {
-    // If this is a system table but the table does not exist, it is okay. Just return OK with void
-    // result.
-    return tnode->is_system() ? Status::OK() : exec_context_->Error(ErrorCode::TABLE_NOT_FOUND);
-  }
-
-  const StatementParameters& params = *exec_context_->params();
-  // If there is a table id in the statement parameter's paging state, this is a continuation of
-  // a prior SELECT statement. Verify that the same table still exists.
-  const bool continue_select = !params.table_id().empty();
-  if (continue_select && params.table_id() != table->id()) {
-    return exec_context_->Error("Table no longer exists.", ErrorCode::TABLE_NOT_FOUND);
-  }
-
-  // Create the read request.
-  shared_ptr<YBqlReadOp> select_op(table->NewQLSelect());
-  QLReadRequestPB *req = select_op->mutable_request();
+Status Executor::SelectToPB(const PTSelectStmt *tnode, QLReadRequestPB *req, bool *no_results) {
   // Where clause - Hash, range, and regular columns.
-
-  bool no_results = false;
   req->set_is_aggregate(tnode->is_aggregate());
   Status st = WhereClauseToPB(req, tnode->key_where_ops(), tnode->where_ops(),
                               tnode->subscripted_col_where_ops(), tnode->partition_key_ops(),
-                              tnode->func_ops(), &no_results);
+                              tnode->func_ops(), no_results);
   if (PREDICT_FALSE(!st.ok())) {
     return exec_context_->Error(st, ErrorCode::INVALID_ARGUMENTS);
   }
 
-  // If where clause restrictions guarantee no rows could match, return empty result immediately.
-  if (no_results && !tnode->is_aggregate()) {
-    QLRowBlock empty_row_block(tnode->table()->InternalSchema(), {});
-    faststring buffer;
-    empty_row_block.Serialize(select_op->request().client(), &buffer);
-    *select_op->mutable_rows_data() = buffer.ToString();
-    result_ = std::make_shared<RowsResult>(select_op.get());
+  // If where clause restrictions guarantee no rows could match, the rest is not needed.
+  if (*no_results && !tnode->is_aggregate()) {
     return Status::OK();
   }
 
@@ -606,6 +597,12 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode) {
       expr->ql_type()->ToQLTypePB(rscol_desc_pb->mutable_ql_type());
     }
   }
+  if (tnode->is_aggregate()) {
+    st = AggregateExprsToPB(tnode, req);
+    if (PREDICT_FALSE(!st.ok())) {
+      return exec_context_->Error(st, ErrorCode::FEATURE_NOT_SUPPORTED);
+    }
+  }
 
   // Setup the column values that need to be read.
   st = ColumnRefsToPB(tnode, req->mutable_column_refs());
@@ -616,6 +613,65 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode) {
   // Specify distinct columns or non.
   req->set_distinct(tnode->distinct());
 
+  return Status::OK();
+}
+
+//--------------------------------------------------------------------------------------------------
+
+Status Executor::ExecPTNode(const PTSelectStmt *tnode) {
+  const shared_ptr<client::YBTable>& table = tnode->table();
+  if (table == nullptr) {
+    // If this is a system table but the table does not exist, it is okay. Just return OK with void
+    // result.
+    return tnode->is_system() ? Status::OK() : exec_context_->Error(ErrorCode::TABLE_NOT_FOUND);
+  }
+
+  const StatementParameters& params = *exec_context_->params();
+  // If there is a table id in the statement parameter's paging state, this is a continuation of
+  // a prior SELECT statement. Verify that the same table still exists.
+  const bool continue_select = !params.table_id().empty();
+  if (continue_select && params.table_id() != table->id()) {
+    return exec_context_->Error("Table no longer exists.", ErrorCode::TABLE_NOT_FOUND);
+  }
+
+  // Create the read request.
+  shared_ptr<YBqlReadOp> select_op(table->NewQLSelect());
+  QLReadRequestPB *req = select_op->mutable_request();
+  Status st;
+
+  const auto request_template = tnode->request_template();
+  if (request_template != nullptr) {
+    st = request_template->Apply(params, req);
+    if (PREDICT_FALSE(!st.ok())) {
+      return exec_context_->Error(st, ErrorCode::INVALID_ARGUMENTS);
+    }
+  } else {
+    // The partitions to read are computed by the proxy from the partition key conditions and the
+    // 'IN' conditions on hash columns, so the request depends on the values of such conditions.
+    bool use_template = tnode->partition_key_ops().empty();
+    for (const auto& op : tnode->key_where_ops()) {
+      use_template = use_template && op.yb_op() != QL_OP_IN;
+    }
+    use_template = use_template && StartRequestTemplate(tnode, *req);
+
+    bool no_results = false;
+    RETURN_NOT_OK(SelectToPB(tnode, req, &no_results));
+
+    // If where clause restrictions guarantee no rows could match, return empty result immediately.
+    if (no_results && !tnode->is_aggregate()) {
+      QLRowBlock empty_row_block(tnode->table()->InternalSchema(), {});
+      faststring buffer;
+      empty_row_block.Serialize(select_op->request().client(), &buffer);
+      *select_op->mutable_rows_data() = buffer.ToString();
+      result_ = std::make_shared<RowsResult>(select_op.get());
+      return Status::OK();
+    }
+
+    if (use_template) {
+      FinishRequestTemplate(tnode, *req);
+    }
+  }
+
   // Default row count limit is the page size.
   // We should return paging state when page size limit is hit.
   req->set_limit(params.page_size());
@@ -671,6 +727,11 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode) {
     select_op->set_yb_consistency_level(YBConsistencyLevel::STRONG);
   } else {
     select_op->set_yb_consistency_level(params.yb_consistency_level());
+    if (params.yb_consistency_level() == YBConsistencyLevel::CONSISTENT_PREFIX &&
+        FLAGS_cql_follower_read_max_staleness_ms >= 0) {
+      select_op->set_max_staleness(
+          MonoDelta::FromMilliseconds(FLAGS_cql_follower_read_max_staleness_ms));
+    }
   }
 
   // If we have several hash partitions (i.e. IN condition on hash columns) we initialize the
@@ -743,8 +804,9 @@ Status Executor::FetchMoreRowsIfNeeded() {
     op->mutable_request()->clear_max_hash_code();
   }
 
-  // If we reached the fetch limit (min of paging state and limit clause) we are done.
-  if (current_fetch_row_count >= fetch_limit) {
+  // If we reached the fetch limit (min of paging state and limit clause) we are done. Aggregate
+  // reads return partial aggregates, so they continue until all partitions are read.
+  if (current_fetch_row_count >= fetch_limit && !tnode->is_aggregate()) {
 
     // If we reached the paging limit at the end of the previous partition for a multi-partition
     // select the next fetch should continue directly from the current partition.
@@ -764,7 +826,9 @@ Status Executor::FetchMoreRowsIfNeeded() {
   // Fetch more results.
 
   // Update limit and paging_state information for next scan request.
-  op->mutable_request()->set_limit(fetch_limit - current_fetch_row_count);
+  if (!tnode->is_aggregate()) {
+    op->mutable_request()->set_limit(fetch_limit - current_fetch_row_count);
+  }
   QLPagingStatePB *paging_state = op->mutable_request()->mutable_paging_state();
   paging_state->set_next_partition_key(current_params.next_partition_key());
   paging_state->set_next_row_key(current_params.next_row_key());
@@ -782,6 +846,29 @@ Status Executor::ExecPTNode(const PTInsertStmt *tnode) {
   shared_ptr<YBqlWriteOp> insert_op(table->NewQLInsert());
   QLWriteRequestPB *req = insert_op->mutable_request();
 
+  const auto request_template = tnode->request_template();
+  if (request_template != nullptr) {
+    Status s = request_template->Apply(*exec_context_->params(), req);
+    if (PREDICT_FALSE(!s.ok())) {
+      return exec_context_->Error(s, ErrorCode::INVALID_ARGUMENTS);
+    }
+    // Null values not allowed for primary key, see ColumnArgsToPB.
+    for (const auto* key_values : { &req->hashed_column_values(), &req->range_column_values() }) {
+      for (const auto& expr_pb : *key_values) {
+        if (expr_pb.has_value() && IsNull(expr_pb.value())) {
+          return exec_context_->Error(ErrorCode::NULL_ARGUMENT_FOR_PRIMARY_KEY);
+        }
+      }
+    }
+    return ApplyWriteOp(tnode, insert_op);
+  }
+
+  // TTL and timestamp are converted to numbers by the proxy, so the request depends on their
+  // values when they are bind variables.
+  const bool use_template =
+      !IsBindVar(tnode->ttl_seconds()) && !IsBindVar(tnode->user_timestamp_usec()) &&
+      StartRequestTemplate(tnode, *req);
+
   // Set the ttl.
   Status s = TtlToPB(tnode, req);
   if (PREDICT_FALSE(!s.ok())) {
@@ -814,6 +901,10 @@ Status Executor::ExecPTNode(const PTInsertStmt *tnode) {
     }
   }
 
+  if (use_template) {
+    FinishRequestTemplate(tnode, *req);
+  }
+
   // Apply the operation.
   return ApplyWriteOp(tnode, insert_op);
 }
@@ -1048,6 +1139,40 @@ Status Executor::ApplyWriteOp(const TreeNode *tnode, const YBqlWriteOpPtr& op) {
 
 //--------------------------------------------------------------------------------------------------
 
+bool Executor::StartRequestTemplate(const PTDmlStmt *tnode,
+                                    const google::protobuf::Message& initial) {
+  template_bind_values_.reset();
+  template_initial_request_.reset();
+  if (!FLAGS_cql_use_request_templates || tnode->bind_variables().empty() ||
+      tnode->request_template_tried() || exec_context_->params() == nullptr) {
+    return false;
+  }
+  template_initial_request_.reset(initial.New());
+  template_initial_request_->CopyFrom(initial);
+  template_bind_values_.reset(new QLRequestTemplate::BindValues());
+  return true;
+}
+
+void Executor::FinishRequestTemplate(const PTDmlStmt *tnode,
+                                     const google::protobuf::Message& request) {
+  if (template_bind_values_ == nullptr) {
+    return;
+  }
+  // All bind variables should be converted into the request, otherwise some were evaluated.
+  if (template_bind_values_->size() == tnode->bind_variables().size()) {
+    auto request_template = QLRequestTemplate::Create(
+        *template_initial_request_, request, *template_bind_values_);
+    VLOG(3) << "Request template " << (request_template ? "built" : "not supported")
+            << " for " << tnode->table_name().ToString();
+    tnode->set_request_template(std::move(request_template));
+  }
+  tnode->set_request_template_tried();
+  template_bind_values_.reset();
+  template_initial_request_.reset();
+}
+
+//--------------------------------------------------------------------------------------------------
+
 void Executor::CommitDone(const Status &s) {
   StatementExecuted(s);
 }
@@ -1174,6 +1299,8 @@ void Executor::Reset() {
   batched_write_ops_.clear();
   result_ = nullptr;
   cb_.Reset();
+  template_bind_values_.reset();
+  template_initial_request_.reset();
 }
 
 }  // namespace ql
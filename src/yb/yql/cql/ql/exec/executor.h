@@ -24,6 +24,7 @@
 #include "yb/common/partial_row.h"
 #include "yb/common/common.pb.h"
 #include "yb/yql/cql/ql/exec/exec_context.h"
+#include "yb/yql/cql/ql/exec/request_template.h"
 #include "yb/yql/cql/ql/ptree/pt_create_keyspace.h"
 #include "yb/yql/cql/ql/ptree/pt_use_keyspace.h"
 #include "yb/yql/cql/ql/ptree/pt_create_table.h"
@@ -110,6 +111,9 @@ class Executor : public QLExprExecutor {
   // Select statement.
   CHECKED_STATUS ExecPTNode(const PTSelectStmt *tnode);
 
+  // Convert the select statement, except the parts that depend on the paging state, to protobuf.
+  CHECKED_STATUS SelectToPB(const PTSelectStmt *tnode, QLReadRequestPB *req, bool *no_results);
+
   // Select statement.
   CHECKED_STATUS ExecPTNode(const PTGrantPermission *tnode);
 
@@ -164,20 +168,21 @@ class Executor : public QLExprExecutor {
   // Continue a multi-partition select (e.g. table scan or query with 'IN' condition on hash cols).
   CHECKED_STATUS FetchMoreRowsIfNeeded();
 
+  // Add the expressions that tablet servers compute in addition to the selected aggregates, i.e.
+  // the counts for AVG() and the GROUP BY columns, to the read request.
+  CHECKED_STATUS AggregateExprsToPB(const PTSelectStmt *tnode, QLReadRequestPB *req);
+
   // Aggregate all result sets from all tablet servers to form the requested resultset.
   CHECKED_STATUS AggregateResultSets();
-  CHECKED_STATUS EvalCount(const std::shared_ptr<QLRowBlock>& row_block,
-                           int column_index,
-                           QLValue *ql_value);
-  CHECKED_STATUS EvalMax(const std::shared_ptr<QLRowBlock>& row_block,
-                         int column_index,
-                         QLValue *ql_value);
-  CHECKED_STATUS EvalMin(const std::shared_ptr<QLRowBlock>& row_block,
-                         int column_index,
-                         QLValue *ql_value);
-  CHECKED_STATUS EvalSum(const std::shared_ptr<QLRowBlock>& row_block,
-                         int column_index,
-                         DataType data_type,
+
+  // Merge a partial aggregate value returned by a tablet server into the aggregate value.
+  CHECKED_STATUS EvalCount(const QLValue& partial_count, QLValue *ql_value);
+  CHECKED_STATUS EvalMax(const QLValue& partial_max, QLValue *ql_value);
+  CHECKED_STATUS EvalMin(const QLValue& partial_min, QLValue *ql_value);
+  CHECKED_STATUS EvalSum(const QLValue& partial_sum, DataType data_type, QLValue *ql_value);
+
+  // Compute AVG() of the given type from the merged sum and count.
+  CHECKED_STATUS EvalAvg(const QLValue& sum, const QLValue& count, DataType data_type,
                          QLValue *ql_value);
 
   // Reset execution state.
@@ -205,6 +210,7 @@ class Executor : public QLExprExecutor {
 
   // Bind variable.
   CHECKED_STATUS PTExprToPB(const PTBindVar *bind_pt, QLExpressionPB *bind_pb);
+  CHECKED_STATUS PTExprToPB(const PTBindVar *bind_pt, QLValuePB *value_pb);
 
   // Column types.
   CHECKED_STATUS PTExprToPB(const PTRef *ref_pt, QLExpressionPB *ref_pb);
@@ -280,6 +286,16 @@ class Executor : public QLExprExecutor {
   //------------------------------------------------------------------------------------------------
   CHECKED_STATUS ApplyWriteOp(const TreeNode *tnode, const client::YBqlWriteOpPtr& op);
 
+  //------------------------------------------------------------------------------------------------
+  // Request templates of prepared statements.
+
+  // Start recording the bind values of the request being built for the statement, if a request
+  // template should be built for it. 'initial' is the request before the statement is converted.
+  bool StartRequestTemplate(const PTDmlStmt *tnode, const google::protobuf::Message& initial);
+
+  // Build the request template of the statement from the request, if recording was started.
+  void FinishRequestTemplate(const PTDmlStmt *tnode, const google::protobuf::Message& request);
+
   //------------------------------------------------------------------------------------------------
   // Environment (YBClient) for executing statements.
   QLEnv *ql_env_;
@@ -307,6 +323,11 @@ class Executor : public QLExprExecutor {
 
   // FlushAsync callback.
   Callback<void(const Status&)> flush_async_cb_;
+
+  // Initial request and bind values recorded while building a request template, null when not
+  // recording.
+  std::unique_ptr<google::protobuf::Message> template_initial_request_;
+  std::unique_ptr<QLRequestTemplate::BindValues> template_bind_values_;
 };
 
 }  // namespace ql
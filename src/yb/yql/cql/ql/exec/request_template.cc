@@ -0,0 +1,125 @@
+//--------------------------------------------------------------------------------------------------
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "yb/yql/cql/ql/exec/request_template.h"
+
+#include <unordered_map>
+
+#include "yb/common/ql_value.h"
+#include "yb/yql/cql/ql/ptree/pt_expr.h"
+#include "yb/yql/cql/ql/util/statement_params.h"
+
+namespace yb {
+namespace ql {
+
+using google::protobuf::FieldDescriptor;
+using google::protobuf::Message;
+using google::protobuf::Reflection;
+
+namespace {
+
+typedef std::unordered_map<const Message*, size_t> ValueIndexes;
+
+// Finds paths to the messages in 'indexes' among the submessages of 'message'.
+template <class PathStep>
+void FindPaths(const Message& message, const ValueIndexes& indexes,
+               std::vector<PathStep>* path, std::vector<std::vector<PathStep>>* paths) {
+  const Reflection* reflection = message.GetReflection();
+  std::vector<const FieldDescriptor*> fields;
+  reflection->ListFields(message, &fields);
+  for (const FieldDescriptor* field : fields) {
+    if (field->cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE) {
+      continue;
+    }
+    const int size = field->is_repeated() ? reflection->FieldSize(message, field) : 1;
+    for (int i = 0; i != size; ++i) {
+      const Message& submessage = field->is_repeated()
+          ? reflection->GetRepeatedMessage(message, field, i)
+          : reflection->GetMessage(message, field);
+      path->push_back({field, field->is_repeated() ? i : -1});
+      auto it = indexes.find(&submessage);
+      if (it != indexes.end()) {
+        (*paths)[it->second] = *path;
+      }
+      FindPaths(submessage, indexes, path, paths);
+      path->pop_back();
+    }
+  }
+}
+
+} // namespace
+
+QLRequestTemplate::SharedPtr QLRequestTemplate::Create(const Message& initial,
+                                                       const Message& request,
+                                                       const BindValues& bind_values) {
+  ValueIndexes indexes;
+  for (size_t i = 0; i != bind_values.size(); ++i) {
+    indexes.emplace(bind_values[i].value, i);
+  }
+  if (indexes.size() != bind_values.size()) {
+    return nullptr;
+  }
+
+  std::vector<std::vector<PathStep>> paths(bind_values.size());
+  std::vector<PathStep> path;
+  FindPaths(request, indexes, &path, &paths);
+
+  std::vector<const FieldDescriptor*> initial_fields;
+  initial.GetReflection()->ListFields(initial, &initial_fields);
+
+  std::shared_ptr<QLRequestTemplate> result(new QLRequestTemplate());
+  for (size_t i = 0; i != bind_values.size(); ++i) {
+    if (paths[i].empty()) {
+      // The value was used by the proxy, e.g. to compute the partitions to read.
+      return nullptr;
+    }
+    for (const auto* field : initial_fields) {
+      if (paths[i].front().field == field) {
+        return nullptr;
+      }
+    }
+    result->slots_.push_back({bind_values[i].bind_var, std::move(paths[i])});
+  }
+
+  result->request_.reset(request.New());
+  result->request_->CopyFrom(request);
+  for (const auto* field : initial_fields) {
+    result->request_->GetReflection()->ClearField(result->request_.get(), field);
+  }
+  return result;
+}
+
+Status QLRequestTemplate::Apply(const StatementParameters& params, Message* request) const {
+  request->MergeFrom(*request_);
+  for (const auto& slot : slots_) {
+    Message* message = request;
+    for (const auto& step : slot.path) {
+      const Reflection* reflection = message->GetReflection();
+      message = step.index < 0
+          ? reflection->MutableMessage(message, step.field)
+          : reflection->MutableRepeatedMessage(message, step.field, step.index);
+    }
+    QLValue value;
+    RETURN_NOT_OK(params.GetBindVariable(slot.bind_var->name()->c_str(),
+                                         slot.bind_var->pos(),
+                                         slot.bind_var->ql_type(),
+                                         &value));
+    static_cast<QLValuePB*>(message)->Swap(value.mutable_value());
+  }
+  return Status::OK();
+}
+
+}  // namespace ql
+}  // namespace yb
@@ -0,0 +1,83 @@
+//--------------------------------------------------------------------------------------------------
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+// Request template of a prepared DML statement. The read or write request of the statement is
+// built from the parse tree on its first execution, and the positions of the bind variable values
+// in the request are recorded. Later executions copy the template and only fill in the values of
+// the bind variables, instead of walking the parse tree and converting every expression again.
+//--------------------------------------------------------------------------------------------------
+
+#ifndef YB_YQL_CQL_QL_EXEC_REQUEST_TEMPLATE_H_
+#define YB_YQL_CQL_QL_EXEC_REQUEST_TEMPLATE_H_
+
+#include <memory>
+#include <vector>
+
+#include <google/protobuf/message.h>
+
+#include "yb/common/ql_protocol.pb.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace ql {
+
+class PTBindVar;
+class StatementParameters;
+
+class QLRequestTemplate {
+ public:
+  typedef std::shared_ptr<const QLRequestTemplate> SharedPtr;
+
+  // A bind variable and the value it was converted to while building the request.
+  struct BindValue {
+    const PTBindVar* bind_var;
+    const QLValuePB* value;
+  };
+  typedef std::vector<BindValue> BindValues;
+
+  // Creates the template from a request built by an execution of the statement. 'initial' is the
+  // request as it was created by the op, before the statement was converted into it. Fields that
+  // are set in it identify the op and are not part of the template. Returns nullptr if some of the
+  // bind values are not found in the request, i.e. the request depends on their values.
+  static SharedPtr Create(const google::protobuf::Message& initial,
+                          const google::protobuf::Message& request,
+                          const BindValues& bind_values);
+
+  // Fills a request created by a new op from the template and the given bind variables.
+  CHECKED_STATUS Apply(const StatementParameters& params,
+                       google::protobuf::Message* request) const;
+
+ private:
+  // Step of the path from the request to a bind value: a field, and the index of the element
+  // for repeated fields.
+  struct PathStep {
+    const google::protobuf::FieldDescriptor* field;
+    int index;
+  };
+
+  struct BindSlot {
+    const PTBindVar* bind_var;
+    std::vector<PathStep> path;
+  };
+
+  QLRequestTemplate() {}
+
+  std::unique_ptr<google::protobuf::Message> request_;
+  std::vector<BindSlot> slots_;
+};
+
+}  // namespace ql
+}  // namespace yb
+
+#endif  // YB_YQL_CQL_QL_EXEC_REQUEST_TEMPLATE_H_
@@ -18,6 +18,9 @@
 #ifndef YB_YQL_CQL_QL_PTREE_PT_DML_H_
 #define YB_YQL_CQL_QL_PTREE_PT_DML_H_
 
+#include <atomic>
+#include <memory>
+
 #include "yb/yql/cql/ql/ptree/column_desc.h"
 #include "yb/yql/cql/ql/ptree/list_node.h"
 #include "yb/yql/cql/ql/ptree/tree_node.h"
@@ -30,6 +33,8 @@
 namespace yb {
 namespace ql {
 
+class QLRequestTemplate;
+
 //--------------------------------------------------------------------------------------------------
 // Counter of operators on each column. "gt" includes ">" and ">=". "lt" includes "<" and "<=".
 class ColumnOpCounter {
@@ -312,6 +317,23 @@ class PTDmlStmt : public PTCollection {
   }
 
 
+  // Request template built by the first execution of the prepared statement. It is shared by
+  // concurrent executions, so it is accessed atomically.
+  std::shared_ptr<const QLRequestTemplate> request_template() const {
+    return std::atomic_load(&request_template_);
+  }
+  void set_request_template(std::shared_ptr<const QLRequestTemplate> request_template) const {
+    std::atomic_store(&request_template_, std::move(request_template));
+  }
+
+  // Whether building of the request template was already tried.
+  bool request_template_tried() const {
+    return request_template_tried_.load(std::memory_order_acquire);
+  }
+  void set_request_template_tried() const {
+    request_template_tried_.store(true, std::memory_order_release);
+  }
+
   bool IsWriteOp() {
     return opcode() == TreeNodeOpcode::kPTInsertStmt ||
            opcode() == TreeNodeOpcode::kPTUpdateStmt ||
@@ -384,6 +406,10 @@ class PTDmlStmt : public PTCollection {
   //       We prepare this vector once at compile time and use it at execution times.
   std::shared_ptr<vector<ColumnSchema>> selected_schemas_;
 
+  // Execution decorates the statement with the request template (see request_template.h).
+  mutable std::shared_ptr<const QLRequestTemplate> request_template_;
+  mutable std::atomic<bool> request_template_tried_{false};
+
   static const PTExpr::SharedPtr kNullPointerRef;
 };
 
@@ -82,7 +82,8 @@ PTSelectStmt::PTSelectStmt(MemoryContext *memctx,
       group_by_clause_(group_by_clause),
       having_clause_(having_clause),
       order_by_clause_(order_by_clause),
-      limit_clause_(limit_clause) {
+      limit_clause_(limit_clause),
+      group_by_columns_(memctx) {
 }
 
 PTSelectStmt::~PTSelectStmt() {
@@ -117,22 +118,8 @@ CHECKED_STATUS PTSelectStmt::Analyze(SemContext *sem_context) {
   }
 
   // Check if this is an aggregate read.
-  bool has_aggregate_expr = false;
-  bool has_singular_expr = false;
-  for (auto expr_node : selected_exprs_->node_list()) {
-    if (expr_node->IsAggregateCall()) {
-      has_aggregate_expr = true;
-    } else {
-      has_singular_expr = true;
-    }
-  }
-  if (has_aggregate_expr && has_singular_expr) {
-    return sem_context->Error(
-        selected_exprs_,
-        "Selecting aggregate together with rows of non-aggregate values is not allowed",
-        ErrorCode::CQL_STATEMENT_INVALID);
-  }
-  is_aggregate_ = has_aggregate_expr;
+  RETURN_NOT_OK(AnalyzeGroupByClause(sem_context));
+  RETURN_NOT_OK(AnalyzeAggregateExprs(sem_context));
 
   // Run error checking on the WHERE conditions.
   RETURN_NOT_OK(AnalyzeWhereClause(sem_context, where_clause_));
@@ -161,7 +148,8 @@ void PTSelectStmt::PrintSemanticAnalysisResult(SemContext *sem_context) {
 // Updates use_index_, index_id_ and read_just_index_ fields properly.
 CHECKED_STATUS PTSelectStmt::AnalyzeIndexes(SemContext *sem_context) {
 
-  if (table_->index_map().empty()) {
+  // Groups are formed by the primary key of the indexed table, so GROUP BY reads it directly.
+  if (table_->index_map().empty() || !group_by_columns_.empty()) {
     use_index_ = false;
     return Status::OK();
   }
@@ -193,6 +181,80 @@ CHECKED_STATUS PTSelectStmt::AnalyzeIndexes(SemContext *sem_context) {
   return Status::OK();
 }
 
+CHECKED_STATUS PTSelectStmt::AnalyzeGroupByClause(SemContext *sem_context) {
+  if (group_by_clause_ == nullptr) {
+    return Status::OK();
+  }
+  if (distinct_) {
+    return sem_context->Error(group_by_clause_, "GROUP BY cannot be used with DISTINCT",
+                              ErrorCode::CQL_STATEMENT_INVALID);
+  }
+
+  // Rows are grouped on the tablet servers, so only groups of whole partitions or of a prefix of
+  // clustering columns within a partition are supported. Rows of such a group are adjacent in
+  // DocDB and are never split between tablets.
+  SemState sem_state(sem_context);
+  for (const auto& item : group_by_clause_->node_list()) {
+    RETURN_NOT_OK(item->Analyze(sem_context));
+    const ColumnDesc *col_desc = nullptr;
+    if (item->opcode() == TreeNodeOpcode::kPTRef) {
+      col_desc = static_cast<const PTRef*>(item.get())->desc();
+    }
+    const size_t index = group_by_columns_.size();
+    if (col_desc == nullptr || !col_desc->is_primary() || col_desc->index() != index) {
+      return sem_context->Error(
+          item, "GROUP BY only supports primary key columns in the primary key order",
+          ErrorCode::CQL_STATEMENT_INVALID);
+    }
+    AddColumnRef(*col_desc);
+    group_by_columns_.push_back(col_desc);
+  }
+  if (group_by_columns_.size() < num_hash_key_columns_) {
+    return sem_context->Error(group_by_clause_,
+                              "GROUP BY must include all partition key columns",
+                              ErrorCode::CQL_STATEMENT_INVALID);
+  }
+  return Status::OK();
+}
+
+CHECKED_STATUS PTSelectStmt::AnalyzeAggregateExprs(SemContext *sem_context) {
+  bool has_aggregate_expr = false;
+  bool has_singular_expr = false;
+  for (auto expr_node : selected_exprs_->node_list()) {
+    if (expr_node->IsAggregateCall()) {
+      has_aggregate_expr = true;
+      continue;
+    }
+
+    // With GROUP BY, the grouped columns could be selected together with aggregates.
+    PTExpr::SharedPtr expr = expr_node;
+    if (expr->expr_op() == ExprOperator::kAlias) {
+      expr = expr->op1();
+    }
+    bool is_group_by_column = false;
+    if (expr->opcode() == TreeNodeOpcode::kPTRef) {
+      const ColumnDesc *col_desc = static_cast<const PTRef*>(expr.get())->desc();
+      is_group_by_column = std::find(group_by_columns_.begin(), group_by_columns_.end(),
+                                     col_desc) != group_by_columns_.end();
+    }
+    if (!is_group_by_column) {
+      has_singular_expr = true;
+    }
+  }
+  if (has_aggregate_expr && has_singular_expr) {
+    return sem_context->Error(
+        selected_exprs_,
+        "Selecting aggregate together with rows of non-aggregate values is not allowed",
+        ErrorCode::CQL_STATEMENT_INVALID);
+  }
+  if (!has_aggregate_expr && !group_by_columns_.empty()) {
+    return sem_context->Error(group_by_clause_, "GROUP BY is only supported with aggregates",
+                              ErrorCode::FEATURE_NOT_SUPPORTED);
+  }
+  is_aggregate_ = has_aggregate_expr;
+  return Status::OK();
+}
+
 CHECKED_STATUS PTSelectStmt::AnalyzeDistinctClause(SemContext *sem_context) {
   // Only partition and static columns are allowed to be used with distinct clause.
   int key_count = 0;
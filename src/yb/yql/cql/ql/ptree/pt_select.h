@@ -246,6 +246,12 @@ class PTSelectStmt : public PTDmlStmt {
     return is_aggregate_;
   }
 
+  // Columns of the GROUP BY clause in the clause order, i.e. the partition key columns followed by
+  // a prefix of the clustering columns.
+  const MCVector<const ColumnDesc*>& group_by_columns() const {
+    return group_by_columns_;
+  }
+
   bool use_index() const {
     return use_index_;
   }
@@ -262,6 +268,8 @@ class PTSelectStmt : public PTDmlStmt {
 
   CHECKED_STATUS AnalyzeIndexes(SemContext *sem_context);
   CHECKED_STATUS AnalyzeDistinctClause(SemContext *sem_context);
+  CHECKED_STATUS AnalyzeGroupByClause(SemContext *sem_context);
+  CHECKED_STATUS AnalyzeAggregateExprs(SemContext *sem_context);
   CHECKED_STATUS AnalyzeOrderByClause(SemContext *sem_context);
   CHECKED_STATUS AnalyzeLimitClause(SemContext *sem_context);
   CHECKED_STATUS ConstructSelectedSchema();
@@ -284,6 +292,7 @@ class PTSelectStmt : public PTDmlStmt {
   PTOrderByListNode::SharedPtr order_by_clause_;
   PTExpr::SharedPtr limit_clause_;
   bool is_aggregate_ = false;
+  MCVector<const ColumnDesc*> group_by_columns_;
   bool use_index_ = false;
   bool read_just_index_ = false;
   TableId index_id_;
@@ -28,6 +28,7 @@ using client::YBColumnSchema;
 // scanner phase and as a result if we're doing string matching everything should be lowercase.
 const std::map<std::string, PTTableProperty::KVProperty> PTTableProperty::kPropertyDataTypes
     = {
+    {"bloom_filter_clustering_columns", KVProperty::kBloomFilterClusteringColumns},
     {"bloom_filter_fp_chance", KVProperty::kBloomFilterFpChance},
     {"caching", KVProperty::kCaching},
     {"comment", KVProperty::kComment},
@@ -155,6 +156,26 @@ CHECKED_STATUS PTTableProperty::Analyze(SemContext *sem_context) {
   string str_val;
 
   switch (iterator->second) {
+    case KVProperty::kBloomFilterClusteringColumns: {
+      // Bloom filters of the existing SST files can't be changed, so this property is only
+      // accepted when a table is created.
+      if (sem_context->current_alter_table() != nullptr) {
+        return sem_context->Error(this,
+                                  Substitute("Property '$0' cannot be altered",
+                                             table_property_name).c_str(),
+                                  ErrorCode::INVALID_TABLE_PROPERTY);
+      }
+      RETURN_SEM_CONTEXT_ERROR_NOT_OK(GetIntValueFromExpr(rhs_, table_property_name, &int_val));
+      const auto num_clustering_columns =
+          sem_context->current_create_table_stmt()->primary_columns().size();
+      if (int_val < 0 || int_val > static_cast<int64_t>(num_clustering_columns)) {
+        return sem_context->Error(this,
+            Substitute("$0 must be between 0 and the number of clustering columns $1 (got $2)",
+                       table_property_name, num_clustering_columns, int_val).c_str(),
+            ErrorCode::INVALID_ARGUMENTS);
+      }
+      break;
+    }
     case KVProperty::kBloomFilterFpChance:
       RETURN_SEM_CONTEXT_ERROR_NOT_OK(GetDoubleValueFromExpr(rhs_, table_property_name,
                                                              &double_val));
@@ -366,6 +387,15 @@ Status PTTableProperty::SetTableProperty(yb::TableProperties *table_property) co
       table_property->SetDefaultTimeToLive(val * MonoTime::kMillisecondsPerSecond);
       break;
     }
+    case KVProperty::kBloomFilterClusteringColumns: {
+      int64_t val;
+      if (!GetIntValueFromExpr(rhs_, table_property_name, &val).ok()) {
+        return STATUS(InvalidArgument,
+                      Substitute("Invalid value for bloom_filter_clustering_columns"));
+      }
+      table_property->SetNumBloomFilterRangeComponents(static_cast<uint32_t>(val));
+      break;
+    }
     case KVProperty::kBloomFilterFpChance: FALLTHROUGH_INTENDED;
     case KVProperty::kComment: FALLTHROUGH_INTENDED;
     case KVProperty::kCrcCheckChance: FALLTHROUGH_INTENDED;
@@ -38,6 +38,7 @@ enum class PropertyType : int {
 class PTTableProperty : public PTProperty {
  public:
   enum class KVProperty : int {
+    kBloomFilterClusteringColumns,
     kBloomFilterFpChance,
     kCaching,
     kComment,
@@ -181,6 +181,35 @@ TEST_F(TestQLCreateTable, TestQLCreateTableWithTTL) {
   EXPECT_EQ(1000, properties_pb.default_time_to_live());
 }
 
+TEST_F(TestQLCreateTable, TestQLCreateTableWithBloomFilterClusteringColumns) {
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster());
+
+  // Get an available processor.
+  TestQLProcessor *processor = GetQLProcessor();
+
+  EXEC_VALID_STMT("CREATE TABLE wide_partition (h int, r1 int, r2 int, v int, "
+                      "PRIMARY KEY((h), r1, r2)) WITH bloom_filter_clustering_columns = 1;");
+  EXEC_INVALID_STMT("CREATE TABLE too_many_columns (h int, r int, v int, "
+                        "PRIMARY KEY((h), r)) WITH bloom_filter_clustering_columns = 2;");
+  EXEC_INVALID_STMT("CREATE TABLE negative_columns (h int, r int, v int, "
+                        "PRIMARY KEY((h), r)) WITH bloom_filter_clustering_columns = -1;");
+  EXEC_INVALID_STMT("ALTER TABLE wide_partition WITH bloom_filter_clustering_columns = 2;");
+
+  // Query the table schema.
+  master::Master *master = cluster_->mini_master()->master();
+  master::CatalogManager *catalog_manager = master->catalog_manager();
+  master::GetTableSchemaRequestPB request_pb;
+  master::GetTableSchemaResponsePB response_pb;
+  request_pb.mutable_table()->mutable_namespace_()->set_name(kDefaultKeyspaceName);
+  request_pb.mutable_table()->set_table_name("wide_partition");
+
+  // Verify the property was stored in syscatalog table.
+  CHECK_OK(catalog_manager->GetTableSchema(&request_pb, &response_pb));
+  const TablePropertiesPB& properties_pb = response_pb.schema().table_properties();
+  EXPECT_EQ(1, properties_pb.num_bloom_filter_range_components());
+}
+
 TEST_F(TestQLCreateTable, TestQLCreateTableWithClusteringOrderBy) {
   // Init the simulated cluster.
   ASSERT_NO_FATALS(CreateSimulatedCluster());
@@ -302,6 +302,108 @@ TEST_F(QLTestSelectedExpr, TestAggregateExpr) {
     CHECK_GT(sum_all_row.column(5).double_value(), v6_min - 0.1);
     CHECK_LT(sum_all_row.column(5).double_value(), v6_min + 0.1);
   }
+
+  //------------------------------------------------------------------------------------------------
+  // Test AVG() aggregate functions.
+  {
+    // Test AVG() - Not exist.
+    CHECK_VALID_STMT("SELECT avg(v1), avg(v2), avg(v3), avg(v4), avg(v5), avg(v6)"
+                     "  FROM test_aggr_expr WHERE h = 1 AND r = 1;");
+    row_block = processor->row_block();
+    CHECK_EQ(row_block->row_count(), 1);
+    const QLRow& avg_0_row = row_block->row(0);
+    CHECK(avg_0_row.column(0).IsNull());
+    CHECK(avg_0_row.column(1).IsNull());
+    CHECK(avg_0_row.column(2).IsNull());
+    CHECK(avg_0_row.column(3).IsNull());
+    CHECK(avg_0_row.column(4).IsNull());
+    CHECK(avg_0_row.column(5).IsNull());
+
+    // Test AVG() - Where condition provides full hash key.
+    CHECK_VALID_STMT("SELECT avg(v1), avg(v2), avg(v3), avg(v4), avg(v5), avg(v6)"
+                     "  FROM test_aggr_expr WHERE h = 1;");
+    row_block = processor->row_block();
+    CHECK_EQ(row_block->row_count(), 1);
+    const QLRow& avg_1_row = row_block->row(0);
+    CHECK_EQ(avg_1_row.column(0).int64_value(), 506);
+    CHECK_EQ(avg_1_row.column(1).int32_value(), 56);
+    CHECK_EQ(avg_1_row.column(2).int16_value(), 12);
+    CHECK_EQ(avg_1_row.column(3).int8_value(), 7);
+    // Comparing floating point for 46.885
+    CHECK_GT(avg_1_row.column(4).float_value(), 46.88);
+    CHECK_LT(avg_1_row.column(4).float_value(), 46.89);
+    // Comparing floating point for 508.495
+    CHECK_GT(avg_1_row.column(5).double_value(), 508.49);
+    CHECK_LT(avg_1_row.column(5).double_value(), 508.50);
+
+    // Test AVG() - All rows. The sums are computed in a wider type, so the sum of tinyint values
+    // (204) does not overflow.
+    CHECK_VALID_STMT("SELECT avg(v1), avg(v2), avg(v3), avg(v4), avg(v5), avg(v6)"
+                     "  FROM test_aggr_expr;");
+    row_block = processor->row_block();
+    CHECK_EQ(row_block->row_count(), 1);
+    const QLRow& avg_all_row = row_block->row(0);
+    CHECK_EQ(avg_all_row.column(0).int64_value(), v1_total / 20);
+    CHECK_EQ(avg_all_row.column(1).int32_value(), v2_total / 20);
+    CHECK_EQ(avg_all_row.column(2).int16_value(), v3_total / 20);
+    CHECK_EQ(avg_all_row.column(3).int8_value(), 10);
+    CHECK_GT(avg_all_row.column(4).float_value(), v5_total / 20 - 0.1);
+    CHECK_LT(avg_all_row.column(4).float_value(), v5_total / 20 + 0.1);
+    CHECK_GT(avg_all_row.column(5).double_value(), v6_total / 20 - 0.1);
+    CHECK_LT(avg_all_row.column(5).double_value(), v6_total / 20 + 0.1);
+  }
+
+  //------------------------------------------------------------------------------------------------
+  // Test GROUP BY.
+  {
+    // Test GROUP BY - Partition key.
+    CHECK_VALID_STMT("SELECT h, count(*), avg(v2), max(r) FROM test_aggr_expr"
+                     "  WHERE h = 1 GROUP BY h;");
+    row_block = processor->row_block();
+    CHECK_EQ(row_block->row_count(), 1);
+    const QLRow& group_1_row = row_block->row(0);
+    CHECK_EQ(group_1_row.column(0).int32_value(), 1);
+    CHECK_EQ(group_1_row.column(1).int64_value(), 2);
+    CHECK_EQ(group_1_row.column(2).int32_value(), 56);
+    CHECK_EQ(group_1_row.column(3).int32_value(), 777);
+
+    // Test GROUP BY - Primary key.
+    CHECK_VALID_STMT("SELECT h, r, count(*), sum(v1) FROM test_aggr_expr"
+                     "  WHERE h = 1 GROUP BY h, r;");
+    row_block = processor->row_block();
+    CHECK_EQ(row_block->row_count(), 2);
+    CHECK_EQ(row_block->row(0).column(1).int32_value(), 2);
+    CHECK_EQ(row_block->row(0).column(2).int64_value(), 1);
+    CHECK_EQ(row_block->row(0).column(3).int64_value(), 1001);
+    CHECK_EQ(row_block->row(1).column(1).int32_value(), 777);
+    CHECK_EQ(row_block->row(1).column(2).int64_value(), 1);
+    CHECK_EQ(row_block->row(1).column(3).int64_value(), 11);
+
+    // Test GROUP BY - All rows.
+    CHECK_VALID_STMT("SELECT h, count(*), sum(v1) FROM test_aggr_expr GROUP BY h;");
+    row_block = processor->row_block();
+    CHECK_EQ(row_block->row_count(), 19);
+    int64_t count_total = 0;
+    int64_t group_v1_total = 0;
+    for (const QLRow& row : row_block->rows()) {
+      CHECK_EQ(row.column(1).int64_value(), row.column(0).int32_value() == 1 ? 2 : 1);
+      count_total += row.column(1).int64_value();
+      group_v1_total += row.column(2).int64_value();
+    }
+    CHECK_EQ(count_total, 20);
+    CHECK_EQ(group_v1_total, v1_total);
+
+    // Test GROUP BY - Limit applies to the groups.
+    CHECK_VALID_STMT("SELECT h, count(*) FROM test_aggr_expr GROUP BY h LIMIT 5;");
+    row_block = processor->row_block();
+    CHECK_EQ(row_block->row_count(), 5);
+
+    // Test GROUP BY - Unsupported groups.
+    CHECK_INVALID_STMT("SELECT count(*) FROM test_aggr_expr GROUP BY r;");
+    CHECK_INVALID_STMT("SELECT count(*) FROM test_aggr_expr GROUP BY v1;");
+    CHECK_INVALID_STMT("SELECT h, v1, count(*) FROM test_aggr_expr GROUP BY h;");
+    CHECK_INVALID_STMT("SELECT h FROM test_aggr_expr GROUP BY h;");
+  }
 }
 
 TEST_F(QLTestSelectedExpr, TestQLSelectNumericExpr) {
@@ -29,6 +29,27 @@ using strings::Substitute;
 namespace yb {
 namespace ql {
 
+// Statement parameters with bind variables given by position.
+class TestBindParameters : public StatementParameters {
+ public:
+  explicit TestBindParameters(std::vector<QLValue> values) : values_(std::move(values)) {
+  }
+
+  CHECKED_STATUS GetBindVariable(const std::string& name,
+                                 int64_t pos,
+                                 const std::shared_ptr<QLType>& type,
+                                 QLValue* value) const override {
+    if (pos < 0 || pos >= static_cast<int64_t>(values_.size())) {
+      return STATUS_FORMAT(NotFound, "Bind variable $0 not found", pos);
+    }
+    *value = values_[pos];
+    return Status::OK();
+  }
+
+ private:
+  std::vector<QLValue> values_;
+};
+
 class TestQLStatement : public QLTestBase {
  public:
   TestQLStatement() : QLTestBase() {
@@ -44,6 +65,35 @@ class TestQLStatement : public QLTestBase {
                               Bind(&TestQLStatement::ExecuteAsyncDone, Unretained(this), cb));
   }
 
+  void ExecuteDone(Synchronizer* sync, const Status& s, const ExecutedResult::SharedPtr& result) {
+    result_ = result;
+    sync->StatusCB(s);
+  }
+
+  Status Execute(Statement *stmt, QLProcessor *processor, std::vector<QLValue> values) {
+    // Parameters are referenced until the execution is completed.
+    TestBindParameters params(std::move(values));
+    Synchronizer sync;
+    result_ = nullptr;
+    RETURN_NOT_OK(stmt->ExecuteAsync(
+        processor, params, Bind(&TestQLStatement::ExecuteDone, Unretained(this), &sync)));
+    return sync.Wait();
+  }
+
+  static QLValue IntValue(int32_t value) {
+    QLValue result;
+    result.set_int32_value(value);
+    return result;
+  }
+
+  static QLValue StringValue(const std::string& value) {
+    QLValue result;
+    result.set_string_value(value);
+    return result;
+  }
+
+  ExecutedResult::SharedPtr result_;
+
 };
 
 TEST_F(TestQLStatement, TestExecutePrepareAfterTableDrop) {
@@ -103,5 +153,45 @@ TEST_F(TestQLStatement, TestPKIndices) {
   LOG(INFO) << "Done.";
 }
 
+TEST_F(TestQLStatement, TestPreparedRequestTemplate) {
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster());
+
+  // Get a processor.
+  TestQLProcessor *processor = GetQLProcessor();
+
+  EXEC_VALID_STMT("create table test_template (h int, r int, c text, primary key ((h), r));");
+
+  // The first execution builds the request template, the following ones fill in the bind
+  // variables of the template.
+  Statement insert_stmt(processor->CurrentKeyspace(),
+                        "insert into test_template (h, r, c) values (?, ?, ?) using ttl 1000;");
+  ASSERT_OK(insert_stmt.Prepare(processor));
+  for (int i = 0; i != 5; ++i) {
+    ASSERT_OK(Execute(&insert_stmt, processor,
+                      { IntValue(i % 2), IntValue(i), StringValue(Substitute("c$0", i)) }));
+  }
+
+  // Null values are still rejected for primary key columns.
+  Status s = Execute(&insert_stmt, processor, { QLValue(), IntValue(1), StringValue("c") });
+  ASSERT_TRUE(s.IsQLError() && GetErrorCode(s) == ErrorCode::NULL_ARGUMENT_FOR_PRIMARY_KEY)
+      << s.ToString();
+
+  Statement select_stmt(processor->CurrentKeyspace(),
+                        "select c from test_template where h = ? and r = ?;");
+  ASSERT_OK(select_stmt.Prepare(processor));
+  for (int i = 0; i != 5; ++i) {
+    ASSERT_OK(Execute(&select_stmt, processor, { IntValue(i % 2), IntValue(i) }));
+    ASSERT_EQ(ExecutedResult::Type::ROWS, result_->type());
+    auto row_block = static_cast<RowsResult*>(result_.get())->GetRowBlock();
+    ASSERT_EQ(1, row_block->row_count());
+    ASSERT_EQ(Substitute("c$0", i), row_block->row(0).column(0).string_value());
+  }
+
+  // Rows of another hash key are not returned.
+  ASSERT_OK(Execute(&select_stmt, processor, { IntValue(1), IntValue(0) }));
+  ASSERT_EQ(0, static_cast<RowsResult*>(result_.get())->GetRowBlock()->row_count());
+}
+
 } // namespace ql
 } // namespace yb
@@ -139,13 +139,13 @@ CHECKED_STATUS ParseSet(YBRedisWriteOp *op, const RedisClientCommand& args) {
   return Status::OK();
 }
 
-// TODO: support MSET
+// MSET is split into single key operations by the service, so here we parse MSET <KEY> <VALUE>.
 CHECKED_STATUS ParseMSet(YBRedisWriteOp *op, const RedisClientCommand& args) {
-  if (args.size() < 3 || args.size() % 2 == 0) {
+  if (args.size() != 3) {
     return STATUS_SUBSTITUTE(InvalidCommand,
-        "An MSET request must have at least 3, odd number of arguments, found $0", args.size());
+        "An MSET request must have a value for each key, found $0 arguments", args.size());
   }
-  return STATUS(InvalidCommand, "MSET command not yet supported");
+  return ParseSet(op, args);
 }
 
 CHECKED_STATUS ParseHSet(YBRedisWriteOp *op, const RedisClientCommand& args) {
@@ -367,7 +367,7 @@ CHECKED_STATUS ParseAppend(YBRedisWriteOp* op, const RedisClientCommand& args) {
   return Status::OK();
 }
 
-// Note: deleting only one key is supported using one command as of now.
+// DEL is split into single key operations by the service, so here we parse DEL <KEY>.
 CHECKED_STATUS ParseDel(YBRedisWriteOp* op, const RedisClientCommand& args) {
   const auto& key = args[1];
   op->mutable_request()->set_allocated_del_request(new RedisDelRequestPB());
@@ -428,9 +428,9 @@ CHECKED_STATUS ParseHGetLikeCommands(YBRedisReadOp* op, const RedisClientCommand
   return ParseCollection(op, args, boost::none, add_string_subkey, remove_duplicates);
 }
 
-// TODO: Support MGET
+// MGET is split into single key operations by the service, so here we parse MGET <KEY>.
 CHECKED_STATUS ParseMGet(YBRedisReadOp* op, const RedisClientCommand& args) {
-  return STATUS(InvalidCommand, "MGET command not yet supported");
+  return ParseGet(op, args);
 }
 
 CHECKED_STATUS ParseHGet(YBRedisReadOp* op, const RedisClientCommand& args) {
@@ -682,9 +682,10 @@ CHECKED_STATUS ParseGetRange(YBRedisReadOp* op, const RedisClientCommand& args)
   return Status::OK();
 }
 
-// Begin of input is going to be consumed, so we should adjust our pointers.
-// Since the beginning of input is being consumed by shifting the remaining bytes to the
-// beginning of the buffer.
+// The first 'count' bytes of input were consumed. The read buffer keeps the remaining bytes in
+// place and only advances its position past the consumed ones, so the next input passed to
+// Update starts with the first remaining byte, possibly at another address. Our pointers
+// are moved back by 'count' here, and rebased on the new input by Update.
 void RedisParser::Consume(size_t count) {
   pos_ -= count;
   if (token_begin_ != nullptr) {
@@ -52,9 +52,10 @@ class RedisParser {
     args_ = args;
   }
 
-  // Begin of input is going to be consumed, so we should adjust our pointers.
-  // Since the beginning of input is being consumed by shifting the remaining bytes to the
-  // beginning of the buffer.
+  // The first 'count' bytes of input were consumed. The read buffer keeps the remaining bytes in
+  // place and only advances its position past the consumed ones, so the next input passed to
+  // Update starts with the first remaining byte, possibly at another address. Our pointers
+  // are moved back by 'count' here, and rebased on the new input by Update.
   void Consume(size_t count);
 
   // New data arrived, so update the end of available bytes.
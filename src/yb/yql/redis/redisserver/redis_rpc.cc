@@ -58,8 +58,9 @@ RedisConnectionContext::RedisConnectionContext()
 RedisConnectionContext::~RedisConnectionContext() {}
 
 Status RedisConnectionContext::ProcessCalls(const rpc::ConnectionPtr& connection,
-                                            Slice slice,
+                                            const RefCntSlice& data,
                                             size_t* consumed) {
+  const Slice& slice = data.AsSlice();
   if (!parser_) {
     parser_.reset(new RedisParser(slice));
   } else {
@@ -80,7 +81,7 @@ Status RedisConnectionContext::ProcessCalls(const rpc::ConnectionPtr& connection
     if (++commands_in_batch_ >= FLAGS_redis_max_batch) {
       RETURN_NOT_OK(HandleInboundCall(connection,
                                       commands_in_batch_,
-                                      Slice(begin_of_batch, end_of_batch)));
+                                      data.SubSlice(begin_of_batch, end_of_batch)));
       begin_of_batch = end_of_batch;
       commands_in_batch_ = 0;
     }
@@ -91,7 +92,7 @@ Status RedisConnectionContext::ProcessCalls(const rpc::ConnectionPtr& connection
   if (commands_in_batch_ > 0 && end_of_batch == slice.end()) {
     RETURN_NOT_OK(HandleInboundCall(connection,
                                     commands_in_batch_,
-                                    Slice(begin_of_batch, end_of_batch)));
+                                    data.SubSlice(begin_of_batch, end_of_batch)));
     begin_of_batch = end_of_batch;
     commands_in_batch_ = 0;
   }
@@ -102,7 +103,7 @@ Status RedisConnectionContext::ProcessCalls(const rpc::ConnectionPtr& connection
 
 Status RedisConnectionContext::HandleInboundCall(const rpc::ConnectionPtr& connection,
                                                  size_t commands_in_batch,
-                                                 Slice source) {
+                                                 const RefCntSlice& source) {
   auto reactor = connection->reactor();
   DCHECK(reactor->IsCurrentThread());
 
@@ -141,12 +142,13 @@ RedisInboundCall::~RedisInboundCall() {
   }
 
 }
-Status RedisInboundCall::ParseFrom(size_t commands, Slice source) {
+Status RedisInboundCall::ParseFrom(size_t commands, const RefCntSlice& data) {
   TRACE_EVENT_FLOW_BEGIN0("rpc", "RedisInboundCall", this);
   TRACE_EVENT0("rpc", "RedisInboundCall::ParseFrom");
 
-  request_data_.assign(source.data(), source.end());
-  serialized_request_ = source = Slice(request_data_.data(), request_data_.size());
+  request_data_ = data;
+  serialized_request_ = data.AsSlice();
+  const Slice& source = serialized_request_;
 
   client_batch_.resize(commands);
   responses_.resize(commands);
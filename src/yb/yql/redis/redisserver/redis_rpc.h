@@ -42,13 +42,13 @@ class RedisConnectionContext : public rpc::ConnectionContextWithQueue {
   }
 
   CHECKED_STATUS ProcessCalls(const rpc::ConnectionPtr& connection,
-                              Slice slice,
+                              const RefCntSlice& data,
                               size_t* consumed) override;
   size_t BufferLimit() override;
 
   CHECKED_STATUS HandleInboundCall(const rpc::ConnectionPtr& connection,
                                    size_t commands_in_batch,
-                                   Slice source);
+                                   const RefCntSlice& source);
 
   std::unique_ptr<RedisParser> parser_;
   size_t commands_in_batch_ = 0;
@@ -58,7 +58,7 @@ class RedisInboundCall : public rpc::QueueableInboundCall {
  public:
   explicit RedisInboundCall(rpc::ConnectionPtr conn, CallProcessedListener call_processed_listener);
   ~RedisInboundCall();
-  CHECKED_STATUS ParseFrom(size_t commands, Slice source);
+  CHECKED_STATUS ParseFrom(size_t commands, const RefCntSlice& data);
 
   // Serialize the response packet for the finished call.
   // The resulting slices refer to memory in this object.
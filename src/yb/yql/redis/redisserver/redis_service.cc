@@ -42,6 +42,7 @@
 #include "yb/yql/redis/redisserver/redis_rpc.h"
 #include "yb/yql/redis/redisserver/redis_server.h"
 
+#include "yb/rpc/messenger.h"
 #include "yb/rpc/rpc_context.h"
 
 #include "yb/tserver/tablet_server.h"
@@ -109,9 +110,13 @@ DEFINE_int32(redis_max_value_size, 64_MB,
 
 DEFINE_bool(redis_safe_batch, true, "Use safe batching with Redis service");
 
+DEFINE_int32(redis_tablet_batch_window_us, 0,
+             "If positive, operations for the same tablet received from different Redis "
+             "connections within this window are sent to the tablet in a single RPC");
+
 #define REDIS_COMMANDS \
     ((get, Get, 2, READ)) \
-    ((mget, MGet, -2, READ)) \
+    ((mget, MGet, -2, MULTI_READ)) \
     ((hget, HGet, 3, READ)) \
     ((tsget, TsGet, 3, READ)) \
     ((hmget, HMGet, -3, READ)) \
@@ -129,7 +134,7 @@ DEFINE_bool(redis_safe_batch, true, "Use safe batching with Redis service");
     ((getrange, GetRange, 4, READ)) \
     ((zcard, ZCard, 2, READ)) \
     ((set, Set, -3, WRITE)) \
-    ((mset, MSet, -3, WRITE)) \
+    ((mset, MSet, -3, MULTI_WRITE)) \
     ((hset, HSet, 4, WRITE)) \
     ((hmset, HMSet, -4, WRITE)) \
     ((hdel, HDel, -3, WRITE)) \
@@ -144,7 +149,7 @@ DEFINE_bool(redis_safe_batch, true, "Use safe batching with Redis service");
     ((zadd, ZAdd, -4, WRITE)) \
     ((getset, GetSet, 3, WRITE)) \
     ((append, Append, 3, WRITE)) \
-    ((del, Del, 2, WRITE)) \
+    ((del, Del, -2, MULTI_WRITE)) \
     ((setrange, SetRange, 4, WRITE)) \
     ((incr, Incr, 2, WRITE)) \
     ((echo, Echo, 2, LOCAL)) \
@@ -182,6 +187,8 @@ typedef boost::container::small_vector_base<Slice> RedisKeyList;
 
 #define READ_OP YBRedisReadOp
 #define WRITE_OP YBRedisWriteOp
+#define MULTI_READ_OP YBRedisReadOp
+#define MULTI_WRITE_OP YBRedisWriteOp
 #define LOCAL_OP RedisResponsePB
 #define TRUNCATE_OP void
 
@@ -195,18 +202,108 @@ BOOST_PP_SEQ_FOR_EACH(PARSER_FORWARD, ~, REDIS_COMMANDS)
 
 namespace {
 
+// Multi key command (MGET, MSET, DEL) is split into single key operations, that are grouped
+// with other operations by tablet, and executed in parallel.
+// This class collects responses of those operations and responds to the command, when all of
+// them are ready. Responses are combined in the order of keys in the command.
+class MultiKeyResponse {
+ public:
+  MultiKeyResponse(const std::shared_ptr<RedisInboundCall>& call,
+                   size_t index,
+                   size_t num_keys,
+                   bool read,
+                   const rpc::RpcMethodMetrics& metrics)
+      : call_(call),
+        index_(index),
+        read_(read),
+        metrics_(metrics),
+        responses_(num_keys),
+        statuses_(num_keys),
+        keys_left_(num_keys) {}
+
+  void Respond(size_t key_index, const Status& status, RedisResponsePB* response) {
+    if (status.ok()) {
+      responses_[key_index].Swap(response);
+    } else {
+      statuses_[key_index] = status;
+    }
+    if (keys_left_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      Complete();
+    }
+  }
+
+ private:
+  void Complete() {
+    for (const auto& status : statuses_) {
+      if (!status.ok()) {
+        call_->RespondFailure(index_, status);
+        return;
+      }
+    }
+
+    RedisResponsePB response;
+    if (read_) {
+      // Like in Redis, missing keys and keys of non string type are returned as nil.
+      auto* array_response = response.mutable_array_response();
+      for (const auto& key_response : responses_) {
+        if (key_response.code() == RedisResponsePB_RedisStatusCode_OK &&
+            key_response.has_string_response()) {
+          auto encoded = EncodeAsBulkString(key_response.string_response());
+          array_response->add_elements(encoded.data(), encoded.size());
+        } else {
+          array_response->add_elements(kNilResponse);
+        }
+      }
+      array_response->set_encoded(true);
+    } else {
+      // MSET responds with OK, DEL with the total number of deleted keys.
+      bool has_int_response = false;
+      int64_t int_response = 0;
+      for (auto& key_response : responses_) {
+        if (key_response.code() != RedisResponsePB_RedisStatusCode_OK) {
+          call_->RespondSuccess(index_, metrics_, &key_response);
+          return;
+        }
+        if (key_response.has_int_response()) {
+          has_int_response = true;
+          int_response += key_response.int_response();
+        }
+      }
+      if (has_int_response) {
+        response.set_int_response(int_response);
+      }
+    }
+    response.set_code(RedisResponsePB_RedisStatusCode_OK);
+    call_->RespondSuccess(index_, metrics_, &response);
+  }
+
+  std::shared_ptr<RedisInboundCall> call_;
+  size_t index_;
+  bool read_;
+  rpc::RpcMethodMetrics metrics_;
+  std::vector<RedisResponsePB> responses_;
+  std::vector<Status> statuses_;
+  std::atomic<size_t> keys_left_;
+};
+
+typedef std::shared_ptr<MultiKeyResponse> MultiKeyResponsePtr;
+
 class Operation {
  public:
   template <class Op>
   Operation(const std::shared_ptr<RedisInboundCall>& call,
             size_t index,
             std::shared_ptr<Op> operation,
-            const rpc::RpcMethodMetrics& metrics)
+            const rpc::RpcMethodMetrics& metrics,
+            MultiKeyResponsePtr multi_key_response = nullptr,
+            size_t key_index = 0)
     : read_(std::is_same<Op, YBRedisReadOp>::value),
       call_(call),
       index_(index),
       operation_(std::move(operation)),
-      metrics_(metrics) {
+      metrics_(metrics),
+      multi_key_response_(std::move(multi_key_response)),
+      key_index_(key_index) {
     auto status = operation_->GetPartitionKey(&partition_key_);
     if (!status.ok()) {
       Respond(status);
@@ -272,8 +369,14 @@ class Operation {
   }
 
   void Respond(const Status& status) {
-    responded_.store(true, std::memory_order_release);
-    if (status.ok()) {
+    // Only the first response matters, i.e. failure to apply operation is not overwritten by
+    // the status of the flush.
+    if (responded_.exchange(true, std::memory_order_acq_rel)) {
+      return;
+    }
+    if (multi_key_response_) {
+      multi_key_response_->Respond(key_index_, status, &response());
+    } else if (status.ok()) {
       call_->RespondSuccess(index_, metrics_, &response());
     } else {
       call_->RespondFailure(index_, status);
@@ -285,6 +388,9 @@ class Operation {
   size_t index_;
   std::shared_ptr<YBRedisOp> operation_;
   rpc::RpcMethodMetrics metrics_;
+  // Set when this operation is a part of multi key command.
+  MultiKeyResponsePtr multi_key_response_;
+  size_t key_index_;
   std::string partition_key_;
   scoped_refptr<client::internal::RemoteTablet> tablet_;
   std::atomic<bool> responded_{false};
@@ -333,6 +439,8 @@ class SessionPool {
 class BatchContext;
 typedef scoped_refptr<BatchContext> BatchContextPtr;
 
+class TabletBatcher;
+
 class Block : public std::enable_shared_from_this<Block> {
  public:
   typedef MCVector<Operation*> Ops;
@@ -349,23 +457,41 @@ class Block : public std::enable_shared_from_this<Block> {
     ops_.push_back(operation);
   }
 
-  void Launch(SessionPool* session_pool, bool allow_local_calls_in_curr_thread = true) {
-    session_pool_ = session_pool;
-    session_ = session_pool->Take();
+  void Launch(SessionPool* session_pool,
+              TabletBatcher* tablet_batcher,
+              bool allow_local_calls_in_curr_thread = true);
+
+  // Applies operations of this block to the session, returns true if any operation was applied.
+  bool Apply(client::YBSession* session) {
     bool has_ok = false;
     for (auto* op : ops_) {
-      has_ok = op->Apply(session_.get()) || has_ok;
+      has_ok = op->Apply(session) || has_ok;
     }
-    if (has_ok) {
-      // Allow local calls in this thread only if no one is waiting behind us.
-      session_->set_allow_local_calls_in_curr_thread(
-          allow_local_calls_in_curr_thread && this->next_ == nullptr);
-      session_->FlushAsync(BlockCallback(shared_from_this()));
+    applied_ = has_ok;
+    return has_ok;
+  }
+
+  // Invoked when this block was flushed by the tablet batcher together with blocks of other calls.
+  void Flushed(const Status& status, client::YBSession* session) {
+    if (applied_) {
+      Done(status, session);
     } else {
       Processed();
     }
   }
 
+  // Invoked when the tablet batcher could not flush this block, e.g. during shutdown.
+  void Failed(const Status& status) {
+    Done(status, nullptr);
+  }
+
+  // Tablet and kind of operations of this block, blocks with the same key could be flushed
+  // together.
+  std::pair<Slice, bool> BatchKey() const {
+    auto& op = *ops_.front();
+    return std::make_pair(Slice(op.tablet()->tablet_id()), op.read());
+  }
+
   std::shared_ptr<Block> SetNext(const std::shared_ptr<Block>& next) {
     std::shared_ptr<Block> result = std::move(next_);
     next_ = next;
@@ -378,7 +504,7 @@ class Block : public std::enable_shared_from_this<Block> {
 
     void operator()(const Status& status) {
       auto context = block_->context_;
-      block_->Done(status);
+      block_->Done(status, block_->session_.get());
       block_.reset();
     }
    private:
@@ -386,14 +512,14 @@ class Block : public std::enable_shared_from_this<Block> {
   };
   friend class BlockCallback;
 
-  void Done(const Status& status) {
+  void Done(const Status& status, client::YBSession* session) {
     MonoTime now = MonoTime::Now();
     metrics_internal_.handler_latency->Increment(now.GetDeltaSince(start_).ToMicroseconds());
     VLOG(3) << "Received status from call " << status.ToString(true);
 
     if (!status.ok()) {
-      if (session_.get() != nullptr) {
-        for (const auto& error : session_->GetPendingErrors()) {
+      if (session != nullptr) {
+        for (const auto& error : session->GetPendingErrors()) {
           LOG(WARNING) << "Explicit error while inserting: " << error->status().ToString();
         }
       }
@@ -407,11 +533,15 @@ class Block : public std::enable_shared_from_this<Block> {
   }
 
   void Processed() {
-    auto allow_local_calls_in_curr_thread = session_->allow_local_calls_in_curr_thread();
-    session_pool_->Release(session_);
-    session_.reset();
+    // Session is not owned by block, when it was flushed by the tablet batcher.
+    bool allow_local_calls_in_curr_thread = false;
+    if (session_) {
+      allow_local_calls_in_curr_thread = session_->allow_local_calls_in_curr_thread();
+      session_pool_->Release(session_);
+      session_.reset();
+    }
     if (next_) {
-      next_->Launch(session_pool_, allow_local_calls_in_curr_thread);
+      next_->Launch(session_pool_, tablet_batcher_, allow_local_calls_in_curr_thread);
     }
     context_.reset();
   }
@@ -421,10 +551,138 @@ class Block : public std::enable_shared_from_this<Block> {
   rpc::RpcMethodMetrics metrics_internal_;
   MonoTime start_;
   SessionPool* session_pool_;
+  TabletBatcher* tablet_batcher_;
   std::shared_ptr<client::YBSession> session_;
   std::shared_ptr<Block> next_;
+  bool applied_ = false;
 };
 
+// Coalesces blocks of different calls, i.e. received from different connections, that contain
+// operations for the same tablet. Such blocks are collected during
+// redis_tablet_batch_window_us and flushed using single session, so the tablet receives them in
+// a single RPC.
+class TabletBatcher : public std::enable_shared_from_this<TabletBatcher> {
+ public:
+  void Init(SessionPool* session_pool, rpc::Scheduler* scheduler) {
+    session_pool_ = session_pool;
+    scheduler_ = scheduler;
+  }
+
+  bool enabled() const {
+    return scheduler_ != nullptr && FLAGS_redis_tablet_batch_window_us > 0;
+  }
+
+  void Add(std::shared_ptr<Block> block) {
+    auto key = block->BatchKey();
+    bool schedule_flush = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = pending_.find(key);
+      if (it == pending_.end()) {
+        // Key refers to tablet id stored in the block, so we use block that is stored in the
+        // pending list to keep it alive.
+        Pending pending;
+        pending.push_back(std::move(block));
+        pending_.emplace(key, std::move(pending));
+        schedule_flush = true;
+      } else {
+        it->second.push_back(std::move(block));
+      }
+    }
+    if (schedule_flush) {
+      auto tablet_id = key.first.ToBuffer();
+      auto read = key.second;
+      std::weak_ptr<TabletBatcher> weak_self = shared_from_this();
+      scheduler_->Schedule(
+          [weak_self, tablet_id, read](const Status& status) {
+            auto self = weak_self.lock();
+            if (self) {
+              self->Flush(std::make_pair(Slice(tablet_id), read), status);
+            }
+          },
+          std::chrono::microseconds(FLAGS_redis_tablet_batch_window_us));
+    }
+  }
+
+ private:
+  typedef std::vector<std::shared_ptr<Block>> Pending;
+  typedef std::pair<Slice, bool> Key;
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      return key.first.hash() ^ key.second;
+    }
+  };
+
+  // status is the status of the scheduled task. It is not OK when the task was aborted, e.g.
+  // because the scheduler is shutting down, in this case pending blocks are failed.
+  void Flush(const Key& key, const Status& status) {
+    Pending blocks;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = pending_.find(key);
+      if (it == pending_.end()) {
+        return;
+      }
+      blocks = std::move(it->second);
+      pending_.erase(it);
+    }
+
+    if (!status.ok()) {
+      for (const auto& block : blocks) {
+        block->Failed(status);
+      }
+      return;
+    }
+
+    auto session = session_pool_->Take();
+    bool has_ok = false;
+    for (const auto& block : blocks) {
+      has_ok = block->Apply(session.get()) || has_ok;
+    }
+    if (!has_ok) {
+      session_pool_->Release(session);
+      for (const auto& block : blocks) {
+        block->Flushed(Status::OK(), nullptr);
+      }
+      return;
+    }
+    session->set_allow_local_calls_in_curr_thread(false);
+    auto* session_pool = session_pool_;
+    session->FlushAsync([session_pool, session, blocks](const Status& status) {
+      for (const auto& block : blocks) {
+        block->Flushed(status, session.get());
+      }
+      session_pool->Release(session);
+    });
+  }
+
+  SessionPool* session_pool_ = nullptr;
+  rpc::Scheduler* scheduler_ = nullptr;
+  std::mutex mutex_;
+  std::unordered_map<Key, Pending, KeyHash> pending_;
+};
+
+void Block::Launch(SessionPool* session_pool,
+                   TabletBatcher* tablet_batcher,
+                   bool allow_local_calls_in_curr_thread) {
+  session_pool_ = session_pool;
+  tablet_batcher_ = tablet_batcher;
+  if (tablet_batcher != nullptr && tablet_batcher->enabled()) {
+    tablet_batcher->Add(shared_from_this());
+    return;
+  }
+  session_ = session_pool->Take();
+  if (Apply(session_.get())) {
+    // Allow local calls in this thread only if no one is waiting behind us.
+    session_->set_allow_local_calls_in_curr_thread(
+        allow_local_calls_in_curr_thread && this->next_ == nullptr);
+    session_->FlushAsync(BlockCallback(shared_from_this()));
+  } else {
+    Processed();
+  }
+}
+
 struct BlockData {
   explicit BlockData(Arena* arena) : used_keys(UsedKeys::allocator_type(arena)) {}
 
@@ -443,15 +701,17 @@ class TabletOperations {
     return read ? read_data_ : write_data_;
   }
 
-  void Done(SessionPool* session_pool, bool allow_local_calls_in_curr_thread) {
+  void Done(SessionPool* session_pool,
+            TabletBatcher* tablet_batcher,
+            bool allow_local_calls_in_curr_thread) {
     if (flush_head_) {
-      flush_head_->Launch(session_pool, allow_local_calls_in_curr_thread);
+      flush_head_->Launch(session_pool, tablet_batcher, allow_local_calls_in_curr_thread);
     } else {
       if (read_data_.block) {
-        read_data_.block->Launch(session_pool, allow_local_calls_in_curr_thread);
+        read_data_.block->Launch(session_pool, tablet_batcher, allow_local_calls_in_curr_thread);
       }
       if (write_data_.block) {
-        write_data_.block->Launch(session_pool, allow_local_calls_in_curr_thread);
+        write_data_.block->Launch(session_pool, tablet_batcher, allow_local_calls_in_curr_thread);
       }
     }
   }
@@ -533,10 +793,12 @@ class BatchContext : public RefCountedThreadSafe<BatchContext> {
  public:
   BatchContext(const std::shared_ptr<client::YBClient>& client,
                SessionPool* session_pool,
+               TabletBatcher* tablet_batcher,
                const std::shared_ptr<RedisInboundCall>& call,
                rpc::RpcMethodMetrics* metrics_internal)
       : client_(client),
         session_pool_(session_pool),
+        tablet_batcher_(tablet_batcher),
         call_(call),
         metrics_internal_(metrics_internal),
         operations_(&arena_),
@@ -571,8 +833,11 @@ class BatchContext : public RefCountedThreadSafe<BatchContext> {
   template <class Op>
   void Apply(size_t idx,
              std::shared_ptr<Op> op,
-             const rpc::RpcMethodMetrics& metrics) {
-    operations_.emplace_back(call_, idx, std::move(op), metrics);
+             const rpc::RpcMethodMetrics& metrics,
+             MultiKeyResponsePtr multi_key_response = nullptr,
+             size_t key_index = 0) {
+    operations_.emplace_back(
+        call_, idx, std::move(op), metrics, std::move(multi_key_response), key_index);
     if (PREDICT_FALSE(operations_.back().responded())) {
       operations_.pop_back();
     }
@@ -604,12 +869,13 @@ class BatchContext : public RefCountedThreadSafe<BatchContext> {
 
     int idx = 0;
     for (auto& tablet : tablets_) {
-      tablet.second.Done(session_pool_, ++idx == tablets_.size());
+      tablet.second.Done(session_pool_, tablet_batcher_, ++idx == tablets_.size());
     }
   }
 
   std::shared_ptr<client::YBClient> client_;
   SessionPool* session_pool_;
+  TabletBatcher* tablet_batcher_;
   std::shared_ptr<RedisInboundCall> call_;
   rpc::RpcMethodMetrics* metrics_internal_;
 
@@ -685,6 +951,13 @@ class RedisServiceImpl::Impl {
       Parser<Op> parser,
       BatchContext* context);
 
+  template<class Op>
+  void MultiKeyCommand(
+      const RedisCommandInfo& info,
+      size_t idx,
+      Parser<Op> parser,
+      BatchContext* context);
+
   void TruncateCommand(
       const RedisCommandInfo& info,
       size_t idx,
@@ -711,6 +984,9 @@ class RedisServiceImpl::Impl {
   std::atomic<bool> yb_client_initialized_;
   std::shared_ptr<client::YBClient> client_;
   SessionPool session_pool_;
+  // Scheduled flushes only keep a weak reference to the tablet batcher, so they don't access it
+  // after it was destroyed.
+  std::shared_ptr<TabletBatcher> tablet_batcher_ = std::make_shared<TabletBatcher>();
   std::shared_ptr<client::YBTable> table_;
 
   RedisServer* server_;
@@ -786,6 +1062,8 @@ void ParseFlushAll(const RedisClientCommand& command) {
 
 #define READ_COMMAND Command<YBRedisReadOp>
 #define WRITE_COMMAND Command<YBRedisWriteOp>
+#define MULTI_READ_COMMAND MultiKeyCommand<YBRedisReadOp>
+#define MULTI_WRITE_COMMAND MultiKeyCommand<YBRedisWriteOp>
 #define LOCAL_COMMAND LocalCommand
 #define TRUNCATE_COMMAND TruncateCommand
 
@@ -857,6 +1135,7 @@ Status RedisServiceImpl::Impl::SetUpYBClient() {
     RETURN_NOT_OK(client_->OpenTable(table_name, &table_));
 
     session_pool_.Init(client_, server_->metric_entity());
+    tablet_batcher_->Init(&session_pool_, &server_->messenger()->scheduler());
 
     yb_client_initialized_.store(true, std::memory_order_release);
   }
@@ -894,6 +1173,7 @@ void RedisServiceImpl::Impl::Handle(rpc::InboundCallPtr call_ptr) {
   // Sequential write commands use single session and the same batcher.
   auto context = make_scoped_refptr(new BatchContext(client_,
                                                      &session_pool_,
+                                                     tablet_batcher_.get(),
                                                      call,
                                                      metrics_internal_.data()));
   const auto& batch = call->client_batch();
@@ -960,6 +1240,48 @@ void RedisServiceImpl::Impl::Command(
   context->Apply(idx, std::move(op), info.metrics);
 }
 
+template<class Op>
+void RedisServiceImpl::Impl::MultiKeyCommand(
+    const RedisCommandInfo& info,
+    size_t idx,
+    Parser<Op> parser,
+    BatchContext* context) {
+  VLOG(1) << "Processing " << info.name << ".";
+
+  // Minimal form of multi key command contains exactly one key, so its arity also defines
+  // number of arguments per key, i.e. 1 for MGET and DEL, 2 for MSET.
+  const auto& command = context->command(idx);
+  const size_t args_per_key = -info.arity - 1;
+  if ((command.size() - 1) % args_per_key != 0) {
+    RespondWithFailure(context->call(), idx, "Wrong number of arguments.");
+    return;
+  }
+
+  // Each key is parsed as a separate single key command, i.e. MGET k1 k2 as MGET k1 and MGET k2.
+  const size_t num_keys = (command.size() - 1) / args_per_key;
+  std::vector<std::shared_ptr<Op>> ops;
+  ops.reserve(num_keys);
+  RedisClientCommand key_command;
+  for (auto it = command.begin() + 1; it != command.end(); it += args_per_key) {
+    key_command.clear();
+    key_command.push_back(command[0]);
+    key_command.insert(key_command.end(), it, it + args_per_key);
+    auto op = std::make_shared<Op>(table_);
+    Status s = parser(op.get(), key_command);
+    if (!s.ok()) {
+      RespondWithFailure(context->call(), idx, s.message().ToBuffer());
+      return;
+    }
+    ops.push_back(std::move(op));
+  }
+
+  auto response = std::make_shared<MultiKeyResponse>(
+      context->call(), idx, num_keys, std::is_same<Op, YBRedisReadOp>::value, info.metrics);
+  for (size_t i = 0; i != num_keys; ++i) {
+    context->Apply(idx, std::move(ops[i]), info.metrics, response, i);
+  }
+}
+
 void RedisServiceImpl::Impl::TruncateCommand(
     const RedisCommandInfo& info,
     size_t idx,
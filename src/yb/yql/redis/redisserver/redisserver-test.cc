@@ -39,6 +39,7 @@
 DECLARE_uint64(redis_max_concurrent_commands);
 DECLARE_uint64(redis_max_batch);
 DECLARE_bool(redis_safe_batch);
+DECLARE_int32(redis_tablet_batch_window_us);
 DECLARE_bool(emulate_redis_responses);
 DECLARE_int32(redis_max_value_size);
 DECLARE_int32(redis_max_command_size);
@@ -807,6 +808,28 @@ TEST_F_EX(TestRedisService, SafeBatchPipeline, TestRedisServiceSafeBatch) {
   LOG(INFO) << yb::Format("Safe set: $0ms, get: $1ms", set_time.count(), get_time.count());
 }
 
+class TestRedisServiceTabletBatching : public TestRedisServicePipelined {
+ public:
+  void SetUp() override {
+    FLAGS_redis_tablet_batch_window_us = 1000;
+    TestRedisServicePipelined::SetUp();
+  }
+};
+
+TEST_F_EX(TestRedisService, TabletBatchingPipeline, TestRedisServiceTabletBatching) {
+  SendCommandAndExpectResponse(__LINE__, PipelineSetCommand(), PipelineSetResponse());
+  SendCommandAndExpectResponse(__LINE__, PipelineGetCommand(), PipelineGetResponse());
+}
+
+TEST_F_EX(TestRedisService, TabletBatchingMixedBatch, TestRedisServiceTabletBatching) {
+  constexpr size_t kBatches = 50;
+  BatchGenerator generator(false);
+  for (size_t i = 0; i != kBatches; ++i) {
+    auto batch = generator.Generate();
+    SendCommandAndExpectResponse(__LINE__, batch.first, batch.second);
+  }
+}
+
 TEST_F(TestRedisService, BatchedCommandMulti) {
   SendCommandAndExpectResponse(
       __LINE__,
@@ -1901,6 +1924,57 @@ TEST_F(TestRedisService, TestDel) {
   VerifyCallbacks();
 }
 
+TEST_F(TestRedisService, TestMultiKeyDel) {
+  FLAGS_emulate_redis_responses = true;
+
+  DoRedisTestOk(__LINE__, {"SET", "key1", "value1"});
+  DoRedisTestOk(__LINE__, {"SET", "key2", "value2"});
+  DoRedisTestOk(__LINE__, {"HSET", "map_key", "subkey", "value"});
+  SyncClient();
+  DoRedisTestInt(__LINE__, {"DEL", "key1", "non_existent", "map_key", "key2"}, 3);
+  DoRedisTestInt(__LINE__, {"DEL", "key1", "key2"}, 0);
+  SyncClient();
+  DoRedisTestNull(__LINE__, {"GET", "key1"});
+  DoRedisTestNull(__LINE__, {"GET", "key2"});
+  SyncClient();
+  VerifyCallbacks();
+}
+
+TEST_F(TestRedisService, TestMGetMSet) {
+  DoRedisTestOk(__LINE__, {"MSET", "key1", "value1", "key2", "value2", "key3", "value3"});
+  DoRedisTestOk(__LINE__, {"HSET", "map_key", "subkey", "value"});
+  SyncClient();
+  // Missing keys and keys of other types are returned as nil, like in Redis.
+  DoRedisTestArray(__LINE__, {"MGET", "key3", "non_existent", "key1", "map_key", "key2"},
+                   {"value3", "", "value1", "", "value2"});
+  DoRedisTestArray(__LINE__, {"MGET", "key2"}, {"value2"});
+  DoRedisTestExpectError(__LINE__, {"MSET", "key1", "value1", "key2"});
+  DoRedisTestExpectError(__LINE__, {"MSET", "", "value"});
+  SyncClient();
+
+  // Keys of a big command belong to different tablets.
+  constexpr size_t kNumKeys = 200;
+  std::vector<std::string> mset = {"MSET"};
+  std::vector<std::string> mget = {"MGET"};
+  std::vector<std::string> expected;
+  for (size_t i = 0; i != kNumKeys; ++i) {
+    auto key = Format("key_$0", i);
+    mset.push_back(key);
+    mset.push_back(Format("value_$0", i));
+    mget.push_back(key);
+    expected.push_back(i % 10 == 0 ? "" : Format("value_$0", i));
+  }
+  DoRedisTestOk(__LINE__, mset);
+  SyncClient();
+  for (size_t i = 0; i < kNumKeys; i += 10) {
+    DoRedisTestInt(__LINE__, {"DEL", mget[i + 1]}, 1);
+  }
+  SyncClient();
+  DoRedisTestArray(__LINE__, mget, expected);
+  SyncClient();
+  VerifyCallbacks();
+}
+
 TEST_F(TestRedisService, TestHDel) {
   // The default value is true, but we explicitly set this here for clarity.
   FLAGS_emulate_redis_responses = true;